@@ -3,6 +3,10 @@
 #include "glad/glad.h"
 #include "GLFW/glfw3.h"
 
+struct BenchmarkSettings;
+class Benchmark;
+class ThreadPool;
+
 enum ShaderStatus
 {
 	DEFFERED,
@@ -22,6 +26,10 @@ private:
 	static ShaderStatus m_shaderStatus;
 	static GLFWwindow* m_Window;
 	static float m_DeltaTime;
+	// Only set when running a benchmark
+	static Benchmark* m_Benchmark;
+	// Workers shared by the resource loading and the scene systems
+	static ThreadPool* m_ThreadPool;
 
 	static void ResizeCallback(GLFWwindow* window, int32_t width, int32_t height);
 	static void ErrorCallback(int32_t error, const char* const description);
@@ -36,7 +44,15 @@ private:
 	static void PostLoop();
 
 public:
-	static void Init();
-	static void MainLoop();
+	/// <summary>
+	/// Creates the window and the GL context
+	/// </summary>
+	/// <param name="benchmark">Options of a benchmark to run, the window is hidden and not synchronized with the display. nullptr to run interactively</param>
+	static void Init(const BenchmarkSettings* const benchmark = nullptr);
+	/// <summary>
+	/// Runs the scene until the window is closed or the benchmark is done
+	/// </summary>
+	/// <returns>False if the benchmark failed, either a resource of the scene couldn't be loaded or the results couldn't be written</returns>
+	static bool MainLoop();
 	static void Shutdown();
 };
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+#include "core/maths/vector3.h"
+#include "core/debug/profiler.hpp"
+
+/// <summary>
+/// API creating the GL context of a benchmark
+/// </summary>
+enum class BenchmarkContext
+{
+	// Default context of the platform, needs a GPU driver
+	NATIVE,
+	// EGL context, e.g. Mesa llvmpipe on a machine without a display
+	EGL,
+	// OSMesa software context
+	OSMESA,
+};
+
+/// <summary>
+/// Options of a headless benchmark run, parsed from the command line
+/// </summary>
+struct BenchmarkSettings
+{
+	uint32_t FrameCount = 1000;
+	// Frames rendered once the resources are loaded, before the measures start
+	uint32_t WarmupFrames = 60;
+	uint32_t ObjectCount = 2000;
+	uint32_t LightCount = 100;
+	uint32_t Width = 1280;
+	uint32_t Height = 720;
+	BenchmarkContext Context = BenchmarkContext::NATIVE;
+	std::filesystem::path OutputPath = "benchmark.json";
+
+	/// <summary>
+	/// Reads the benchmark options : --benchmark [--frames n] [--warmup n] [--objects n] [--lights n]
+	/// [--width n] [--height n] [--context native|egl|osmesa] [--output path]
+	/// </summary>
+	/// <param name="argc">Number of arguments</param>
+	/// <param name="argv">Arguments, the first one is the executable</param>
+	/// <param name="settings">Receives the options given</param>
+	/// <returns>True if --benchmark was given</returns>
+	static bool Parse(const int argc, const char* const* const argv, BenchmarkSettings& settings);
+};
+
+/// <summary>
+/// Runs the camera along a scripted path through a generated scene and reports the frame time percentiles.
+/// <para>
+/// The timings come from the profiler : the duration of the frames, the CPU scopes of every frame and the GPU passes.
+/// A frame is only recorded when it is about to leave the profiler history, so its GPU queries had every chance to be read.
+/// </para>
+/// </summary>
+class Benchmark
+{
+private:
+	BenchmarkSettings m_Settings;
+
+	bool m_Started;
+	// Profiler index of the first measured frame
+	uint64_t m_FirstFrame;
+	uint64_t m_Frame;
+	// Profiler index of the next frame to record
+	uint64_t m_NextRecorded;
+
+	// Milliseconds per measured frame
+	std::vector<float> m_FrameTimes;
+	// Milliseconds per measured frame, summed over the scopes of the same name
+	std::map<std::string, std::vector<float>> m_CpuTimes;
+	std::map<std::string, std::vector<float>> m_GpuTimes;
+
+	void Record(const ProfileFrame& frame);
+
+public:
+	Benchmark(const BenchmarkSettings& settings);
+
+	/// <summary>
+	/// Gets a value of a sample by nearest rank
+	/// </summary>
+	/// <param name="values">Samples, sorted in place</param>
+	/// <param name="percentile">Percentile, in [0, 100]</param>
+	/// <returns>Value, 0 if there are no samples</returns>
+	_NODISCARD static float Percentile(std::vector<float>& values, const float percentile);
+
+	/// <summary>
+	/// Starts a frame, the warmup starts with the first frame whose resources are ready
+	/// </summary>
+	/// <param name="frameIndex">Index of the frame in the profiler</param>
+	/// <param name="ready">Whether every resource of the scene is loaded</param>
+	void BeginFrame(const uint64_t frameIndex, const bool ready);
+
+	/// <summary>
+	/// Records the frames of the profiler history that are ready, to call after Profiler::EndFrame
+	/// </summary>
+	void Collect();
+
+	/// <summary>
+	/// Checks if every measured frame has been rendered
+	/// </summary>
+	_NODISCARD bool IsDone() const;
+
+	/// <summary>
+	/// Gets the half size of the cube the objects and the lights are placed in, it grows with their number so their density stays the same
+	/// </summary>
+	_NODISCARD float GetSceneExtent() const;
+
+	/// <summary>
+	/// Gets the camera of the current frame, orbiting the scene once over the run while moving up and down
+	/// </summary>
+	/// <param name="position">Receives the position</param>
+	/// <param name="target">Receives the point looked at</param>
+	void GetCameraPose(Vector3& position, Vector3& target) const;
+
+	/// <summary>
+	/// Records the frames left in the profiler history and writes the results to the output file as JSON
+	/// </summary>
+	/// <param name="renderer">Name of the GL renderer, written with the results</param>
+	/// <returns>False if the file couldn't be written</returns>
+	bool Finish(const std::string& renderer);
+
+	_NODISCARD const BenchmarkSettings& GetSettings() const;
+};
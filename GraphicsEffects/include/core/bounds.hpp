@@ -0,0 +1,21 @@
+#pragma once
+
+#include "core/maths/vector3.h"
+
+/// <summary>
+/// Axis aligned bounding box
+/// </summary>
+struct BoundingBox
+{
+	Vector3 Min;
+	Vector3 Max;
+};
+
+/// <summary>
+/// Bounding sphere
+/// </summary>
+struct BoundingSphere
+{
+	Vector3 Center;
+	float Radius;
+};
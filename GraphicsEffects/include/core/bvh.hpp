@@ -0,0 +1,130 @@
+#pragma once
+
+#include <vector>
+#include <functional>
+#include <stdint.h>
+
+#include "core/bounds.hpp"
+#include "renderer/frustum.hpp"
+
+/// <summary>
+/// Dynamic bounding volume hierarchy over axis aligned boxes (proxies).
+/// <para>
+/// The tree is built top-down with a binned surface area heuristic. Moving a proxy only refits the boxes of its ancestors,
+/// the tree is rebuilt when proxies are added or removed, or when refitting degraded its cost too much.
+/// </para>
+/// </summary>
+class Bvh
+{
+public:
+	static constexpr uint32_t Null = UINT32_MAX;
+
+private:
+	static constexpr uint32_t MaxLeafSize = 4;
+	static constexpr uint32_t BinCount = 16;
+	// Rebuild once refitting made the tree this much more expensive than when it was built
+	static constexpr float RebuildRatio = 1.3f;
+
+	struct Node
+	{
+		BoundingBox Bounds;
+		uint32_t Parent;
+		// First child for internal nodes (the second one follows it), first primitive for leaves
+		uint32_t First;
+		// Number of primitives, 0 for internal nodes
+		uint32_t Count;
+	};
+
+	struct Proxy
+	{
+		BoundingBox Bounds;
+		uint32_t Leaf;
+		bool Alive;
+	};
+
+	std::vector<Proxy> m_Proxies;
+	std::vector<uint32_t> m_FreeProxies;
+
+	std::vector<Node> m_Nodes;
+	// Proxies referenced by the leaves, each leaf owns a contiguous range
+	std::vector<uint32_t> m_Primitives;
+
+	// Proxies moved since the last update
+	std::vector<uint32_t> m_Moved;
+	std::vector<uint8_t> m_DirtyNodes;
+
+	bool m_NeedsRebuild;
+	float m_BuiltCost;
+
+	// Centers of the proxies, only used while building
+	std::vector<Vector3> m_Centroids;
+	// Reused by the build and the queries
+	mutable std::vector<uint32_t> m_Stack;
+
+	void Build();
+	void Split(const uint32_t node);
+	void Refit();
+	_NODISCARD float ComputeCost() const;
+
+public:
+	Bvh();
+
+	/// <summary>
+	/// Adds a proxy, it is part of the queries after the next update
+	/// </summary>
+	/// <param name="bounds">World bounds</param>
+	/// <returns>Proxy</returns>
+	uint32_t Insert(const BoundingBox& bounds);
+
+	/// <summary>
+	/// Removes a proxy, its index can be given to another proxy
+	/// </summary>
+	/// <param name="proxy">Proxy</param>
+	void Remove(const uint32_t proxy);
+
+	/// <summary>
+	/// Moves a proxy, the tree is refitted on the next update
+	/// </summary>
+	/// <param name="proxy">Proxy</param>
+	/// <param name="bounds">New world bounds</param>
+	void Move(const uint32_t proxy, const BoundingBox& bounds);
+
+	/// <summary>
+	/// Removes every proxy
+	/// </summary>
+	void Clear();
+
+	/// <summary>
+	/// Applies the changes since the last update, by refitting or rebuilding the tree
+	/// </summary>
+	void Update();
+
+	/// <summary>
+	/// Finds the proxies whose box intersects a frustum
+	/// </summary>
+	/// <param name="frustum">Frustum</param>
+	/// <param name="callback">Called with every proxy found</param>
+	void Query(const Frustum& frustum, const std::function<void(uint32_t)>& callback) const;
+
+	/// <summary>
+	/// Finds the proxies whose box intersects a sphere, e.g. the objects in the range of a light
+	/// </summary>
+	/// <param name="sphere">Sphere</param>
+	/// <param name="callback">Called with every proxy found</param>
+	void Query(const BoundingSphere& sphere, const std::function<void(uint32_t)>& callback) const;
+
+	/// <summary>
+	/// Finds the closest proxy hit by a ray, nodes are visited front to back and skipped when they are behind the closest hit
+	/// </summary>
+	/// <param name="origin">Origin</param>
+	/// <param name="direction">Normalized direction</param>
+	/// <param name="maxDistance">Length of the ray</param>
+	/// <param name="hit">Called for the proxies whose box is hit, returns the distance of the exact hit or a negative value if there is none</param>
+	/// <param name="distance">Receives the distance of the closest hit</param>
+	/// <returns>Closest proxy, Null if nothing was hit</returns>
+	uint32_t Raycast(const Vector3& origin, const Vector3& direction, const float maxDistance,
+		const std::function<float(uint32_t)>& hit, float& distance) const;
+
+	_NODISCARD uint32_t GetNodeCount() const;
+	_NODISCARD float GetCost() const;
+};
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <atomic>
+#include <optional>
+#include <new>
+#include <utility>
+#include <cassert>
+
+/// <summary>
+/// Lock-free multiple producers, single consumer queue (linked list with a stub node).
+/// <para>
+/// Push can be called from any thread, every other function must only be called from the consumer thread.
+/// A push is wait-free : one atomic exchange on the head and one store to link the node.
+/// </para>
+/// </summary>
+template <typename T>
+class MpscQueue
+{
+private:
+	struct Node
+	{
+		std::atomic<Node*> next;
+		alignas(T) unsigned char storage[sizeof(T)];
+
+		Node() : next(nullptr) {}
+
+		T& Value() { return *std::launder(reinterpret_cast<T*>(storage)); }
+	};
+
+	// Last pushed node, shared by the producers
+	alignas(64) std::atomic<Node*> m_Head;
+	// Stub node preceding the front item, only touched by the consumer
+	alignas(64) Node* m_Tail;
+
+public:
+	MpscQueue()
+	{
+		Node* const stub = new Node();
+		m_Head.store(stub, std::memory_order_relaxed);
+		m_Tail = stub;
+	}
+
+	~MpscQueue()
+	{
+		while (TryPop())
+			;
+
+		delete m_Tail;
+	}
+
+	// Prevent copy construction because of the nodes
+	MpscQueue(const MpscQueue<T>&) = delete;
+	MpscQueue& operator=(const MpscQueue<T>&) = delete;
+
+	/// <summary>
+	/// Gets a reference to the front item in the queue, the queue must not be empty
+	/// </summary>
+	/// <returns>Item</returns>
+	const T& Front()
+	{
+		Node* const next = m_Tail->next.load(std::memory_order_acquire);
+		assert(next != nullptr && "Front called on an empty queue");
+
+		return next->Value();
+	}
+
+	/// <summary>
+	/// Pushes a new item on the back of the queue, can be called from any thread
+	/// </summary>
+	/// <param name="item">Item</param>
+	void Push(const T& item)
+	{
+		Node* const node = new Node();
+		new (node->storage) T(item);
+
+		// Link the node after the previous head, it becomes visible to the consumer with the store
+		Node* const prev = m_Head.exchange(node, std::memory_order_acq_rel);
+		prev->next.store(node, std::memory_order_release);
+	}
+
+	/// <summary>
+	/// Checks if the queue is empty, a push that is still in progress isn't visible yet
+	/// </summary>
+	/// <returns>Empty</returns>
+	bool Empty()
+	{
+		return m_Tail->next.load(std::memory_order_acquire) == nullptr;
+	}
+
+	/// <summary>
+	/// Get the number of items in the queue, walks the whole list
+	/// </summary>
+	/// <returns>Count</returns>
+	size_t Count()
+	{
+		size_t count = 0;
+
+		for (Node* node = m_Tail->next.load(std::memory_order_acquire); node != nullptr; node = node->next.load(std::memory_order_acquire))
+			count++;
+
+		return count;
+	}
+
+	/// <summary>
+	/// Pops the item on the front of the queue, the queue must not be empty
+	/// </summary>
+	/// <returns>Item</returns>
+	T PopFront()
+	{
+		std::optional<T> item = TryPop();
+		assert(item.has_value() && "PopFront called on an empty queue");
+
+		return std::move(*item);
+	}
+
+	/// <summary>
+	/// Pops the item on the front of the queue if there is one
+	/// </summary>
+	/// <returns>Item, or nothing if the queue is empty</returns>
+	std::optional<T> TryPop()
+	{
+		Node* const tail = m_Tail;
+		Node* const next = tail->next.load(std::memory_order_acquire);
+
+		if (next == nullptr)
+			return std::nullopt;
+
+		// The popped node becomes the new stub
+		std::optional<T> item(std::move(next->Value()));
+		next->Value().~T();
+
+		m_Tail = next;
+		delete tail;
+
+		return item;
+	}
+};
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <map>
+#include <stdint.h>
+
+/// <summary>
+/// Sub-allocates ranges of a fixed size space (e.g. the elements of a GPU buffer), without touching the memory itself.
+/// <para>
+/// Free ranges are kept sorted by offset, allocations take the first one large enough
+/// and freed ranges are merged with their free neighbours so the space doesn't fragment over time.
+/// </para>
+/// </summary>
+class RangeAllocator
+{
+public:
+	static constexpr uint32_t InvalidOffset = UINT32_MAX;
+
+private:
+	// Offset to size of the free ranges
+	std::map<uint32_t, uint32_t> m_FreeRanges;
+	uint32_t m_Capacity;
+	uint32_t m_FreeSize;
+
+public:
+	/// <summary>
+	/// Creates the allocator, the whole space is free
+	/// </summary>
+	/// <param name="capacity">Size of the space</param>
+	RangeAllocator(const uint32_t capacity)
+		: m_Capacity(capacity), m_FreeSize(capacity)
+	{
+		if (capacity > 0)
+			m_FreeRanges.emplace(0, capacity);
+	}
+
+	/// <summary>
+	/// Allocates a range
+	/// </summary>
+	/// <param name="size">Size of the range, an empty range takes no space and is always at offset 0</param>
+	/// <returns>Offset of the range, InvalidOffset if no free range is large enough</returns>
+	uint32_t Allocate(const uint32_t size)
+	{
+		if (size == 0)
+			return 0;
+
+		for (auto it = m_FreeRanges.begin(); it != m_FreeRanges.end(); it++)
+		{
+			if (it->second < size)
+				continue;
+
+			const uint32_t offset = it->first;
+			const uint32_t remaining = it->second - size;
+
+			m_FreeRanges.erase(it);
+
+			if (remaining > 0)
+				m_FreeRanges.emplace(offset + size, remaining);
+
+			m_FreeSize -= size;
+			return offset;
+		}
+
+		return InvalidOffset;
+	}
+
+	/// <summary>
+	/// Frees a range given by Allocate
+	/// </summary>
+	/// <param name="offset">Offset of the range</param>
+	/// <param name="size">Size it was allocated with</param>
+	void Free(uint32_t offset, uint32_t size)
+	{
+		// Empty ranges were never taken from the free ranges
+		if (size == 0)
+			return;
+
+		m_FreeSize += size;
+
+		auto next = m_FreeRanges.lower_bound(offset);
+
+		// Merge with the free range right before
+		if (next != m_FreeRanges.begin())
+		{
+			const auto previous = std::prev(next);
+
+			if (previous->first + previous->second == offset)
+			{
+				offset = previous->first;
+				size += previous->second;
+				m_FreeRanges.erase(previous);
+			}
+		}
+
+		// Merge with the free range right after
+		if (next != m_FreeRanges.end() && offset + size == next->first)
+		{
+			size += next->second;
+			m_FreeRanges.erase(next);
+		}
+
+		m_FreeRanges.emplace(offset, size);
+	}
+
+	_NODISCARD uint32_t GetCapacity() const { return m_Capacity; }
+	_NODISCARD uint32_t GetFreeSize() const { return m_FreeSize; }
+	/// <summary>
+	/// Gets the number of free ranges, 1 when the free space isn't fragmented
+	/// </summary>
+	_NODISCARD size_t GetFreeRangeCount() const { return m_FreeRanges.size(); }
+};
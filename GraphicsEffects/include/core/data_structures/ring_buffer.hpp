@@ -0,0 +1,120 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <cassert>
+
+/// <summary>
+/// Bounded lock-free multiple producers, single consumer queue, every slot is allocated once at construction.
+/// <para>
+/// Items are written and read in place in their slot, so pushing and popping never allocates or copies a whole item.
+/// Each slot carries a sequence number telling whether it is free, being written or ready to be read.
+/// </para>
+/// </summary>
+template <typename T>
+class RingBuffer
+{
+private:
+	struct Cell
+	{
+		std::atomic<size_t> sequence;
+		T value;
+	};
+
+	std::unique_ptr<Cell[]> m_Cells;
+	size_t m_Mask;
+
+	// Next slot to write, shared by the producers
+	alignas(64) std::atomic<size_t> m_WritePosition;
+	// Next slot to read, only touched by the consumer
+	alignas(64) size_t m_ReadPosition;
+
+public:
+	/// <summary>
+	/// Creates the ring buffer
+	/// </summary>
+	/// <param name="capacity">Number of slots, must be a power of 2</param>
+	RingBuffer(const size_t capacity)
+		: m_Cells(new Cell[capacity]), m_Mask(capacity - 1), m_WritePosition(0), m_ReadPosition(0)
+	{
+		assert((capacity & m_Mask) == 0 && "The capacity must be a power of 2");
+
+		for (size_t i = 0; i < capacity; i++)
+			m_Cells[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	RingBuffer(const RingBuffer<T>&) = delete;
+	RingBuffer& operator=(const RingBuffer<T>&) = delete;
+
+	/// <summary>
+	/// Claims a slot and writes an item in it, can be called from any thread
+	/// </summary>
+	/// <param name="write">Function writing the item, called with a reference to the slot</param>
+	/// <returns>False if the buffer is full</returns>
+	template <typename F>
+	bool TryPush(F&& write)
+	{
+		size_t position = m_WritePosition.load(std::memory_order_relaxed);
+		Cell* cell;
+
+		while (true)
+		{
+			cell = &m_Cells[position & m_Mask];
+			const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+			const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+			if (diff == 0)
+			{
+				// The slot is free, try to claim it
+				if (m_WritePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (diff < 0)
+			{
+				// The slot still holds an item from the previous lap
+				return false;
+			}
+			else
+			{
+				// Another producer claimed the slot
+				position = m_WritePosition.load(std::memory_order_relaxed);
+			}
+		}
+
+		write(cell->value);
+
+		// Publish the item to the consumer
+		cell->sequence.store(position + 1, std::memory_order_release);
+		return true;
+	}
+
+	/// <summary>
+	/// Reads the item on the front of the buffer and frees its slot, must only be called from the consumer thread
+	/// </summary>
+	/// <param name="read">Function reading the item, called with a reference to the slot</param>
+	/// <returns>False if the buffer is empty</returns>
+	template <typename F>
+	bool TryPop(F&& read)
+	{
+		Cell* const cell = &m_Cells[m_ReadPosition & m_Mask];
+
+		if (cell->sequence.load(std::memory_order_acquire) != m_ReadPosition + 1)
+			return false;
+
+		read(cell->value);
+
+		// Hand the slot back to the producers for the next lap
+		cell->sequence.store(m_ReadPosition + m_Mask + 1, std::memory_order_release);
+		m_ReadPosition++;
+		return true;
+	}
+
+	/// <summary>
+	/// Checks if the buffer is empty, must only be called from the consumer thread
+	/// </summary>
+	/// <returns>Empty</returns>
+	bool Empty() const
+	{
+		return m_Cells[m_ReadPosition & m_Mask].sequence.load(std::memory_order_acquire) != m_ReadPosition + 1;
+	}
+};
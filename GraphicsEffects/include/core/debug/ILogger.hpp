@@ -7,4 +7,10 @@ class ILogger
 public:
 	virtual ~ILogger() {};
 	virtual void Log(const LogData& info) = 0;
+
+	/// <summary>
+	/// Called by the logger thread after each batch of logs and periodically when idle,
+	/// loggers buffering their output write it here
+	/// </summary>
+	virtual void EndBatch() {};
 };
@@ -2,9 +2,18 @@
 
 #include "core/debug/ILogger.hpp"
 
+#include <string>
+
+/// <summary>
+/// Logs to the standard output, the logs of a batch are written at once
+/// </summary>
 class ConsoleLogger : public ILogger
 {
+private:
+	std::string m_Buffer;
+
 public:
 	void Log(const LogData& data) override;
+	void EndBatch() override;
 };
 
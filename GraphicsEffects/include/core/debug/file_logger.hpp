@@ -3,21 +3,67 @@
 #include <fstream>
 #include <filesystem>
 #include <string>
+#include <chrono>
+#include <stdint.h>
 #include "core/debug/ILogger.hpp"
 
+/// <summary>
+/// When the logs buffered in memory are written to the file
+/// </summary>
+struct FlushPolicy
+{
+	// Maximum time logs stay in memory (milliseconds), 0 writes them at the end of every batch
+	uint32_t Interval = 1000;
+	// Buffered size that triggers a write (bytes)
+	size_t Size = 64 * 1024;
+	// Whether fatal logs are written immediately
+	bool OnFatal = true;
+};
+
+/// <summary>
+/// Size based rotation, when the file gets too big it is renamed to "name.1.ext", "name.1.ext" to "name.2.ext"...
+/// </summary>
+struct RotationPolicy
+{
+	// Maximum size of a file (bytes), 0 disables the rotation
+	size_t MaxSize = 0;
+	// Number of rotated files kept
+	uint32_t MaxFiles = 3;
+};
+
 class FileLogger : public ILogger
 {
 protected:
 	std::ofstream m_File;
 	std::filesystem::path m_FileName;
 
+	FlushPolicy m_FlushPolicy;
+	RotationPolicy m_RotationPolicy;
+
+	// Logs waiting to be written
+	std::string m_Buffer;
+	std::chrono::steady_clock::time_point m_LastWrite;
+	// Size of the current file
+	size_t m_FileSize;
+
+	/// <summary>
+	/// Writes the buffered logs in one block
+	/// </summary>
+	void WriteBuffer();
+
+	/// <summary>
+	/// Shifts the rotated files and starts a new file
+	/// </summary>
+	void Rotate();
+
 public:
-	FileLogger() {}
+	FileLogger() : m_FileSize(0) {}
 	virtual ~FileLogger();
-	FileLogger(const std::filesystem::path& fileName);
+	FileLogger(const std::filesystem::path& fileName, const FlushPolicy& flushPolicy = FlushPolicy(),
+		const RotationPolicy& rotationPolicy = RotationPolicy());
 
 	void OpenFile(const std::filesystem::path& fileName);
 
 	void Log(const LogData& data) override;
+	void EndBatch() override;
 };
-
@@ -4,12 +4,16 @@
 #include <vector>
 #include <thread>
 #include <condition_variable>
+#include <mutex>
 #include <queue>
+#include <atomic>
+#include <chrono>
 
 #include "core/debug/ILogger.hpp"
 #include "core/debug/log_data.hpp"
+#include "core/debug/log_record.hpp"
 
-#include "core/data_structures/tsqueue.hpp"
+#include "core/data_structures/ring_buffer.hpp"
 
 // Constraint for a generic of type ILogger
 template<class T>
@@ -27,17 +31,69 @@ private:
 	// Thread variables
 	static std::thread m_Thread;
 	static std::condition_variable m_CondVar;
-	static TsQueue<LogData> m_QueuedMessages;
+	static RingBuffer<LogRecord> m_Records;
 	static std::mutex m_Mutex;
 	static bool m_Running;
+	// Whether the thread is waiting for messages, producers only wake it up in that case
+	static std::atomic<bool> m_Waiting;
+	// Number of logs dropped because the ring buffer was full
+	static std::atomic<uint32_t> m_Dropped;
 
-	static inline LogData CreateLogData(const LogLevel level, const std::string& message,
-		const char* funcName, const char* fileName, const int32_t line);
+	/// <summary>
+	/// Wakes up the logger thread if it is waiting
+	/// </summary>
+	static void Notify();
+
+	/// <summary>
+	/// Formats a record and sends it to every logger, runs on the logger thread
+	/// </summary>
+	static void ForwardRecord(const LogRecord& record);
 
-	static void ForwardLog(const LogData& data);
+	/// <summary>
+	/// Converts system clock ticks to a date, runs on the logger thread
+	/// </summary>
+	static const std::string& FormatDate(const int64_t time);
 
 	static void Run();
 
+	/// <summary>
+	/// Writes a binary record in the ring buffer, the message is only formatted on the logger thread.
+	/// When the buffer is full the log is dropped, except fatal logs which wait for a free slot.
+	/// </summary>
+	template<typename... Args>
+	static void Write(const LogLevel level, const LogSite& site, const Args&... args)
+	{
+		static_assert(LogArgs::MinSize<Args...> <= LogRecord::ArgsCapacity, "Too many log arguments");
+
+		constexpr LogRecord::Formatter format = &LogArgs::Format<Args...>;
+		const int64_t time = std::chrono::system_clock::now().time_since_epoch().count();
+
+		const auto write = [&](LogRecord& record)
+			{
+				record.Time = time;
+				record.Level = level;
+				record.Site = site;
+				record.Format = format;
+
+				unsigned char* out = record.Arguments;
+				LogArgs::Encode(out, record.Arguments + LogRecord::ArgsCapacity, args...);
+			};
+
+		while (!m_Records.TryPush(write))
+		{
+			if (level != LogLevel::FATAL)
+			{
+				m_Dropped.fetch_add(1, std::memory_order_relaxed);
+				break;
+			}
+
+			Notify();
+			std::this_thread::yield();
+		}
+
+		Notify();
+	}
+
 public:
 	static void Init();
 	static void Stop();
@@ -69,6 +125,50 @@ public:
 	/// <param name="freeMem">Whether delete should be called on the removed logger (true by default)</param>
 	static void RemoveLogger(ILogger* const logger, const bool freeMem = true);
 
+	/// <summary>
+	/// Logs an info without allocating, the message is formatted on the logger thread
+	/// </summary>
+	/// <param name="site">Format of the message, "{}" is replaced by the next argument (must be a string literal)</param>
+	/// <param name="args">Arithmetic or string arguments</param>
+	template<typename... Args>
+	static void Info(const LogSite site, const Args&... args)
+	{
+		Write(LogLevel::INFO, site, args...);
+	}
+
+	/// <summary>
+	/// Logs a warning without allocating, the message is formatted on the logger thread
+	/// </summary>
+	/// <param name="site">Format of the message, "{}" is replaced by the next argument (must be a string literal)</param>
+	/// <param name="args">Arithmetic or string arguments</param>
+	template<typename... Args>
+	static void Warning(const LogSite site, const Args&... args)
+	{
+		Write(LogLevel::WARNING, site, args...);
+	}
+
+	/// <summary>
+	/// Logs an error without allocating, the message is formatted on the logger thread
+	/// </summary>
+	/// <param name="site">Format of the message, "{}" is replaced by the next argument (must be a string literal)</param>
+	/// <param name="args">Arithmetic or string arguments</param>
+	template<typename... Args>
+	static void Error(const LogSite site, const Args&... args)
+	{
+		Write(LogLevel::ERROR, site, args...);
+	}
+
+	/// <summary>
+	/// Logs a fatal error without allocating, the message is formatted on the logger thread
+	/// </summary>
+	/// <param name="site">Format of the message, "{}" is replaced by the next argument (must be a string literal)</param>
+	/// <param name="args">Arithmetic or string arguments</param>
+	template<typename... Args>
+	static void Fatal(const LogSite site, const Args&... args)
+	{
+		Write(LogLevel::FATAL, site, args...);
+	}
+
 	/// <summary>
 	/// Logs an info
 	/// </summary>
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <cstring>
+#include <type_traits>
+#include <stdint.h>
+
+#include "core/debug/log_level.hpp"
+
+/// <summary>
+/// Call site of a log, every member points to static storage so it can be captured without any copy.
+/// Implicitly created from a string literal, which captures the location of the caller.
+/// </summary>
+struct LogSite
+{
+	// Format of the message, every "{}" is replaced by the next argument
+	const char* Format = nullptr;
+	const char* Function = nullptr;
+	const char* File = nullptr;
+	int32_t Line = 0;
+
+	LogSite() = default;
+
+	LogSite(const char* const format,
+		const char* funcName = __builtin_FUNCTION(),
+		const char* fileName = __builtin_FILE(),
+		const int32_t line = __builtin_LINE())
+		: Format(format), Function(funcName), File(fileName), Line(line)
+	{}
+};
+
+/// <summary>
+/// Binary log, stores the raw arguments of the message so it can be formatted later on the logger thread
+/// </summary>
+struct LogRecord
+{
+	static constexpr size_t ArgsCapacity = 200;
+
+	// Formats the message from the format and the raw arguments, instantiated for the argument types of the call site
+	using Formatter = std::string(*)(const char* format, const unsigned char* args);
+
+	// System clock ticks
+	int64_t Time;
+	LogLevel Level;
+	LogSite Site;
+	Formatter Format;
+	unsigned char Arguments[ArgsCapacity];
+};
+
+/// <summary>
+/// Encoding of the log arguments in a LogRecord
+/// </summary>
+namespace LogArgs
+{
+	/// <summary>
+	/// Strings are stored inline as a length followed by the characters,
+	/// the ones that don't fit are moved to the heap and their pointer is stored instead
+	/// </summary>
+	struct StringArg
+	{
+		static constexpr uint32_t HeapFlag = 1u << 31;
+		static constexpr size_t MinSize = sizeof(uint32_t) + sizeof(std::string*);
+
+		static void Encode(unsigned char*& out, const unsigned char* const end, const std::string_view value)
+		{
+			const size_t size = value.size();
+
+			if (sizeof(uint32_t) + size <= static_cast<size_t>(end - out))
+			{
+				const uint32_t header = static_cast<uint32_t>(size);
+				std::memcpy(out, &header, sizeof(uint32_t));
+				std::memcpy(out + sizeof(uint32_t), value.data(), size);
+				out += sizeof(uint32_t) + size;
+				return;
+			}
+
+			// Slow path, only for long messages
+			const uint32_t header = HeapFlag;
+			std::string* const heap = new std::string(value);
+			std::memcpy(out, &header, sizeof(uint32_t));
+			std::memcpy(out + sizeof(uint32_t), &heap, sizeof(std::string*));
+			out += MinSize;
+		}
+
+		static std::string Decode(const unsigned char*& in)
+		{
+			uint32_t header;
+			std::memcpy(&header, in, sizeof(uint32_t));
+			in += sizeof(uint32_t);
+
+			if (header & HeapFlag)
+			{
+				std::string* heap;
+				std::memcpy(&heap, in, sizeof(std::string*));
+				in += sizeof(std::string*);
+
+				std::string value = std::move(*heap);
+				delete heap;
+				return value;
+			}
+
+			std::string value(reinterpret_cast<const char*>(in), header);
+			in += header;
+			return value;
+		}
+	};
+
+	template <typename T>
+	struct ValueArg
+	{
+		static constexpr size_t MinSize = sizeof(T);
+
+		static void Encode(unsigned char*& out, const unsigned char* const, const T value)
+		{
+			std::memcpy(out, &value, sizeof(T));
+			out += sizeof(T);
+		}
+
+		static std::string Decode(const unsigned char*& in)
+		{
+			T value;
+			std::memcpy(&value, in, sizeof(T));
+			in += sizeof(T);
+
+			if constexpr (std::is_same_v<T, bool>)
+				return value ? "true" : "false";
+			else if constexpr (std::is_same_v<T, char>)
+				return std::string(1, value);
+			else
+				return std::to_string(value);
+		}
+	};
+
+	template <typename T>
+	using CodecOf = std::conditional_t<std::is_arithmetic_v<std::decay_t<T>>, ValueArg<std::decay_t<T>>, StringArg>;
+
+	template <typename... Args>
+	constexpr size_t MinSize = (static_cast<size_t>(0) + ... + CodecOf<Args>::MinSize);
+
+	inline void Encode(unsigned char*&, const unsigned char* const)
+	{
+	}
+
+	/// <summary>
+	/// Encodes the arguments, every argument is guaranteed to keep enough space for the ones following it
+	/// </summary>
+	template <typename T, typename... Rest>
+	void Encode(unsigned char*& out, const unsigned char* const end, const T& value, const Rest&... rest)
+	{
+		static_assert(std::is_arithmetic_v<std::decay_t<T>> || std::is_convertible_v<const T&, std::string_view>,
+			"Log arguments must be arithmetic types or strings");
+
+		CodecOf<T>::Encode(out, end - MinSize<Rest...>, value);
+		Encode(out, end, rest...);
+	}
+
+	/// <summary>
+	/// Formats a message from its encoded arguments
+	/// </summary>
+	template <typename... Args>
+	std::string Format(const char* const format, const unsigned char* args)
+	{
+		std::string text;
+		const char* cursor = format;
+
+		[[maybe_unused]] const auto append = [&text, &cursor](const std::string& arg)
+			{
+				const char* const placeholder = std::strstr(cursor, "{}");
+
+				// Extra arguments are ignored, they still have to be decoded to free them
+				if (placeholder == nullptr)
+					return;
+
+				text.append(cursor, placeholder);
+				text.append(arg);
+				cursor = placeholder + 2;
+			};
+
+		// Arguments are decoded in order
+		(append(CodecOf<Args>::Decode(args)), ...);
+
+		text.append(cursor);
+		return text;
+	}
+}
@@ -0,0 +1,215 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <filesystem>
+#include <stdint.h>
+
+#include "core/data_structures/ring_buffer.hpp"
+
+/// <summary>
+/// Timed CPU scope, times are in nanoseconds since the profiler started
+/// </summary>
+struct ProfileEvent
+{
+	// Must be a string literal, only the pointer is stored
+	const char* Name;
+	int64_t Start;
+	int64_t End;
+	// Number of enclosing scopes on the same thread
+	uint32_t Depth;
+	// Index of the thread in the order threads first recorded a scope, 0 is the thread of the frames
+	uint32_t Thread;
+};
+
+/// <summary>
+/// GPU duration of a pass, measured with a GL_TIME_ELAPSED query
+/// </summary>
+struct GpuTiming
+{
+	const char* Name;
+	// CPU time at which the pass was issued, the GPU runs it later
+	int64_t Start;
+	int64_t Duration;
+};
+
+/// <summary>
+/// Everything recorded between two calls to Profiler::BeginFrame
+/// </summary>
+struct ProfileFrame
+{
+	uint64_t Index;
+	int64_t Start;
+	int64_t End;
+	std::vector<ProfileEvent> Events;
+	// Filled GpuLatency frames after the frame, when its queries are read back
+	std::vector<GpuTiming> Gpu;
+};
+
+/// <summary>
+/// Static frame profiler recording CPU scopes from any thread and GPU passes from the GL thread.
+/// <para>
+/// Every thread records its scopes in a ring buffer of its own, so recording never takes a lock.
+/// The buffers are drained on the thread of the frames when the frame ends.
+/// GPU passes are timed with queries that are only read GpuLatency frames later, once their result is available,
+/// so reading them never stalls the pipeline.
+/// </para>
+/// </summary>
+class Profiler
+{
+public:
+	static constexpr uint32_t HistorySize = 240;
+	static constexpr uint32_t GpuLatency = 3;
+	static constexpr size_t ThreadCapacity = 4096;
+
+private:
+	struct ThreadBuffer
+	{
+		RingBuffer<ProfileEvent> Events;
+		uint32_t Index;
+		uint32_t Depth;
+
+		ThreadBuffer(const uint32_t index);
+	};
+
+	struct GpuQuery
+	{
+		uint32_t Handle;
+		const char* Name;
+		int64_t Start;
+		uint64_t Frame;
+	};
+
+	// Buffers of every thread that recorded a scope, the lock is only taken when a thread records its first scope
+	static std::vector<std::unique_ptr<ThreadBuffer>> m_Buffers;
+	static std::mutex m_BuffersMutex;
+	static thread_local ThreadBuffer* m_ThreadBuffer;
+
+	static std::vector<ProfileFrame> m_History;
+	static ProfileFrame m_Current;
+	static uint64_t m_FrameIndex;
+	// Events dropped because the buffer of their thread was full
+	static std::atomic<uint32_t> m_Dropped;
+
+	static std::vector<uint32_t> m_FreeQueries;
+	static std::vector<GpuQuery> m_PendingQueries;
+	static bool m_GpuActive;
+
+	static ThreadBuffer& GetThreadBuffer();
+	static void ReadGpuQueries();
+
+public:
+	/// <summary>
+	/// Gets the current time in nanoseconds since the profiler started
+	/// </summary>
+	_NODISCARD static int64_t Now();
+
+	/// <summary>
+	/// Starts a frame, scopes recorded until EndFrame are part of it
+	/// </summary>
+	static void BeginFrame();
+
+	/// <summary>
+	/// Ends the frame, gathers the scopes of every thread and reads back the GPU queries of the previous frames
+	/// </summary>
+	static void EndFrame();
+
+	/// <summary>
+	/// Deletes the GPU queries, must be called while the GL context exists
+	/// </summary>
+	static void Shutdown();
+
+	/// <summary>
+	/// Opens a scope on the calling thread, returns its start time
+	/// </summary>
+	static int64_t PushScope();
+
+	/// <summary>
+	/// Closes the last scope opened on the calling thread and records it
+	/// </summary>
+	/// <param name="name">Name, must be a string literal</param>
+	/// <param name="start">Time returned by PushScope</param>
+	static void PopScope(const char* const name, const int64_t start);
+
+	/// <summary>
+	/// Starts timing a GPU pass, GPU passes can't be nested
+	/// </summary>
+	/// <param name="name">Name, must be a string literal</param>
+	static void BeginGpu(const char* const name);
+
+	/// <summary>
+	/// Stops timing the current GPU pass
+	/// </summary>
+	static void EndGpu();
+
+	/// <summary>
+	/// Writes the frames of the history as a Chrome trace (chrome://tracing, Perfetto)
+	/// </summary>
+	/// <param name="path">File path</param>
+	/// <returns>False if the file couldn't be written</returns>
+	static bool ExportTrace(const std::filesystem::path& path);
+
+	/// <summary>
+	/// Gets a frame of the history
+	/// </summary>
+	/// <param name="age">0 for the last ended frame, up to GetFrameCount() - 1</param>
+	_NODISCARD static const ProfileFrame& GetFrame(const uint32_t age);
+
+	/// <summary>
+	/// Gets the number of frames in the history
+	/// </summary>
+	_NODISCARD static uint32_t GetFrameCount();
+	/// <summary>
+	/// Gets the index of the current frame, the number of frames ended so far
+	/// </summary>
+	_NODISCARD static uint64_t GetFrameIndex();
+	_NODISCARD static uint32_t GetDroppedCount();
+};
+
+/// <summary>
+/// Records a CPU scope from its construction to its destruction
+/// </summary>
+class ProfileScope
+{
+private:
+	const char* m_Name;
+	int64_t m_Start;
+
+public:
+	/// <param name="name">Name, must be a string literal</param>
+	ProfileScope(const char* const name)
+		: m_Name(name), m_Start(Profiler::PushScope())
+	{
+	}
+
+	~ProfileScope()
+	{
+		Profiler::PopScope(m_Name, m_Start);
+	}
+
+	ProfileScope(const ProfileScope&) = delete;
+	ProfileScope& operator=(const ProfileScope&) = delete;
+};
+
+/// <summary>
+/// Times the GPU commands issued from its construction to its destruction
+/// </summary>
+class GpuProfileScope
+{
+public:
+	/// <param name="name">Name, must be a string literal</param>
+	GpuProfileScope(const char* const name)
+	{
+		Profiler::BeginGpu(name);
+	}
+
+	~GpuProfileScope()
+	{
+		Profiler::EndGpu();
+	}
+
+	GpuProfileScope(const GpuProfileScope&) = delete;
+	GpuProfileScope& operator=(const GpuProfileScope&) = delete;
+};
@@ -10,6 +10,16 @@ private:
 	static void DrawSceneGraph_Object(Object& obj);
 	static void DrawSelectedObject();
 
+	/// <summary>
+	/// Selects the object under the mouse when the scene is clicked
+	/// </summary>
+	static void PickObject(const Scene& scene);
+
 public:
 	static void DrawSceneGraph(Scene& scene);
+
+	/// <summary>
+	/// Draws the timings of the last frame and their rolling statistics over the profiler history
+	/// </summary>
+	static void DrawProfiler();
 };
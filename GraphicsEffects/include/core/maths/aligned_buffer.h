@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstring>
+#include <new>
+#include <utility>
+#include <stdint.h>
+
+/// <summary>
+/// Heap array of floats starting on a cache line, used as the storage of the Vector M and Matrix M
+/// <para>
+/// Copies duplicate the values, moves only transfer the pointer
+/// </para>
+/// </summary>
+class AlignedBuffer
+{
+public:
+	// Cache line size, also enough for aligned AVX loads
+	static constexpr size_t Alignment = 64;
+
+private:
+	float* mData;
+	size_t mSize;
+
+	static float* Allocate(const size_t size)
+	{
+		if (size == 0)
+			return nullptr;
+
+		return static_cast<float*>(::operator new[](size * sizeof(float), std::align_val_t(Alignment)));
+	}
+
+	void Release()
+	{
+		if (mData != nullptr)
+			::operator delete[](mData, std::align_val_t(Alignment));
+
+		mData = nullptr;
+		mSize = 0;
+	}
+
+public:
+	AlignedBuffer()
+		: mData(nullptr), mSize(0)
+	{
+	}
+
+	/// <summary>
+	/// Allocates a buffer, VALUES ARE UN-INITIALIZED
+	/// </summary>
+	/// <param name="size">Number of floats</param>
+	explicit AlignedBuffer(const size_t size)
+		: mData(Allocate(size)), mSize(size)
+	{
+	}
+
+	AlignedBuffer(const AlignedBuffer& buffer)
+		: mData(Allocate(buffer.mSize)), mSize(buffer.mSize)
+	{
+		if (mSize != 0)
+			std::memcpy(mData, buffer.mData, mSize * sizeof(float));
+	}
+
+	AlignedBuffer(AlignedBuffer&& buffer) noexcept
+		: mData(std::exchange(buffer.mData, nullptr)), mSize(std::exchange(buffer.mSize, 0))
+	{
+	}
+
+	~AlignedBuffer()
+	{
+		Release();
+	}
+
+	AlignedBuffer& operator=(const AlignedBuffer& buffer)
+	{
+		if (this == &buffer)
+			return *this;
+
+		// Reuses the allocation when the size doesn't change, e.g. when assigning in a loop
+		if (mSize != buffer.mSize)
+		{
+			Release();
+			mData = Allocate(buffer.mSize);
+			mSize = buffer.mSize;
+		}
+
+		if (mSize != 0)
+			std::memcpy(mData, buffer.mData, mSize * sizeof(float));
+
+		return *this;
+	}
+
+	AlignedBuffer& operator=(AlignedBuffer&& buffer) noexcept
+	{
+		if (this == &buffer)
+			return *this;
+
+		Release();
+		mData = std::exchange(buffer.mData, nullptr);
+		mSize = std::exchange(buffer.mSize, 0);
+
+		return *this;
+	}
+
+	/// <summary>
+	/// Sets every value of the buffer
+	/// </summary>
+	/// <param name="value">Value</param>
+	void Fill(const float value)
+	{
+		for (size_t i = 0; i < mSize; i++)
+			mData[i] = value;
+	}
+
+	_NODISCARD float* Data()
+	{
+		return mData;
+	}
+
+	_NODISCARD const float* Data() const
+	{
+		return mData;
+	}
+
+	_NODISCARD size_t Size() const
+	{
+		return mSize;
+	}
+
+	_NODISCARD float& operator[](const size_t i)
+	{
+		return mData[i];
+	}
+
+	_NODISCARD float operator[](const size_t i) const
+	{
+		return mData[i];
+	}
+};
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <vector>
+#include <stdint.h>
+
+#include "core/maths/matrixM.h"
+#include "core/maths/vectorM.h"
+
+/// <summary>
+/// LU decomposition with partial pivoting of a square Matrix M, P * A = L * U
+/// <para>
+/// The matrix is factored once, then any number of systems A * x = b can be solved in O(n^2) each.
+/// L and U share one matrix : L is below the diagonal (its diagonal is 1 and isn't stored), U is on and above it.
+/// </para>
+/// </summary>
+class LUDecomposition
+{
+private:
+	MatrixM mFactors;
+	// Row of the factored matrix that ended up at each row of the factors
+	std::vector<uint32_t> mPermutation;
+	// -1 if the pivoting swapped rows an odd number of times
+	float mPermutationSign;
+	bool mSingular;
+
+public:
+	/// <summary>
+	/// Creates an empty decomposition, Factor must be called before solving
+	/// </summary>
+	LUDecomposition();
+
+	/// <summary>
+	/// Factors a matrix, IsSingular tells if it succeeded
+	/// </summary>
+	/// <param name="mat">Square matrix</param>
+	explicit LUDecomposition(const MatrixM& mat);
+
+	/// <summary>
+	/// Factors a matrix, replacing the previous factors
+	/// <para>
+	/// Only an exact 0 pivot makes the matrix singular, so badly scaled matrices are still factored.
+	/// Whether a nearly singular matrix is usable is left to the callers, e.g. from the diagonal of U
+	/// </para>
+	/// </summary>
+	/// <param name="mat">Square matrix</param>
+	/// <returns>False if the matrix isn't square or is singular</returns>
+	bool Factor(const MatrixM& mat);
+
+	_NODISCARD bool IsSingular() const;
+
+	/// <summary>
+	/// Gets the number of rows of the factored matrix
+	/// </summary>
+	_NODISCARD uint32_t Size() const;
+
+	/// <summary>
+	/// Gets the determinant of the factored matrix, the product of the diagonal of U
+	/// </summary>
+	/// <returns>Determinant, 0 if the matrix is singular or isn't square</returns>
+	_NODISCARD float Determinant() const;
+
+	/// <summary>
+	/// Solves A * x = b
+	/// </summary>
+	/// <param name="b">Right hand side, Size() values</param>
+	/// <param name="x">Receives the solution</param>
+	/// <returns>False if the matrix is singular</returns>
+	bool Solve(const VectorM& b, VectorM& x) const;
+
+	/// <summary>
+	/// Solves A * X = B for every column of B at once
+	/// </summary>
+	/// <param name="b">Right hand sides, Size() rows</param>
+	/// <param name="x">Receives the solutions, as many columns as B</param>
+	/// <returns>False if the matrix is singular</returns>
+	bool Solve(const MatrixM& b, MatrixM& x) const;
+
+	/// <summary>
+	/// Computes the inverse of the factored matrix by solving A * X = I
+	/// </summary>
+	/// <param name="dst">Receives the inverse</param>
+	/// <returns>False if the matrix is singular</returns>
+	bool Inverse(MatrixM& dst) const;
+
+	_NODISCARD const MatrixM& GetFactors() const;
+	_NODISCARD const std::vector<uint32_t>& GetPermutation() const;
+};
@@ -0,0 +1,175 @@
+#pragma once
+
+#include "core/maths/vec.h"
+#include "core/maths/vector2.h"
+#include "core/maths/vector3.h"
+#include "core/maths/vector4.h"
+
+/// <summary>
+/// Fixed size row-major matrix of R rows and C columns of type T, every operation is constexpr and header only
+/// <para>
+/// Mat&lt;float, 2, 2&gt;, Mat&lt;float, 3, 3&gt; and Mat&lt;float, 4, 4&gt; are specialized with Row0..Row3 members,
+/// they are the Matrix2x2, Matrix3x3 and Matrix4x4 of core/maths/matrix2x2.h, matrix3x3.h and matrix4x4.h
+/// </para>
+/// </summary>
+/// <typeparam name="T">Value type</typeparam>
+/// <typeparam name="R">Number of rows</typeparam>
+/// <typeparam name="C">Number of columns</typeparam>
+template <typename T, size_t R, size_t C>
+class Mat
+{
+	static_assert(R > 0 && C > 0, "A Mat must have at least one row and one column");
+	static_assert(!(std::is_same_v<T, float> && R == C && R >= 2 && R <= 4),
+		"Mat<float, 2/3/4, 2/3/4> is specialized, include core/maths/matrix2x2.h, matrix3x3.h or matrix4x4.h");
+
+	static constexpr int Rows = static_cast<int>(R);
+	static constexpr int Columns = static_cast<int>(C);
+
+public:
+	Vec<T, C> rows[R];
+
+	/// <summary>
+	/// Creates a Mat object with default values (0)
+	/// </summary>
+	constexpr Mat()
+		: rows{}
+	{
+	}
+
+	/// <summary>
+	/// Creates a Mat object using the same value for every element
+	/// </summary>
+	/// <param name="value">Value</param>
+	constexpr explicit Mat(const T value)
+		: rows{}
+	{
+		for (int r = 0; r < Rows; r++)
+			rows[r] = Vec<T, C>(value);
+	}
+
+	/// <summary>
+	/// Gets the identity matrix
+	/// </summary>
+	/// <returns>Identity</returns>
+	_NODISCARD static constexpr Mat GetIdentity() requires (R == C)
+	{
+		Mat result;
+		for (int i = 0; i < Rows; i++)
+			result.rows[i][i] = T(1);
+		return result;
+	}
+
+	_NODISCARD constexpr Mat<T, C, R> GetTransposed() const
+	{
+		Mat<T, C, R> result;
+		for (int r = 0; r < Rows; r++)
+		{
+			for (int c = 0; c < Columns; c++)
+				result.rows[c][r] = rows[r][c];
+		}
+		return result;
+	}
+
+	_NODISCARD constexpr Vec<T, C>& operator[](const int i)
+	{
+		assert(i >= 0 && i < Rows && "Mat subscript out of range");
+
+		return rows[i];
+	}
+
+	_NODISCARD constexpr const Vec<T, C>& operator[](const int i) const
+	{
+		assert(i >= 0 && i < Rows && "Mat subscript out of range");
+
+		return rows[i];
+	}
+
+#pragma region Operators
+	_NODISCARD constexpr Mat operator-() const
+	{
+		Mat result;
+		for (int r = 0; r < Rows; r++)
+			result.rows[r] = -rows[r];
+		return result;
+	}
+
+	_NODISCARD constexpr Mat operator+(const Mat& o) const
+	{
+		Mat result;
+		for (int r = 0; r < Rows; r++)
+			result.rows[r] = rows[r] + o.rows[r];
+		return result;
+	}
+
+	_NODISCARD constexpr Mat operator-(const Mat& o) const
+	{
+		Mat result;
+		for (int r = 0; r < Rows; r++)
+			result.rows[r] = rows[r] - o.rows[r];
+		return result;
+	}
+
+	_NODISCARD constexpr Mat operator*(const T scalar) const
+	{
+		Mat result;
+		for (int r = 0; r < Rows; r++)
+			result.rows[r] = rows[r] * scalar;
+		return result;
+	}
+
+	/// <summary>
+	/// Operator Mat * Vec, the vector is a column
+	/// </summary>
+	/// <param name="vec">Vector</param>
+	/// <returns>Result</returns>
+	_NODISCARD constexpr Vec<T, R> operator*(const Vec<T, C>& vec) const
+	{
+		Vec<T, R> result;
+		for (int r = 0; r < Rows; r++)
+			result[r] = Vec<T, C>::DotProduct(rows[r], vec);
+		return result;
+	}
+
+	/// <summary>
+	/// Operator Mat * Mat
+	/// </summary>
+	/// <typeparam name="K">Number of columns of the right matrix</typeparam>
+	/// <param name="o">Right matrix</param>
+	/// <returns>Result</returns>
+	template <size_t K>
+	_NODISCARD constexpr Mat<T, R, K> operator*(const Mat<T, C, K>& o) const
+	{
+		Mat<T, R, K> result;
+		for (int r = 0; r < Rows; r++)
+		{
+			for (int c = 0; c < Columns; c++)
+			{
+				// Through operator[], either matrix can be one of the specialized sizes
+				const T value = rows[r][c];
+				for (int k = 0; k < static_cast<int>(K); k++)
+					result[r][k] += value * o[c][k];
+			}
+		}
+		return result;
+	}
+
+	_NODISCARD constexpr bool operator==(const Mat& o) const
+	{
+		for (int r = 0; r < Rows; r++)
+		{
+			if (rows[r] != o.rows[r])
+				return false;
+		}
+		return true;
+	}
+
+	_NODISCARD constexpr bool operator!=(const Mat& o) const
+	{
+		return !(*this == o);
+	}
+#pragma endregion
+};
+
+using Matrix2x2 = Mat<float, 2, 2>;
+using Matrix3x3 = Mat<float, 3, 3>;
+using Matrix4x4 = Mat<float, 4, 4>;
@@ -1,11 +1,16 @@
 #pragma once
 
 #include <initializer_list>
+#include "core/maths/mat.h"
 #include "core/maths/vector2.h"
 
 class MatrixM;
 
-class Matrix2x2
+/// <summary>
+/// Float matrix of 2 rows and 2 columns, specialization of Mat&lt;T, R, C&gt;
+/// </summary>
+template <>
+class Mat<float, 2, 2>
 {
 public:
 	Vector2 Row0;
@@ -15,7 +20,10 @@ public:
 	/// <summary>
 	/// Constructs an empty 2x2 Matrix
 	/// </summary>
-	Matrix2x2();
+	constexpr Mat()
+		: Row0(), Row1()
+	{
+	}
 
 	/// <summary>
 	/// Constructs a 2x2 Matrix filled with "value"
@@ -25,7 +33,10 @@ public:
 	/// [ value, value ]
 	/// </summary>
 	/// <param name="value">Value</param>
-	Matrix2x2(const float value);
+	constexpr Mat(const float value)
+		: Row0(value), Row1(value)
+	{
+	}
 
 	/// <summary>
 	/// Constructs a 2x2 Matrix using direct component values
@@ -38,7 +49,10 @@ public:
 	/// <param name="r01">m[0, 1] value</param>
 	/// <param name="r10">m[1, 0] value</param>
 	/// <param name="r11">m[1, 1] value</param>
-	Matrix2x2(const float r00, const float r01, const float r10, const float r11);
+	constexpr Mat(const float r00, const float r01, const float r10, const float r11)
+		: Row0(r00, r01), Row1(r10, r11)
+	{
+	}
 
 	/// <summary>
 	/// Constructs a 2x2 Matrix using a Vector 2 and 2 components
@@ -50,7 +64,10 @@ public:
 	/// <param name="r0">m[0] First row</param>
 	/// <param name="r10">m[1, 0] value</param>
 	/// <param name="r11">m[1, 1] value</param>
-	Matrix2x2(const Vector2 r0, const float r10, const float r11);
+	constexpr Mat(const Vector2 r0, const float r10, const float r11)
+		: Row0(r0), Row1(r10, r11)
+	{
+	}
 
 	/// <summary>
 	/// Constructs a 2x2 Matrix using 2 components and a Vector 2
@@ -62,7 +79,10 @@ public:
 	/// <param name="r00">m[0, 0] value</param>
 	/// <param name="r01">m[0, 1] value</param>
 	/// <param name="r1">m[1] Second row</param>
-	Matrix2x2(const float r00, const float r01, const Vector2 r1);
+	constexpr Mat(const float r00, const float r01, const Vector2 r1)
+		: Row0(r00, r01), Row1(r1)
+	{
+	}
 
 	/// <summary>
 	/// Constructs a 2x2 Matrix using 2 Vector 2
@@ -73,24 +93,35 @@ public:
 	/// </summary>
 	/// <param name="r0">m[0] First row</param>
 	/// <param name="r1">m[1] Second row</param>
-	Matrix2x2(const Vector2 r0, const Vector2 r1);
+	constexpr Mat(const Vector2 r0, const Vector2 r1)
+		: Row0(r0), Row1(r1)
+	{
+	}
 
 	/// <summary>
 	/// Constructs a 2x2 Matrix using an initializer list of floats, [1;4] range of elements
 	/// </summary>
 	/// <param name="data">Data</param>
-	Matrix2x2(const std::initializer_list<float>& data);
+	Mat(const std::initializer_list<float>& data);
 
 	/// <summary>
 	/// Constructs a 2x2 Matrix using an initializer list of Vector 2, [1;2] range of elements
 	/// </summary>
 	/// <param name="data">Data</param>
-	Matrix2x2(const std::initializer_list<Vector2>& data);
+	Mat(const std::initializer_list<Vector2>& data);
 
 #pragma endregion
 
-	_NODISCARD Vector2 Diagonal() const;
-	_NODISCARD float Trace() const;
+	_NODISCARD constexpr Vector2 Diagonal() const
+	{
+		return Vector2(Row0.x, Row1.y);
+	}
+
+	_NODISCARD constexpr float Trace() const
+	{
+		return Row0.x + Row1.y;
+	}
+
 	_NODISCARD float Determinant() const;
 
 	void Augment(const MatrixM& in, MatrixM& out) const;
@@ -102,10 +133,68 @@ public:
 	Matrix2x2& Multiply(const float scalar);
 	Matrix2x2& Multiply(const Matrix2x2& mat);
 
-	Vector2 operator[](int i) const;
-	Vector2& operator[](int i);
+	_NODISCARD constexpr Vector2 operator[](int i) const
+	{
+		assert(i >= 0 && i < 2 && "Matrix 2x2 subscript out of range");
+		__assume(i >= 0 && i < 2);
+
+		// The rows are contiguous, but indexing past Row0 is only allowed at runtime
+		if (std::is_constant_evaluated())
+			return i == 0 ? Row0 : Row1;
+
+		return (&Row0)[i];
+	}
+
+	_NODISCARD constexpr Vector2& operator[](int i)
+	{
+		assert(i >= 0 && i < 2 && "Matrix 2x2 subscript out of range");
+		__assume(i >= 0 && i < 2);
+
+		if (std::is_constant_evaluated())
+			return i == 0 ? Row0 : Row1;
+
+		return (&Row0)[i];
+	}
+
+	/// <summary>
+	/// Operator Mat2 * Mat2
+	/// </summary>
+	/// <param name="mat">Right matrix</param>
+	/// <returns>Result</returns>
+	_NODISCARD constexpr Matrix2x2 operator*(const Matrix2x2& mat) const
+	{
+		return Matrix2x2(
+			Row0.x * mat.Row0.x + Row0.y * mat.Row1.x, Row0.x * mat.Row0.y + Row0.y * mat.Row1.y,
+			Row1.x * mat.Row0.x + Row1.y * mat.Row1.x, Row1.x * mat.Row0.y + Row1.y * mat.Row1.y
+		);
+	}
+
+	/// <summary>
+	/// Operator Mat2 * Vec2, the vector is a column
+	/// </summary>
+	/// <param name="vec">Vector</param>
+	/// <returns>Result</returns>
+	_NODISCARD constexpr Vector2 operator*(const Vector2& vec) const
+	{
+		return Vector2(Vector2::DotProduct(Row0, vec), Vector2::DotProduct(Row1, vec));
+	}
+
+	_NODISCARD constexpr bool operator==(const Matrix2x2& mat) const
+	{
+		return Row0 == mat.Row0 && Row1 == mat.Row1;
+	}
+
+	_NODISCARD constexpr bool operator!=(const Matrix2x2& mat) const
+	{
+		return !(*this == mat);
+	}
 
 	void Log() const;
 
 	static const Matrix2x2 Identity;
 };
+
+inline constexpr Matrix2x2 Matrix2x2::Identity = Matrix2x2(
+	1, 0,
+	0, 1
+);
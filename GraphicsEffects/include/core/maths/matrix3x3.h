@@ -1,11 +1,16 @@
 #pragma once
 
-#include "vector3.h"
+#include "core/maths/mat.h"
+#include "core/maths/vector3.h"
 #include "core/maths/matrix2x2.h"
 
 class MatrixM;
 
-class Matrix3x3
+/// <summary>
+/// Float matrix of 3 rows and 3 columns, specialization of Mat&lt;T, R, C&gt;
+/// </summary>
+template <>
+class Mat<float, 3, 3>
 {
 public:
 	Vector3 Row0;
@@ -17,7 +22,10 @@ public:
 	/// <summary>
 	/// Constructs an empty 3x3 Matrix
 	/// </summary>
-	Matrix3x3();
+	constexpr Mat()
+		: Row0(0), Row1(0), Row2(0)
+	{
+	}
 
 	/// <summary>
 	/// Constructs a 3x3 Matrix filled with "value"
@@ -30,7 +38,10 @@ public:
 	/// [ value, value, value ]
 	/// </summary>
 	/// <param name="value"></param>
-	Matrix3x3(const float value);
+	constexpr Mat(const float value)
+		: Row0(value), Row1(value), Row2(value)
+	{
+	}
 
 	/// <summary>
 	/// Constructs a 3x3 Matrix using direct component values
@@ -51,11 +62,14 @@ public:
 	/// <param name="r20">m[2, 0] value</param>
 	/// <param name="r21">m[2, 1] value</param>
 	/// <param name="r22">m[2, 2] value</param>
-	Matrix3x3(
+	constexpr Mat(
 		const float r00, const float r01, const float r02,
 		const float r10, const float r11, const float r12,
 		const float r20, const float r21, const float r22
-	);
+	)
+		: Row0(r00, r01, r02), Row1(r10, r11, r12), Row2(r20, r21, r22)
+	{
+	}
 
 	/// <summary>
 	/// Constructs a 3x3 Matrix using a Vector 3, then direct components
@@ -74,11 +88,14 @@ public:
 	/// <param name="r20">m[2, 0] value</param>
 	/// <param name="r21">m[2, 1] value</param>
 	/// <param name="r22">m[2, 2] value</param>
-	Matrix3x3(
+	constexpr Mat(
 		const Vector3& r0,
 		const float r10, const float r11, const float r12,
 		const float r20, const float r21, const float r22
-	);
+	)
+		: Row0(r0), Row1(r10, r11, r12), Row2(r20, r21, r22)
+	{
+	}
 
 	/// <summary>
 	/// Constructs a 3x3 Matrix using 3 components, a Vector 3, then 3 components
@@ -97,11 +114,14 @@ public:
 	/// <param name="r20">m[2, 0] value</param>
 	/// <param name="r21">m[2, 1] value</param>
 	/// <param name="r22">m[2, 2] value</param>
-	Matrix3x3(
+	constexpr Mat(
 		const float r00, const float r01, const float r02,
 		const Vector3& r1,
 		const float r20, const float r21, const float r22
-	);
+	)
+		: Row0(r00, r01, r02), Row1(r1), Row2(r20, r21, r22)
+	{
+	}
 
 	/// <summary>
 	/// Constructs a 3x3 Matrix using components, then a Vector 3
@@ -120,11 +140,14 @@ public:
 	/// <param name="r11">m[1, 1] value</param>
 	/// <param name="r12">m[1, 2] value</param>
 	/// <param name="r1">m[2] Third row</param>
-	Matrix3x3(
+	constexpr Mat(
 		const float r00, const float r01, const float r02,
 		const float r10, const float r11, const float r12,
 		const Vector3& r2
-	);
+	)
+		: Row0(r00, r01, r02), Row1(r10, r11, r12), Row2(r2)
+	{
+	}
 
 	/// <summary>
 	/// Constructs a 3x3 Matrix using 2 Vector 3, then components
@@ -141,11 +164,14 @@ public:
 	/// <param name="r20">m[2, 0] value</param>
 	/// <param name="r21">m[2, 1] value</param>
 	/// <param name="r22">m[2, 2] value</param>
-	Matrix3x3(
+	constexpr Mat(
 		const Vector3& r0,
 		const Vector3& r1,
 		const float r20, const float r21, const float r22
-	);
+	)
+		: Row0(r0), Row1(r1), Row2(r20, r21, r22)
+	{
+	}
 
 	/// <summary>
 	/// Constructs a 3x3 Matrix using a Vector 3, components, then a Vector 3
@@ -162,11 +188,14 @@ public:
 	/// <param name="r11">m[1, 1] value</param>
 	/// <param name="r12">m[1, 2] value</param>
 	/// <param name="r2">m[2] Third row</param>
-	Matrix3x3(
+	constexpr Mat(
 		const Vector3& r0,
 		const float r10, const float r11, const float r12,
 		const Vector3& r2
-	);
+	)
+		: Row0(r0), Row1(r10, r11, r12), Row2(r2)
+	{
+	}
 
 	/// <summary>
 	/// Constructs a 3x3 Matrix using components, then 2 Vector 3
@@ -183,11 +212,14 @@ public:
 	/// <param name="r02">m[0, 2] value</param>
 	/// <param name="r1">m[1] Second row</param>
 	/// <param name="r2">m[2] Third row</param>
-	Matrix3x3(
+	constexpr Mat(
 		const float r00, const float r01, const float r02,
 		const Vector3& r1,
 		const Vector3& r2
-	);
+	)
+		: Row0(r00, r01, r02), Row1(r1), Row2(r2)
+	{
+	}
 
 	/// <summary>
 	/// Constructs a 3x3 Matrix using 3 Vector 3
@@ -202,11 +234,14 @@ public:
 	/// <param name="r0">m[0] First row</param>
 	/// <param name="r1">m[1] Second row</param>
 	/// <param name="r2">m[2] Third row</param>
-	Matrix3x3(
+	constexpr Mat(
 		const Vector3& r0,
 		const Vector3& r1,
 		const Vector3& r2
-	);
+	)
+		: Row0(r0), Row1(r1), Row2(r2)
+	{
+	}
 
 	/// <summary>
 	/// Constructs a 3x3 Matrix using a 2x2 Matrix
@@ -219,9 +254,12 @@ public:
 	/// </para>
 	/// </summary>
 	/// <param name="mat">Upper left corner values</param>
-	Matrix3x3(
+	constexpr Mat(
 		const Matrix2x2& mat
-	);
+	)
+		: Row0(mat[0][0], mat[0][1], 0), Row1(mat[1][0], mat[1][1], 0), Row2(0)
+	{
+	}
 
 	/// <summary>
 	/// Constructs a 3x3 Matrix using a 2x2 Matrix, and then components
@@ -239,11 +277,14 @@ public:
 	/// <param name="r20">m[2, 0] value</param>
 	/// <param name="r21">m[2, 1] value</param>
 	/// <param name="r22">m[2, 2] value</param>
-	Matrix3x3(
+	constexpr Mat(
 		const Matrix2x2& mat, const float r02,
 		const float r12,
 		const float r20, const float r21, const float r22
-	);
+	)
+		: Row0(mat[0][0], mat[0][1], r02), Row1(mat[1][0], mat[1][1], r12), Row2(r20, r21, r22)
+	{
+	}
 
 	/// <summary>
 	/// Constructs a 3x3 Matrix using a 2x2 Matrix, components, and a Vector 3
@@ -259,28 +300,39 @@ public:
 	/// <param name="r02">m[0, 2] value</param>
 	/// <param name="r12">m[1, 2] value</param>
 	/// <param name="r2">m[2] Third row</param>
-	Matrix3x3(
+	constexpr Mat(
 		const Matrix2x2& mat, const float r02,
 		const float r12,
 		const Vector3& r2
-	);
+	)
+		: Row0(mat[0][0], mat[0][1], r02), Row1(mat[1][0], mat[1][1], r12), Row2(r2)
+	{
+	}
 
 	/// <summary>
 	/// Constructs a 3x3 Matrix using an initializer list of floats, [1;9] range of elements
 	/// </summary>
 	/// <param name="data">Data</param>
-	Matrix3x3(const std::initializer_list<float>& data);
+	Mat(const std::initializer_list<float>& data);
 
 	/// <summary>
 	/// Constructs a 3x3 Matrix using an initializer list of Vector 2, [1;3] range of elements
 	/// </summary>
 	/// <param name="data">Data</param>
-	Matrix3x3(const std::initializer_list<Vector3>& data);
+	Mat(const std::initializer_list<Vector3>& data);
 
 #pragma endregion
 
-	_NODISCARD Vector3 Diagonal() const;
-	_NODISCARD float Trace() const;
+	_NODISCARD constexpr Vector3 Diagonal() const
+	{
+		return Vector3(Row0.x, Row1.y, Row2.z);
+	}
+
+	_NODISCARD constexpr float Trace() const
+	{
+		return Row0.x + Row1.y + Row2.z;
+	}
+
 	_NODISCARD float Determinant() const;
 
 	void Augment(const MatrixM& in, MatrixM& out) const;
@@ -298,11 +350,70 @@ public:
 	static void RotationZ(const float angle, Matrix3x3& dst);
 	static void Rotation(const Vector3& rotation, Matrix3x3& dst);
 
-	Vector3 operator[](int i) const;
-	Vector3& operator[](int i);
+	_NODISCARD constexpr Vector3 operator[](int i) const
+	{
+		assert(i >= 0 && i < 3 && "Matrix 3x3 subscript out of range");
+		__assume(i >= 0 && i < 3);
+
+		// The rows are contiguous, but indexing past Row0 is only allowed at runtime
+		if (std::is_constant_evaluated())
+			return i == 0 ? Row0 : i == 1 ? Row1 : Row2;
+
+		return (&Row0)[i];
+	}
+
+	_NODISCARD constexpr Vector3& operator[](int i)
+	{
+		assert(i >= 0 && i < 3 && "Matrix 3x3 subscript out of range");
+		__assume(i >= 0 && i < 3);
+
+		if (std::is_constant_evaluated())
+			return i == 0 ? Row0 : i == 1 ? Row1 : Row2;
+
+		return (&Row0)[i];
+	}
+
+	/// <summary>
+	/// Operator Mat3 * Mat3
+	/// </summary>
+	/// <param name="mat">Right matrix</param>
+	/// <returns>Result</returns>
+	_NODISCARD constexpr Matrix3x3 operator*(const Matrix3x3& mat) const
+	{
+		return Matrix3x3(
+			Row0.x * mat.Row0.x + Row0.y * mat.Row1.x + Row0.z * mat.Row2.x, Row0.x * mat.Row0.y + Row0.y * mat.Row1.y + Row0.z * mat.Row2.y, Row0.x * mat.Row0.z + Row0.y * mat.Row1.z + Row0.z * mat.Row2.z,
+			Row1.x * mat.Row0.x + Row1.y * mat.Row1.x + Row1.z * mat.Row2.x, Row1.x * mat.Row0.y + Row1.y * mat.Row1.y + Row1.z * mat.Row2.y, Row1.x * mat.Row0.z + Row1.y * mat.Row1.z + Row1.z * mat.Row2.z,
+			Row2.x * mat.Row0.x + Row2.y * mat.Row1.x + Row2.z * mat.Row2.x, Row2.x * mat.Row0.y + Row2.y * mat.Row1.y + Row2.z * mat.Row2.y, Row2.x * mat.Row0.z + Row2.y * mat.Row1.z + Row2.z * mat.Row2.z
+		);
+	}
+
+	/// <summary>
+	/// Operator Mat3 * Vec3, the vector is a column
+	/// </summary>
+	/// <param name="vec">Vector</param>
+	/// <returns>Result</returns>
+	_NODISCARD constexpr Vector3 operator*(const Vector3& vec) const
+	{
+		return Vector3(Vector3::DotProduct(Row0, vec), Vector3::DotProduct(Row1, vec), Vector3::DotProduct(Row2, vec));
+	}
+
+	_NODISCARD constexpr bool operator==(const Matrix3x3& mat) const
+	{
+		return Row0 == mat.Row0 && Row1 == mat.Row1 && Row2 == mat.Row2;
+	}
+
+	_NODISCARD constexpr bool operator!=(const Matrix3x3& mat) const
+	{
+		return !(*this == mat);
+	}
 
 	void Log() const;
 
 	static const Matrix3x3 Identity;
 };
 
+inline constexpr Matrix3x3 Matrix3x3::Identity = Matrix3x3(
+	1, 0, 0,
+	0, 1, 0,
+	0, 0, 1
+);
@@ -1,12 +1,18 @@
 #pragma once
 
+#include "core/maths/mat.h"
 #include "core/maths/vector4.h"
 #include "core/maths/matrix2x2.h"
 #include "core/maths/matrix3x3.h"
 
 class MatrixM;
+class Quaternion;
 
-class Matrix4x4
+/// <summary>
+/// Float matrix of 4 rows and 4 columns, specialization of Mat&lt;T, R, C&gt;
+/// </summary>
+template <>
+class Mat<float, 4, 4>
 {
 public:
 	Vector4 Row0;
@@ -31,7 +37,10 @@ public:
 	/// [ 0, 0, 0, 0 ]
 	/// </para>
 	/// </summary>
-	Matrix4x4();
+	constexpr Mat()
+		: Row0(0), Row1(0), Row2(0), Row3(0)
+	{
+	}
 
 	/// <summary>
 	/// Constructs a 4x4 Matrix filled with "value"
@@ -48,7 +57,10 @@ public:
 	/// [ value, value, value, value ]
 	/// </para>
 	/// </summary>
-	Matrix4x4(const float value);
+	constexpr Mat(const float value)
+		: Row0(value), Row1(value), Row2(value), Row3(value)
+	{
+	}
 
 	/// <summary>
 	/// Constructs a 4x4 Matrix using direct component values
@@ -81,12 +93,15 @@ public:
 	/// <param name="r31">m[3, 1] value</param>
 	/// <param name="r32">m[3, 2] value</param>
 	/// <param name="r33">m[3, 3] value</param>
-	Matrix4x4(
+	constexpr Mat(
 		const float r00, const float r01, const float r02, const float r03,
 		const float r10, const float r11, const float r12, const float r13,
 		const float r20, const float r21, const float r22, const float r23,
 		const float r30, const float r31, const float r32, const float r33
-	);
+	)
+		: Row0(r00, r01, r02, r03), Row1(r10, r11, r12, r13), Row2(r20, r21, r22, r23), Row3(r30, r31, r32, r33)
+	{
+	}
 
 	/// <summary>
 	/// Constructs a 4x4 Matrix using a Vector 4, then component values
@@ -116,12 +131,15 @@ public:
 	/// <param name="r31">m[3, 1] value</param>
 	/// <param name="r32">m[3, 2] value</param>
 	/// <param name="r33">m[3, 3] value</param>
-	Matrix4x4(
+	constexpr Mat(
 		const Vector4& r0,
 		const float r10, const float r11, const float r12, const float r13,
 		const float r20, const float r21, const float r22, const float r23,
 		const float r30, const float r31, const float r32, const float r33
-	);
+	)
+		: Row0(r0), Row1(r10, r11, r12, r13), Row2(r20, r21, r22, r23), Row3(r30, r31, r32, r33)
+	{
+	}
 
 	/// <summary>
 	/// Constructs a 4x4 Matrix using direct components, a Vector 4, then components values
@@ -151,12 +169,15 @@ public:
 	/// <param name="r31">m[3, 1] value</param>
 	/// <param name="r32">m[3, 2] value</param>
 	/// <param name="r33">m[3, 3] value</param>
-	Matrix4x4(
+	constexpr Mat(
 		const float r00, const float r01, const float r02, const float r03,
 		const Vector4& r1,
 		const float r20, const float r21, const float r22, const float r23,
 		const float r30, const float r31, const float r32, const float r33
-	);
+	)
+		: Row0(r00, r01, r02, r03), Row1(r1), Row2(r20, r21, r22, r23), Row3(r30, r31, r32, r33)
+	{
+	}
 
 	/// <summary>
 	/// Constructs a 4x4 Matrix using direct components, a Vector 4, then components values
@@ -186,12 +207,15 @@ public:
 	/// <param name="r31">m[3, 1] value</param>
 	/// <param name="r32">m[3, 2] value</param>
 	/// <param name="r33">m[3, 3] value</param>
-	Matrix4x4(
+	constexpr Mat(
 		const float r00, const float r01, const float r02, const float r03,
 		const float r10, const float r11, const float r12, const float r13,
 		const Vector4& r2,
 		const float r30, const float r31, const float r32, const float r33
-	);
+	)
+		: Row0(r00, r01, r02, r03), Row1(r10, r11, r12, r13), Row2(r2), Row3(r30, r31, r32, r33)
+	{
+	}
 
 	/// <summary>
 	/// Constructs a 4x4 Matrix using direct components, then a Vector 4
@@ -221,12 +245,15 @@ public:
 	/// <param name="r22">m[2, 2] value</param>
 	/// <param name="r23">m[2, 3] value</param>
 	/// <param name="r3">m[3] Fourth row</param>
-	Matrix4x4(
+	constexpr Mat(
 		const float r00, const float r01, const float r02, const float r03,
 		const float r10, const float r11, const float r12, const float r13,
 		const float r20, const float r21, const float r22, const float r23,
 		const Vector4& r3
-	);
+	)
+		: Row0(r00, r01, r02, r03), Row1(r10, r11, r12, r13), Row2(r20, r21, r22, r23), Row3(r3)
+	{
+	}
 
 	/// <summary>
 	/// Constructs a 4x4 Matrix using 2 Vector 4, then direct components
@@ -253,12 +280,15 @@ public:
 	/// <param name="r31">m[3, 1] value</param>
 	/// <param name="r32">m[3, 2] value</param>
 	/// <param name="r33">m[3, 3] value</param>
-	Matrix4x4(
+	constexpr Mat(
 		const Vector4& r0,
 		const Vector4& r1,
 		const float r20, const float r21, const float r22, const float r23,
 		const float r30, const float r31, const float r32, const float r33
-	);
+	)
+		: Row0(r0), Row1(r1), Row2(r20, r21, r22, r23), Row3(r30, r31, r32, r33)
+	{
+	}
 
 	/// <summary>
 	/// Constructs a 4x4 Matrix using a Vector 4, direct components, a Vector 4, then direct components
@@ -285,12 +315,15 @@ public:
 	/// <param name="r31">m[3, 1] value</param>
 	/// <param name="r32">m[3, 2] value</param>
 	/// <param name="r33">m[3, 3] value</param>
-	Matrix4x4(
+	constexpr Mat(
 		const Vector4& r0,
 		const float r10, const float r11, const float r12, const float r13,
 		const Vector4& r2,
 		const float r30, const float r31, const float r32, const float r33
-	);
+	)
+		: Row0(r0), Row1(r10, r11, r12, r13), Row2(r2), Row3(r30, r31, r32, r33)
+	{
+	}
 
 	/// <summary>
 	/// Constructs a 4x4 Matrix using a Vector 4, direct components, then a Vector 4
@@ -317,12 +350,15 @@ public:
 	/// <param name="r22">m[2, 2] value</param>
 	/// <param name="r23">m[2, 3] value</param>
 	/// <param name="r3">m[3] Fourth row</param>
-	Matrix4x4(
+	constexpr Mat(
 		const Vector4& r0,
 		const float r10, const float r11, const float r12, const float r13,
 		const float r20, const float r21, const float r22, const float r23,
 		const Vector4& r3
-	);
+	)
+		: Row0(r0), Row1(r10, r11, r12, r13), Row2(r20, r21, r22, r23), Row3(r3)
+	{
+	}
 
 	/// <summary>
 	/// Constructs a 4x4 Matrix using 3 Vector 4, then direct components
@@ -346,12 +382,15 @@ public:
 	/// <param name="r31">m[3, 1] value</param>
 	/// <param name="r32">m[3, 2] value</param>
 	/// <param name="r33">m[3, 3] value</param>
-	Matrix4x4(
+	constexpr Mat(
 		const Vector4& r0,
 		const Vector4& r1,
 		const Vector4& r2,
 		const float r30, const float r31, const float r32, const float r33
-	);
+	)
+		: Row0(r0), Row1(r1), Row2(r2), Row3(r30, r31, r32, r33)
+	{
+	}
 
 	/// <summary>
 	/// Constructs a 4x4 Matrix using 2 Vector 4, direct components, then a Vector 4
@@ -375,12 +414,15 @@ public:
 	/// <param name="r22">m[2, 2] value</param>
 	/// <param name="r23">m[2, 3] value</param>
 	/// <param name="r3">m[3] Fourth row</param>
-	Matrix4x4(
+	constexpr Mat(
 		const Vector4& r0,
 		const Vector4& r1,
 		const float r20, const float r21, const float r22, const float r23,
 		const Vector4& r3
-	);
+	)
+		: Row0(r0), Row1(r1), Row2(r20, r21, r22, r23), Row3(r3)
+	{
+	}
 
 	/// <summary>
 	/// Constructs a 4x4 Matrix using direct components, 2 Vector 4, then direct components
@@ -407,12 +449,15 @@ public:
 	/// <param name="r31">m[3, 1] value</param>
 	/// <param name="r32">m[3, 2] value</param>
 	/// <param name="r33">m[3, 3] value</param>
-	Matrix4x4(
+	constexpr Mat(
 		const float r00, const float r01, const float r02, const float r03,
 		const Vector4& r1,
 		const Vector4& r2,
 		const float r30, const float r31, const float r32, const float r33
-	);
+	)
+		: Row0(r00, r01, r02, r03), Row1(r1), Row2(r2), Row3(r30, r31, r32, r33)
+	{
+	}
 
 	/// <summary>
 	/// Constructs a 4x4 Matrix using direct components, a Vector 4, direct components, then a Vector 4,
@@ -439,12 +484,15 @@ public:
 	/// <param name="r22">m[2, 2] value</param>
 	/// <param name="r23">m[2, 3] value</param>
 	/// <param name="r3">m[3] Fourth row</param>
-	Matrix4x4(
+	constexpr Mat(
 		const float r00, const float r01, const float r02, const float r03,
 		const Vector4& r1,
 		const float r20, const float r21, const float r22, const float r23,
 		const Vector4& r3
-	);
+	)
+		: Row0(r00, r01, r02, r03), Row1(r1), Row2(r20, r21, r22, r23), Row3(r3)
+	{
+	}
 
 	/// <summary>
 	/// Constructs a 4x4 Matrix using direct components, a Vector 4, direct components, then a Vector 4
@@ -471,12 +519,15 @@ public:
 	/// <param name="r13">m[1, 3] value</param>
 	/// <param name="r2">m[2] Third row</param>
 	/// <param name="r3">m[3] Fourth row</param>
-	Matrix4x4(
+	constexpr Mat(
 		const float r00, const float r01, const float r02, const float r03,
 		const float r10, const float r11, const float r12, const float r13,
 		const Vector4& r2,
 		const Vector4& r3
-	);
+	)
+		: Row0(r00, r01, r02, r03), Row1(r10, r11, r12, r13), Row2(r2), Row3(r3)
+	{
+	}
 
 	/// <summary>
 	/// Constructs a 4x4 Matrix using 4 Vector 4
@@ -497,12 +548,15 @@ public:
 	/// <param name="r1">m[1] Second row</param>
 	/// <param name="r2">m[2] Third row</param>
 	/// <param name="r3">m[3] Fourth row</param>
-	Matrix4x4(
+	constexpr Mat(
 		const Vector4& r0,
 		const Vector4& r1,
 		const Vector4& r2,
 		const Vector4& r3
-	);
+	)
+		: Row0(r0), Row1(r1), Row2(r2), Row3(r3)
+	{
+	}
 
 	/// <summary>
 	/// Constructs a 4x4 Matrix using a 2x2 Matrix
@@ -518,9 +572,12 @@ public:
 	/// </para>
 	/// </summary>
 	/// <param name="mat">Upper left corner values</param>
-	Matrix4x4(
+	constexpr Mat(
 		const Matrix2x2& mat
-	);
+	)
+		: Row0(mat[0][0], mat[0][1], 0, 0), Row1(mat[1][0], mat[1][1], 0, 0), Row2(0), Row3(0)
+	{
+	}
 
 	/// <summary>
 	/// Constructs a 4x4 Matrix using 4 2x2 Matrix
@@ -539,10 +596,14 @@ public:
 	/// <param name="mat1">Upper right corner values</param>
 	/// <param name="mat2">Lower left corner values</param>
 	/// <param name="mat3">Lower right corner values</param>
-	Matrix4x4(
+	constexpr Mat(
 		const Matrix2x2& mat0, const Matrix2x2& mat1,
 		const Matrix2x2& mat2, const Matrix2x2& mat3
-	);
+	)
+		: Row0(mat0[0][0], mat0[0][1], mat1[0][0], mat1[0][1]), Row1(mat0[1][0], mat0[1][1], mat1[1][0], mat1[1][1]),
+		  Row2(mat2[0][0], mat2[0][1], mat3[0][0], mat3[0][1]), Row3(mat2[1][0], mat2[1][1], mat3[1][0], mat3[1][1])
+	{
+	}
 
 	/// <summary>
 	/// Constructs a 4x4 Matrix using a 3x3 Matrix
@@ -558,9 +619,13 @@ public:
 	/// </para>
 	/// </summary>
 	/// <param name="mat">Upper left corner values</param>
-	Matrix4x4(
+	constexpr Mat(
 		const Matrix3x3& mat
-	);
+	)
+		: Row0(mat[0][0], mat[0][1], mat[0][2], 0), Row1(mat[1][0], mat[1][1], mat[1][2], 0),
+		  Row2(mat[2][0], mat[2][1], mat[2][2], 0), Row3(0)
+	{
+	}
 
 	/// <summary>
 	/// Constructs a 4x4 Matrix using a 3x3 Matrix and direct components
@@ -583,12 +648,16 @@ public:
 	/// <param name="r31">m[3, 1] value</param>
 	/// <param name="r32">m[3, 2] value</param>
 	/// <param name="r33">m[3, 3] value</param>
-	Matrix4x4(
+	constexpr Mat(
 		const Matrix3x3& mat, const float r03,
 		const float r13,
 		const float r23,
 		const float r30, const float r31, const float r32, const float r33
-	);
+	)
+		: Row0(mat[0][0], mat[0][1], mat[0][2], r03), Row1(mat[1][0], mat[1][1], mat[1][2], r13),
+		  Row2(mat[2][0], mat[2][1], mat[2][2], r23), Row3(r30, r31, r32, r33)
+	{
+	}
 
 	/// <summary>
 	/// Constructs a 4x4 Matrix using a 3x3 Matrix, direct components and a Vector 3
@@ -608,18 +677,22 @@ public:
 	/// <param name="r13">m[1, 3] value</param>
 	/// <param name="r23">m[2, 3] value</param>
 	/// <param name="r3">m[3] Fourth row</param>
-	Matrix4x4(
+	constexpr Mat(
 		const Matrix3x3& mat, const float r03,
 		const float r13,
 		const float r23,
 		const Vector4& r3
-	);
+	)
+		: Row0(mat[0][0], mat[0][1], mat[0][2], r03), Row1(mat[1][0], mat[1][1], mat[1][2], r13),
+		  Row2(mat[2][0], mat[2][1], mat[2][2], r23), Row3(r3)
+	{
+	}
 
 	/// <summary>
 	/// Constructs a 4x4 Matrix using an initializer list of floats, [1;16] range of elements
 	/// </summary>
 	/// <param name="data">Data</param>
-	Matrix4x4(
+	Mat(
 		const std::initializer_list<float>& data
 	);
 
@@ -627,15 +700,52 @@ public:
 	/// Constructs a 4x4 Matrix using an initializer list of Vector 4, [1;4] range of elements
 	/// </summary>
 	/// <param name="data">Data</param>
-	Matrix4x4(
+	Mat(
 		const std::initializer_list<Vector4>& data
 	);
 #pragma endregion
 
-	_NODISCARD Vector4 Diagonal() const;
-	_NODISCARD float Trace() const;
+	_NODISCARD constexpr Vector4 Diagonal() const
+	{
+		return Vector4(Row0[0], Row1[1], Row2[2], Row3[3]);
+	}
+
+	_NODISCARD constexpr float Trace() const
+	{
+		return Row0[0] + Row1[1] + Row2[2] + Row3[3];
+	}
+
 	_NODISCARD float Determinant() const;
 
+	/// <summary>
+	/// Computes the inverse of the matrix (closed form, no MatrixM detour)
+	/// </summary>
+	/// <param name="dst">Destination matrix, left untouched if the matrix isn't invertible</param>
+	/// <returns>Whether the matrix is invertible</returns>
+	_NODISCARD bool Inverse(Matrix4x4& dst) const;
+
+	/// <summary>
+	/// Computes the inverse of an affine matrix (last row is 0, 0, 0, 1), e.g. a TRS matrix.
+	/// <para>
+	/// Only the 3x3 linear part is inverted, from the cross products of its rows, the translation is then rotated back.
+	/// Hierarchies with non-uniform scaling produce sheared matrices, they are inverted exactly as well
+	/// </para>
+	/// </summary>
+	/// <param name="dst">Destination matrix, left untouched if the matrix isn't invertible</param>
+	/// <returns>Whether the matrix is invertible</returns>
+	_NODISCARD bool InverseAffine(Matrix4x4& dst) const;
+
+	/// <summary>
+	/// Computes the matrix transforming the normals, the inverse transpose of the 3x3 linear part.
+	/// <para>
+	/// Stored in the upper 3x3 of dst, the rest is the identity, so mat3(dst) can be used in shaders.
+	/// Unlike the linear part itself, it keeps the normals perpendicular to the surfaces under non-uniform scaling
+	/// </para>
+	/// </summary>
+	/// <param name="dst">Destination matrix, left untouched if the matrix isn't invertible</param>
+	/// <returns>Whether the matrix is invertible</returns>
+	_NODISCARD bool NormalMatrix(Matrix4x4& dst) const;
+
 	void Augment(const MatrixM& in, MatrixM& out) const;
 
 	Matrix4x4& Negate();
@@ -650,11 +760,18 @@ public:
 	static void Translation(const Vector3& translation, Matrix4x4& dst);
 	static void Rotation(const Vector3& rotation, Matrix4x4& dst);
 	static void Rotation(const float angle, const Vector3& axis, Matrix4x4& dst);
+	/// <summary>
+	/// Creates the rotation matrix of a unit quaternion, no trigonometry involved
+	/// </summary>
+	/// <param name="rotation">Rotation, must be normalized</param>
+	/// <param name="dst">Destination matrix</param>
+	static void Rotation(const Quaternion& rotation, Matrix4x4& dst);
 	static void Scaling(const Vector3& scaling, Matrix4x4& dst);
 
 	static void TRS(const Vector3& translation, const float angle, const Vector3& axis, const Vector3& scaling, Matrix4x4& dst);
 	static void TRS(const Vector3& translation, const Vector3& rotation, const Vector3& scaling, Matrix4x4& dst);
 	static void TRS(const Vector3& translation, const Matrix3x3& rotation, const Vector3& scaling, Matrix4x4& dst);
+	static void TRS(const Vector3& translation, const Quaternion& rotation, const Vector3& scaling, Matrix4x4& dst);
 
 	/// <summary>
 	/// Creates a 4x4 view matrix
@@ -710,10 +827,88 @@ public:
 		const float top, const float zNear, const float zFar, Matrix4x4& dst
 	);
 	
-	Vector4 operator[](int i) const;
-	Vector4& operator[](int i);
+	_NODISCARD constexpr Vector4 operator[](int i) const
+	{
+		assert(i >= 0 && i < 4 && "Matrix 4x4 subscript out of range");
+		__assume(i >= 0 && i < 4);
+
+		// The rows are contiguous, but indexing past Row0 is only allowed at runtime
+		if (std::is_constant_evaluated())
+			return i == 0 ? Row0 : i == 1 ? Row1 : i == 2 ? Row2 : Row3;
+
+		return (&Row0)[i];
+	}
+
+	_NODISCARD constexpr Vector4& operator[](int i)
+	{
+		assert(i >= 0 && i < 4 && "Matrix 4x4 subscript out of range");
+		__assume(i >= 0 && i < 4);
+
+		if (std::is_constant_evaluated())
+			return i == 0 ? Row0 : i == 1 ? Row1 : i == 2 ? Row2 : Row3;
+
+		return (&Row0)[i];
+	}
+
+	/// <summary>
+	/// Operator Mat4 * Mat4, same result as Multiply(left, right, dst)
+	/// </summary>
+	/// <param name="mat">Right matrix</param>
+	/// <returns>Result</returns>
+	_NODISCARD constexpr Matrix4x4 operator*(const Matrix4x4& mat) const
+	{
+		if (!std::is_constant_evaluated())
+		{
+			Matrix4x4 result;
+			Multiply(*this, mat, result);
+			return result;
+		}
+
+		return Matrix4x4(
+			Row0.x * mat.Row0.x + Row0.y * mat.Row1.x + Row0.z * mat.Row2.x + Row0.w * mat.Row3.x, Row0.x * mat.Row0.y + Row0.y * mat.Row1.y + Row0.z * mat.Row2.y + Row0.w * mat.Row3.y, Row0.x * mat.Row0.z + Row0.y * mat.Row1.z + Row0.z * mat.Row2.z + Row0.w * mat.Row3.z, Row0.x * mat.Row0.w + Row0.y * mat.Row1.w + Row0.z * mat.Row2.w + Row0.w * mat.Row3.w,
+			Row1.x * mat.Row0.x + Row1.y * mat.Row1.x + Row1.z * mat.Row2.x + Row1.w * mat.Row3.x, Row1.x * mat.Row0.y + Row1.y * mat.Row1.y + Row1.z * mat.Row2.y + Row1.w * mat.Row3.y, Row1.x * mat.Row0.z + Row1.y * mat.Row1.z + Row1.z * mat.Row2.z + Row1.w * mat.Row3.z, Row1.x * mat.Row0.w + Row1.y * mat.Row1.w + Row1.z * mat.Row2.w + Row1.w * mat.Row3.w,
+			Row2.x * mat.Row0.x + Row2.y * mat.Row1.x + Row2.z * mat.Row2.x + Row2.w * mat.Row3.x, Row2.x * mat.Row0.y + Row2.y * mat.Row1.y + Row2.z * mat.Row2.y + Row2.w * mat.Row3.y, Row2.x * mat.Row0.z + Row2.y * mat.Row1.z + Row2.z * mat.Row2.z + Row2.w * mat.Row3.z, Row2.x * mat.Row0.w + Row2.y * mat.Row1.w + Row2.z * mat.Row2.w + Row2.w * mat.Row3.w,
+			Row3.x * mat.Row0.x + Row3.y * mat.Row1.x + Row3.z * mat.Row2.x + Row3.w * mat.Row3.x, Row3.x * mat.Row0.y + Row3.y * mat.Row1.y + Row3.z * mat.Row2.y + Row3.w * mat.Row3.y, Row3.x * mat.Row0.z + Row3.y * mat.Row1.z + Row3.z * mat.Row2.z + Row3.w * mat.Row3.z, Row3.x * mat.Row0.w + Row3.y * mat.Row1.w + Row3.z * mat.Row2.w + Row3.w * mat.Row3.w
+		);
+	}
+
+	/// <summary>
+	/// Operator Mat4 * Vec4, the vector is a column
+	/// </summary>
+	/// <param name="vec">Vector</param>
+	/// <returns>Result</returns>
+	_NODISCARD constexpr Vector4 operator*(const Vector4& vec) const
+	{
+		return Vector4(Vector4::DotProduct(Row0, vec), Vector4::DotProduct(Row1, vec), Vector4::DotProduct(Row2, vec), Vector4::DotProduct(Row3, vec));
+	}
+
+	_NODISCARD constexpr bool operator==(const Matrix4x4& mat) const
+	{
+		return Row0 == mat.Row0 && Row1 == mat.Row1 && Row2 == mat.Row2 && Row3 == mat.Row3;
+	}
+
+	_NODISCARD constexpr bool operator!=(const Matrix4x4& mat) const
+	{
+		return !(*this == mat);
+	}
 
 	void Log() const;
 
 	static const Matrix4x4 Identity;
+
+private:
+	/// <summary>
+	/// Scales the columns of a rotation matrix and sets its translation, dst = T * R * S
+	/// </summary>
+	/// <param name="translation">Translation</param>
+	/// <param name="scaling">Scaling</param>
+	/// <param name="dst">Rotation matrix, modified in place</param>
+	static void ApplyScalingTranslation(const Vector3& translation, const Vector3& scaling, Matrix4x4& dst);
 };
+
+inline constexpr Matrix4x4 Matrix4x4::Identity = Matrix4x4(
+	1, 0, 0, 0,
+	0, 1, 0, 0,
+	0, 0, 1, 0,
+	0, 0, 0, 1
+);
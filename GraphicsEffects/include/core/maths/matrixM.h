@@ -1,16 +1,112 @@
 #pragma once
 
-#include <memory>
+#include "core/maths/aligned_buffer.h"
 #include "core/maths/vectorM.h"
 
+class ThreadPool;
+
+/// <summary>
+/// Non-owning view of a block of a Matrix M, its rows are Stride values apart
+/// <para>
+/// The view is only valid as long as the matrix it points into is neither destroyed nor reassigned
+/// </para>
+/// </summary>
+template<typename T>
+class BasicMatrixView
+{
+private:
+	T* mData;
+	uint32_t mColumns;
+	uint32_t mRows;
+	uint32_t mStride;
+
+public:
+	BasicMatrixView()
+		: mData(nullptr), mColumns(0), mRows(0), mStride(0)
+	{
+	}
+
+	BasicMatrixView(T* const data, const uint32_t columns, const uint32_t rows, const uint32_t stride)
+		: mData(data), mColumns(columns), mRows(rows), mStride(stride)
+	{
+	}
+
+	// A mutable view converts to a const one
+	template<typename U, typename = std::enable_if_t<std::is_same_v<const U, T> && !std::is_same_v<U, T>>>
+	BasicMatrixView(const BasicMatrixView<U>& view)
+		: mData(view.Data()), mColumns(view.GetNbrColumns()), mRows(view.GetNbrRows()), mStride(view.GetStride())
+	{
+	}
+
+	_NODISCARD T* Data() const
+	{
+		return mData;
+	}
+
+	_NODISCARD uint32_t GetNbrColumns() const
+	{
+		return mColumns;
+	}
+
+	_NODISCARD uint32_t GetNbrRows() const
+	{
+		return mRows;
+	}
+
+	_NODISCARD uint32_t GetStride() const
+	{
+		return mStride;
+	}
+
+	/// <summary>
+	/// Gets a view of a block of this view
+	/// </summary>
+	/// <param name="x">First column</param>
+	/// <param name="y">First row</param>
+	/// <param name="columns">Number of columns</param>
+	/// <param name="rows">Number of rows</param>
+	_NODISCARD BasicMatrixView Block(const uint32_t x, const uint32_t y, const uint32_t columns, const uint32_t rows) const
+	{
+		assert(x + columns <= mColumns && y + rows <= mRows && "Matrix view block out of range");
+
+		return BasicMatrixView(mData + static_cast<size_t>(y) * mStride + x, columns, rows, mStride);
+	}
+
+	_NODISCARD BasicVectorView<T> operator[](const uint32_t i) const
+	{
+		assert(i < mRows && "Matrix view subscript out of range");
+
+		__assume(i < mRows);
+
+		return BasicVectorView<T>(mData + static_cast<size_t>(i) * mStride, mColumns);
+	}
+};
+
+using MatrixView = BasicMatrixView<float>;
+using ConstMatrixView = BasicMatrixView<const float>;
+
+/// <summary>
+/// Matrix of any size, its values are stored row major in one aligned allocation
+/// <para>
+/// Rows are padded to a multiple of RowAlignment values so every row starts on a 16 bytes boundary,
+/// the padding is always 0
+/// </para>
+/// </summary>
 class MatrixM
 {
+public:
+	static constexpr uint32_t RowAlignment = 4;
+
 private:
-	std::shared_ptr<VectorM[]> mValues;
+	AlignedBuffer mValues;
 	uint32_t mColumns;
 	uint32_t mRows;
+	uint32_t mStride;
 	bool mIsSquare;
 
+	_NODISCARD float* RowData(const uint32_t row);
+	_NODISCARD const float* RowData(const uint32_t row) const;
+
 public:
 	// <summary>
 	/// Creates a fully empty Matrix M object, ONLY USE THIS CONSTRUCTOR IF YOU'RE DOING A COPY AFTER
@@ -35,22 +131,57 @@ public:
 	
 	MatrixM(const uint32_t _columns, const uint32_t _rows, const std::initializer_list<float>& data);
 
-	// Prohibit copy constructor because of the smart pointer, the shallow/deep copy methods shall be used instead
-	MatrixM(const MatrixM&) = delete;
+	/// <summary>
+	/// Creates a Matrix M object holding a copy of the values of a view
+	/// </summary>
+	/// <param name="view">Values to copy</param>
+	explicit MatrixM(ConstMatrixView view);
+
+	MatrixM(const MatrixM& mat);
+	MatrixM(MatrixM&& mat) noexcept;
 
 	_NODISCARD VectorM Diagonal() const;
 	_NODISCARD float Trace() const;
 
-	_NODISCARD VectorM& GetRow(uint32_t row);
-	_NODISCARD const VectorM& GetRow(uint32_t row) const;
+	_NODISCARD VectorView GetRow(uint32_t row);
+	_NODISCARD ConstVectorView GetRow(uint32_t row) const;
 
 	_NODISCARD uint32_t GetNbrColumns() const;
 	_NODISCARD uint32_t GetNbrRows() const;
+	/// <summary>
+	/// Gets the number of values between the start of two rows, including the padding
+	/// </summary>
+	_NODISCARD uint32_t GetStride() const;
+
+	_NODISCARD float* Data();
+	_NODISCARD const float* Data() const;
+
+	/// <summary>
+	/// Gets a view of the whole matrix
+	/// </summary>
+	_NODISCARD MatrixView View();
+	_NODISCARD ConstMatrixView View() const;
+
+	/// <summary>
+	/// Gets a view of a block of the matrix, to read or write it without copying it
+	/// </summary>
+	/// <param name="x">First column</param>
+	/// <param name="y">First row</param>
+	/// <param name="columns">Number of columns</param>
+	/// <param name="rows">Number of rows</param>
+	_NODISCARD MatrixView Block(const uint32_t x, const uint32_t y, const uint32_t columns, const uint32_t rows);
+	_NODISCARD ConstMatrixView Block(const uint32_t x, const uint32_t y, const uint32_t columns, const uint32_t rows) const;
 
 	_NODISCARD const bool IsSquare() const;
 	_NODISCARD const bool IsDiagonal() const;
 
 	void GaussJordanPivot();
+
+	/// <summary>
+	/// Computes the inverse from an LU decomposition with partial pivoting
+	/// </summary>
+	/// <param name="dst">Receives the inverse</param>
+	/// <returns>False if the matrix isn't square or is singular</returns>
 	_NODISCARD bool Inverse(MatrixM& dst) const;
 
 	void Augment(const MatrixM& in, MatrixM& out) const;
@@ -60,18 +191,24 @@ public:
 	MatrixM& Add(const float scalar);
 	MatrixM& Add(const MatrixM& mat);
 	MatrixM& Multiply(const float scalar);
-	MatrixM& Multiply(const MatrixM& mat);
 
-	_NODISCARD float Determinant() const;
-	void SubMatrix(const uint32_t x, const uint32_t y, const uint32_t sizeX, const uint32_t sizeY,
-		const bool wrapAround, MatrixM& dst) const;
+	/// <summary>
+	/// Multiplies the matrix by another one, this = this * mat
+	/// <para>
+	/// The product is computed by blocks that stay in cache, and the blocks of rows are spread over the pool for large matrices
+	/// </para>
+	/// </summary>
+	/// <param name="mat">Right matrix, its number of rows must be the number of columns of this matrix</param>
+	/// <param name="pool">Pool to compute the blocks of rows on, nullptr to compute them on the calling thread</param>
+	/// <returns>Ref to this</returns>
+	MatrixM& Multiply(const MatrixM& mat, ThreadPool* const pool = nullptr);
 
 	/// <summary>
-	/// Creates a shallow copy of the current matrix, and puts into the "out" parameter
-	/// The shallow copy shares the pointer to the data of the matrix, it does not duplicate the values
+	/// Computes the determinant from an LU decomposition, use LUDecomposition directly to also solve systems
 	/// </summary>
-	/// <param name="out">Destination matrix</param>
-	void ShallowCopy(MatrixM& out);
+	_NODISCARD float Determinant() const;
+	void SubMatrix(const uint32_t x, const uint32_t y, const uint32_t sizeX, const uint32_t sizeY,
+		const bool wrapAround, MatrixM& dst) const;
 
 	/// <summary>
 	/// Creates a deep copy of the current matrix, and puts into the "out" parameter
@@ -80,12 +217,22 @@ public:
 	/// <param name="out">Destination matrix</param>
 	void DeepCopy(MatrixM& out) const;
 
-	_NODISCARD VectorM& operator[](uint32_t i);
-	_NODISCARD const VectorM& operator[](uint32_t i) const;
+	_NODISCARD VectorView operator[](uint32_t i);
+	_NODISCARD ConstVectorView operator[](uint32_t i) const;
 
 	MatrixM& operator=(const MatrixM& mat);
+	MatrixM& operator=(MatrixM&& mat) noexcept;
 
 	static void GetIdentity(uint32_t size, MatrixM& out);
 
-	void Log();
+	/// <summary>
+	/// Adds a scaled row to another, dst += scale * src, with SIMD when available
+	/// </summary>
+	/// <param name="dst">Destination values</param>
+	/// <param name="src">Source values</param>
+	/// <param name="scale">Factor applied to the source</param>
+	/// <param name="count">Number of values</param>
+	static void AddScaled(float* const dst, const float* const src, const float scale, const uint32_t count);
+
+	void Log() const;
 };
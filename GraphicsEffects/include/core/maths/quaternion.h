@@ -0,0 +1,134 @@
+#pragma once
+// no discard macro
+#include <memory>
+
+#include "core/maths/vec.h"
+#include "core/maths/mat.h"
+
+/// <summary>
+/// Rotation stored as a unit quaternion, x/y/z are the vector part and w the scalar part
+/// <para>
+/// Euler angles follow the convention of Matrix4x4::Rotation : radians, R = Rz * Ry * Rx
+/// </para>
+/// </summary>
+class Quaternion
+{
+public:
+	float x;
+	float y;
+	float z;
+	float w;
+
+	/// <summary>
+	/// Creates the identity rotation
+	/// </summary>
+	Quaternion();
+
+	/// <summary>
+	/// Creates a Quaternion object using the given components, they are not normalized
+	/// </summary>
+	/// <param name="_x">X value</param>
+	/// <param name="_y">Y value</param>
+	/// <param name="_z">Z value</param>
+	/// <param name="_w">W value</param>
+	Quaternion(const float _x, const float _y, const float _z, const float _w);
+
+	/// <summary>
+	/// Creates a rotation around an axis
+	/// </summary>
+	/// <param name="angle">Angle (radians)</param>
+	/// <param name="axis">Axis, must be normalized</param>
+	/// <returns>Result</returns>
+	_NODISCARD static Quaternion FromAxisAngle(const float angle, const Vector3& axis);
+
+	/// <summary>
+	/// Creates a rotation from Euler angles
+	/// </summary>
+	/// <param name="euler">Angles around X, Y and Z (radians)</param>
+	/// <returns>Result</returns>
+	_NODISCARD static Quaternion FromEuler(const Vector3& euler);
+
+	/// <summary>
+	/// Creates a rotation from a rotation matrix
+	/// </summary>
+	/// <param name="mat">Rotation matrix, without scaling</param>
+	/// <returns>Result</returns>
+	_NODISCARD static Quaternion FromMatrix(const Matrix3x3& mat);
+
+	/// <summary>
+	/// Creates a rotation from the upper 3x3 of a matrix
+	/// </summary>
+	/// <param name="mat">Matrix whose upper 3x3 is a rotation, without scaling</param>
+	/// <returns>Result</returns>
+	_NODISCARD static Quaternion FromMatrix(const Matrix4x4& mat);
+
+	/// <summary>
+	/// Gets the Euler angles of the rotation, the angle around Y is in [-pi/2, pi/2]
+	/// </summary>
+	/// <returns>Angles around X, Y and Z (radians)</returns>
+	_NODISCARD Vector3 ToEuler() const;
+
+	/// <summary>
+	/// Gets the rotation matrix of the quaternion
+	/// </summary>
+	/// <param name="dst">Destination matrix</param>
+	void ToMatrix(Matrix3x3& dst) const;
+
+	_NODISCARD float Norm() const;
+	_NODISCARD float NormSquared() const;
+
+	/// <summary>
+	/// Gets the normalized representation of the quaternion
+	/// </summary>
+	/// <returns>Result</returns>
+	_NODISCARD Quaternion Normalize() const;
+
+	/// <summary>
+	/// Gets the conjugate, the inverse rotation of a unit quaternion
+	/// </summary>
+	/// <returns>Result</returns>
+	_NODISCARD Quaternion Conjugate() const;
+
+	/// <summary>
+	/// Rotates a vector
+	/// </summary>
+	/// <param name="vec">Vector</param>
+	/// <returns>Result</returns>
+	_NODISCARD Vector3 Rotate(const Vector3& vec) const;
+
+	_NODISCARD static float DotProduct(const Quaternion& a, const Quaternion& b);
+
+	/// <summary>
+	/// Combines two rotations, the result applies b then a
+	/// </summary>
+	/// <param name="a">Second rotation</param>
+	/// <param name="b">First rotation</param>
+	/// <returns>Result</returns>
+	_NODISCARD static Quaternion Multiply(const Quaternion& a, const Quaternion& b);
+
+	/// <summary>
+	/// Interpolates along the shortest arc at constant angular speed
+	/// </summary>
+	/// <param name="a">Start rotation</param>
+	/// <param name="b">End rotation</param>
+	/// <param name="t">Factor, [0;1] range</param>
+	/// <returns>Result</returns>
+	_NODISCARD static Quaternion Slerp(const Quaternion& a, const Quaternion& b, const float t);
+
+	/// <summary>
+	/// Interpolates linearly then normalizes, cheaper than Slerp but the angular speed isn't constant
+	/// </summary>
+	/// <param name="a">Start rotation</param>
+	/// <param name="b">End rotation</param>
+	/// <param name="t">Factor, [0;1] range</param>
+	/// <returns>Result</returns>
+	_NODISCARD static Quaternion Nlerp(const Quaternion& a, const Quaternion& b, const float t);
+
+	_NODISCARD Quaternion operator*(const Quaternion& q) const;
+	Quaternion& operator*=(const Quaternion& q);
+
+	_NODISCARD bool operator==(const Quaternion& q) const;
+	_NODISCARD bool operator!=(const Quaternion& q) const;
+
+	static const Quaternion Identity;
+};
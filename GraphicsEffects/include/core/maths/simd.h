@@ -0,0 +1,57 @@
+#pragma once
+
+// SIMD backend selection for the maths library, chosen at build time.
+// SSE is used whenever the target guarantees SSE2 (always the case on x64),
+// AVX is additionally used when the project is compiled with /arch:AVX (or -mavx).
+// Define MATHS_NO_SIMD to force the scalar fallback.
+
+#if !defined(MATHS_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define MATHS_SIMD_SSE
+
+#include <xmmintrin.h>
+#include <emmintrin.h>
+
+#if defined(__AVX__)
+#define MATHS_SIMD_AVX
+
+#include <immintrin.h>
+#endif
+
+#define MATHS_SHUFFLE_MASK(x, y, z, w) ((x) | ((y) << 2) | ((z) << 4) | ((w) << 6))
+
+namespace Simd
+{
+	/// <summary>
+	/// Swizzles the components of a register, result = (v[x], v[y], v[z], v[w])
+	/// </summary>
+	template<int x, int y, int z, int w>
+	inline __m128 Swizzle(const __m128 v)
+	{
+		return _mm_shuffle_ps(v, v, MATHS_SHUFFLE_MASK(x, y, z, w));
+	}
+
+	/// <summary>
+	/// Broadcasts one component of a register to every lane
+	/// </summary>
+	template<int i>
+	inline __m128 Splat(const __m128 v)
+	{
+		return _mm_shuffle_ps(v, v, MATHS_SHUFFLE_MASK(i, i, i, i));
+	}
+
+	/// <summary>
+	/// Computes a row of a row major 4x4 matrix product, result = l.x * r0 + l.y * r1 + l.z * r2 + l.w * r3
+	/// <para>
+	/// The additions are done in the same order as the scalar code so the results are bit-for-bit identical
+	/// </para>
+	/// </summary>
+	inline __m128 LinearCombine(const __m128 l, const __m128 r0, const __m128 r1, const __m128 r2, const __m128 r3)
+	{
+		__m128 result = _mm_mul_ps(Splat<0>(l), r0);
+		result = _mm_add_ps(result, _mm_mul_ps(Splat<1>(l), r1));
+		result = _mm_add_ps(result, _mm_mul_ps(Splat<2>(l), r2));
+		result = _mm_add_ps(result, _mm_mul_ps(Splat<3>(l), r3));
+		return result;
+	}
+}
+#endif
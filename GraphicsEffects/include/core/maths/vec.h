@@ -0,0 +1,174 @@
+#pragma once
+// no discard macro
+#include <memory>
+#include <type_traits>
+#include <assert.h>
+#include <stddef.h>
+
+/// <summary>
+/// Fixed size vector of N values of type T, every operation is constexpr and header only
+/// <para>
+/// Vec&lt;float, 2&gt;, Vec&lt;float, 3&gt; and Vec&lt;float, 4&gt; are specialized with x/y/z/w members,
+/// they are the Vector2, Vector3 and Vector4 of core/maths/vector2.h, vector3.h and vector4.h
+/// </para>
+/// </summary>
+/// <typeparam name="T">Value type</typeparam>
+/// <typeparam name="N">Number of values</typeparam>
+template <typename T, size_t N>
+class Vec
+{
+	static_assert(N > 0, "A Vec must have at least one value");
+	static_assert(!(std::is_same_v<T, float> && N >= 2 && N <= 4),
+		"Vec<float, 2/3/4> is specialized, include core/maths/vector2.h, vector3.h or vector4.h");
+
+public:
+	T values[N];
+
+	/// <summary>
+	/// Creates a Vec object with default values (0)
+	/// </summary>
+	constexpr Vec()
+		: values{}
+	{
+	}
+
+	/// <summary>
+	/// Creates a Vec object using the same value for every component
+	/// </summary>
+	/// <param name="value">Value</param>
+	constexpr explicit Vec(const T value)
+		: values{}
+	{
+		for (size_t i = 0; i < N; i++)
+			values[i] = value;
+	}
+
+	_NODISCARD static constexpr size_t Size()
+	{
+		return N;
+	}
+
+	_NODISCARD constexpr T NormSquared() const
+	{
+		return DotProduct(*this, *this);
+	}
+
+	_NODISCARD static constexpr T DotProduct(const Vec& a, const Vec& b)
+	{
+		T sum = T();
+
+		for (size_t i = 0; i < N; i++)
+			sum += a.values[i] * b.values[i];
+
+		return sum;
+	}
+
+	_NODISCARD constexpr T& operator[](const int i)
+	{
+		assert(i >= 0 && static_cast<size_t>(i) < N && "Vec subscript out of range");
+
+		return values[i];
+	}
+
+	_NODISCARD constexpr T operator[](const int i) const
+	{
+		assert(i >= 0 && static_cast<size_t>(i) < N && "Vec subscript out of range");
+
+		return values[i];
+	}
+
+#pragma region Operators
+	_NODISCARD constexpr Vec operator-() const
+	{
+		Vec result;
+		for (size_t i = 0; i < N; i++)
+			result.values[i] = -values[i];
+		return result;
+	}
+
+	constexpr Vec& operator+=(const Vec& o)
+	{
+		for (size_t i = 0; i < N; i++)
+			values[i] += o.values[i];
+		return *this;
+	}
+
+	constexpr Vec& operator-=(const Vec& o)
+	{
+		for (size_t i = 0; i < N; i++)
+			values[i] -= o.values[i];
+		return *this;
+	}
+
+	constexpr Vec& operator*=(const Vec& o)
+	{
+		for (size_t i = 0; i < N; i++)
+			values[i] *= o.values[i];
+		return *this;
+	}
+
+	constexpr Vec& operator/=(const Vec& o)
+	{
+		for (size_t i = 0; i < N; i++)
+			values[i] /= o.values[i];
+		return *this;
+	}
+
+	constexpr Vec& operator+=(const T scalar)
+	{
+		for (size_t i = 0; i < N; i++)
+			values[i] += scalar;
+		return *this;
+	}
+
+	constexpr Vec& operator-=(const T scalar)
+	{
+		for (size_t i = 0; i < N; i++)
+			values[i] -= scalar;
+		return *this;
+	}
+
+	constexpr Vec& operator*=(const T scalar)
+	{
+		for (size_t i = 0; i < N; i++)
+			values[i] *= scalar;
+		return *this;
+	}
+
+	constexpr Vec& operator/=(const T scalar)
+	{
+		for (size_t i = 0; i < N; i++)
+			values[i] /= scalar;
+		return *this;
+	}
+
+	_NODISCARD constexpr Vec operator+(const Vec& o) const { return Vec(*this) += o; }
+	_NODISCARD constexpr Vec operator-(const Vec& o) const { return Vec(*this) -= o; }
+	_NODISCARD constexpr Vec operator*(const Vec& o) const { return Vec(*this) *= o; }
+	_NODISCARD constexpr Vec operator/(const Vec& o) const { return Vec(*this) /= o; }
+
+	_NODISCARD constexpr Vec operator+(const T scalar) const { return Vec(*this) += scalar; }
+	_NODISCARD constexpr Vec operator-(const T scalar) const { return Vec(*this) -= scalar; }
+	_NODISCARD constexpr Vec operator*(const T scalar) const { return Vec(*this) *= scalar; }
+	_NODISCARD constexpr Vec operator/(const T scalar) const { return Vec(*this) /= scalar; }
+
+	_NODISCARD constexpr bool operator==(const Vec& o) const
+	{
+		for (size_t i = 0; i < N; i++)
+		{
+			if (values[i] != o.values[i])
+				return false;
+		}
+		return true;
+	}
+
+	_NODISCARD constexpr bool operator!=(const Vec& o) const
+	{
+		return !(*this == o);
+	}
+#pragma endregion
+};
+
+using Vector2 = Vec<float, 2>;
+using Vector3 = Vec<float, 3>;
+using Vector4 = Vec<float, 4>;
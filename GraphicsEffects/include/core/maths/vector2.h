@@ -1,9 +1,12 @@
 #pragma once
 
-// no discard macro
-#include <memory>
+#include "core/maths/vec.h"
 
-class Vector2
+/// <summary>
+/// Float vector of 2 components, specialization of Vec&lt;T, N&gt;
+/// </summary>
+template <>
+class Vec<float, 2>
 {
 public:
 	float x;
@@ -12,27 +15,39 @@ public:
 	/// <summary>
 	/// Creates a Vector2 object with default values (0)
 	/// </summary>
-	Vector2();
+	constexpr Vec()
+		: x(0), y(0)
+	{
+	}
 
 	/// <summary>
 	/// Creates a Vector2 object using the same value for the X and Y components
 	/// </summary>
 	/// <param name="_xy">Value</param>
-	Vector2(const float _xy);
+	constexpr Vec(const float _xy)
+		: x(_xy), y(_xy)
+	{
+	}
 
 	/// <summary>
 	/// Creates a Vector2 object using the given components
 	/// </summary>
 	/// <param name="_x">X value</param>
 	/// <param name="_y">Y value</param>
-	Vector2(const float _x, const float _y);
+	constexpr Vec(const float _x, const float _y)
+		: x(_x), y(_y)
+	{
+	}
 
 	/// <summary>
 	/// Creates a Vector2 object that goes from a to b
 	/// </summary>
 	/// <param name="a">First vector</param>
 	/// <param name="b">Second vector</param>
-	Vector2(const Vector2 a, const Vector2 b);
+	constexpr Vec(const Vector2 a, const Vector2 b)
+		: x(b.x - a.x), y(b.y - a.y)
+	{
+	}
 
 	/// <summary>
 	/// Gets the norm/size of the vector
@@ -44,7 +59,10 @@ public:
 	/// Gets the squared norm/size of the vector 2
 	/// </summary>
 	/// <returns>Squared norm</returns>
-	_NODISCARD float NormSquared() const;
+	_NODISCARD constexpr float NormSquared() const
+	{
+		return x * x + y * y;
+	}
 
 	/// <summary>
 	/// Gets the normalized representation of the vector
@@ -110,7 +128,10 @@ public:
 	/// <param name="a">Vector A</param>
 	/// <param name="b">Vector B</param>
 	/// <returns>Result</returns>
-	_NODISCARD static float DotProduct(const Vector2 a, const Vector2 b);
+	_NODISCARD constexpr static float DotProduct(const Vector2 a, const Vector2 b)
+	{
+		return a.x * b.x + a.y * b.y;
+	}
 
 	/// <summary>
 	/// Gets the cross product between 2 vectors
@@ -118,7 +139,10 @@ public:
 	/// <param name="a">Vector A</param>
 	/// <param name="b">Vector B</param>
 	/// <returns>Result</returns>
-	_NODISCARD static float CrossProduct(const Vector2 a, const Vector2 b);
+	_NODISCARD constexpr static float CrossProduct(const Vector2 a, const Vector2 b)
+	{
+		return a.x * b.y - b.x * a.y;
+	}
 
 	/// <summary>
 	/// Gets the distance between 2 vectors (treated as points)
@@ -134,84 +158,141 @@ public:
 	/// <param name="a">Vector A</param>
 	/// <param name="b">Vector B</param>
 	/// <returns>Squared distance</returns>
-	_NODISCARD static float DistanceSquared(const Vector2 a, const Vector2 b);
+	_NODISCARD constexpr static float DistanceSquared(const Vector2 a, const Vector2 b)
+	{
+		return (b - a).NormSquared();
+	}
 
 	/// <summary>
 	/// Operator Vec2 + Vec2
 	/// </summary>
 	/// <param name="o">Other</param>
 	/// <returns>Result</returns>
-	_NODISCARD Vector2 operator+(const Vector2 o) const;
+	_NODISCARD constexpr Vector2 operator+(const Vector2 o) const
+	{
+		return Vector2(x + o.x, y + o.y);
+	}
 
 	/// <summary>
 	/// Operator Vec2 - Vec2
 	/// </summary>
 	/// <param name="o">Other</param>
 	/// <returns>Result</returns>
-	_NODISCARD Vector2 operator-(const Vector2 o) const;
+	_NODISCARD constexpr Vector2 operator-(const Vector2 o) const
+	{
+		return Vector2(x - o.x, y - o.y);
+	}
 
 	/// <summary>
 	/// Operator Vec2 * Vec2
 	/// </summary>
 	/// <param name="o">Other</param>
 	/// <returns>Result</returns>
-	_NODISCARD Vector2 operator*(const Vector2 o) const;
+	_NODISCARD constexpr Vector2 operator*(const Vector2 o) const
+	{
+		return Vector2(x * o.x, y * o.y);
+	}
 
 	/// <summary>
 	/// Operator Vec2 / Vec2
 	/// </summary>
 	/// <param name="o">Other</param>
 	/// <returns>Result</returns>
-	_NODISCARD Vector2 operator/(const Vector2 o) const;
+	_NODISCARD constexpr Vector2 operator/(const Vector2 o) const
+	{
+		return Vector2(x / o.x, y / o.y);
+	}
 
 
 	/// <summary>
 	/// Operator -Vec2
 	/// </summary>
 	/// <returns>Result</returns>
-	_NODISCARD Vector2 operator-() const;
+	_NODISCARD constexpr Vector2 operator-() const
+	{
+		return Vector2(-x, -y);
+	}
 
 	/// <summary>
 	/// Operator Vec2 + Scalar
 	/// </summary>
 	/// <param name="scalar">Scalar</param>
 	/// <returns>Result</returns>
-	_NODISCARD Vector2 operator+(const float scalar) const;
+	_NODISCARD constexpr Vector2 operator+(const float scalar) const
+	{
+		return Vector2(x + scalar, y + scalar);
+	}
 
 	/// <summary>
 	/// Operator Vec2 - Scalar
 	/// </summary>
 	/// <param name="scalar">Scalar</param>
 	/// <returns>Result</returns>
-	_NODISCARD Vector2 operator-(const float scalar) const;
+	_NODISCARD constexpr Vector2 operator-(const float scalar) const
+	{
+		return Vector2(x - scalar, y - scalar);
+	}
 
 	/// <summary>
 	/// Operator Vec2 * Scalar
 	/// </summary>
 	/// <param name="scalar">Scalar</param>
 	/// <returns>Result</returns>
-	_NODISCARD Vector2 operator*(const float scalar) const;
+	_NODISCARD constexpr Vector2 operator*(const float scalar) const
+	{
+		return Vector2(x * scalar, y * scalar);
+	}
 
 	/// <summary>
 	/// Operator Vec2 / Scalar
 	/// </summary>
 	/// <param name="scalar">Scalar</param>
 	/// <returns>Result</returns>
-	_NODISCARD Vector2 operator/(const float scalar) const;
+	_NODISCARD constexpr Vector2 operator/(const float scalar) const
+	{
+		return Vector2(x / scalar, y / scalar);
+	}
 
 	/// <summary>
 	/// Setter for the vector via array indexing
 	/// </summary>
 	/// <param name="i">Index</param>
 	/// <returns>Reference to the value</returns>
-	_NODISCARD float& operator[](int i);
+	_NODISCARD constexpr float& operator[](int i)
+	{
+		assert(i >= 0 && i < 2 && "Vector 2 subscript out of range");
+
+		// The components are contiguous, but indexing past x is only allowed at runtime
+		if (std::is_constant_evaluated())
+			return i == 0 ? x : y;
+
+		return (&x)[i];
+	}
 
 	/// <summary>
 	/// Getter for the vector via array indexing
 	/// </summary>
 	/// <param name="i">Index</param>
 	/// <returns>Value</returns>
-	_NODISCARD float  operator[](int i) const;
+	_NODISCARD constexpr float operator[](int i) const
+	{
+		assert(i >= 0 && i < 2 && "Vector 2 subscript out of range");
+
+		if (std::is_constant_evaluated())
+			return i == 0 ? x : y;
+
+		return (&x)[i];
+	}
+
+	_NODISCARD constexpr bool operator==(const Vector2& o) const
+	{
+		return x == o.x && y == o.y;
+	}
+
+	_NODISCARD constexpr bool operator!=(const Vector2& o) const
+	{
+		return !(*this == o);
+	}
 
 	/// <summary>
 	/// Logs the Vector 2 to the console
@@ -219,8 +300,30 @@ public:
 	void Log() const;
 };
 
-Vector2& operator+=(Vector2& v, const float scalar);
-Vector2& operator+=(Vector2& v, const Vector2 v2);
+constexpr Vector2& operator+=(Vector2& v, const float scalar)
+{
+	v.x += scalar;
+	v.y += scalar;
+	return v;
+}
+
+constexpr Vector2& operator+=(Vector2& v, const Vector2 v2)
+{
+	v.x += v2.x;
+	v.y += v2.y;
+	return v;
+}
 
-Vector2& operator*=(Vector2& v, const float scalar);
-Vector2& operator*=(Vector2& v, const Vector2 v2);
+constexpr Vector2& operator*=(Vector2& v, const float scalar)
+{
+	v.x *= scalar;
+	v.y *= scalar;
+	return v;
+}
+
+constexpr Vector2& operator*=(Vector2& v, const Vector2 v2)
+{
+	v.x *= v2.x;
+	v.y *= v2.y;
+	return v;
+}
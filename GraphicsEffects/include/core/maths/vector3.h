@@ -1,10 +1,13 @@
 #pragma once
-// no discard macro
-#include <memory>
 
-class Vector2;
+#include "core/maths/vec.h"
+#include "core/maths/vector2.h"
 
-class Vector3
+/// <summary>
+/// Float vector of 3 components, specialization of Vec&lt;T, N&gt;
+/// </summary>
+template <>
+class Vec<float, 3>
 {
 public:
 	float x;
@@ -14,13 +17,19 @@ public:
 	/// <summary>
 	/// Creates a Vector3 object with default values (0)
 	/// </summary>
-	Vector3();
+	constexpr Vec()
+		: x(0), y(0), z(0)
+	{
+	}
 
 	/// <summary>
 	/// Creates a Vector3 object using the same value for the X, Y and Z components
 	/// </summary>
 	/// <param name="_xyz">Value</param>
-	Vector3(const float _xyz);
+	constexpr Vec(const float _xyz)
+		: x(_xyz), y(_xyz), z(_xyz)
+	{
+	}
 
 	/// <summary>
 	/// Creates a Vector3 object using the given components
@@ -28,27 +37,39 @@ public:
 	/// <param name="_x">X value</param>
 	/// <param name="_y">Y value</param>
 	/// <param name="_z">Z value</param>
-	Vector3(const float _x, const float _y, const float _z);
+	constexpr Vec(const float _x, const float _y, const float _z)
+		: x(_x), y(_y), z(_z)
+	{
+	}
 
 	/// <summary>
 	/// Creates a Vector3 object that goes from a to b
 	/// </summary>
 	/// <param name="a">First vector</param>
 	/// <param name="b">Second vector</param>
-	Vector3(const Vector3& a, const Vector3& b);
+	constexpr Vec(const Vector3& a, const Vector3& b)
+		: x(b.x - a.x), y(b.y - a.y), z(b.z - a.z)
+	{
+	}
 
 	/// <summary>
 	/// Creates a Vector3 object using a vector 2 for the X and Y components
 	/// </summary>
 	/// <param name="_xy">X/Y vector</param>
-	Vector3(const Vector2 _xy);
+	constexpr Vec(const Vector2 _xy)
+		: x(_xy.x), y(_xy.y), z(0)
+	{
+	}
 
 	/// <summary>
 	/// Creates a Vector3 object using a vector 2 for the X and Y components, and a scalar for Z
 	/// </summary>
 	/// <param name="_xy">X/Y vector</param>
 	/// <param name="_z">Z value</param>
-	Vector3(const Vector2 _xy, const float _z);
+	constexpr Vec(const Vector2 _xy, const float _z)
+		: x(_xy.x), y(_xy.y), z(_z)
+	{
+	}
 
 	/// <summary>
 	/// Gets the norm/size of the vector
@@ -60,7 +81,10 @@ public:
 	/// Gets the squared norm/size of the vector 3
 	/// </summary>
 	/// <returns>Squared norm</returns>
-	_NODISCARD float NormSquared() const;
+	_NODISCARD constexpr float NormSquared() const
+	{
+		return x * x + y * y + z * z;
+	}
 
 	/// <summary>
 	/// Gets the normalized representation of the vector
@@ -195,7 +219,10 @@ public:
 	/// <param name="a">Vector A</param>
 	/// <param name="b">Vector B</param>
 	/// <returns>Result</returns>
-	_NODISCARD static float DotProduct(const Vector3& a, const Vector3& b);
+	_NODISCARD constexpr static float DotProduct(const Vector3& a, const Vector3& b)
+	{
+		return a.x * b.x + a.y * b.y + a.z * b.z;
+	}
 
 	/// <summary>
 	/// Gets the cross product between 2 vectors
@@ -203,7 +230,14 @@ public:
 	/// <param name="a">Vector A</param>
 	/// <param name="b">Vector B</param>
 	/// <returns>Result</returns>
-	_NODISCARD static Vector3 CrossProduct(const Vector3& a, const Vector3& b);
+	_NODISCARD constexpr static Vector3 CrossProduct(const Vector3& a, const Vector3& b)
+	{
+		const float x = a.y * b.z - a.z * b.y;
+		const float y = a.z * b.x - a.x * b.z;
+		const float z = a.x * b.y - a.y * b.x;
+
+		return Vector3(x, y, z);
+	}
 
 	/// <summary>
 	/// Gets the distance between 2 vectors (treated as points)
@@ -219,84 +253,141 @@ public:
 	/// <param name="a">Vector A</param>
 	/// <param name="b">Vector B</param>
 	/// <returns>Squared distance</returns>
-	_NODISCARD static float DistanceSquared(const Vector3& a, const Vector3& b);
+	_NODISCARD constexpr static float DistanceSquared(const Vector3& a, const Vector3& b)
+	{
+		return (b - a).NormSquared();
+	}
 
 	/// <summary>
 	/// Operator Vec3 + Vec3
 	/// </summary>
 	/// <param name="o">Other</param>
 	/// <returns>Result</returns>
-	_NODISCARD Vector3 operator+(const Vector3& o) const;
+	_NODISCARD constexpr Vector3 operator+(const Vector3& o) const
+	{
+		return Vector3(x + o.x, y + o.y, z + o.z);
+	}
 
 	/// <summary>
 	/// Operator Vec3 - Vec3
 	/// </summary>
 	/// <param name="o">Other</param>
 	/// <returns>Result</returns>
-	_NODISCARD Vector3 operator-(const Vector3& o) const;
+	_NODISCARD constexpr Vector3 operator-(const Vector3& o) const
+	{
+		return Vector3(x - o.x, y - o.y, z - o.z);
+	}
 
 	/// <summary>
 	/// Operator Vec3 * Vec3
 	/// </summary>
 	/// <param name="o">Other</param>
 	/// <returns>Result</returns>
-	_NODISCARD Vector3 operator*(const Vector3& o) const;
+	_NODISCARD constexpr Vector3 operator*(const Vector3& o) const
+	{
+		return Vector3(x * o.x, y * o.y, z * o.z);
+	}
 
 	/// <summary>
 	/// Operator Vec3 / Vec3
 	/// </summary>
 	/// <param name="o">Other</param>
 	/// <returns>Result</returns>
-	_NODISCARD Vector3 operator/(const Vector3& o) const;
+	_NODISCARD constexpr Vector3 operator/(const Vector3& o) const
+	{
+		return Vector3(x / o.x, y / o.y, z / o.z);
+	}
 
 
 	/// <summary>
 	/// Operator -Vec3
 	/// </summary>
 	/// <returns>Result</returns>
-	_NODISCARD Vector3 operator-() const;
+	_NODISCARD constexpr Vector3 operator-() const
+	{
+		return Vector3(-x, -y, -z);
+	}
 
 	/// <summary>
 	/// Operator Vec3 + Scalar
 	/// </summary>
 	/// <param name="scalar">Scalar</param>
 	/// <returns>Result</returns>
-	_NODISCARD Vector3 operator+(const float scalar) const;
+	_NODISCARD constexpr Vector3 operator+(const float scalar) const
+	{
+		return Vector3(x + scalar, y + scalar, z + scalar);
+	}
 
 	/// <summary>
 	/// Operator Vec3 - Scalar
 	/// </summary>
 	/// <param name="scalar">Scalar</param>
 	/// <returns>Result</returns>
-	_NODISCARD Vector3 operator-(const float scalar) const;
+	_NODISCARD constexpr Vector3 operator-(const float scalar) const
+	{
+		return Vector3(x - scalar, y - scalar, z - scalar);
+	}
 
 	/// <summary>
 	/// Operator Vec3 * Scalar
 	/// </summary>
 	/// <param name="scalar">Scalar</param>
 	/// <returns>Result</returns>
-	_NODISCARD Vector3 operator*(const float scalar) const;
+	_NODISCARD constexpr Vector3 operator*(const float scalar) const
+	{
+		return Vector3(x * scalar, y * scalar, z * scalar);
+	}
 
 	/// <summary>
 	/// Operator Vec3 / Scalar
 	/// </summary>
 	/// <param name="scalar">Scalar</param>
 	/// <returns>Result</returns>
-	_NODISCARD Vector3 operator/(const float scalar) const;
+	_NODISCARD constexpr Vector3 operator/(const float scalar) const
+	{
+		return Vector3(x / scalar, y / scalar, z / scalar);
+	}
 
 	/// <summary>
 	/// Setter for the vector via array indexing
 	/// </summary>
 	/// <param name="i">Index</param>
 	/// <returns>Reference to the value</returns>
-	_NODISCARD float& operator[](int i);
+	_NODISCARD constexpr float& operator[](int i)
+	{
+		assert(i >= 0 && i < 3 && "Vector 3 subscript out of range");
+
+		// The components are contiguous, but indexing past x is only allowed at runtime
+		if (std::is_constant_evaluated())
+			return i == 0 ? x : i == 1 ? y : z;
+
+		return (&x)[i];
+	}
 
 	/// <summary>
 	/// Getter for the vector via array indexing
 	/// </summary>
 	/// <param name="i">Index</param>
 	/// <returns>Value</returns>
-	_NODISCARD float  operator[](int i) const;
+	_NODISCARD constexpr float operator[](int i) const
+	{
+		assert(i >= 0 && i < 3 && "Vector 3 subscript out of range");
+
+		if (std::is_constant_evaluated())
+			return i == 0 ? x : i == 1 ? y : z;
+
+		return (&x)[i];
+	}
+
+	_NODISCARD constexpr bool operator==(const Vector3& o) const
+	{
+		return x == o.x && y == o.y && z == o.z;
+	}
+
+	_NODISCARD constexpr bool operator!=(const Vector3& o) const
+	{
+		return !(*this == o);
+	}
 
 	/// <summary>
 	/// Logs the Vector 3 to the console
@@ -305,9 +396,42 @@ public:
 };
 
 
-Vector3& operator+=(Vector3& v, const float scalar);
-Vector3& operator+=(Vector3& v, const Vector3 v2);
-Vector3& operator-=(Vector3& v, const Vector3 v2);
+constexpr Vector3& operator+=(Vector3& v, const float scalar)
+{
+	v.x += scalar;
+	v.y += scalar;
+	v.z += scalar;
+	return v;
+}
 
-Vector3& operator*=(Vector3& v, const float scalar);
-Vector3& operator*=(Vector3& v, const Vector3 v2);
+constexpr Vector3& operator+=(Vector3& v, const Vector3 v2)
+{
+	v.x += v2.x;
+	v.y += v2.y;
+	v.z += v2.z;
+	return v;
+}
+
+constexpr Vector3& operator-=(Vector3& v, const Vector3 v2)
+{
+	v.x -= v2.x;
+	v.y -= v2.y;
+	v.z -= v2.z;
+	return v;
+}
+
+constexpr Vector3& operator*=(Vector3& v, const float scalar)
+{
+	v.x *= scalar;
+	v.y *= scalar;
+	v.z *= scalar;
+	return v;
+}
+
+constexpr Vector3& operator*=(Vector3& v, const Vector3 v2)
+{
+	v.x *= v2.x;
+	v.y *= v2.y;
+	v.z *= v2.z;
+	return v;
+}
@@ -1,11 +1,15 @@
 #pragma once
 
-class Vector3;
-// no discard macro
-#include <memory>
+#include "core/maths/vec.h"
+#include "core/maths/vector3.h"
+#include "core/maths/simd.h"
 #include "ImGui/imgui.h"
 
-class Vector4
+/// <summary>
+/// Float vector of 4 components, specialization of Vec&lt;T, N&gt;
+/// </summary>
+template <>
+class Vec<float, 4>
 {
 public:
 	float x;
@@ -16,13 +20,19 @@ public:
 	/// <summary>
 	/// Creates a Vector4 object with default values (0)
 	/// </summary>
-	Vector4();
+	constexpr Vec()
+		: x(0), y(0), z(0), w(0)
+	{
+	}
 
 	/// <summary>
 	/// Creates a Vector4 object using the same value for the X, Y, Z and W components
 	/// </summary>
 	/// <param name=")">Value</param>
-	Vector4(float _xyzw);
+	constexpr Vec(float _xyzw)
+		: x(_xyzw), y(_xyzw), z(_xyzw), w(_xyzw)
+	{
+	}
 
 	/// <summary>
 	/// Creates a Vector4 object using the given components
@@ -31,27 +41,39 @@ public:
 	/// <param name="_y">Y value</param>
 	/// <param name="_z">Z value</param>
 	/// <param name="_w">Z value</param>
-	Vector4(float _x, float _y, float _z, float _w);
+	constexpr Vec(float _x, float _y, float _z, float _w)
+		: x(_x), y(_y), z(_z), w(_w)
+	{
+	}
 
 	/// <summary>
 	/// Creates a Vector4 object that goes from a to b
 	/// </summary>
 	/// <param name="a">First vector</param>
 	/// <param name="b">Second vector</param>
-	Vector4(const Vector4& a, const Vector4& b);
+	constexpr Vec(const Vector4& a, const Vector4& b)
+		: x(b.x - a.x), y(b.y - a.y), z(b.z - a.z), w(b.w - a.w)
+	{
+	}
 
 	/// <summary>
 	/// Creates a Vector4 object using a vector 3 for the X, Y and Z components
 	/// </summary>
 	/// <param name="_xyz">X/Y/Z vector</param>
-	Vector4(const Vector3& _xyz);
+	constexpr Vec(const Vector3& _xyz)
+		: x(_xyz.x), y(_xyz.y), z(_xyz.z), w(0)
+	{
+	}
 
 	/// <summary>
 	/// Creates a Vector4 object using a vector 2 for the X and Y components, and a scalar for Z
 	/// </summary>
 	/// <param name="_xyz">X/Y/Z vector</param>
 	/// <param name="_w">W value</param>
-	Vector4(const Vector3& _xyz, const float _w);
+	constexpr Vec(const Vector3& _xyz, const float _w)
+		: x(_xyz.x), y(_xyz.y), z(_xyz.z), w(_w)
+	{
+	}
 
 	/// <summary>
 	/// Gets the norm/size of the vector
@@ -63,7 +85,10 @@ public:
 	/// Gets the squared norm/size of the vector
 	/// </summary>
 	/// <returns>Squared norm</returns>
-	_NODISCARD float NormSquared() const;
+	_NODISCARD constexpr float NormSquared() const
+	{
+		return x * x + y * y + z * z + w * w;
+	}
 
 	/// <summary>
 	/// Gets the normalized representation of the vector
@@ -91,7 +116,21 @@ public:
 	/// <param name="a">Vector A</param>
 	/// <param name="b">Vector B</param>
 	/// <returns>Result</returns>
-	_NODISCARD static float DotProduct(const Vector4& a, const Vector4& b);
+	_NODISCARD constexpr static float DotProduct(const Vector4& a, const Vector4& b)
+	{
+#ifdef MATHS_SIMD_SSE
+		if (!std::is_constant_evaluated())
+		{
+			// Sum in the same order as the scalar version : ((x + y) + z) + w
+			const __m128 mul = _mm_mul_ps(Load(a), Load(b));
+			__m128 sum = _mm_add_ss(mul, Simd::Splat<1>(mul));
+			sum = _mm_add_ss(sum, Simd::Splat<2>(mul));
+			sum = _mm_add_ss(sum, Simd::Splat<3>(mul));
+			return _mm_cvtss_f32(sum);
+		}
+#endif
+		return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+	}
 
 	/// <summary>
 	/// Gets the distance between 2 vectors (treated as points)
@@ -107,7 +146,10 @@ public:
 	/// <param name="a">Vector A</param>
 	/// <param name="b">Vector B</param>
 	/// <returns>Squared distance</returns>
-	_NODISCARD static float DistanceSquared(const Vector4& a, const Vector4& b);
+	_NODISCARD constexpr static float DistanceSquared(const Vector4& a, const Vector4& b)
+	{
+		return (b - a).NormSquared();
+	}
 
 	/// <summary>
 	/// Logs the Vector 4 to the console
@@ -119,84 +161,250 @@ public:
 	/// </summary>
 	/// <param name="o">Other</param>
 	/// <returns>Result</returns>
-	_NODISCARD Vector4 operator+(const Vector4& o) const;
+	_NODISCARD constexpr Vector4 operator+(const Vector4& o) const
+	{
+#ifdef MATHS_SIMD_SSE
+		if (!std::is_constant_evaluated())
+			return Store(_mm_add_ps(Load(*this), Load(o)));
+#endif
+		return Vector4(x + o.x, y + o.y, z + o.z, w + o.w);
+	}
 
 	/// <summary>
 	/// Operator Vec3 - Vec3
 	/// </summary>
 	/// <param name="o">Other</param>
 	/// <returns>Result</returns>
-	_NODISCARD Vector4 operator-(const Vector4& o) const;
+	_NODISCARD constexpr Vector4 operator-(const Vector4& o) const
+	{
+#ifdef MATHS_SIMD_SSE
+		if (!std::is_constant_evaluated())
+			return Store(_mm_sub_ps(Load(*this), Load(o)));
+#endif
+		return Vector4(x - o.x, y - o.y, z - o.z, w - o.w);
+	}
 
 	/// <summary>
 	/// Operator Vec3 * Vec3
 	/// </summary>
 	/// <param name="o">Other</param>
 	/// <returns>Result</returns>
-	_NODISCARD Vector4 operator*(const Vector4& o) const;
+	_NODISCARD constexpr Vector4 operator*(const Vector4& o) const
+	{
+#ifdef MATHS_SIMD_SSE
+		if (!std::is_constant_evaluated())
+			return Store(_mm_mul_ps(Load(*this), Load(o)));
+#endif
+		return Vector4(x * o.x, y * o.y, z * o.z, w * o.w);
+	}
 
 	/// <summary>
 	/// Operator Vec3 / Vec3
 	/// </summary>
 	/// <param name="o">Other</param>
 	/// <returns>Result</returns>
-	_NODISCARD Vector4 operator/(const Vector4& o) const;
+	_NODISCARD constexpr Vector4 operator/(const Vector4& o) const
+	{
+#ifdef MATHS_SIMD_SSE
+		if (!std::is_constant_evaluated())
+			return Store(_mm_div_ps(Load(*this), Load(o)));
+#endif
+		return Vector4(x / o.x, y / o.y, z / o.z, w / o.w);
+	}
 
 
 	/// <summary>
 	/// Operator -Vec3
 	/// </summary>
 	/// <returns>Result</returns>
-	_NODISCARD Vector4 operator-() const;
+	_NODISCARD constexpr Vector4 operator-() const
+	{
+#ifdef MATHS_SIMD_SSE
+		if (!std::is_constant_evaluated())
+		{
+			// Flip the sign bits
+			return Store(_mm_xor_ps(Load(*this), _mm_set1_ps(-0.f)));
+		}
+#endif
+		return Vector4(-x, -y, -z, -w);
+	}
 
 	/// <summary>
 	/// Operator Vec3 + Scalar
 	/// </summary>
 	/// <param name="scalar">Scalar</param>
 	/// <returns>Result</returns>
-	_NODISCARD Vector4 operator+(const float scalar) const;
+	_NODISCARD constexpr Vector4 operator+(const float scalar) const
+	{
+#ifdef MATHS_SIMD_SSE
+		if (!std::is_constant_evaluated())
+			return Store(_mm_add_ps(Load(*this), _mm_set1_ps(scalar)));
+#endif
+		return Vector4(x + scalar, y + scalar, z + scalar, w + scalar);
+	}
 
 	/// <summary>
 	/// Operator Vec3 - Scalar
 	/// </summary>
 	/// <param name="scalar">Scalar</param>
 	/// <returns>Result</returns>
-	_NODISCARD Vector4 operator-(const float scalar) const;
+	_NODISCARD constexpr Vector4 operator-(const float scalar) const
+	{
+#ifdef MATHS_SIMD_SSE
+		if (!std::is_constant_evaluated())
+			return Store(_mm_sub_ps(Load(*this), _mm_set1_ps(scalar)));
+#endif
+		return Vector4(x - scalar, y - scalar, z - scalar, w - scalar);
+	}
 
 	/// <summary>
 	/// Operator Vec3 * Scalar
 	/// </summary>
 	/// <param name="scalar">Scalar</param>
 	/// <returns>Result</returns>
-	_NODISCARD Vector4 operator*(const float scalar) const;
+	_NODISCARD constexpr Vector4 operator*(const float scalar) const
+	{
+#ifdef MATHS_SIMD_SSE
+		if (!std::is_constant_evaluated())
+			return Store(_mm_mul_ps(Load(*this), _mm_set1_ps(scalar)));
+#endif
+		return Vector4(x * scalar, y * scalar, z * scalar, w * scalar);
+	}
 
 	/// <summary>
 	/// Operator Vec3 / Scalar
 	/// </summary>
 	/// <param name="scalar">Scalar</param>
 	/// <returns>Result</returns>
-	_NODISCARD Vector4 operator/(const float scalar) const;
+	_NODISCARD constexpr Vector4 operator/(const float scalar) const
+	{
+#ifdef MATHS_SIMD_SSE
+		if (!std::is_constant_evaluated())
+			return Store(_mm_div_ps(Load(*this), _mm_set1_ps(scalar)));
+#endif
+		return Vector4(x / scalar, y / scalar, z / scalar, w / scalar);
+	}
 
 	/// <summary>
 	/// Setter for the vector via array indexing
 	/// </summary>
 	/// <param name="i">Index</param>
 	/// <returns>Reference to the value</returns>
-	_NODISCARD float& operator[](int i);
+	_NODISCARD constexpr float& operator[](int i)
+	{
+		assert(i >= 0 && i < 4 && "Vector 4 subscript out of range");
+
+		// The components are contiguous, but indexing past x is only allowed at runtime
+		if (std::is_constant_evaluated())
+			return i == 0 ? x : i == 1 ? y : i == 2 ? z : w;
+
+		return (&x)[i];
+	}
 
 	/// <summary>
 	/// Getter for the vector via array indexing
 	/// </summary>
 	/// <param name="i">Index</param>
 	/// <returns>Value</returns>
-	_NODISCARD float  operator[](int i) const;
+	_NODISCARD constexpr float operator[](int i) const
+	{
+		assert(i >= 0 && i < 4 && "Vector 4 subscript out of range");
+
+		if (std::is_constant_evaluated())
+			return i == 0 ? x : i == 1 ? y : i == 2 ? z : w;
+
+		return (&x)[i];
+	}
+
+	_NODISCARD constexpr bool operator==(const Vector4& o) const
+	{
+		return x == o.x && y == o.y && z == o.z && w == o.w;
+	}
+
+	_NODISCARD constexpr bool operator!=(const Vector4& o) const
+	{
+		return !(*this == o);
+	}
 
 	operator ImVec4() { return ImVec4(x, y, z, w); }
-};
 
+#ifdef MATHS_SIMD_SSE
+private:
+	_NODISCARD static __m128 Load(const Vector4& v)
+	{
+		return _mm_loadu_ps(&v.x);
+	}
+
+	_NODISCARD static Vector4 Store(const __m128 v)
+	{
+		Vector4 result;
+		_mm_storeu_ps(&result.x, v);
+		return result;
+	}
+#endif
+};
 
-Vector4& operator+=(Vector4& v, const float scalar);
-Vector4& operator+=(Vector4& v, const Vector4 v2);
 
-Vector4& operator*=(Vector4& v, const float scalar);
-Vector4& operator*=(Vector4& v, const Vector4 v2);
+constexpr Vector4& operator+=(Vector4& v, const float scalar)
+{
+#ifdef MATHS_SIMD_SSE
+	if (!std::is_constant_evaluated())
+	{
+		_mm_storeu_ps(&v.x, _mm_add_ps(_mm_loadu_ps(&v.x), _mm_set1_ps(scalar)));
+		return v;
+	}
+#endif
+	v.x += scalar;
+	v.y += scalar;
+	v.z += scalar;
+	v.w += scalar;
+	return v;
+}
+
+constexpr Vector4& operator+=(Vector4& v, const Vector4 v2)
+{
+#ifdef MATHS_SIMD_SSE
+	if (!std::is_constant_evaluated())
+	{
+		_mm_storeu_ps(&v.x, _mm_add_ps(_mm_loadu_ps(&v.x), _mm_loadu_ps(&v2.x)));
+		return v;
+	}
+#endif
+	v.x += v2.x;
+	v.y += v2.y;
+	v.z += v2.z;
+	v.w += v2.w;
+	return v;
+}
+
+constexpr Vector4& operator*=(Vector4& v, const float scalar)
+{
+#ifdef MATHS_SIMD_SSE
+	if (!std::is_constant_evaluated())
+	{
+		_mm_storeu_ps(&v.x, _mm_mul_ps(_mm_loadu_ps(&v.x), _mm_set1_ps(scalar)));
+		return v;
+	}
+#endif
+	v.x *= scalar;
+	v.y *= scalar;
+	v.z *= scalar;
+	v.w *= scalar;
+	return v;
+}
+
+constexpr Vector4& operator*=(Vector4& v, const Vector4 v2)
+{
+#ifdef MATHS_SIMD_SSE
+	if (!std::is_constant_evaluated())
+	{
+		_mm_storeu_ps(&v.x, _mm_mul_ps(_mm_loadu_ps(&v.x), _mm_loadu_ps(&v2.x)));
+		return v;
+	}
+#endif
+	v.x *= v2.x;
+	v.y *= v2.y;
+	v.z *= v2.z;
+	v.w *= v2.w;
+	return v;
+}
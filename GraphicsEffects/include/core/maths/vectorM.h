@@ -1,17 +1,98 @@
 #pragma once
 
 #include <initializer_list>
-#include <vector>
+#include <type_traits>
+#include <assert.h>
 #include <stdint.h>
 
-class Vector2;
-class Vector3;
-class Vector4;
+#include "core/maths/aligned_buffer.h"
+#include "core/maths/vector2.h"
+#include "core/maths/vector3.h"
+#include "core/maths/vector4.h"
 
+/// <summary>
+/// Non-owning view of contiguous values, e.g. a row of a Matrix M or a part of a Vector M
+/// <para>
+/// The view is only valid as long as the storage it points into is neither destroyed nor reallocated
+/// </para>
+/// </summary>
+template<typename T>
+class BasicVectorView
+{
+private:
+	T* mData;
+	uint32_t mSize;
+
+public:
+	BasicVectorView()
+		: mData(nullptr), mSize(0)
+	{
+	}
+
+	BasicVectorView(T* const data, const uint32_t size)
+		: mData(data), mSize(size)
+	{
+	}
+
+	// A mutable view converts to a const one
+	template<typename U, typename = std::enable_if_t<std::is_same_v<const U, T> && !std::is_same_v<U, T>>>
+	BasicVectorView(const BasicVectorView<U>& view)
+		: mData(view.Data()), mSize(view.Size())
+	{
+	}
+
+	_NODISCARD uint32_t Size() const
+	{
+		return mSize;
+	}
+
+	_NODISCARD T* Data() const
+	{
+		return mData;
+	}
+
+	/// <summary>
+	/// Gets a view of a part of this view
+	/// </summary>
+	/// <param name="offset">Index of the first value</param>
+	/// <param name="size">Number of values</param>
+	_NODISCARD BasicVectorView Sub(const uint32_t offset, const uint32_t size) const
+	{
+		assert(offset + size <= mSize && "Vector view out of range");
+
+		return BasicVectorView(mData + offset, size);
+	}
+
+	/// <summary>
+	/// Accesses a value via array indexing
+	/// </summary>
+	/// <param name="i">Index [-Size;Size[ range</param>
+	/// <returns>Reference to the value</returns>
+	_NODISCARD T& operator[](int i) const
+	{
+		const int32_t size = mSize;
+
+		assert(i < size && i >= -size && "Vector view subscript out of range");
+
+		__assume(i < size && i >= -size);
+
+		if (i < 0)
+			i = size + i;
+
+		return mData[i];
+	}
+};
+
+using VectorView = BasicVectorView<float>;
+using ConstVectorView = BasicVectorView<const float>;
+
+/// <summary>
+/// Vector of any size, its values are stored in one aligned allocation
+/// </summary>
 class VectorM
 {
 private:
-	std::vector<float> mValues;
+	AlignedBuffer mValues;
 	uint32_t mSize;
 public:
 	/// <summary>
@@ -38,7 +119,14 @@ public:
 	/// <param name="data">Data</param>
 	VectorM(const std::initializer_list<float>& data);
 
+	/// <summary>
+	/// Creates a Vector M object holding a copy of the values of a view
+	/// </summary>
+	/// <param name="view">Values to copy</param>
+	explicit VectorM(ConstVectorView view);
+
 	VectorM(const VectorM& vec);
+	VectorM(VectorM&& vec) noexcept;
 
 	~VectorM();
 
@@ -136,13 +224,6 @@ public:
 	/// <returns>Result</returns>
 	_NODISCARD static float Distance(const VectorM& a, const VectorM& b);
 
-	/// <summary>
-	/// Creates a shallow copy of the current vector, and puts into the "out" parameter
-	/// The shallow copy shares the pointer to the data of the vector, it does not duplicate the values
-	/// </summary>
-	/// <param name="out">Destination vector</param>
-	void ShallowCopy(VectorM& out);
-
 	/// <summary>
 	/// Creates a deep copy of the current vector, and puts into the "out" parameter
 	/// The deep copy does not sharedthe pointer to the data of the vector, it fully duplicates all the data
@@ -155,7 +236,17 @@ public:
 	/// </summary>
 	void Log() const;
 
+	/// <summary>
+	/// Gets a view of the values, to share them without copying them
+	/// </summary>
+	_NODISCARD VectorView View();
+	_NODISCARD ConstVectorView View() const;
+
+	_NODISCARD float* Data();
+	_NODISCARD const float* Data() const;
+
 	VectorM& operator=(const VectorM& vec);
+	VectorM& operator=(VectorM&& vec) noexcept;
 
 	/// <summary>
 	/// Setter for the vector M via array indexing
@@ -78,10 +78,12 @@ public:
 	Transform Transformation;
 	std::string Name;
 	bool Outlined;
+	// Per instance color, read by the shaders that use it
+	Vector4 Color;
 
 	Object(Shader* const shader, Model* const model, Texture* const texture, const Vector4 outlineColor);
 	Object(Shader* const shader, Model* const model, Texture* const texture, const Vector4 outlineColor, 
-		const Vector3& position, const Vector3& rotation, const Vector3& scaling);
+		const Vector3& position, const Quaternion& rotation, const Vector3& scaling);
 
 	
 
@@ -101,7 +103,24 @@ public:
 	bool HasShader() const;
 	Shader& GetShader();
 
-	void Render();
+	bool HasTexture() const;
+	Texture& GetTexture();
+
+	bool IsHidden() const;
+	bool HasModel() const;
+	Model& GetModel();
+
+	/// <summary>
+	/// Sets the stencil state so the next draw marks the pixels the outline is drawn around
+	/// </summary>
+	static void BeginOutline();
+
+	/// <summary>
+	/// Draws the outline of an outlined object around the pixels it wrote to the stencil buffer, binds the outline shader
+	/// </summary>
+	/// <param name="projView">Projection view matrix of the camera</param>
+	/// <returns>False if no outline shader is set</returns>
+	bool DrawOutline(const Matrix4x4& projView);
 
 	/// <summary>
 	/// Called when the object is created
@@ -1,15 +1,33 @@
 #pragma once
 
 #include <string>
+#include <unordered_map>
 
 #include "core/object.hpp"
+#include "core/transform_system.hpp"
+#include "core/bvh.hpp"
 
 #include "renderer/point_light.hpp"
 #include "renderer/directional_light.hpp"
 #include "renderer/spot_light.hpp"
+#include "renderer/light_buffer.hpp"
+#include "renderer/light_clusters.hpp"
+#include "renderer/render_queue.hpp"
 
 class EngineUi;
-class Shader;
+class Camera;
+
+/// <summary>
+/// Frustum culling counters of the last frame
+/// </summary>
+struct CullingStats
+{
+	// Objects with a loaded model
+	uint32_t Tested;
+	// Rejected by the hierarchy or by their bounding sphere
+	uint32_t Culled;
+	uint32_t Drawn;
+};
 
 class Scene
 {
@@ -25,6 +43,9 @@ public:
 private:
 	Object m_Root;
 	std::string m_Name;
+
+	// Computes the matrices of the whole hierarchy before it gets rendered
+	TransformSystem m_Transforms;
 	
 	// Lights need to be handled in a special way and have special properties,
 	// so we keep track of them directly in the scene
@@ -32,10 +53,49 @@ private:
 	std::vector<DirectionalLight*> m_DirLights;
 	std::vector<SpotLight*> m_SpotLights;
 
-	void UpdateChildren(Object& obj);
+	// Lights as read by the shaders, uploaded once per frame
+	LightBuffer<DirectionalLightData> m_DirLightBuffer;
+	LightBuffer<PointLightData> m_PointLightBuffer;
+	LightBuffer<SpotLightData> m_SpotLightBuffer;
+
+	// Lights touching each part of the view, so the lighting shaders only process the local ones
+	LightClusters m_Clusters;
+	std::vector<LightBounds> m_PointBounds;
+	std::vector<LightBounds> m_SpotBounds;
+
+	// Hierarchy of the world bounds of the objects with a loaded model, only the objects that moved are updated
+	Bvh m_Bvh;
+	std::unordered_map<const Object*, uint32_t> m_Proxies;
+	// Object and world bounding sphere of each proxy
+	std::vector<Object*> m_ProxyObjects;
+	std::vector<BoundingSphere> m_ProxySpheres;
+	// Objects whose model is still loading, added to the hierarchy once it is loaded
+	std::vector<Object*> m_PendingObjects;
+
+	// Objects found in the frustum by the hierarchy, and their world bounding spheres as a structure of arrays
+	std::vector<Object*> m_Renderables;
+	std::vector<float> m_BoundsX;
+	std::vector<float> m_BoundsY;
+	std::vector<float> m_BoundsZ;
+	std::vector<float> m_BoundsRadius;
+	std::vector<uint8_t> m_Visible;
+
+	CullingStats m_CullingStats;
+
+	// Draws of the visible objects, sorted to minimize the state changes
+	RenderQueue m_Queue;
+
+	void RebuildBvh();
+	void AddToBvh(Object& obj);
+	void UpdateBvh();
 
 public:
-	Scene(const std::string& name);
+	/// <summary>
+	/// Creates a scene, the first one created becomes the current scene
+	/// </summary>
+	/// <param name="name">Name of the scene</param>
+	/// <param name="pool">Workers shared by the systems of the scene, nullptr to run them on the calling thread</param>
+	Scene(const std::string& name, ThreadPool* const pool = nullptr);
 
 	void AddObject(Object& obj);
 
@@ -48,9 +108,36 @@ public:
 	void AddSpotLight(SpotLight* const light);
 	void RemoveSpotLight(SpotLight* const light);
 
-	void ApplyLights(Shader& shader);
+	/// <summary>
+	/// Uploads the lights that changed, bins them in the clusters of the camera and binds the light buffers for the lighting shaders
+	/// </summary>
+	/// <param name="camera">Camera</param>
+	void ApplyLights(const Camera& camera);
 
+	/// <summary>
+	/// Updates the transforms, and submits and renders the objects inside the view frustum of the camera
+	/// </summary>
 	void Update();
 
+	/// <summary>
+	/// Finds the closest object whose bounding sphere is hit by a ray
+	/// </summary>
+	/// <param name="origin">Origin</param>
+	/// <param name="direction">Normalized direction</param>
+	/// <param name="maxDistance">Length of the ray</param>
+	/// <param name="distance">Receives the distance of the hit</param>
+	/// <returns>Object, nullptr if nothing was hit</returns>
+	_NODISCARD Object* Raycast(const Vector3& origin, const Vector3& direction, const float maxDistance, float& distance) const;
+
+	/// <summary>
+	/// Finds the objects whose bounds intersect a sphere, e.g. the volume of a light
+	/// </summary>
+	/// <param name="sphere">Sphere</param>
+	/// <param name="objects">Receives the objects</param>
+	void Query(const BoundingSphere& sphere, std::vector<Object*>& objects) const;
+
+	_NODISCARD const CullingStats& GetCullingStats() const;
+	_NODISCARD const RenderStats& GetRenderStats() const;
+
 	friend class EngineUi;
 };
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <stdint.h>
+
+/// <summary>
+/// Fixed size pool of worker threads executing tasks in submission order
+/// </summary>
+class ThreadPool
+{
+private:
+	std::vector<std::thread> m_Threads;
+
+	// Thread variables
+	std::queue<std::function<void()>> m_Tasks;
+	std::condition_variable m_CondVar;
+	std::mutex m_Mutex;
+	bool m_Running;
+
+	void Run();
+
+public:
+	/// <summary>
+	/// Starts the worker threads
+	/// </summary>
+	/// <param name="threadCount">Number of threads, 0 to use every hardware thread but the calling one</param>
+	ThreadPool(const uint32_t threadCount = 0);
+
+	/// <summary>
+	/// Stops the worker threads, tasks that didn't start yet are discarded
+	/// </summary>
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	/// <summary>
+	/// Queues a task to be executed on one of the worker threads
+	/// </summary>
+	/// <param name="task">Task</param>
+	void Enqueue(std::function<void()> task);
+
+	/// <summary>
+	/// Executes a task for every index in [0, count) on the worker threads and the calling thread,
+	/// returns once every index is done. The calling thread keeps taking indices, so it never waits on busy workers.
+	/// </summary>
+	/// <param name="count">Number of indices</param>
+	/// <param name="task">Task, called with the index</param>
+	void ParallelFor(const uint32_t count, std::function<void(uint32_t)> task);
+
+	_NODISCARD uint32_t GetThreadCount() const;
+};
@@ -1,9 +1,12 @@
 #pragma once
 
 #include <vector>
+#include <stdint.h>
 
 #include "core/maths/vector3.h"
 #include "core/maths/matrix4x4.h"
+#include "core/maths/quaternion.h"
+#include "core/bounds.hpp"
 
 class Scene;
 
@@ -11,28 +14,82 @@ class Object;
 
 class Transform
 {
+#pragma region Static
+private:
+	// Incremented every time a parent/child link changes, used to know when batched hierarchies must be rebuilt
+	static uint64_t m_HierarchyVersion;
+
+	// Number of matrices recomputed since the last reset
+	static uint32_t m_RecomputedCount;
+
+public:
+	static uint64_t GetHierarchyVersion();
+
+	/// <summary>
+	/// Gets the number of global matrices recomputed since the last call to ResetRecomputedCount,
+	/// reset it once per frame to know how much a frame costs
+	/// </summary>
+	static uint32_t GetRecomputedCount();
+	static void ResetRecomputedCount();
+
+#pragma endregion
+
 private:
 	Object& m_Owner;
 	std::vector<Transform*> m_Children;
 	Transform* m_Parent;
 
+	Vector3 m_Position;
+	Quaternion m_Rotation;
+	Vector3 m_Scaling;
+
+	// Angles last set or derived from the rotation, kept so editing one angle doesn't make the others jump
+	Vector3 m_EulerAngles;
+
 	Matrix4x4 m_LocalTrs;
 	Matrix4x4 m_GlobalTrs;
 
+	// The local matrix is outdated (position, rotation or scaling changed)
+	bool m_LocalDirty;
+	// The global matrix is outdated (local matrix or parent changed)
+	bool m_GlobalDirty;
+
+	void MarkChildrenDirty();
+
 public:
-	Vector3 Position;
-	Vector3 Rotation;
-	Vector3 Scaling;
 
 	Transform() = delete;
 	Transform(Object& owner);
-	Transform(Object& owner, const Vector3& position, const Vector3& rotation, const Vector3& scaling);
-	Transform(Object& owner, const Vector3& position, const Vector3& rotation, const Vector3& scaling, Transform* const parent);
+	Transform(Object& owner, const Vector3& position, const Quaternion& rotation, const Vector3& scaling);
+	Transform(Object& owner, const Vector3& position, const Quaternion& rotation, const Vector3& scaling, Transform* const parent);
 
 	~Transform();
 
+	/// <summary>
+	/// Recomputes the matrices if they are outdated, and marks the children as outdated if the global matrix changed
+	/// </summary>
 	void UpdateTransformation();
 
+	const Vector3& GetPosition() const;
+	const Quaternion& GetRotation() const;
+	const Vector3& GetScaling() const;
+
+	/// <summary>
+	/// Gets the rotation as Euler angles (radians, R = Rz * Ry * Rx), for display
+	/// </summary>
+	const Vector3& GetEulerAngles() const;
+
+	void SetPosition(const Vector3& position);
+	void SetRotation(const Quaternion& rotation);
+	void SetScaling(const Vector3& scaling);
+
+	/// <summary>
+	/// Sets the rotation from Euler angles (radians, R = Rz * Ry * Rx)
+	/// </summary>
+	void SetEulerAngles(const Vector3& angles);
+
+	bool IsDirty() const;
+
 	bool HasParent() const;
 	bool HasChildren() const;
 	void SetParent(Transform* const parent);
@@ -40,6 +97,22 @@ public:
 	void AddChildren(Transform* const child);
 
 	const Matrix4x4& GetGlobalTransform() const;
+
+	/// <summary>
+	/// Transforms local bounds to world space with the global matrix, the box still encloses the rotated box
+	/// </summary>
+	/// <param name="local">Local bounds</param>
+	/// <returns>World bounds</returns>
+	_NODISCARD BoundingBox GetWorldBounds(const BoundingBox& local) const;
+
+	/// <summary>
+	/// Transforms local bounds to world space with the global matrix, the radius is scaled by the largest scaling
+	/// </summary>
+	/// <param name="local">Local bounds</param>
+	/// <returns>World bounds</returns>
+	_NODISCARD BoundingSphere GetWorldBounds(const BoundingSphere& local) const;
 	Object& GetOwner() const;
 	const std::vector<Transform*>& GetChildren() const;
+
+	friend class TransformSystem;
 };
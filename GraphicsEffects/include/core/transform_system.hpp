@@ -0,0 +1,122 @@
+#pragma once
+
+#include <vector>
+#include <stdint.h>
+
+#include "core/maths/vector3.h"
+#include "core/maths/matrix4x4.h"
+#include "core/maths/quaternion.h"
+
+class Transform;
+
+/// <summary>
+/// Batched transform computation, stores the position/rotation/scaling of every node as a structure of arrays
+/// and computes the local and global matrices of the whole hierarchy in one pass.
+/// <para>
+/// Nodes are kept in topological order (a parent is always stored before its children),
+/// so the global matrices are computed with a single linear loop instead of a recursion.
+/// </para>
+/// </summary>
+class TransformSystem
+{
+private:
+	// Structure of arrays, the size is padded to a multiple of 4 so the SIMD path never needs a scalar tail
+	std::vector<float> m_PositionX;
+	std::vector<float> m_PositionY;
+	std::vector<float> m_PositionZ;
+
+	std::vector<float> m_RotationX;
+	std::vector<float> m_RotationY;
+	std::vector<float> m_RotationZ;
+	std::vector<float> m_RotationW;
+
+	std::vector<float> m_ScalingX;
+	std::vector<float> m_ScalingY;
+	std::vector<float> m_ScalingZ;
+
+	// Index of the parent of each node, -1 for roots
+	std::vector<int32_t> m_Parents;
+
+	std::vector<Matrix4x4> m_Local;
+	std::vector<Matrix4x4> m_Global;
+
+	// Nodes whose matrices must be recomputed, propagated to the children during the update
+	std::vector<uint8_t> m_Dirty;
+	uint32_t m_RecomputedCount;
+
+	// Transforms bound with Build, same order as the nodes
+	std::vector<Transform*> m_Bound;
+	uint64_t m_BoundVersion;
+
+	// Transforms whose matrices were written back by the last sync, and whether it rebuilt the nodes
+	std::vector<Transform*> m_Changed;
+	bool m_Rebuilt;
+
+	uint32_t m_Count;
+
+	void Resize(const uint32_t count);
+
+	void UpdateLocal();
+	void UpdateGlobal();
+	void ClearDirty();
+
+	void Gather();
+	void Scatter();
+
+public:
+	TransformSystem();
+
+	/// <summary>
+	/// Removes every node
+	/// </summary>
+	void Clear();
+
+	/// <summary>
+	/// Adds a node, the parent must already be in the system to keep the topological order
+	/// </summary>
+	/// <param name="position">Position</param>
+	/// <param name="rotation">Rotation, must be normalized</param>
+	/// <param name="scaling">Scaling</param>
+	/// <param name="parent">Parent index, -1 for a root node</param>
+	/// <returns>Index of the node</returns>
+	uint32_t Add(const Vector3& position, const Quaternion& rotation, const Vector3& scaling, const int32_t parent = -1);
+
+	void SetPosition(const uint32_t index, const Vector3& position);
+	void SetRotation(const uint32_t index, const Quaternion& rotation);
+	void SetScaling(const uint32_t index, const Vector3& scaling);
+
+	/// <summary>
+	/// Computes the local and global matrices of the nodes that changed since the last update, and of their children
+	/// </summary>
+	void Update();
+
+	/// <summary>
+	/// Rebuilds the nodes from a transform hierarchy, in depth first order
+	/// </summary>
+	/// <param name="root">Root of the hierarchy</param>
+	void Build(Transform& root);
+
+	/// <summary>
+	/// Updates a transform hierarchy : rebuilds the nodes if the hierarchy changed since the last call,
+	/// reads the values of the dirty transforms, computes their matrices and writes them back to the transforms
+	/// </summary>
+	/// <param name="root">Root of the hierarchy</param>
+	void Sync(Transform& root);
+
+	_NODISCARD uint32_t GetCount() const;
+	/// <summary>
+	/// Gets the number of global matrices computed by the last update
+	/// </summary>
+	_NODISCARD uint32_t GetRecomputedCount() const;
+	/// <summary>
+	/// Gets the transforms whose global matrix changed during the last sync
+	/// </summary>
+	_NODISCARD const std::vector<Transform*>& GetChanged() const;
+	/// <summary>
+	/// Checks if the last sync rebuilt the nodes because the hierarchy changed
+	/// </summary>
+	_NODISCARD bool WasRebuilt() const;
+	_NODISCARD int32_t GetParent(const uint32_t index) const;
+	_NODISCARD const Matrix4x4& GetLocal(const uint32_t index) const;
+	_NODISCARD const Matrix4x4& GetGlobal(const uint32_t index) const;
+};
@@ -53,7 +53,15 @@ public:
 	void CalculateView();
 	void CalculateProjection();
 	const Matrix4x4& GetProjView();
-	const Vector3& GetFront();
+	const Vector3& GetFront() const;
+	const Vector3& GetRight() const;
+	const Vector3& GetUp() const;
+
+	/// <summary>
+	/// Turns the camera towards a point
+	/// </summary>
+	/// <param name="target">Point, must differ from the position</param>
+	void LookAt(const Vector3& target);
 
 	void ProcessKeyboard(const CameraMovement movement, const float deltaTime);
 	void ProcessMouse(const float xOffset, const float yOffset);
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <vector>
+#include <stdint.h>
+
+#include "core/thread_pool.hpp"
+#include "renderer/geometry_arena.hpp"
+
+/// <summary>
+/// Draw command as read by glMultiDrawElementsIndirect
+/// </summary>
+struct DrawElementsIndirectCommand
+{
+	uint32_t Count;
+	uint32_t InstanceCount;
+	uint32_t FirstIndex;
+	int32_t BaseVertex;
+	uint32_t BaseInstance;
+};
+
+static_assert(sizeof(DrawElementsIndirectCommand) == 20, "DrawElementsIndirectCommand must match the layout expected by GL");
+
+/// <summary>
+/// Instanced draw of a mesh of the geometry arena
+/// </summary>
+struct IndirectBatch
+{
+	// Batches with the same state (shader, texture...) can be drawn by the same multi draw call when they are consecutive
+	uint32_t State;
+	MeshRange Mesh;
+	uint32_t InstanceCount;
+	uint32_t BaseInstance;
+};
+
+/// <summary>
+/// Consecutive commands sharing a state, issued by a single multi draw call
+/// </summary>
+struct MultiDraw
+{
+	uint32_t State;
+	uint32_t FirstCommand;
+	uint32_t CommandCount;
+};
+
+/// <summary>
+/// Builds the indirect draw commands of a frame on the CPU, without any GL call so it can be built and checked without a GPU.
+/// Commands are filled by chunks on worker threads, then grouped in multi draws by state.
+/// </summary>
+class CommandBuffer
+{
+private:
+	static constexpr uint32_t ChunkSize = 1024;
+
+	std::vector<DrawElementsIndirectCommand> m_Commands;
+	std::vector<MultiDraw> m_Draws;
+
+public:
+	/// <summary>
+	/// Builds one command per batch, in the same order
+	/// </summary>
+	/// <param name="batches">Batches, ordered by state</param>
+	/// <param name="pool">Workers filling the commands, nullptr to fill them on the calling thread</param>
+	void Build(const std::vector<IndirectBatch>& batches, ThreadPool* const pool = nullptr);
+
+	_NODISCARD const std::vector<DrawElementsIndirectCommand>& GetCommands() const;
+	_NODISCARD const std::vector<MultiDraw>& GetDraws() const;
+};
@@ -3,6 +3,21 @@
 #include "renderer/light.hpp"
 #include "core/maths/vector3.h"
 
+/// <summary>
+/// Directional light as read by the shaders, std430 layout
+/// </summary>
+struct DirectionalLightData
+{
+	Vector3 Direction;
+	float Padding;
+
+	Vector4 Ambient;
+	Vector4 Diffuse;
+	Vector4 Specular;
+};
+
+static_assert(sizeof(DirectionalLightData) == 64, "DirectionalLightData must match the std430 layout of the shaders");
+
 class DirectionalLight : public Light
 {
 public:
@@ -12,7 +27,7 @@ public:
 		const Vector4& ambient, const Vector4& specular);
 	~DirectionalLight() override;
 
-	void ForwardToShader(Shader& shader, uint32_t i) const override;
+	void Pack(DirectionalLightData& data) const;
 
 	void OnGui() override;
 };
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <stdint.h>
+#include <cstddef>
+
+struct __GLsync;
+
+/// <summary>
+/// Range of the frame ring written by the CPU for the current frame
+/// </summary>
+struct RingAllocation
+{
+	// Mapped memory of the range, nullptr if the allocation failed
+	void* Data;
+	// Offset in the buffer, to bind the range
+	size_t Offset;
+	size_t Size;
+};
+
+/// <summary>
+/// Buffer of the data written once per frame (instances, camera, light clusters), persistently mapped.
+/// <para>
+/// The buffer is split in one region per frame in flight, each frame linearly allocates its ranges from its region
+/// and writes to them directly, without any driver copy. A fence is inserted once the frame is submitted,
+/// a region is only reused once the GPU passed the fence of the frame that last used it.
+/// </para>
+/// </summary>
+class FrameRing
+{
+public:
+	static constexpr uint32_t FrameCount = 3;
+
+private:
+	static FrameRing* m_Instance;
+
+	uint32_t m_Handle;
+	uint8_t* m_Mapping;
+
+	size_t m_FrameSize;
+	size_t m_Alignment;
+
+	uint32_t m_Frame;
+	// Offset of the next allocation in the region of the current frame
+	size_t m_Offset;
+
+	__GLsync* m_Fences[FrameCount];
+
+	// Number of frames that had to wait for the GPU before reusing their region
+	uint32_t m_StallCount;
+
+public:
+	/// <summary>
+	/// Creates and maps the buffer, and makes this ring the one the renderer writes to
+	/// </summary>
+	/// <param name="frameSize">Size in bytes of the region of each frame</param>
+	FrameRing(const size_t frameSize);
+	~FrameRing();
+
+	FrameRing(const FrameRing&) = delete;
+	FrameRing& operator=(const FrameRing&) = delete;
+
+	/// <summary>
+	/// Gets the ring the renderer writes to, nullptr if there is none
+	/// </summary>
+	_NODISCARD static FrameRing* Instance();
+
+	/// <summary>
+	/// Moves to the region of the next frame, waits for the GPU if it is still reading it
+	/// </summary>
+	void BeginFrame();
+
+	/// <summary>
+	/// Inserts the fence of the current frame, to call once every draw reading the ring has been issued
+	/// </summary>
+	void EndFrame();
+
+	/// <summary>
+	/// Allocates a range for the current frame, aligned so it can be bound as a storage buffer.
+	/// The range must be written before the draws reading it and is only valid until the end of the frame
+	/// </summary>
+	/// <param name="size">Size in bytes</param>
+	/// <returns>Range, its data is nullptr if the region of the frame is full</returns>
+	_NODISCARD RingAllocation Allocate(const size_t size);
+
+	/// <summary>
+	/// Binds a range to an indexed storage buffer binding point
+	/// </summary>
+	/// <param name="binding">Binding index</param>
+	/// <param name="allocation">Range</param>
+	void BindRange(const uint32_t binding, const RingAllocation& allocation) const;
+
+	/// <summary>
+	/// Binds the buffer as the source of the indirect draw commands, the commands are read at the offset of their range
+	/// </summary>
+	void BindIndirect() const;
+
+	_NODISCARD size_t GetFrameSize() const;
+	/// <summary>
+	/// Gets the number of bytes allocated by the current frame
+	/// </summary>
+	_NODISCARD size_t GetUsedSize() const;
+	_NODISCARD uint32_t GetStallCount() const;
+};
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <stdint.h>
+#include <cstddef>
+
+#include "core/maths/vector4.h"
+#include "core/maths/matrix4x4.h"
+#include "core/bounds.hpp"
+
+/// <summary>
+/// View frustum as 6 planes, used to skip the objects that can't be seen
+/// </summary>
+class Frustum
+{
+private:
+	// a * x + b * y + c * z + d, normalized, positive inside
+	Vector4 m_Planes[6];
+
+public:
+	/// <summary>
+	/// Extracts the planes from a projection view matrix
+	/// </summary>
+	/// <param name="projView">Projection view matrix</param>
+	Frustum(const Matrix4x4& projView);
+
+	_NODISCARD bool Intersects(const BoundingSphere& sphere) const;
+	_NODISCARD bool Intersects(const BoundingBox& box) const;
+
+	/// <summary>
+	/// Tests a batch of spheres stored as a structure of arrays, 4 at a time when SIMD is available
+	/// </summary>
+	/// <param name="x">Centers on x</param>
+	/// <param name="y">Centers on y</param>
+	/// <param name="z">Centers on z</param>
+	/// <param name="radius">Radii</param>
+	/// <param name="count">Number of spheres</param>
+	/// <param name="visible">Receives 1 for the spheres intersecting the frustum, 0 otherwise</param>
+	void Cull(const float* const x, const float* const y, const float* const z, const float* const radius,
+		const size_t count, uint8_t* const visible) const;
+};
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <stdint.h>
+#include <cstddef>
+
+#include "core/data_structures/range_allocator.hpp"
+#include "renderer/vertex.hpp"
+
+/// <summary>
+/// Place of a mesh in the geometry arena, the indices are relative to the first vertex
+/// </summary>
+struct MeshRange
+{
+	uint32_t FirstIndex;
+	uint32_t IndexCount;
+	uint32_t BaseVertex;
+	uint32_t VertexCount;
+};
+
+/// <summary>
+/// Shared vertex and index buffers holding the static geometry of every model, with a single vertex array.
+/// <para>
+/// Models are placed at sub-allocated ranges instead of having their own buffers,
+/// so draws of different models don't need to switch vertex arrays and can be issued by one multi draw indirect call.
+/// </para>
+/// </summary>
+class GeometryArena
+{
+private:
+	static GeometryArena* m_Instance;
+
+	RangeAllocator m_Vertices;
+	RangeAllocator m_Indices;
+
+	uint32_t m_Vao;
+	uint32_t m_Vbo;
+	uint32_t m_Ebo;
+
+public:
+	/// <summary>
+	/// Creates the buffers and makes this arena the one the models are uploaded to
+	/// </summary>
+	/// <param name="vertexCapacity">Number of vertices</param>
+	/// <param name="indexCapacity">Number of indices</param>
+	GeometryArena(const uint32_t vertexCapacity, const uint32_t indexCapacity);
+	~GeometryArena();
+
+	GeometryArena(const GeometryArena&) = delete;
+	GeometryArena& operator=(const GeometryArena&) = delete;
+
+	/// <summary>
+	/// Gets the arena the models are uploaded to, nullptr if there is none
+	/// </summary>
+	_NODISCARD static GeometryArena* Instance();
+
+	/// <summary>
+	/// Places a mesh in the arena
+	/// </summary>
+	/// <param name="vertices">Vertices</param>
+	/// <param name="vertexCount">Number of vertices</param>
+	/// <param name="indices">Indices, relative to the first vertex</param>
+	/// <param name="indexCount">Number of indices</param>
+	/// <param name="range">Receives the place of the mesh</param>
+	/// <returns>False if the arena is full</returns>
+	bool Add(const Vertex* const vertices, const size_t vertexCount, const uint32_t* const indices, const size_t indexCount, MeshRange& range);
+
+	/// <summary>
+	/// Frees the place of a mesh
+	/// </summary>
+	/// <param name="range">Place of the mesh</param>
+	void Remove(const MeshRange& range);
+
+	_NODISCARD uint32_t GetVao() const;
+	_NODISCARD const RangeAllocator& GetVertices() const;
+	_NODISCARD const RangeAllocator& GetIndices() const;
+};
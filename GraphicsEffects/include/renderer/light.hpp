@@ -5,11 +5,13 @@
 #include "core/maths/vector4.h"
 
 class Object;
-class Shader;
 
 class Light : public Component
 {
 public:
+	// Attenuation under which a light is negligible, a few steps of an 8 bit colour
+	static constexpr float MinAttenuation = 5.f / 256.f;
+
 	Vector4 Diffuse;
 	Vector4 Ambient;
 	Vector4 Specular;
@@ -18,8 +20,16 @@ public:
 	Light(Object* const obj, const Vector4& diffuse, const Vector4& ambient, const Vector4& specular, const float radius);
 	virtual ~Light() {};
 
-	virtual void ForwardToShader(Shader& shader, uint32_t i) const = 0;
-
 	virtual void OnGui() override;
+
+	/// <summary>
+	/// Gets the distance at which the falloff of deferred.fs, 1 / (1 + linear * d + quadratic * d * d), drops under MinAttenuation.
+	/// The lights are cut off at their radius, so it is the smallest radius that doesn't visibly change the deferred lighting.
+	/// gooch.fs and toon.fs keep their own falloff, which is scaled by the radius.
+	/// </summary>
+	/// <param name="linearAtt">Linear attenuation</param>
+	/// <param name="quadAtt">Quadratic attenuation</param>
+	/// <returns>Distance, infinite if the light doesn't fall off</returns>
+	static float GetRange(const float linearAtt, const float quadAtt);
 };
 
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <vector>
+#include <cstring>
+#include <algorithm>
+
+#include "renderer/storage_buffer.hpp"
+
+/// <summary>
+/// Binding indices of the light buffers, must match the buffer blocks of the lighting shaders
+/// </summary>
+enum class LightBinding : uint32_t
+{
+	DIRECTIONAL = 0,
+	POINT = 1,
+	SPOT = 2,
+	CLUSTERS = 3,
+	CLUSTER_LIGHTS = 4,
+};
+
+/// <summary>
+/// Array of lights packed in a storage buffer, laid out as std430 :
+/// a header holding the number of lights, followed by the lights.
+/// <para>
+/// The lights are packed every frame, but only the range of lights that changed since the last frame is uploaded.
+/// </para>
+/// </summary>
+/// <typeparam name="T">std430 struct of the light, must not have any implicit padding</typeparam>
+template <typename T>
+class LightBuffer
+{
+private:
+	// The light array is aligned on the vec4 in the light structs
+	static constexpr size_t HeaderSize = 16;
+	static constexpr size_t MinCapacity = 16;
+
+	StorageBuffer m_Buffer;
+	// Copy of the lights in the buffer, to find the ones that changed
+	std::vector<T> m_Lights;
+	size_t m_Capacity;
+	uint32_t m_Binding;
+
+public:
+	LightBuffer(const LightBinding binding)
+		: m_Capacity(0), m_Binding(static_cast<uint32_t>(binding))
+	{
+	}
+
+	/// <summary>
+	/// Packs the lights and uploads the ones that changed
+	/// </summary>
+	/// <param name="lights">Lights, must have a Pack(T&amp;) function</param>
+	template <typename L>
+	void Update(const std::vector<L*>& lights)
+	{
+		const size_t count = lights.size();
+		const size_t previousCount = m_Lights.size();
+		bool reallocated = false;
+
+		if (count > m_Capacity || m_Capacity == 0)
+		{
+			m_Capacity = std::max({ count, m_Capacity * 2, MinCapacity });
+			m_Buffer.Allocate(HeaderSize + m_Capacity * sizeof(T));
+			reallocated = true;
+		}
+
+		if (reallocated || count != previousCount)
+		{
+			const int32_t header[4] = { static_cast<int32_t>(count), 0, 0, 0 };
+			m_Buffer.Update(0, sizeof(header), header);
+		}
+
+		m_Lights.resize(count);
+
+		// Range of lights to upload
+		size_t first = count, last = 0;
+
+		for (size_t i = 0; i < count; i++)
+		{
+			T packed{};
+			lights[i]->Pack(packed);
+
+			if (!reallocated && i < previousCount && std::memcmp(&packed, &m_Lights[i], sizeof(T)) == 0)
+				continue;
+
+			m_Lights[i] = packed;
+			first = std::min(first, i);
+			last = i + 1;
+		}
+
+		if (first < last)
+			m_Buffer.Update(HeaderSize + first * sizeof(T), (last - first) * sizeof(T), &m_Lights[first]);
+	}
+
+	/// <summary>
+	/// Binds the buffer to the binding index of the light type
+	/// </summary>
+	void Bind() const
+	{
+		m_Buffer.Bind(m_Binding);
+	}
+};
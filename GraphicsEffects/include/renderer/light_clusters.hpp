@@ -0,0 +1,169 @@
+#pragma once
+
+#include <vector>
+#include <stdint.h>
+
+#include "core/maths/vector2.h"
+#include "core/maths/vector3.h"
+#include "core/thread_pool.hpp"
+#include "renderer/storage_buffer.hpp"
+
+/// <summary>
+/// Bounding sphere of a light, in world space, a light with a radius <= 0 is in no cluster
+/// </summary>
+struct LightBounds
+{
+	Vector3 Position;
+	float Radius;
+};
+
+/// <summary>
+/// Camera the clusters are built for
+/// </summary>
+struct ClusterView
+{
+	Vector3 Position;
+	Vector3 Right;
+	Vector3 Up;
+	Vector3 Front;
+
+	// Vertical field of view in radians
+	float Fov;
+	Vector2 ScreenSize;
+	float Near;
+	float Far;
+};
+
+/// <summary>
+/// Light list of a cluster as read by the shaders, the point light indices are followed by the spot light indices
+/// </summary>
+struct Cluster
+{
+	uint32_t Offset;
+	uint32_t PointCount;
+	uint32_t SpotCount;
+	uint32_t Padding;
+};
+
+/// <summary>
+/// Splits the view frustum in screen tiles and exponential depth slices,
+/// and lists the lights touching each of these clusters so the lighting shaders only process the local lights.
+/// <para>
+/// The lights are binned on the CPU, slices are processed in parallel and each cluster tests 4 lights at once with SSE.
+/// </para>
+/// </summary>
+class LightClusters
+{
+public:
+	static constexpr uint32_t TileCountX = 16;
+	static constexpr uint32_t TileCountY = 9;
+	static constexpr uint32_t SliceCount = 24;
+	static constexpr uint32_t ClusterCount = TileCountX * TileCountY * SliceCount;
+
+private:
+	/// <summary>
+	/// Header of the cluster buffer, std430 layout
+	/// </summary>
+	struct Header
+	{
+		uint32_t TileCountX;
+		uint32_t TileCountY;
+		uint32_t SliceCount;
+		uint32_t Padding0;
+
+		Vector2 ScreenSize;
+		// The slice of a depth d is log(d) * SliceScale + SliceBias
+		float SliceScale;
+		float SliceBias;
+
+		Vector3 Front;
+		float Padding1;
+	};
+
+	static_assert(sizeof(Header) == 48, "Header must match the std430 layout of the shaders");
+
+	/// <summary>
+	/// View space bounding box of a cluster, the depth axis points forward
+	/// </summary>
+	struct Bounds
+	{
+		float MinX, MinY, MinZ;
+		float MaxX, MaxY, MaxZ;
+	};
+
+	/// <summary>
+	/// Lights of a depth slice, structure of arrays so they can be tested 4 at a time
+	/// </summary>
+	struct Slice
+	{
+		std::vector<float> X, Y, Z, RadiusSquared;
+		std::vector<uint32_t> Indices;
+
+		// Light lists of the clusters of the slice, offsets are relative to the slice
+		std::vector<uint32_t> Lights;
+		Cluster Clusters[TileCountX * TileCountY];
+	};
+
+	// Workers binning the slices, nullptr to bin them on the calling thread
+	ThreadPool* m_Pool;
+
+	// Projection the bounds were computed for
+	float m_Fov;
+	float m_Aspect;
+	float m_Near;
+	float m_Far;
+	std::vector<Bounds> m_Bounds;
+
+	// View space lights, point lights followed by spot lights
+	std::vector<float> m_X, m_Y, m_Z, m_Radius;
+	uint32_t m_PointCount;
+
+	std::vector<Slice> m_Slices;
+
+	Header m_Header;
+	std::vector<Cluster> m_Clusters;
+	std::vector<uint32_t> m_Lights;
+
+	StorageBuffer m_ClusterBuffer;
+	StorageBuffer m_LightBuffer;
+
+	static void ComputeBounds(const float fov, const float aspect, const float zNear, const float zFar, std::vector<Bounds>& bounds);
+	static bool Intersects(const Bounds& bounds, const float x, const float y, const float z, const float radiusSquared);
+
+	void BinSlice(const uint32_t slice);
+
+public:
+	/// <summary>
+	/// Creates the clusters
+	/// </summary>
+	/// <param name="pool">Workers binning the slices with the calling thread, nullptr to bin them on the calling thread only</param>
+	LightClusters(ThreadPool* const pool = nullptr);
+
+	/// <summary>
+	/// Bins the lights in the clusters
+	/// </summary>
+	/// <param name="view">Camera</param>
+	/// <param name="pointLights">Bounds of the point lights, in the order of the point light buffer</param>
+	/// <param name="spotLights">Bounds of the spot lights, in the order of the spot light buffer</param>
+	void Build(const ClusterView& view, const std::vector<LightBounds>& pointLights, const std::vector<LightBounds>& spotLights);
+
+	/// <summary>
+	/// Bins the lights by testing every light against every cluster, single threaded and without SIMD.
+	/// Gives the same result as Build, used to validate it.
+	/// </summary>
+	/// <param name="view">Camera</param>
+	/// <param name="pointLights">Bounds of the point lights</param>
+	/// <param name="spotLights">Bounds of the spot lights</param>
+	/// <param name="clusters">Light list of every cluster</param>
+	/// <param name="lights">Light indices</param>
+	static void BuildReference(const ClusterView& view, const std::vector<LightBounds>& pointLights,
+		const std::vector<LightBounds>& spotLights, std::vector<Cluster>& clusters, std::vector<uint32_t>& lights);
+
+	/// <summary>
+	/// Writes the clusters to the frame ring, or uploads them to buffers of their own when it is full, and binds them for the lighting shaders
+	/// </summary>
+	void Upload();
+
+	_NODISCARD const std::vector<Cluster>& GetClusters() const { return m_Clusters; }
+	_NODISCARD const std::vector<uint32_t>& GetLights() const { return m_Lights; }
+};
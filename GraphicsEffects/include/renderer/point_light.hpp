@@ -1,6 +1,27 @@
 #pragma once
 
 #include "renderer/light.hpp"
+#include "core/maths/vector3.h"
+
+/// <summary>
+/// Point light as read by the shaders, std430 layout
+/// </summary>
+struct PointLightData
+{
+	Vector3 Position;
+	float Radius;
+
+	Vector4 Ambient;
+	Vector4 Diffuse;
+	Vector4 Specular;
+
+	float Constant;
+	float Linear;
+	float Quadratic;
+	float Padding;
+};
+
+static_assert(sizeof(PointLightData) == 80, "PointLightData must match the std430 layout of the shaders");
 
 class PointLight : public Light
 {
@@ -15,7 +36,7 @@ public:
 		const float constantAtt, const float linearAtt, const float quadAtt);
 	~PointLight() override;
 
-	void ForwardToShader(Shader& shader, uint32_t i) const override;
+	void Pack(PointLightData& data) const;
 
 	void OnGui() override;
 };
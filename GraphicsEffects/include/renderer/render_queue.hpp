@@ -0,0 +1,210 @@
+#pragma once
+
+#include <vector>
+#include <stdint.h>
+
+#include "core/maths/vector4.h"
+#include "core/maths/matrix4x4.h"
+#include "core/thread_pool.hpp"
+#include "renderer/storage_buffer.hpp"
+#include "renderer/frame_ring.hpp"
+#include "renderer/command_buffer.hpp"
+
+class Object;
+class Camera;
+class Shader;
+class Texture;
+
+/// <summary>
+/// How a render queue issues its batches
+/// </summary>
+enum class RenderMode
+{
+	// One instanced draw call per batch
+	INSTANCED,
+	// One multi draw indirect call per run of batches sharing a shader and a texture, for the models of the geometry arena
+	INDIRECT,
+};
+
+/// <summary>
+/// Draw submitted to a render queue, the key gives the order of execution
+/// </summary>
+struct DrawPacket
+{
+	uint64_t Key;
+	Object* Obj;
+};
+
+/// <summary>
+/// Data of a drawn object as read by the shaders, std430 layout with row major matrices
+/// </summary>
+struct InstanceData
+{
+	Matrix4x4 Model;
+	// Inverse transpose of the model matrix, keeps the normals right under non-uniform scaling
+	Matrix4x4 Normal;
+	Vector4 Color;
+};
+
+static_assert(sizeof(InstanceData) == 144, "InstanceData must match the std430 layout of the shaders");
+
+/// <summary>
+/// Data of the camera as read by the shaders, std430 layout with row major matrices
+/// </summary>
+struct CameraData
+{
+	Matrix4x4 ProjView;
+};
+
+static_assert(sizeof(CameraData) == 64, "CameraData must match the std430 layout of the shaders");
+
+/// <summary>
+/// State changes and draws issued by the last execution of a render queue
+/// </summary>
+struct RenderStats
+{
+	uint32_t DrawCalls;
+	uint32_t Instances;
+	uint32_t ProgramBinds;
+	uint32_t TextureBinds;
+};
+
+/// <summary>
+/// Separates the submission of the draws from their execution.
+/// <para>
+/// Objects are submitted as packets with a 64 bits sort key, from the most significant bits :
+/// outline (1), shader (12), texture (12), model (12), depth (24).
+/// The packets are radix sorted so the draws sharing a shader and a texture are consecutive and drawn front to back,
+/// the execution then only binds a program or a texture when it changes.
+/// </para>
+/// <para>
+/// Consecutive packets sharing their shader, texture and model are drawn as one instanced draw call,
+/// the data of every instance and of the camera is written once per execution to the frame ring,
+/// or uploaded to storage buffers of the queue when there is no ring or it is full.
+/// In indirect mode, the batches are turned into indirect commands on worker threads and issued by multi draw calls.
+/// </para>
+/// </summary>
+class RenderQueue
+{
+public:
+	static constexpr uint32_t IdBits = 12;
+	static constexpr uint32_t DepthBits = 24;
+
+	static constexpr uint32_t DepthShift = 3;
+	static constexpr uint32_t ModelShift = DepthShift + DepthBits;
+	static constexpr uint32_t TextureShift = ModelShift + IdBits;
+	static constexpr uint32_t ShaderShift = TextureShift + IdBits;
+	// Outlined objects write to the stencil buffer and bind the outline shader, they are drawn last
+	static constexpr uint32_t OutlineShift = ShaderShift + IdBits;
+
+	// Binding of the instance buffer block, follows the light bindings
+	static constexpr uint32_t InstanceBinding = 5;
+	static constexpr uint32_t CameraBinding = 6;
+
+private:
+	static constexpr size_t MinInstanceCapacity = 64;
+
+	/// <summary>
+	/// Packets drawn with a single instanced draw call
+	/// </summary>
+	struct Batch
+	{
+		// Index of the first packet, which is also the index of its instance
+		uint32_t First;
+		uint32_t Count;
+	};
+
+	std::vector<DrawPacket> m_Packets;
+	// Ping-pong buffer of the radix sort
+	std::vector<DrawPacket> m_Scratch;
+
+	RenderMode m_Mode;
+	// Workers building the instances and the commands, nullptr to build them on the calling thread
+	ThreadPool* m_Pool;
+
+	std::vector<Batch> m_Batches;
+	// Range of the frame ring holding the instances, its data is nullptr when they are in m_Instances
+	RingAllocation m_InstanceRange;
+	std::vector<InstanceData> m_Instances;
+	StorageBuffer m_InstanceBuffer;
+	size_t m_InstanceCapacity;
+
+	StorageBuffer m_CameraBuffer;
+
+	std::vector<IndirectBatch> m_IndirectBatches;
+	CommandBuffer m_Commands;
+	StorageBuffer m_CommandBuffer;
+	size_t m_CommandCapacity;
+	// Offset of the commands in the bound indirect buffer
+	size_t m_CommandOffset;
+
+	// State bound by the execution
+	const Shader* m_BoundShader;
+	Texture* m_BoundTexture;
+
+	RenderStats m_Stats;
+
+	void BuildBatches();
+	_NODISCARD InstanceData* MapInstances(const size_t count);
+	void UploadInstances();
+	void UploadCamera(Camera& camera);
+	void UploadCommands();
+
+	void BindState(Object& obj, Camera& camera);
+	void DrawBatch(const Batch& batch, const Matrix4x4& projView);
+	void ExecuteIndirect(Camera& camera);
+
+public:
+	/// <summary>
+	/// Creates the queue
+	/// </summary>
+	/// <param name="pool">Workers building the instances and the commands with the calling thread, nullptr to build them on the calling thread only</param>
+	RenderQueue(ThreadPool* const pool = nullptr);
+
+	/// <summary>
+	/// Builds the sort key of a draw, the ids are truncated so they only need to be distinct in their low bits to be grouped
+	/// </summary>
+	/// <param name="shader">Shader handle</param>
+	/// <param name="texture">Texture handle</param>
+	/// <param name="model">Model handle</param>
+	/// <param name="depth">Distance to the camera, 0 on the near plane and 1 on the far plane</param>
+	/// <param name="outlined">Outlined</param>
+	/// <returns>Key</returns>
+	_NODISCARD static uint64_t MakeKey(const uint32_t shader, const uint32_t texture, const uint32_t model, const float depth, const bool outlined);
+
+	/// <summary>
+	/// Sorts packets by key, least significant byte first, skipping the bytes every key shares
+	/// </summary>
+	/// <param name="packets">Packets, sorted in place</param>
+	/// <param name="scratch">Buffer of the same size used by the passes</param>
+	static void RadixSort(std::vector<DrawPacket>& packets, std::vector<DrawPacket>& scratch);
+
+	/// <summary>
+	/// Removes every packet
+	/// </summary>
+	void Clear();
+
+	/// <summary>
+	/// Adds the draw of an object, it must have a shader, a texture and a loaded model
+	/// </summary>
+	/// <param name="obj">Object</param>
+	/// <param name="depth">Distance to the camera, 0 on the near plane and 1 on the far plane</param>
+	void Submit(Object& obj, const float depth);
+
+	/// <summary>
+	/// Orders the packets by key
+	/// </summary>
+	void Sort();
+
+	/// <summary>
+	/// Draws the packets in order, batched in instanced draw calls
+	/// </summary>
+	/// <param name="camera">Camera</param>
+	void Execute(Camera& camera);
+
+	void SetMode(const RenderMode mode);
+	_NODISCARD RenderMode GetMode() const;
+
+	_NODISCARD const std::vector<DrawPacket>& GetPackets() const;
+	_NODISCARD const RenderStats& GetStats() const;
+};
@@ -3,6 +3,29 @@
 #include "renderer/light.hpp"
 #include "core/maths/vector3.h"
 
+/// <summary>
+/// Spot light as read by the shaders, std430 layout
+/// </summary>
+struct SpotLightData
+{
+	Vector3 Position;
+	float Radius;
+
+	Vector3 Direction;
+	float CutOff;
+
+	float OuterCutOff;
+	float Constant;
+	float Linear;
+	float Quadratic;
+
+	Vector4 Ambient;
+	Vector4 Diffuse;
+	Vector4 Specular;
+};
+
+static_assert(sizeof(SpotLightData) == 96, "SpotLightData must match the std430 layout of the shaders");
+
 class SpotLight : public Light
 {
 public:
@@ -23,6 +46,6 @@ public:
 
 	~SpotLight() override;
 
-	void ForwardToShader(Shader& shader, uint32_t i) const override;
+	void Pack(SpotLightData& data) const;
 	void OnGui() override;
 };
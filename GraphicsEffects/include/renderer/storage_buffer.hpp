@@ -0,0 +1,49 @@
+#pragma once
+
+#include <stdint.h>
+#include <cstddef>
+
+/// <summary>
+/// Shader storage buffer, read by the shaders through a std430 buffer block bound to the same index
+/// </summary>
+class StorageBuffer
+{
+private:
+	uint32_t m_Handle;
+	size_t m_Size;
+
+public:
+	StorageBuffer();
+	~StorageBuffer();
+
+	// Prevent copy construction because of the GL buffer
+	StorageBuffer(const StorageBuffer&) = delete;
+	StorageBuffer& operator=(const StorageBuffer&) = delete;
+
+	/// <summary>
+	/// Reallocates the buffer, its previous content is lost
+	/// </summary>
+	/// <param name="size">Size in bytes</param>
+	void Allocate(const size_t size);
+
+	/// <summary>
+	/// Uploads a range of the buffer
+	/// </summary>
+	/// <param name="offset">Offset in bytes</param>
+	/// <param name="size">Size in bytes</param>
+	/// <param name="data">Data</param>
+	void Update(const size_t offset, const size_t size, const void* const data);
+
+	/// <summary>
+	/// Binds the buffer to an indexed binding point, the buffer blocks declared with this binding read it
+	/// </summary>
+	/// <param name="binding">Binding index</param>
+	void Bind(const uint32_t binding) const;
+
+	/// <summary>
+	/// Binds the buffer as the source of the indirect draw commands
+	/// </summary>
+	void BindIndirect() const;
+
+	_NODISCARD size_t GetSize() const { return m_Size; }
+};
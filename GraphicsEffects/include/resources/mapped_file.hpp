@@ -0,0 +1,33 @@
+#pragma once
+
+#include <string>
+#include <stdint.h>
+
+/// <summary>
+/// Read-only memory mapped file, the content is paged in by the OS on access instead of being copied into a buffer
+/// </summary>
+class MappedFile
+{
+private:
+	const char* m_Data;
+	size_t m_Size;
+	bool m_Open;
+
+#ifdef _WIN32
+	void* m_File;
+	void* m_Mapping;
+#else
+	int32_t m_File;
+#endif
+
+public:
+	MappedFile(const std::string& path);
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	_NODISCARD bool IsOpen() const;
+	_NODISCARD const char* GetData() const;
+	_NODISCARD size_t GetSize() const;
+};
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+#include "resources/mapped_file.hpp"
+#include "renderer/vertex.hpp"
+
+/// <summary>
+/// Header of a cooked mesh file, followed by the vertex stream and the index stream at the given offsets
+/// </summary>
+struct CookedMeshHeader
+{
+	static constexpr uint32_t Magic = 'G' | ('E' << 8) | ('M' << 16) | ('S' << 24);
+	// Must be incremented every time the layout of the file or of Vertex changes
+	static constexpr uint32_t Version = 1;
+
+	uint32_t magic;
+	uint32_t version;
+	uint32_t vertexSize;
+	uint32_t vertexCount;
+	uint32_t indexCount;
+	uint32_t padding;
+
+	// Key of the source file the mesh was cooked from
+	uint64_t sourceSize;
+	int64_t sourceTime;
+	uint64_t sourceHash;
+
+	Vector3 boundsMin;
+	Vector3 boundsMax;
+
+	uint64_t vertexOffset;
+	uint64_t indexOffset;
+};
+
+/// <summary>
+/// Binary mesh cache, a cooked mesh is written next to its source model the first time the model is parsed
+/// </summary>
+namespace MeshCache
+{
+	/// <summary>
+	/// Gets the path of the cooked mesh of a source model
+	/// </summary>
+	/// <param name="source">Path of the source model</param>
+	/// <returns>Path of the cooked mesh</returns>
+	_NODISCARD std::string GetCookedPath(const std::string& source);
+
+	/// <summary>
+	/// Hashes the content of a source file (64 bits FNV-1a)
+	/// </summary>
+	_NODISCARD uint64_t Hash(const char* const data, const size_t size);
+
+	/// <summary>
+	/// Writes the cooked mesh of a source model
+	/// </summary>
+	/// <param name="source">Path of the source model</param>
+	/// <param name="sourceData">Content of the source model, used as the cache key</param>
+	/// <param name="sourceSize">Size of the source model</param>
+	/// <param name="vertices">Vertex stream</param>
+	/// <param name="indices">Index stream</param>
+	/// <param name="boundsMin">Minimum corner of the bounding box</param>
+	/// <param name="boundsMax">Maximum corner of the bounding box</param>
+	/// <returns>Whether the file could be written</returns>
+	bool Write(const std::string& source, const char* const sourceData, const size_t sourceSize,
+		const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
+		const Vector3& boundsMin, const Vector3& boundsMax);
+}
+
+/// <summary>
+/// Cooked mesh mapped in memory, the streams point directly into the mapping so they can be uploaded without copies
+/// </summary>
+class CookedMesh
+{
+private:
+	MappedFile m_File;
+	const CookedMeshHeader* m_Header;
+
+	bool Validate(const std::string& source) const;
+
+public:
+	/// <summary>
+	/// Opens the cooked mesh of a source model, it is only valid if it is up to date with the source
+	/// </summary>
+	/// <param name="source">Path of the source model</param>
+	CookedMesh(const std::string& source);
+
+	_NODISCARD bool IsValid() const;
+
+	_NODISCARD const Vertex* GetVertices() const;
+	_NODISCARD uint32_t GetVertexCount() const;
+
+	_NODISCARD const uint32_t* GetIndices() const;
+	_NODISCARD uint32_t GetIndexCount() const;
+
+	_NODISCARD const Vector3& GetBoundsMin() const;
+	_NODISCARD const Vector3& GetBoundsMax() const;
+};
@@ -1,29 +1,100 @@
 #pragma once
 
 #include "resources/resource.hpp"
+#include "resources/mesh_cache.hpp"
 #include "renderer/vertex.hpp"
 #include <vector>
+#include <memory>
+#include <atomic>
 
 #include "core/maths/vector3.h"
 #include "core/maths/vector2.h"
+#include "core/bounds.hpp"
+#include "renderer/geometry_arena.hpp"
 
 class Model : public Resource
 {
 private:
+	// Decoded mesh waiting to be uploaded, either the cooked mesh or the parsed source model
+	std::unique_ptr<CookedMesh> m_Cooked;
 	std::vector<Vertex> m_Vertices;
 	std::vector<uint32_t> m_Indices;
 
+	uint32_t m_IndexCount;
+
+	Vector3 m_BoundsMin;
+	Vector3 m_BoundsMax;
+	// Radius of the bounding sphere centered on the bounding box
+	float m_BoundingRadius;
+
+	static std::atomic<uint32_t> m_NextId;
+	uint32_t m_Id;
+
 	uint32_t m_Vbo;
 	uint32_t m_Vao;
 	uint32_t m_Ebo;
 
-	void SetupMesh();
+	// Place of the mesh in its buffers, either its own ones or the geometry arena
+	MeshRange m_Range;
+	bool m_InArena;
+
+	void ComputeBoundingRadius(const Vertex* const vertices, const size_t vertexCount);
+
+	void SetupMesh(const Vertex* const vertices, const size_t vertexCount, const uint32_t* const indices, const size_t indexCount);
+
+	/// <summary>
+	/// Parses the source model and writes its cooked mesh for the next loads
+	/// </summary>
+	void Cook();
+
+protected:
+	/// <summary>
+	/// Maps the cooked mesh if it is up to date, or parses and cooks the source model otherwise
+	/// </summary>
+	void Decode() override;
+	void Upload() override;
 
 public:
-	Model(const std::string& name) : Resource(name) {}
+	Model(const std::string& name) : Resource(name), m_IndexCount(0), m_BoundingRadius(0.f), m_Id(m_NextId++),
+		m_Vbo(0), m_Vao(0), m_Ebo(0), m_Range(), m_InArena(false) {}
+	~Model() override;
 
-	void Load() override;
+	/// <summary>
+	/// Declares the vertex layout in the bound vertex array, for the vertex buffer bound to GL_ARRAY_BUFFER
+	/// </summary>
+	static void SetupAttributes();
 
 	void Render();
+
+	/// <summary>
+	/// Draws several instances of the model, the shaders find their data at gl_BaseInstance + gl_InstanceID
+	/// </summary>
+	/// <param name="instanceCount">Number of instances</param>
+	/// <param name="baseInstance">Index of the first instance</param>
+	void RenderInstanced(const uint32_t instanceCount, const uint32_t baseInstance);
+
+	/// <summary>
+	/// Gets a small id unique to the model, used to sort the draws
+	/// </summary>
+	_NODISCARD uint32_t GetId() const;
+
+	/// <summary>
+	/// Checks if the mesh was uploaded to the geometry arena
+	/// </summary>
+	_NODISCARD bool IsInArena() const;
+	_NODISCARD const MeshRange& GetMeshRange() const;
+
+	_NODISCARD const Vector3& GetBoundsMin() const;
+	_NODISCARD const Vector3& GetBoundsMax() const;
+
+	/// <summary>
+	/// Gets the local bounding box, computed when the model is decoded
+	/// </summary>
+	_NODISCARD BoundingBox GetBoundingBox() const;
+
+	/// <summary>
+	/// Gets the local bounding sphere, computed when the model is decoded
+	/// </summary>
+	_NODISCARD BoundingSphere GetBoundingSphere() const;
 };
 
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <vector>
+#include <stdint.h>
+
+#include "renderer/vertex.hpp"
+#include "core/thread_pool.hpp"
+
+/// <summary>
+/// Wavefront OBJ parser, builds an indexed mesh from the content of an OBJ file.
+/// <para>
+/// The text is split into chunks at line boundaries that are parsed on the workers of a thread pool,
+/// the position/uv/normal triplets are then deduplicated so every unique vertex is only stored once.
+/// </para>
+/// </summary>
+namespace ObjParser
+{
+	/// <summary>
+	/// Parses an OBJ file
+	/// </summary>
+	/// <param name="data">Text of the file, doesn't need to be null terminated</param>
+	/// <param name="size">Size of the text</param>
+	/// <param name="vertices">Unique vertices of the mesh</param>
+	/// <param name="indices">Triangle list indexing the vertices, faces with more than 3 corners are fan triangulated</param>
+	/// <param name="pool">Workers parsing the chunks along with the calling thread, which can be one of them. Parsed on the calling thread alone if null</param>
+	/// <returns>Whether the file could be parsed, false if a statement is malformed or a face refers to an attribute not declared before it</returns>
+	bool Parse(const char* const data, const size_t size, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices,
+		ThreadPool* const pool = nullptr);
+}
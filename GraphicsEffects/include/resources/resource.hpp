@@ -1,15 +1,50 @@
 #pragma once
 
 #include <string>
+#include <atomic>
 
 class Resource
 {
 protected:
 	const std::string m_Name;
+	bool m_Loaded;
+	// Set by the worker thread when decoding an asynchronous load failed, the resource then never becomes loaded
+	std::atomic<bool> m_Failed;
+
+	/// <summary>
+	/// Reads and decodes the resource, doesn't use the graphics API so it can run on a worker thread.
+	/// Throws std::runtime_error if the file can't be read or decoded
+	/// </summary>
+	virtual void Decode() {};
+
+	/// <summary>
+	/// Uploads the decoded resource to the GPU, must run on the main thread
+	/// </summary>
+	virtual void Upload() {};
+
+	friend class ResourceManager;
 
 public:
-	Resource(const std::string& name) : m_Name(name) {}
+	Resource(const std::string& name) : m_Name(name), m_Loaded(false), m_Failed(false) {}
 	virtual ~Resource() {}
 
-	virtual void Load() {};
+	/// <summary>
+	/// Decodes and uploads the resource synchronously
+	/// </summary>
+	virtual void Load()
+	{
+		Decode();
+		Upload();
+		m_Loaded = true;
+	};
+
+	/// <summary>
+	/// Whether the resource finished loading, a resource loaded asynchronously is empty until then
+	/// </summary>
+	_NODISCARD bool IsLoaded() const { return m_Loaded; }
+
+	/// <summary>
+	/// Whether an asynchronous load failed, the resource stays empty
+	/// </summary>
+	_NODISCARD bool IsFailed() const { return m_Failed.load(std::memory_order_acquire); }
 };
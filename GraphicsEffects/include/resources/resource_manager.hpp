@@ -3,10 +3,14 @@
 #include <unordered_map>
 #include <string>
 #include <iostream>
+#include <functional>
+#include <stdexcept>
 
 #include "resources/resource.hpp"
 #include "resources/texture.hpp"
 #include "core/debug/log.hpp"
+#include "core/thread_pool.hpp"
+#include "core/data_structures/mpsc_queue.hpp"
 
 template<class T>
 concept ResourceClass = std::is_base_of<Resource, T>::value;
@@ -16,9 +20,38 @@ class ResourceManager
 private:
 	static std::unordered_map<std::string, Resource*> m_Resources;
 
+	// Decodes the resources loaded asynchronously, owned by the application
+	static ThreadPool* m_Pool;
+	// Uploads of the decoded resources, executed on the main thread
+	static MpscQueue<Resource*> m_Uploads;
+
 public:
 	ResourceManager() = delete;
 
+	/// <summary>
+	/// Sets the worker threads used to load resources asynchronously
+	/// </summary>
+	/// <param name="pool">Workers, shared with the rest of the engine</param>
+	static void Init(ThreadPool* const pool);
+
+	/// <summary>
+	/// Gets the worker threads given to Init, resources can split their decoding on them
+	/// </summary>
+	/// <returns>The workers, null before Init and after Shutdown</returns>
+	_NODISCARD static ThreadPool* GetPool();
+
+	/// <summary>
+	/// Deletes every resource, the pool given to Init must be stopped first so that no resource is deleted while being decoded
+	/// </summary>
+	static void Shutdown();
+
+	/// <summary>
+	/// Creates a resource, an existing resource with the same name is deleted and replaced.
+	/// It must not be one still loading asynchronously, the workers and the upload queue still point to it
+	/// </summary>
+	/// <typeparam name="T">Resource type</typeparam>
+	/// <param name="name">Name of the resource</param>
+	/// <returns>The resource</returns>
 	template<ResourceClass T>
 	_NODISCARD static T* Create(const std::string& name)
 	{
@@ -30,12 +63,58 @@ public:
 		{
 			// Delete and replace
 			delete result.first->second;
-			m_Resources.emplace(name, res);
+			result.first->second = res;
 		}
 
 		return res;
 	}
 
+	/// <summary>
+	/// Creates a resource and loads it asynchronously : it is decoded on a worker thread,
+	/// then uploaded on the main thread by ProcessUploads
+	/// </summary>
+	/// <typeparam name="T">Resource type</typeparam>
+	/// <param name="name">Name of the resource</param>
+	/// <returns>The resource, it can be used right away but stays empty until IsLoaded returns true, or forever if IsFailed does.
+	/// If the name is already registered, that resource is returned and nothing is loaded</returns>
+	template<ResourceClass T>
+	_NODISCARD static T* LoadAsync(const std::string& name)
+	{
+		// The existing resource may still be decoding, replacing it would delete it under the worker
+		auto search = m_Resources.find(name);
+		if (search != m_Resources.end())
+			return static_cast<T*>(search->second);
+
+		T* const res = new T(name);
+		Resource* const base = res;
+		m_Resources.emplace(name, res);
+
+		m_Pool->Enqueue([base]()
+			{
+				try
+				{
+					base->Decode();
+				}
+				catch (const std::exception& e)
+				{
+					Log::LogError(std::string("Couldn't decode the resource named : ").append(base->m_Name).append(" (").append(e.what()).append(")"));
+					base->m_Failed.store(true, std::memory_order_release);
+					return;
+				}
+
+				m_Uploads.Push(base);
+			});
+
+		return res;
+	}
+
+	/// <summary>
+	/// Uploads the resources decoded by the worker threads, should be called once per frame on the main thread
+	/// </summary>
+	/// <param name="budget">Time budget (milliseconds), at least one resource is uploaded if any is waiting</param>
+	/// <returns>Number of resources uploaded</returns>
+	static uint32_t ProcessUploads(const float budget);
+
 	template<ResourceClass T>
 	_NODISCARD static T* Get(const std::string& name)
 	{
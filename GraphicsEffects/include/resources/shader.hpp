@@ -1,6 +1,8 @@
 #pragma once
 
+#include <algorithm>
 #include <filesystem>
+#include <unordered_map>
 #include "resources/resource.hpp"
 
 #include "core/maths/vector2.h"
@@ -22,16 +24,39 @@ ShaderVariables operator|=(ShaderVariables left, ShaderVariables right);
 
 bool operator&(ShaderVariables left, ShaderVariables right);
 
+/// <summary>
+/// Uniforms set for every draw, their locations are resolved once when the shader is linked
+/// </summary>
+enum class ShaderUniform : uint32_t
+{
+	MVP,
+	MODEL,
+	VIEW_POS,
+
+	COUNT
+};
+
 class Shader : public Resource
 {
 private:
+	// Program currently bound, to skip redundant binds
+	static uint32_t m_BoundHandle;
+
 	uint32_t m_Handle;
 	ShaderVariables m_Variables;
 
-	inline int32_t GetUniform(const std::string& name) const;
+	// Location of every active uniform, filled once after linking
+	std::unordered_map<std::string, int32_t> m_Uniforms;
+	// -1 until the shader is linked, so a failed link doesn't set the uniforms at location 0
+	int32_t m_BuiltIns[static_cast<uint32_t>(ShaderUniform::COUNT)];
+
+	void CacheUniforms();
 
 public:
-	Shader(const std::string& name) : Resource(name) {}
+	Shader(const std::string& name) : Resource(name), m_Handle(0), m_Variables(ShaderVariables::NONE)
+	{
+		std::fill(std::begin(m_BuiltIns), std::end(m_BuiltIns), -1);
+	}
 	~Shader() override;
 
 	void Load(const std::filesystem::path& vertex, const std::filesystem::path& fragment);
@@ -39,8 +64,31 @@ public:
 	void Use() const;
 	void Unuse() const;
 
+	_NODISCARD uint32_t GetHandle() const;
+
 	bool HasVariable(const ShaderVariables variable) const;
 
+	/// <summary>
+	/// Gets the location of a uniform from the cache, should be stored by the callers that set it every frame
+	/// </summary>
+	/// <param name="name">Uniform</param>
+	/// <returns>Location, -1 if it doesn't exist</returns>
+	_NODISCARD int32_t GetUniformLocation(const std::string& name) const;
+
+	void SetUniform(const ShaderUniform uniform, const Vector3& value) const;
+	void SetUniform(const ShaderUniform uniform, const Vector4& value) const;
+	void SetUniform(const ShaderUniform uniform, const Matrix4x4& value) const;
+
+	void SetUniform(const int32_t location, const bool value) const;
+	void SetUniform(const int32_t location, const int32_t value) const;
+	void SetUniform(const int32_t location, const float_t value) const;
+	void SetUniform(const int32_t location, const Vector2 value) const;
+	void SetUniform(const int32_t location, const Vector3& value) const;
+	void SetUniform(const int32_t location, const Vector4& value) const;
+	void SetUniform(const int32_t location, const Matrix2x2& value) const;
+	void SetUniform(const int32_t location, const Matrix3x3& value) const;
+	void SetUniform(const int32_t location, const Matrix4x4& value) const;
+
 	void SetUniform(const std::string& name, const bool value) const;
 	void SetUniform(const std::string& name, const int32_t value) const;
 	void SetUniform(const std::string& name, const float_t value) const;
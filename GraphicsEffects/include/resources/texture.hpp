@@ -7,12 +7,22 @@ class Texture : public Resource
 private:
 	uint32_t m_Handle;
 
+	// Decoded image waiting to be uploaded
+	uint8_t* m_Data;
+	int32_t m_Width;
+	int32_t m_Height;
+	int32_t m_NbrChannels;
+
+protected:
+	void Decode() override;
+	void Upload() override;
+
 public:
-	Texture(const std::string& name) : Resource(name) {}
+	Texture(const std::string& name) : Resource(name), m_Handle(0), m_Data(nullptr), m_Width(0), m_Height(0), m_NbrChannels(0) {}
 	~Texture() override;
 
-	void Load() override;
-
 	void Use();
+
+	_NODISCARD uint32_t GetHandle() const;
 };
 
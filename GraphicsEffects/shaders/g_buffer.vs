@@ -8,14 +8,34 @@ out vec2 texCoords;
 out vec3 normal;
 out vec3 fragPos;
 
-uniform mat4 mvp;
-uniform mat4 model;
+struct Instance
+{
+    mat4 model;
+    // Inverse transpose of the model matrix
+    mat4 normal;
+    vec4 color;
+};
+
+// Written by the render queue, one element per drawn object
+layout (std430, row_major, binding = 5) readonly buffer Instances
+{
+    Instance instances[];
+};
+
+// Written by the render queue once per execution
+layout (std430, row_major, binding = 6) readonly buffer CameraBuffer
+{
+    mat4 projView;
+};
 
 void main()
 {
-    gl_Position = mvp * vec4(inPos, 1.0);
-    fragPos = vec3(model * vec4(inPos, 1.0));
+    Instance instance = instances[gl_BaseInstance + gl_InstanceID];
+    vec4 worldPos = instance.model * vec4(inPos, 1.0);
+
+    gl_Position = projView * worldPos;
+    fragPos = vec3(worldPos);
 
     texCoords = inTexCoords;
-    normal = normalize(mat3(model) * inNormal);
+    normal = normalize(mat3(instance.normal) * inNormal);
 }
@@ -7,10 +7,12 @@ uniform sampler2D gPosition;
 uniform sampler2D gNormal;
 uniform sampler2D gAlbedoSpec;
 
+// Lights are read from storage buffers, see LightBuffer, the structs follow the std430 layout of the C++ side
 struct PointLight
 {
     vec3 position;
-    
+    float radius;
+
     vec4 ambient;
     vec4 diffuse;
     vec4 specular;
@@ -18,13 +20,12 @@ struct PointLight
     float constant;
     float linear;
     float quadratic;
-    float radius;
 };
 
 struct DirLight
 {
     vec3 direction;
-    
+
     vec4 ambient;
     vec4 diffuse;
     vec4 specular;
@@ -33,31 +34,59 @@ struct DirLight
 struct SpotLight
 {
     vec3 position;
-    vec3 direction;
+    float radius;
 
+    vec3 direction;
     float cutOff;
+
     float outerCutOff;
-  
+    float constant;
+    float linear;
+    float quadratic;
+
     vec4 ambient;
     vec4 diffuse;
     vec4 specular;
-    
-    float constant;
-    float linear;
-    float quadratic; 
-    float radius;
 };
 
 uniform vec3 viewPos;
 
-uniform int nbrDirLights;
-uniform int nbrPointLights;
-uniform int nbrSpotLights;
+layout(std430, binding = 0) readonly buffer DirLightBuffer
+{
+    int nbrDirLights;
+    DirLight dirLights[];
+};
 
-uniform DirLight dirLights[3];
-uniform PointLight pointLights[100];
-uniform SpotLight spotLights[10];
+layout(std430, binding = 1) readonly buffer PointLightBuffer
+{
+    int nbrPointLights;
+    PointLight pointLights[];
+};
+
+layout(std430, binding = 2) readonly buffer SpotLightBuffer
+{
+    int nbrSpotLights;
+    SpotLight spotLights[];
+};
+
+// Lights touching each cluster of the view, see LightClusters
+layout(std430, binding = 3) readonly buffer ClusterBuffer
+{
+    // Tiles on x and y, depth slices
+    uvec4 clusterGrid;
+    // Screen size, slice scale and bias : the slice of a depth d is log(d) * scale + bias
+    vec4 clusterParams;
+    vec3 clusterFront;
+    // Offset in clusterLights, number of point lights, number of spot lights
+    uvec4 clusters[];
+};
+
+layout(std430, binding = 4) readonly buffer ClusterLightBuffer
+{
+    uint clusterLights[];
+};
 
+uvec4 GetCluster(vec3 fragPos);
 vec4 ProcessDirLight(DirLight light, vec3 normal, vec3 viewDir);
 vec4 ProcessPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir);
 vec4 ProcessSpotLight(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir);
@@ -81,16 +110,29 @@ void main()
     for (int i = 0; i < nbrDirLights; i++)
         light += ProcessDirLight(dirLights[i], normal, viewDir);
 
-    for (int i = 0; i < nbrPointLights; i++)
-        light += ProcessPointLight(pointLights[i], normal, fragPos, viewDir);
+    // Only the lights touching the cluster of the pixel are processed
+    uvec4 cluster = GetCluster(fragPos);
 
-    for (int i = 0; i < nbrSpotLights; i++)
-        light += ProcessSpotLight(spotLights[i], normal, fragPos, viewDir);
+    for (uint i = 0; i < cluster.y; i++)
+        light += ProcessPointLight(pointLights[clusterLights[cluster.x + i]], normal, fragPos, viewDir);
+
+    for (uint i = 0; i < cluster.z; i++)
+        light += ProcessSpotLight(spotLights[clusterLights[cluster.x + cluster.y + i]], normal, fragPos, viewDir);
 
     // FragColor = vec4(diffuse * light.rgb, 1.0);
     FragColor = vec4(light.rgb * diffuse, 1.0);
 }
 
+uvec4 GetCluster(vec3 fragPos)
+{
+    uvec2 tile = min(uvec2(gl_FragCoord.xy / clusterParams.xy * vec2(clusterGrid.xy)), clusterGrid.xy - 1);
+
+    float depth = max(dot(fragPos - viewPos, clusterFront), 1e-4);
+    uint slice = uint(clamp(log(depth) * clusterParams.z + clusterParams.w, 0.0, float(clusterGrid.z - 1)));
+
+    return clusters[(slice * clusterGrid.y + tile.y) * clusterGrid.x + tile.x];
+}
+
 vec4 ProcessDirLight(DirLight light, vec3 normal, vec3 viewDir)
 {
     
@@ -117,6 +159,10 @@ vec4 ProcessDirLight(DirLight light, vec3 normal, vec3 viewDir)
 
 vec4 ProcessPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir)
 {
+    // A light without radius lights nothing, distance / radius would be NaN
+    if (light.radius <= 0.0)
+        return vec4(0.0);
+
     // calculate distance between light source and current fragment
     // Get light direction
     vec3 lightDir = normalize(light.position - fragPos);
@@ -146,6 +192,10 @@ vec4 ProcessPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir
     vec4 diffuse = light.diffuse * diff;
     vec4 specular = light.specular * spec;
 
+    // Fade out to 0 at the radius, the lights are culled past it
+    float window = clamp(1.0 - pow(distance / light.radius, 4.0), 0.0, 1.0);
+    attenuation *= window * window;
+
     // Apply attenuation
     ambient *= attenuation;
     diffuse *= attenuation;
@@ -157,6 +207,10 @@ vec4 ProcessPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir
 
 vec4 ProcessSpotLight(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir)
 {
+    // A light without radius lights nothing, distance / radius would be NaN
+    if (light.radius <= 0.0)
+        return vec4(0.0);
+
     // Get light direction
     vec3 lightDir = normalize(light.position - fragPos);
 
@@ -191,6 +245,10 @@ vec4 ProcessSpotLight(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir)
     vec4 diffuse = light.diffuse * diff;
     vec4 specular = light.specular * spec;
 
+    // Fade out to 0 at the radius, the lights are culled past it
+    float window = clamp(1.0 - pow(distance / light.radius, 4.0), 0.0, 1.0);
+    attenuation *= window * window;
+
     // Apply attenuation
     ambient *= attenuation * intensity;
     diffuse *= attenuation * intensity;
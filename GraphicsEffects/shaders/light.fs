@@ -1,9 +1,9 @@
 #version 460 core
 layout (location = 0) out vec4 FragColor;
 
-uniform vec4 lightColor;
+in vec4 color;
 
 void main()
 {           
-    FragColor = vec4(lightColor.rgb, 1.0);
+    FragColor = vec4(color.rgb, 1.0);
 }
\ No newline at end of file
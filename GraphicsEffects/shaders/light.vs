@@ -3,10 +3,32 @@ layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec2 aTexCoords;
 
-uniform mat4 mvp;
-uniform mat4 model;
+out vec4 color;
+
+struct Instance
+{
+    mat4 model;
+    // Inverse transpose of the model matrix
+    mat4 normal;
+    vec4 color;
+};
+
+// Written by the render queue, one element per drawn object
+layout (std430, row_major, binding = 5) readonly buffer Instances
+{
+    Instance instances[];
+};
+
+// Written by the render queue once per execution
+layout (std430, row_major, binding = 6) readonly buffer CameraBuffer
+{
+    mat4 projView;
+};
 
 void main()
 {
-    gl_Position = mvp * vec4(aPos, 1.0);
-}
\ No newline at end of file
+    Instance instance = instances[gl_BaseInstance + gl_InstanceID];
+
+    gl_Position = projView * instance.model * vec4(aPos, 1.0);
+    color = instance.color;
+}
@@ -6,18 +6,25 @@
 #include "resources/model.hpp"
 #include "resources/shader.hpp"
 #include "resources/texture.hpp"
+#include "resources/resource_manager.hpp"
 
 #include "renderer/camera.hpp"
 #include "renderer/g_buffer.hpp"
+#include "renderer/render_queue.hpp"
+#include "renderer/geometry_arena.hpp"
+#include "renderer/frame_ring.hpp"
 
 #include "core/object.hpp"
 #include "core/scene.hpp"
+#include "core/benchmark.hpp"
+#include "core/thread_pool.hpp"
 
 #include "core/debug/assert.hpp"
 #include "core/debug/log.hpp"
 #include "core/debug/file_logger.hpp"
 #include "core/debug/console_logger.hpp"
 #include "core/debug/fatal_logger.hpp"
+#include "core/debug/profiler.hpp"
 
 #include "core/engine_ui.hpp"
 
@@ -33,6 +40,8 @@ bool Application::m_LookingWithCamera;
 
 GLFWwindow* Application::m_Window;
 float Application::m_DeltaTime;
+Benchmark* Application::m_Benchmark;
+ThreadPool* Application::m_ThreadPool;
 ShaderStatus Application::m_shaderStatus;
 
 void Application::ResizeCallback(GLFWwindow* window, int32_t width, int32_t height)
@@ -139,13 +148,25 @@ void Application::PreLoop()
     ImGui_ImplOpenGL3_NewFrame();
     ImGui_ImplGlfw_NewFrame();
     ImGui::NewFrame();
+
+    // Upload the resources that finished loading in the background
+    {
+        ProfileScope scope("Resource uploads");
+        ResourceManager::ProcessUploads(2.f);
+    }
+
+    Transform::ResetRecomputedCount();
 }
 
 void Application::PostLoop()
 {
-    ImGui::Render();
+    {
+        ProfileScope scope("ImGui");
+        GpuProfileScope gpuScope("ImGui");
 
-    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        ImGui::Render();
+        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    }
 
     GLFWwindow* ctxBackup = glfwGetCurrentContext();
     ImGui::UpdatePlatformWindows();
@@ -153,11 +174,13 @@ void Application::PostLoop()
     glfwMakeContextCurrent(ctxBackup);
 
     glfwPollEvents();
+
+    ProfileScope scope("Swap buffers");
     glfwSwapBuffers(m_Window);
 }
 
 
-void Application::Init()
+void Application::Init(const BenchmarkSettings* const benchmark)
 {
     m_shaderStatus = DEFFERED;
 
@@ -177,7 +200,26 @@ void Application::Init()
 
     glfwSetErrorCallback(ErrorCallback);
 
-    m_Window = glfwCreateWindow(800, 600, "ModernGl", nullptr, nullptr);
+    int32_t width = 800;
+    int32_t height = 600;
+
+    if (benchmark != nullptr)
+    {
+        m_Benchmark = new Benchmark(*benchmark);
+
+        width = static_cast<int32_t>(benchmark->Width);
+        height = static_cast<int32_t>(benchmark->Height);
+
+        // Nothing is shown, the frames are rendered to the back buffer of the hidden window
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+        if (benchmark->Context == BenchmarkContext::EGL)
+            glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_EGL_CONTEXT_API);
+        else if (benchmark->Context == BenchmarkContext::OSMESA)
+            glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+    }
+
+    m_Window = glfwCreateWindow(width, height, "ModernGl", nullptr, nullptr);
     if (m_Window == nullptr)
     {
         glfwTerminate();
@@ -192,10 +234,14 @@ void Application::Init()
 
     gladLoadGL();
 
-    glfwSwapInterval(1); // Enable vsync
+    // Benchmarks render as fast as possible
+    glfwSwapInterval(m_Benchmark != nullptr ? 0 : 1);
 
     SetupImgui();
 
+    m_ThreadPool = new ThreadPool();
+    ResourceManager::Init(m_ThreadPool);
+
     glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
     glEnable(GL_DEPTH_TEST);
     glDepthFunc(GL_LESS);
@@ -211,20 +257,23 @@ void Application::Init()
         }, nullptr);
 }
 
-void Application::MainLoop()
+bool Application::MainLoop()
 {
-    constexpr size_t nbrBalls = 9;
-    constexpr size_t nbrLights = 100;
-
-    Scene scene("Test scene");
-    Texture* const tex = new Texture("assets/textures/all_bald.png");
-    tex->Load();
-
-    Model* const sphere = new Model("assets/models/sphere.obj");
-    sphere->Load();
-
-    Model* const cube = new Model("assets/models/cube.obj");
-    cube->Load();
+    const size_t nbrBalls = m_Benchmark != nullptr ? m_Benchmark->GetSettings().ObjectCount : 9;
+    const size_t nbrLights = m_Benchmark != nullptr ? m_Benchmark->GetSettings().LightCount : 100;
+    // Benchmark scenes are spread in a larger cube as they grow, so their density stays the same
+    const float spread = m_Benchmark != nullptr ? m_Benchmark->GetSceneExtent() / 3.f : 1.f;
+
+    // Must exist before the models are uploaded so they are placed in it
+    GeometryArena arena(1 << 20, 1 << 22);
+    // Per frame data of the render queues and the light clusters
+    FrameRing frameRing(std::max<size_t>(8 << 20, (nbrBalls + nbrLights) * sizeof(InstanceData) + (1 << 20)));
+
+    Scene scene("Test scene", m_ThreadPool);
+    // Objects are displayed as soon as their resources are uploaded
+    Texture* const tex = ResourceManager::LoadAsync<Texture>("assets/textures/all_bald.png");
+    Model* const sphere = ResourceManager::LoadAsync<Model>("assets/models/sphere.obj");
+    Model* const cube = ResourceManager::LoadAsync<Model>("assets/models/cube.obj");
 
     Shader* const gBufferShader = new Shader("g_buffer");
     gBufferShader->Load("shaders/g_buffer.vs", "shaders/g_buffer.fs");
@@ -245,7 +294,8 @@ void Application::MainLoop()
     std::vector<Object*> lights;
     std::vector<PointLight*> pointLights;
     
-    srand(time(NULL));
+    // Benchmarks always draw the same scene
+    srand(m_Benchmark != nullptr ? 0 : static_cast<uint32_t>(time(NULL)));
     for (size_t i = 0; i < nbrBalls; i++)
     {
         float xPos = static_cast<float>(((rand() % 100) / 100.0) * 6.0 - 3.0);
@@ -253,11 +303,15 @@ void Application::MainLoop()
         float zPos = static_cast<float>(((rand() % 100) / 100.0) * 6.0 - 3.0);
 
         float scale = static_cast<float>(((rand() % 100) / 200.0f) + 0.1);
-        balls.push_back(new Object(gBufferShader, sphere, tex, Vector4(1.f, 1.f, 1.f, 1.0f), Vector3(xPos, yPos, zPos), Vector3(0.f), Vector3(scale)));
+        balls.push_back(new Object(gBufferShader, sphere, tex, Vector4(1.f, 1.f, 1.f, 1.0f), Vector3(xPos, yPos, zPos) * spread, Quaternion::Identity, Vector3(scale)));
         balls[i]->Name = std::string("Ball ") + std::to_string(i);
         scene.AddObject(*balls[i]);
     }
 
+    // Lights are cut off at their radius, put it where their falloff becomes negligible so it doesn't darken the scene
+    const float linearAtt = 2.f, quadAtt = 1.f;
+    const float lightRadius = Light::GetRange(linearAtt, quadAtt);
+
     for (size_t i = 0; i < nbrLights; i++)
     {
         float xPos = static_cast<float>(((rand() % 100) / 100.0) * 6.0 - 3.0);
@@ -269,24 +323,39 @@ void Application::MainLoop()
         float bColor = static_cast<float>(((rand() % 100) / 100.0f)); // between 0.5 and 1.)
         Vector4 color = Vector4(rColor, gColor, bColor, 1.f);
 
-        lights.push_back(new Object(lightShader, cube, tex, Vector4(0), Vector3(xPos, yPos, zPos), Vector3(0.f), Vector3(0.1f)));
+        lights.push_back(new Object(lightShader, cube, tex, Vector4(0), Vector3(xPos, yPos, zPos) * spread, Quaternion::Identity, Vector3(0.1f)));
         lights[i]->Name = std::string("Light ") + std::to_string(i);
-        pointLights.push_back(new PointLight(lights[i], color, color, color, 1.0f, 1.f, 2.f, 1.f));
+        pointLights.push_back(new PointLight(lights[i], color, color, color, lightRadius, 1.f, linearAtt, quadAtt));
         lights[i]->AddComponent(pointLights[i]);
     }
 
     Camera camera(M_PI / 2.f, Vector2(800, 600), 0.1f, 100.f, Vector3(0.f, 0.f, 5.f), Vector3(0.f, 0.f, 0.f));
 
+    if (m_Benchmark != nullptr)
+    {
+        const BenchmarkSettings& settings = m_Benchmark->GetSettings();
+
+        camera.ScreenSize = Vector2(static_cast<float>(settings.Width), static_cast<float>(settings.Height));
+        camera.DepthFar = std::max(camera.DepthFar, 4.f * m_Benchmark->GetSceneExtent());
+    }
+
     GBuffer gBuffer;
     gBuffer.AddTarget(RenderTarget("Position pass", false, Vector4(0.f), GL_RGBA16F, GL_RGBA, GL_FLOAT));
     gBuffer.AddTarget(RenderTarget("Normal pass", false, Vector4(0.f), GL_RGBA16F, GL_RGBA, GL_FLOAT));
     gBuffer.AddTarget(RenderTarget("Specular pass", false, Vector4(0.f), GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE));
     gBuffer.FinishInit();
 
+    // The light cubes are drawn after the lighting pass, on top of the scene, there are few enough to pack them on the main thread
+    RenderQueue lightQueue;
+
     float lastFrame = 0.f;
     float time = 0.f;
 
     int toonColorLevel = 1;
+    bool success = true;
+
+    // The editor UI isn't part of what a benchmark measures, building it would add its cost and noise to every frame
+    const bool drawUi = m_Benchmark == nullptr;
 
     while (!glfwWindowShouldClose(m_Window))
     {
@@ -294,8 +363,31 @@ void Application::MainLoop()
         m_DeltaTime = currentFrame - lastFrame;
         lastFrame = currentFrame;
 
+        // A resource that failed to load never becomes ready, the benchmark would wait for it forever
+        if (m_Benchmark != nullptr && (tex->IsFailed() || sphere->IsFailed() || cube->IsFailed()))
+        {
+            Log::LogError("A resource of the benchmark scene couldn't be loaded, aborting the benchmark");
+            success = false;
+            break;
+        }
+
+        Profiler::BeginFrame();
+
+        if (m_Benchmark != nullptr)
+        {
+            // The camera follows the path from the first frame whose resources are all loaded
+            m_Benchmark->BeginFrame(Profiler::GetFrameIndex(), tex->IsLoaded() && sphere->IsLoaded() && cube->IsLoaded());
+
+            Vector3 target;
+            m_Benchmark->GetCameraPose(camera.Position, target);
+            camera.LookAt(target);
+        }
+
         PreLoop();
-        ProcessInput();
+        frameRing.BeginFrame();
+
+        if (m_Benchmark == nullptr)
+            ProcessInput();
 
         gBuffer.Begin();
 
@@ -303,16 +395,24 @@ void Application::MainLoop()
 
         const char* items[] = { "DEFFERED", "GOOCHED", "TOONED" };
 
-        ImGui::Combo("Render status", (int*)&m_shaderStatus, items, IM_ARRAYSIZE(items));
+        if (drawUi)
+            ImGui::Combo("Render status", (int*)&m_shaderStatus, items, IM_ARRAYSIZE(items));
 
         camera.Update();
 
-        scene.Update();
+        {
+            ProfileScope scope("Scene");
+            GpuProfileScope gpuScope("G-buffer fill");
+            scene.Update();
+        }
+
         Shader* usedShader = deferredShader;
 
         if (m_shaderStatus == TOONED)
         {
-            ImGui::SliderInt("toon color level", &toonColorLevel, 1, 100);
+            if (drawUi)
+                ImGui::SliderInt("toon color level", &toonColorLevel, 1, 100);
+
             toonShader->SetUniform("toon_color_levels", toonColorLevel);
             usedShader = toonShader;
         }
@@ -332,13 +432,19 @@ void Application::MainLoop()
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
         usedShader->Use();
         camera.SendToShader(*usedShader);
-        scene.ApplyLights(*usedShader);
-        glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-        gBuffer.BindTextures();
-        usedShader->Use();
-        gBuffer.RenderQuad();
-        gBuffer.End();
+
+        {
+            ProfileScope scope("Lighting");
+            GpuProfileScope gpuScope("Lighting quad");
+
+            scene.ApplyLights(camera);
+            glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            gBuffer.BindTextures();
+            usedShader->Use();
+            gBuffer.RenderQuad();
+            gBuffer.End();
+        }
 
         glBindFramebuffer(GL_READ_FRAMEBUFFER, gBuffer.GetFbo());
         glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0); // write to default framebuffer
@@ -347,19 +453,50 @@ void Application::MainLoop()
         );
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
-        for (size_t i = 0; i < nbrLights; i++)
         {
-            lights[i]->GetShader().SetUniform("lightColor", pointLights[i]->Diffuse);
-            lights[i]->Render();
+            ProfileScope scope("Light cubes");
+            GpuProfileScope gpuScope("Light cubes");
+
+            lightQueue.Clear();
+
+            for (size_t i = 0; i < nbrLights; i++)
+            {
+                // The light cubes aren't part of the scene hierarchy, so their matrices aren't batched,
+                // this does nothing as long as they don't move
+                lights[i]->Transformation.UpdateTransformation();
+                lights[i]->Color = pointLights[i]->Diffuse;
+
+                if (!lights[i]->IsHidden() && lights[i]->GetModel().IsLoaded())
+                    lightQueue.Submit(*lights[i], 0.f);
+            }
+
+            lightQueue.Sort();
+            lightQueue.Execute(camera);
         }
 
-        EngineUi::DrawSceneGraph(scene);
+        if (drawUi)
+        {
+            EngineUi::DrawSceneGraph(scene);
+            EngineUi::DrawProfiler();
+        }
 
+        frameRing.EndFrame();
         PostLoop();
+
+        Profiler::EndFrame();
+
+        if (m_Benchmark != nullptr)
+        {
+            m_Benchmark->Collect();
+
+            if (m_Benchmark->IsDone())
+                break;
+        }
     }
 
-    delete tex;
-    delete sphere;
+    if (m_Benchmark != nullptr && success)
+        success = m_Benchmark->Finish(reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+
     delete gBufferShader;
     delete deferredShader;
     delete toonShader;
@@ -370,6 +507,8 @@ void Application::MainLoop()
 
     for (size_t i = 0; i < nbrLights; i++)
         delete lights[i];
+
+    return success;
 }
 
 void Application::Shutdown()
@@ -378,6 +517,16 @@ void Application::Shutdown()
     ImGui_ImplGlfw_Shutdown();
     ImGui::DestroyContext();
 
+    // Join the workers first so that no resource is deleted while being decoded
+    delete m_ThreadPool;
+    m_ThreadPool = nullptr;
+
+    ResourceManager::Shutdown();
+    Profiler::Shutdown();
+
+    delete m_Benchmark;
+    m_Benchmark = nullptr;
+
     glfwTerminate();
     Log::Stop();
 }
@@ -0,0 +1,265 @@
+#include "core/benchmark.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <numbers>
+#include <unordered_map>
+
+#include "core/debug/log.hpp"
+
+/// <summary>
+/// Writes the statistics of samples as a JSON object
+/// </summary>
+static void WriteStats(std::ofstream& file, std::vector<float>& values)
+{
+	float total = 0.f;
+
+	for (const float value : values)
+		total += value;
+
+	const float mean = values.empty() ? 0.f : total / static_cast<float>(values.size());
+
+	file << "{\"samples\":" << values.size() << ",\"mean\":" << mean
+		<< ",\"p50\":" << Benchmark::Percentile(values, 50.f)
+		<< ",\"p95\":" << Benchmark::Percentile(values, 95.f)
+		<< ",\"p99\":" << Benchmark::Percentile(values, 99.f)
+		<< ",\"max\":" << (values.empty() ? 0.f : values.back()) << "}";
+}
+
+/// <summary>
+/// Writes timings by name as a JSON object
+/// </summary>
+static void WriteTimings(std::ofstream& file, std::map<std::string, std::vector<float>>& timings)
+{
+	file << "{";
+
+	for (auto it = timings.begin(); it != timings.end(); it++)
+	{
+		file << (it == timings.begin() ? "\n" : ",\n") << "    \"" << it->first << "\": ";
+		WriteStats(file, it->second);
+	}
+
+	file << "\n  }";
+}
+
+bool BenchmarkSettings::Parse(const int argc, const char* const* const argv, BenchmarkSettings& settings)
+{
+	bool benchmark = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const char* const option = argv[i];
+
+		if (std::strcmp(option, "--benchmark") == 0)
+		{
+			benchmark = true;
+			continue;
+		}
+
+		if (i + 1 >= argc)
+		{
+			Log::Warning("Command line option {} has no value", option);
+			break;
+		}
+
+		const char* const value = argv[++i];
+		const uint32_t number = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+
+		if (std::strcmp(option, "--frames") == 0)
+			settings.FrameCount = std::max(number, 1u);
+		else if (std::strcmp(option, "--warmup") == 0)
+			settings.WarmupFrames = number;
+		else if (std::strcmp(option, "--objects") == 0)
+			settings.ObjectCount = number;
+		else if (std::strcmp(option, "--lights") == 0)
+			settings.LightCount = number;
+		else if (std::strcmp(option, "--width") == 0)
+			settings.Width = std::max(number, 1u);
+		else if (std::strcmp(option, "--height") == 0)
+			settings.Height = std::max(number, 1u);
+		else if (std::strcmp(option, "--output") == 0)
+			settings.OutputPath = value;
+		else if (std::strcmp(option, "--context") == 0 && std::strcmp(value, "native") == 0)
+			settings.Context = BenchmarkContext::NATIVE;
+		else if (std::strcmp(option, "--context") == 0 && std::strcmp(value, "egl") == 0)
+			settings.Context = BenchmarkContext::EGL;
+		else if (std::strcmp(option, "--context") == 0 && std::strcmp(value, "osmesa") == 0)
+			settings.Context = BenchmarkContext::OSMESA;
+		else
+			Log::Warning("Unknown command line option {} {}", option, value);
+	}
+
+	return benchmark;
+}
+
+Benchmark::Benchmark(const BenchmarkSettings& settings)
+	: m_Settings(settings), m_Started(false), m_FirstFrame(0), m_Frame(0), m_NextRecorded(0)
+{
+	m_FrameTimes.reserve(settings.FrameCount);
+}
+
+float Benchmark::Percentile(std::vector<float>& values, const float percentile)
+{
+	if (values.empty())
+		return 0.f;
+
+	std::sort(values.begin(), values.end());
+
+	const float rank = std::ceil(percentile / 100.f * static_cast<float>(values.size()));
+	const size_t index = static_cast<size_t>(std::clamp(rank, 1.f, static_cast<float>(values.size()))) - 1;
+
+	return values[index];
+}
+
+void Benchmark::BeginFrame(const uint64_t frameIndex, const bool ready)
+{
+	if (!m_Started)
+	{
+		if (!ready)
+			return;
+
+		m_Started = true;
+		m_FirstFrame = frameIndex + m_Settings.WarmupFrames;
+	}
+
+	m_Frame = frameIndex;
+}
+
+void Benchmark::Record(const ProfileFrame& frame)
+{
+	if (!m_Started || frame.Index < m_FirstFrame || frame.Index >= m_FirstFrame + m_Settings.FrameCount)
+		return;
+
+	constexpr float nsToMs = 1e-6f;
+
+	m_FrameTimes.push_back((frame.End - frame.Start) * nsToMs);
+
+	// Scopes recorded several times in a frame, e.g. by every worker, are summed
+	std::unordered_map<const char*, float> cpuTimes;
+	std::unordered_map<const char*, float> gpuTimes;
+
+	for (const ProfileEvent& event : frame.Events)
+		cpuTimes[event.Name] += (event.End - event.Start) * nsToMs;
+
+	for (const GpuTiming& timing : frame.Gpu)
+		gpuTimes[timing.Name] += timing.Duration * nsToMs;
+
+	for (const auto& [name, time] : cpuTimes)
+		m_CpuTimes[name].push_back(time);
+
+	for (const auto& [name, time] : gpuTimes)
+		m_GpuTimes[name].push_back(time);
+}
+
+void Benchmark::Collect()
+{
+	const uint32_t count = Profiler::GetFrameCount();
+
+	// Oldest frame first, only the one about to be replaced has to be recorded now
+	for (uint32_t age = count; age-- > 0;)
+	{
+		if (age + 1 < Profiler::HistorySize)
+			break;
+
+		const ProfileFrame& frame = Profiler::GetFrame(age);
+
+		if (frame.Index < m_NextRecorded)
+			continue;
+
+		Record(frame);
+		m_NextRecorded = frame.Index + 1;
+	}
+}
+
+bool Benchmark::IsDone() const
+{
+	return m_Started && m_Frame + 1 >= m_FirstFrame + m_Settings.FrameCount;
+}
+
+float Benchmark::GetSceneExtent() const
+{
+	// The interactive scene has 9 objects in a cube of half size 3
+	return 3.f * std::max(1.f, std::cbrt(static_cast<float>(m_Settings.ObjectCount) / 9.f));
+}
+
+void Benchmark::GetCameraPose(Vector3& position, Vector3& target) const
+{
+	const uint64_t start = m_FirstFrame - m_Settings.WarmupFrames;
+	const uint64_t length = static_cast<uint64_t>(m_Settings.WarmupFrames) + m_Settings.FrameCount;
+	const float t = m_Started ? static_cast<float>(m_Frame - start) / static_cast<float>(length) : 0.f;
+
+	const float extent = GetSceneExtent();
+	const float angle = 2.f * std::numbers::pi_v<float> * t;
+
+	// Inside the scene for half the orbit so both dense and sparse views are measured
+	const float radius = extent * (1.f + 0.6f * std::cos(angle));
+
+	position = Vector3(radius * std::cos(angle), extent * 0.5f * std::sin(2.f * angle), radius * std::sin(angle));
+	target = Vector3(0.f, 0.f, 0.f);
+}
+
+bool Benchmark::Finish(const std::string& renderer)
+{
+	const uint32_t count = Profiler::GetFrameCount();
+
+	for (uint32_t age = count; age-- > 0;)
+	{
+		const ProfileFrame& frame = Profiler::GetFrame(age);
+
+		if (frame.Index >= m_NextRecorded)
+		{
+			Record(frame);
+			m_NextRecorded = frame.Index + 1;
+		}
+	}
+
+	std::ofstream file(m_Settings.OutputPath);
+
+	if (!file)
+	{
+		Log::Warning("Couldn't open {} to write the benchmark results", m_Settings.OutputPath.string());
+		return false;
+	}
+
+	std::string escapedRenderer;
+
+	for (const char c : renderer)
+	{
+		if (c == '"' || c == '\\')
+			escapedRenderer.push_back('\\');
+
+		escapedRenderer.push_back(c);
+	}
+
+	file << std::fixed;
+	file.precision(4);
+
+	file << "{\n  \"renderer\": \"" << escapedRenderer << "\",\n"
+		<< "  \"frames\": " << m_Settings.FrameCount << ",\n"
+		<< "  \"warmup_frames\": " << m_Settings.WarmupFrames << ",\n"
+		<< "  \"objects\": " << m_Settings.ObjectCount << ",\n"
+		<< "  \"lights\": " << m_Settings.LightCount << ",\n"
+		<< "  \"width\": " << m_Settings.Width << ",\n"
+		<< "  \"height\": " << m_Settings.Height << ",\n"
+		<< "  \"frame_ms\": ";
+	WriteStats(file, m_FrameTimes);
+
+	file << ",\n  \"cpu_ms\": ";
+	WriteTimings(file, m_CpuTimes);
+
+	file << ",\n  \"gpu_ms\": ";
+	WriteTimings(file, m_GpuTimes);
+
+	file << "\n}\n";
+
+	Log::Info("Benchmark of {} frames written to {}", m_FrameTimes.size(), m_Settings.OutputPath.string());
+
+	return file.good();
+}
+
+const BenchmarkSettings& Benchmark::GetSettings() const
+{
+	return m_Settings;
+}
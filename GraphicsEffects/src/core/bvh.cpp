@@ -0,0 +1,529 @@
+#include "core/bvh.hpp"
+
+#include <algorithm>
+#include <cfloat>
+
+#include "core/debug/assert.hpp"
+
+// Grows from the first box added to it
+static const BoundingBox EmptyBox{ Vector3(FLT_MAX), Vector3(-FLT_MAX) };
+
+// The helpers below are called for every primitive of every level while building,
+// they work on the components directly so they stay inlined
+
+static void Grow(BoundingBox& box, const BoundingBox& other)
+{
+	box.Min.x = std::min(box.Min.x, other.Min.x);
+	box.Min.y = std::min(box.Min.y, other.Min.y);
+	box.Min.z = std::min(box.Min.z, other.Min.z);
+	box.Max.x = std::max(box.Max.x, other.Max.x);
+	box.Max.y = std::max(box.Max.y, other.Max.y);
+	box.Max.z = std::max(box.Max.z, other.Max.z);
+}
+
+static void Grow(BoundingBox& box, const Vector3& point)
+{
+	box.Min.x = std::min(box.Min.x, point.x);
+	box.Min.y = std::min(box.Min.y, point.y);
+	box.Min.z = std::min(box.Min.z, point.z);
+	box.Max.x = std::max(box.Max.x, point.x);
+	box.Max.y = std::max(box.Max.y, point.y);
+	box.Max.z = std::max(box.Max.z, point.z);
+}
+
+static float Component(const Vector3& v, const int32_t axis)
+{
+	return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+}
+
+// Half of the surface area, the heuristic only compares ratios
+static float Area(const BoundingBox& box)
+{
+	const float x = box.Max.x - box.Min.x;
+	const float y = box.Max.y - box.Min.y;
+	const float z = box.Max.z - box.Min.z;
+
+	if (x < 0.f || y < 0.f || z < 0.f)
+		return 0.f;
+
+	return x * y + y * z + z * x;
+}
+
+static bool Intersects(const BoundingBox& box, const BoundingSphere& sphere)
+{
+	const Vector3& c = sphere.Center;
+
+	// Distance from the center to the closest point of the box
+	const float dx = std::max({ box.Min.x - c.x, 0.f, c.x - box.Max.x });
+	const float dy = std::max({ box.Min.y - c.y, 0.f, c.y - box.Max.y });
+	const float dz = std::max({ box.Min.z - c.z, 0.f, c.z - box.Max.z });
+
+	return dx * dx + dy * dy + dz * dz <= sphere.Radius * sphere.Radius;
+}
+
+// Slab test, gives the distance at which the ray enters the box
+static bool Intersects(const BoundingBox& box, const Vector3& origin, const Vector3& invDirection, const float maxDistance, float& entry)
+{
+	const float x0 = (box.Min.x - origin.x) * invDirection.x;
+	const float x1 = (box.Max.x - origin.x) * invDirection.x;
+	const float y0 = (box.Min.y - origin.y) * invDirection.y;
+	const float y1 = (box.Max.y - origin.y) * invDirection.y;
+	const float z0 = (box.Min.z - origin.z) * invDirection.z;
+	const float z1 = (box.Max.z - origin.z) * invDirection.z;
+
+	const float tNear = std::max({ std::min(x0, x1), std::min(y0, y1), std::min(z0, z1), 0.f });
+	const float tFar = std::min({ std::max(x0, x1), std::max(y0, y1), std::max(z0, z1), maxDistance });
+
+	entry = tNear;
+	return tNear <= tFar;
+}
+
+Bvh::Bvh()
+	: m_NeedsRebuild(false), m_BuiltCost(0.f)
+{
+}
+
+uint32_t Bvh::Insert(const BoundingBox& bounds)
+{
+	uint32_t proxy;
+
+	if (m_FreeProxies.empty())
+	{
+		proxy = static_cast<uint32_t>(m_Proxies.size());
+		m_Proxies.emplace_back();
+	}
+	else
+	{
+		proxy = m_FreeProxies.back();
+		m_FreeProxies.pop_back();
+	}
+
+	m_Proxies[proxy] = Proxy{ bounds, Null, true };
+	m_NeedsRebuild = true;
+
+	return proxy;
+}
+
+void Bvh::Remove(const uint32_t proxy)
+{
+	Assert::IsTrue(proxy < m_Proxies.size() && m_Proxies[proxy].Alive, "Invalid BVH proxy");
+
+	m_Proxies[proxy].Alive = false;
+	m_FreeProxies.push_back(proxy);
+	m_NeedsRebuild = true;
+}
+
+void Bvh::Move(const uint32_t proxy, const BoundingBox& bounds)
+{
+	Assert::IsTrue(proxy < m_Proxies.size() && m_Proxies[proxy].Alive, "Invalid BVH proxy");
+
+	m_Proxies[proxy].Bounds = bounds;
+
+	// A rebuild reads the new bounds anyway
+	if (!m_NeedsRebuild)
+		m_Moved.push_back(proxy);
+}
+
+void Bvh::Clear()
+{
+	m_Proxies.clear();
+	m_FreeProxies.clear();
+	m_Nodes.clear();
+	m_Primitives.clear();
+	m_Moved.clear();
+	m_NeedsRebuild = false;
+	m_BuiltCost = 0.f;
+}
+
+void Bvh::Update()
+{
+	if (m_NeedsRebuild)
+	{
+		Build();
+		return;
+	}
+
+	if (m_Moved.empty())
+		return;
+
+	Refit();
+
+	// Refitting keeps the topology, which gets worse as the proxies move away from where they were when it was built
+	if (ComputeCost() > m_BuiltCost * RebuildRatio)
+		Build();
+}
+
+void Bvh::Build()
+{
+	m_Nodes.clear();
+	m_Primitives.clear();
+	m_Moved.clear();
+	m_NeedsRebuild = false;
+
+	m_Centroids.resize(m_Proxies.size());
+
+	for (uint32_t i = 0; i < m_Proxies.size(); i++)
+	{
+		Proxy& proxy = m_Proxies[i];
+
+		if (!proxy.Alive)
+			continue;
+
+		m_Primitives.push_back(i);
+		m_Centroids[i] = (proxy.Bounds.Min + proxy.Bounds.Max) * .5f;
+	}
+
+	const uint32_t count = static_cast<uint32_t>(m_Primitives.size());
+
+	if (count == 0)
+	{
+		m_BuiltCost = 0.f;
+		return;
+	}
+
+	// A binary tree with at least one primitive per leaf can't have more nodes, so the references stay valid while splitting
+	m_Nodes.reserve(2 * static_cast<size_t>(count) - 1);
+	m_Nodes.push_back(Node{ EmptyBox, Null, 0, count });
+
+	m_Stack.clear();
+	m_Stack.push_back(0);
+
+	while (!m_Stack.empty())
+	{
+		const uint32_t node = m_Stack.back();
+		m_Stack.pop_back();
+
+		Split(node);
+	}
+
+	m_BuiltCost = ComputeCost();
+}
+
+void Bvh::Split(const uint32_t index)
+{
+	Node& node = m_Nodes[index];
+	const uint32_t first = node.First;
+	const uint32_t count = node.Count;
+
+	BoundingBox centroidBounds = EmptyBox;
+	node.Bounds = EmptyBox;
+
+	for (uint32_t i = first; i < first + count; i++)
+	{
+		const uint32_t proxy = m_Primitives[i];
+
+		Grow(node.Bounds, m_Proxies[proxy].Bounds);
+		Grow(centroidBounds, m_Centroids[proxy]);
+	}
+
+	// Find the cheapest split plane on the bin boundaries of every axis
+	int32_t bestAxis = -1;
+	uint32_t bestBin = 0;
+	float bestCost = FLT_MAX;
+
+	if (count > 1)
+	{
+		for (int32_t axis = 0; axis < 3; axis++)
+		{
+			const float min = Component(centroidBounds.Min, axis);
+			const float extent = Component(centroidBounds.Max, axis) - min;
+
+			if (extent <= 0.f)
+				continue;
+
+			const float scale = BinCount / extent;
+
+			BoundingBox binBounds[BinCount];
+			uint32_t binCounts[BinCount] = {};
+
+			for (uint32_t b = 0; b < BinCount; b++)
+				binBounds[b] = EmptyBox;
+
+			for (uint32_t i = first; i < first + count; i++)
+			{
+				const uint32_t proxy = m_Primitives[i];
+				const uint32_t bin = std::min(BinCount - 1, static_cast<uint32_t>((Component(m_Centroids[proxy], axis) - min) * scale));
+
+				binCounts[bin]++;
+				Grow(binBounds[bin], m_Proxies[proxy].Bounds);
+			}
+
+			// Sweep from the right to get the area and count on the right of each plane
+			float rightAreas[BinCount - 1];
+			uint32_t rightCounts[BinCount - 1];
+			BoundingBox right = EmptyBox;
+			uint32_t rightCount = 0;
+
+			for (uint32_t b = BinCount - 1; b > 0; b--)
+			{
+				Grow(right, binBounds[b]);
+				rightCount += binCounts[b];
+
+				rightAreas[b - 1] = Area(right);
+				rightCounts[b - 1] = rightCount;
+			}
+
+			BoundingBox left = EmptyBox;
+			uint32_t leftCount = 0;
+
+			for (uint32_t b = 0; b < BinCount - 1; b++)
+			{
+				Grow(left, binBounds[b]);
+				leftCount += binCounts[b];
+
+				if (leftCount == 0 || rightCounts[b] == 0)
+					continue;
+
+				const float cost = Area(left) * leftCount + rightAreas[b] * rightCounts[b];
+
+				if (cost < bestCost)
+				{
+					bestCost = cost;
+					bestAxis = axis;
+					bestBin = b;
+				}
+			}
+		}
+	}
+
+	// Traversing a node costs as much as testing a primitive
+	const float area = Area(node.Bounds);
+	const float leafCost = static_cast<float>(count);
+	const float splitCost = area > 0.f ? 1.f + bestCost / area : 1.f;
+
+	if (count == 1 || (count <= MaxLeafSize && (bestAxis < 0 || splitCost >= leafCost)))
+	{
+		for (uint32_t i = first; i < first + count; i++)
+			m_Proxies[m_Primitives[i]].Leaf = index;
+
+		return;
+	}
+
+	uint32_t* const begin = m_Primitives.data() + first;
+	uint32_t* const end = begin + count;
+	uint32_t* middle;
+
+	if (bestAxis >= 0)
+	{
+		const float min = Component(centroidBounds.Min, bestAxis);
+		const float scale = BinCount / (Component(centroidBounds.Max, bestAxis) - min);
+
+		middle = std::partition(begin, end, [&](const uint32_t proxy)
+			{
+				return std::min(BinCount - 1, static_cast<uint32_t>((Component(m_Centroids[proxy], bestAxis) - min) * scale)) <= bestBin;
+			});
+	}
+	else
+	{
+		// Every center is at the same place, any split is as good as another
+		middle = begin + count / 2;
+	}
+
+	const uint32_t leftCount = static_cast<uint32_t>(middle - begin);
+
+	node.First = static_cast<uint32_t>(m_Nodes.size());
+	node.Count = 0;
+
+	m_Nodes.push_back(Node{ EmptyBox, index, first, leftCount });
+	m_Nodes.push_back(Node{ EmptyBox, index, first + leftCount, count - leftCount });
+
+	m_Stack.push_back(node.First);
+	m_Stack.push_back(node.First + 1);
+}
+
+void Bvh::Refit()
+{
+	m_DirtyNodes.assign(m_Nodes.size(), 0);
+
+	for (const uint32_t proxy : m_Moved)
+	{
+		if (!m_Proxies[proxy].Alive)
+			continue;
+
+		// Stop at the first ancestor already marked by another proxy
+		for (uint32_t node = m_Proxies[proxy].Leaf; node != Null && !m_DirtyNodes[node]; node = m_Nodes[node].Parent)
+			m_DirtyNodes[node] = 1;
+	}
+
+	m_Moved.clear();
+
+	// Children are always stored after their parent, so a reverse loop refits the nodes bottom-up
+	for (size_t i = m_Nodes.size(); i-- > 0;)
+	{
+		if (!m_DirtyNodes[i])
+			continue;
+
+		Node& node = m_Nodes[i];
+		node.Bounds = EmptyBox;
+
+		if (node.Count > 0)
+		{
+			for (uint32_t p = node.First; p < node.First + node.Count; p++)
+				Grow(node.Bounds, m_Proxies[m_Primitives[p]].Bounds);
+		}
+		else
+		{
+			Grow(node.Bounds, m_Nodes[node.First].Bounds);
+			Grow(node.Bounds, m_Nodes[node.First + 1].Bounds);
+		}
+	}
+}
+
+float Bvh::ComputeCost() const
+{
+	if (m_Nodes.empty())
+		return 0.f;
+
+	float cost = 0.f;
+
+	for (const Node& node : m_Nodes)
+		cost += Area(node.Bounds) * (node.Count > 0 ? static_cast<float>(node.Count) : 1.f);
+
+	const float rootArea = Area(m_Nodes[0].Bounds);
+	return rootArea > 0.f ? cost / rootArea : 0.f;
+}
+
+void Bvh::Query(const Frustum& frustum, const std::function<void(uint32_t)>& callback) const
+{
+	if (m_Nodes.empty())
+		return;
+
+	m_Stack.clear();
+	m_Stack.push_back(0);
+
+	while (!m_Stack.empty())
+	{
+		const Node& node = m_Nodes[m_Stack.back()];
+		m_Stack.pop_back();
+
+		if (!frustum.Intersects(node.Bounds))
+			continue;
+
+		if (node.Count == 0)
+		{
+			m_Stack.push_back(node.First);
+			m_Stack.push_back(node.First + 1);
+			continue;
+		}
+
+		for (uint32_t i = node.First; i < node.First + node.Count; i++)
+		{
+			const uint32_t proxy = m_Primitives[i];
+
+			if (m_Proxies[proxy].Alive && frustum.Intersects(m_Proxies[proxy].Bounds))
+				callback(proxy);
+		}
+	}
+}
+
+void Bvh::Query(const BoundingSphere& sphere, const std::function<void(uint32_t)>& callback) const
+{
+	if (m_Nodes.empty())
+		return;
+
+	m_Stack.clear();
+	m_Stack.push_back(0);
+
+	while (!m_Stack.empty())
+	{
+		const Node& node = m_Nodes[m_Stack.back()];
+		m_Stack.pop_back();
+
+		if (!Intersects(node.Bounds, sphere))
+			continue;
+
+		if (node.Count == 0)
+		{
+			m_Stack.push_back(node.First);
+			m_Stack.push_back(node.First + 1);
+			continue;
+		}
+
+		for (uint32_t i = node.First; i < node.First + node.Count; i++)
+		{
+			const uint32_t proxy = m_Primitives[i];
+
+			if (m_Proxies[proxy].Alive && Intersects(m_Proxies[proxy].Bounds, sphere))
+				callback(proxy);
+		}
+	}
+}
+
+uint32_t Bvh::Raycast(const Vector3& origin, const Vector3& direction, const float maxDistance,
+	const std::function<float(uint32_t)>& hit, float& distance) const
+{
+	uint32_t closest = Null;
+	distance = maxDistance;
+
+	if (m_Nodes.empty())
+		return closest;
+
+	const Vector3 invDirection(1.f / direction.x, 1.f / direction.y, 1.f / direction.z);
+	float entry;
+
+	m_Stack.clear();
+	m_Stack.push_back(0);
+
+	while (!m_Stack.empty())
+	{
+		const Node& node = m_Nodes[m_Stack.back()];
+		m_Stack.pop_back();
+
+		// Also skips the nodes pushed before a closer hit was found
+		if (!Intersects(node.Bounds, origin, invDirection, distance, entry))
+			continue;
+
+		if (node.Count == 0)
+		{
+			float leftEntry, rightEntry;
+			const bool left = Intersects(m_Nodes[node.First].Bounds, origin, invDirection, distance, leftEntry);
+			const bool right = Intersects(m_Nodes[node.First + 1].Bounds, origin, invDirection, distance, rightEntry);
+
+			// Push the closest child last so it is visited first
+			if (left && right)
+			{
+				const bool leftFirst = leftEntry <= rightEntry;
+				m_Stack.push_back(leftFirst ? node.First + 1 : node.First);
+				m_Stack.push_back(leftFirst ? node.First : node.First + 1);
+			}
+			else if (left)
+			{
+				m_Stack.push_back(node.First);
+			}
+			else if (right)
+			{
+				m_Stack.push_back(node.First + 1);
+			}
+
+			continue;
+		}
+
+		for (uint32_t i = node.First; i < node.First + node.Count; i++)
+		{
+			const uint32_t proxy = m_Primitives[i];
+
+			if (!m_Proxies[proxy].Alive || !Intersects(m_Proxies[proxy].Bounds, origin, invDirection, distance, entry))
+				continue;
+
+			const float d = hit(proxy);
+
+			if (d >= 0.f && d < distance)
+			{
+				distance = d;
+				closest = proxy;
+			}
+		}
+	}
+
+	return closest;
+}
+
+uint32_t Bvh::GetNodeCount() const
+{
+	return static_cast<uint32_t>(m_Nodes.size());
+}
+
+float Bvh::GetCost() const
+{
+	return ComputeCost();
+}
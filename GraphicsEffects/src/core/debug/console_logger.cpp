@@ -10,34 +10,46 @@
 
 void ConsoleLogger::Log(const LogData& data)
 {
-	std::string text = Log::FormatText(data);
-
 	switch (data.Level)
 	{
 		case LogLevel::TRACE:
-			std::cout << COLOR_WHITE;
+			m_Buffer.append(COLOR_WHITE);
 			break;
 
 		case LogLevel::DEBUG:
-			std::cout << COLOR_WHITE;
+			m_Buffer.append(COLOR_WHITE);
 			break;
 
 		case LogLevel::INFO:
-			std::cout << COLOR_GREEN;
+			m_Buffer.append(COLOR_GREEN);
 			break;
 
 		case LogLevel::WARNING:
-			std::cout << COLOR_YELLOW;
+			m_Buffer.append(COLOR_YELLOW);
 			break;
 
 		case LogLevel::ERROR:
-			std::cout << COLOR_RED;
+			m_Buffer.append(COLOR_RED);
 			break;
 
 		case LogLevel::FATAL:
-			std::cout << COLOR_RED;
+			m_Buffer.append(COLOR_RED);
 			break;
 	}
 
-	std::cout << text;
+	m_Buffer.append(Log::FormatText(data));
+
+	// Make sure fatal logs are visible before the application stops
+	if (data.Level == LogLevel::FATAL)
+		EndBatch();
+}
+
+void ConsoleLogger::EndBatch()
+{
+	if (m_Buffer.empty())
+		return;
+
+	std::cout.write(m_Buffer.data(), m_Buffer.size());
+	std::cout.flush();
+	m_Buffer.clear();
 }
@@ -3,7 +3,8 @@
 
 #include <iostream>
 
-FileLogger::FileLogger(const std::filesystem::path& fileName)
+FileLogger::FileLogger(const std::filesystem::path& fileName, const FlushPolicy& flushPolicy, const RotationPolicy& rotationPolicy)
+	: m_FlushPolicy(flushPolicy), m_RotationPolicy(rotationPolicy), m_FileSize(0)
 {
 	OpenFile(fileName);
 }
@@ -13,7 +14,7 @@ FileLogger::~FileLogger()
 	if (m_File.is_open())
 	{
 		// Just in case
-		m_File.flush();
+		WriteBuffer();
 		m_File.close();
 	}
 }
@@ -25,6 +26,8 @@ void FileLogger::OpenFile(const std::filesystem::path& fileName)
 
 	m_FileName = fileName;
 	m_File = std::ofstream(m_FileName);
+	m_FileSize = 0;
+	m_LastWrite = std::chrono::steady_clock::now();
 
 	if (m_File.bad())
 	{
@@ -45,8 +48,59 @@ void FileLogger::OpenFile(const std::filesystem::path& fileName)
 
 void FileLogger::Log(const LogData& data)
 {
-	const std::string text = Log::FormatText(data);
+	m_Buffer.append(Log::FormatText(data));
 
-	m_File.write(text.c_str(), text.size());
+	if ((data.Level == LogLevel::FATAL && m_FlushPolicy.OnFatal) || m_Buffer.size() >= m_FlushPolicy.Size)
+		WriteBuffer();
+}
+
+void FileLogger::EndBatch()
+{
+	if (m_Buffer.empty())
+		return;
+
+	const std::chrono::milliseconds elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_LastWrite);
+
+	if (elapsed.count() >= m_FlushPolicy.Interval)
+		WriteBuffer();
+}
+
+void FileLogger::WriteBuffer()
+{
+	m_LastWrite = std::chrono::steady_clock::now();
+
+	if (m_Buffer.empty() || !m_File.is_open())
+		return;
+
+	if (m_RotationPolicy.MaxSize != 0 && m_FileSize != 0 && m_FileSize + m_Buffer.size() > m_RotationPolicy.MaxSize)
+		Rotate();
+
+	m_File.write(m_Buffer.data(), m_Buffer.size());
 	m_File.flush();
+
+	m_FileSize += m_Buffer.size();
+	m_Buffer.clear();
+}
+
+void FileLogger::Rotate()
+{
+	m_File.close();
+
+	const std::filesystem::path stem = m_FileName.parent_path() / m_FileName.stem();
+	const std::string extension = m_FileName.extension().string();
+	const auto rotatedName = [&stem, &extension](const uint32_t index)
+		{
+			return std::filesystem::path(stem.string() + "." + std::to_string(index) + extension);
+		};
+
+	std::error_code error;
+
+	// The oldest file is overwritten
+	for (uint32_t i = m_RotationPolicy.MaxFiles; i > 1; i--)
+		std::filesystem::rename(rotatedName(i - 1), rotatedName(i), error);
+
+	if (m_RotationPolicy.MaxFiles > 0)
+		std::filesystem::rename(m_FileName, rotatedName(1), error);
+
+	OpenFile(m_FileName);
 }
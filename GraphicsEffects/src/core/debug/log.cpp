@@ -5,37 +5,49 @@
 #include <iostream>
 #include <ctime>
 #include <sstream>
+#include <algorithm>
 
 std::vector<ILogger*> Log::m_Loggers;
 
 std::thread Log::m_Thread;
 std::condition_variable Log::m_CondVar;
-TsQueue<LogData> Log::m_QueuedMessages;
+// 4096 records of 256 bytes, allocated once
+RingBuffer<LogRecord> Log::m_Records(4096);
 std::mutex Log::m_Mutex;
 bool Log::m_Running = true;
+std::atomic<bool> Log::m_Waiting = false;
+std::atomic<uint32_t> Log::m_Dropped = 0;
+
+// Maximum number of logs written by the loggers at once
+static constexpr size_t MaxBatchSize = 1024;
+// Time after which the loggers get a batch end even if nothing was logged
+static constexpr std::chrono::milliseconds IdleBatchInterval(100);
 
 void Log::Init()
 {
 	// Start thread
-	m_Thread = std::thread(Log::Run);
 	m_Running = true;
+	m_Thread = std::thread(Log::Run);
 }
 
 void Log::Stop()
 {
 	// Set not running and wake up the thread one last time to fully stop it
-	m_Running = false;
+	{
+		std::scoped_lock lock(m_Mutex);
+		m_Running = false;
+	}
 	m_CondVar.notify_one();
 
+	// Join with main thread before the loggers are freed, the thread may still be using them
+	if (m_Thread.joinable())
+		m_Thread.join();
+
 	// Cleanup loggers
 	for (size_t i = 0; i < m_Loggers.size(); i++)
 		delete m_Loggers[i];
 
 	m_Loggers.clear();
-
-	// Join with main thread
-	if (m_Thread.joinable())
-		m_Thread.join();
 }
 
 void Log::Run()
@@ -45,23 +57,78 @@ void Log::Run()
 	// Allows for the thread to be stopped by setting m_Running to false and waking it up
 	while (m_Running)
 	{
-		// Make the thread wait
-		m_CondVar.wait(lock, [](){ return !m_QueuedMessages.Empty() || !m_Running; });
+		// Make the thread wait, the flag is raised before checking the queue so a concurrent push either
+		// is seen by the check or sees the flag and wakes the thread up
+		m_Waiting = true;
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		// Wake up periodically so that the loggers can write what they buffered
+		m_CondVar.wait_for(lock, IdleBatchInterval, [](){ return !m_Records.Empty() || !m_Running; });
+		m_Waiting = false;
 	
-		// Process every message
-		while (!m_QueuedMessages.Empty())
+		// Process the messages in batches, popping the message frees its slot
+		bool remaining = true;
+		while (remaining)
 		{
-			// Pop the message, which removes it from the queue
-			const LogData data = m_QueuedMessages.PopFront();
+			size_t count = 0;
+			while (count < MaxBatchSize && m_Records.TryPop(ForwardRecord))
+				count++;
+
+			remaining = count == MaxBatchSize;
+
+			for (size_t i = 0; i < m_Loggers.size(); i++)
+				m_Loggers[i]->EndBatch();
+		}
+
+		const uint32_t dropped = m_Dropped.exchange(0, std::memory_order_relaxed);
+		if (dropped != 0)
+		{
+			const LogData data(LogLevel::WARNING, std::to_string(dropped).append(" logs were dropped, the log buffer was full"),
+				__builtin_FUNCTION(), __builtin_FILE(), __builtin_LINE(), FormatDate(std::chrono::system_clock::now().time_since_epoch().count()));
+
 			for (size_t i = 0; i < m_Loggers.size(); i++)
 			{
-				// Send to each logger
 				m_Loggers[i]->Log(data);
+				m_Loggers[i]->EndBatch();
 			}
 		}
 	}
 }
 
+void Log::ForwardRecord(const LogRecord& record)
+{
+	const LogData data(record.Level, record.Format(record.Site.Format, record.Arguments),
+		record.Site.Function, record.Site.File, record.Site.Line, FormatDate(record.Time));
+
+	for (size_t i = 0; i < m_Loggers.size(); i++)
+	{
+		// Send to each logger
+		m_Loggers[i]->Log(data);
+	}
+}
+
+const std::string& Log::FormatDate(const int64_t time)
+{
+	// Most logs happen within the same second as the previous one
+	static time_t lastTime = -1;
+	static std::string lastDate;
+
+	const std::chrono::system_clock::time_point timePoint{ std::chrono::system_clock::duration(time) };
+	const time_t t = std::chrono::system_clock::to_time_t(timePoint);
+
+	if (t == lastTime)
+		return lastDate;
+
+	tm tm;
+	localtime_s(&tm, &t);
+
+	std::ostringstream oss;
+	oss << std::put_time(&tm, "%d/%m/%Y %H-%M-%S");
+
+	lastTime = t;
+	lastDate = oss.str();
+	return lastDate;
+}
+
 void Log::AddLogger(ILogger* const logger)
 {
 	Assert::IsTrue(logger != nullptr, "Can't add an empty logger");
@@ -82,41 +149,35 @@ void Log::RemoveLogger(ILogger* const logger, const bool freeMem)
 
 void Log::LogInfo(const std::string& message, const char* funcName, const char* fileName, const int32_t line)
 {
-	ForwardLog(CreateLogData(LogLevel::INFO, message, funcName, fileName, line));
+	Write(LogLevel::INFO, LogSite("{}", funcName, fileName, line), message);
 }
 
 void Log::LogWarning(const std::string& message, const char* funcName, const char* fileName, const int32_t line)
 {
-	ForwardLog(CreateLogData(LogLevel::WARNING, message, funcName, fileName, line));
+	Write(LogLevel::WARNING, LogSite("{}", funcName, fileName, line), message);
 }
 
 void Log::LogError(const std::string& message, const char* funcName, const char* fileName,	const int32_t line)
 {
-	ForwardLog(CreateLogData(LogLevel::ERROR, message, funcName, fileName, line));
+	Write(LogLevel::ERROR, LogSite("{}", funcName, fileName, line), message);
 }
 
 void Log::LogFatal(const std::string& message, const char* funcName, const char* fileName, const int32_t line)
 {
-	ForwardLog(CreateLogData(LogLevel::FATAL, message, funcName, fileName, line));
+	Write(LogLevel::FATAL, LogSite("{}", funcName, fileName, line), message);
 }
 
-inline LogData Log::CreateLogData(const LogLevel level, const std::string& message,
-	const char* funcName, const char* fileName, const int32_t line)
+void Log::Notify()
 {
-	time_t t = std::time(nullptr);
-	tm tm;
-	localtime_s(&tm, &t);
-
-	std::ostringstream oss;
-	oss << std::put_time(&tm, "%d/%m/%Y %H-%M-%S");
-
-	return LogData(level, message, funcName, fileName, line, oss.str());
-}
-
-void Log::ForwardLog(const LogData& data)
-{
-	m_QueuedMessages.Push(data);
-	m_CondVar.notify_one();
+	// Only wake up the thread if it is sleeping, taking the mutex guarantees it is either
+	// blocked in the wait or hasn't checked the buffer yet.
+	// The flag is cleared so that only the first producer pays for the wake up
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (m_Waiting.load(std::memory_order_relaxed) && m_Waiting.exchange(false))
+	{
+		std::scoped_lock lock(m_Mutex);
+		m_CondVar.notify_one();
+	}
 }
 
 std::string Log::FormatText(const LogData& data)
@@ -0,0 +1,267 @@
+#include "core/debug/profiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <string>
+
+#include "core/debug/assert.hpp"
+#include "core/debug/log.hpp"
+
+#include "glad/glad.h"
+
+// Thread id of the GPU passes in the exported traces
+static constexpr uint32_t GpuTraceThread = 1000;
+
+static const std::chrono::steady_clock::time_point ProfilerStart = std::chrono::steady_clock::now();
+
+std::vector<std::unique_ptr<Profiler::ThreadBuffer>> Profiler::m_Buffers;
+std::mutex Profiler::m_BuffersMutex;
+thread_local Profiler::ThreadBuffer* Profiler::m_ThreadBuffer = nullptr;
+
+std::vector<ProfileFrame> Profiler::m_History;
+ProfileFrame Profiler::m_Current;
+uint64_t Profiler::m_FrameIndex = 0;
+std::atomic<uint32_t> Profiler::m_Dropped = 0;
+
+std::vector<uint32_t> Profiler::m_FreeQueries;
+std::vector<Profiler::GpuQuery> Profiler::m_PendingQueries;
+bool Profiler::m_GpuActive = false;
+
+Profiler::ThreadBuffer::ThreadBuffer(const uint32_t index)
+	: Events(ThreadCapacity), Index(index), Depth(0)
+{
+}
+
+Profiler::ThreadBuffer& Profiler::GetThreadBuffer()
+{
+	if (m_ThreadBuffer == nullptr)
+	{
+		std::scoped_lock lock(m_BuffersMutex);
+
+		// Owned by the profiler so the events of a thread outlive it
+		m_Buffers.push_back(std::make_unique<ThreadBuffer>(static_cast<uint32_t>(m_Buffers.size())));
+		m_ThreadBuffer = m_Buffers.back().get();
+	}
+
+	return *m_ThreadBuffer;
+}
+
+int64_t Profiler::Now()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - ProfilerStart).count();
+}
+
+void Profiler::BeginFrame()
+{
+	// Registers the thread of the frames first, so it is thread 0
+	GetThreadBuffer();
+
+	m_Current.Index = m_FrameIndex;
+	m_Current.Start = Now();
+}
+
+void Profiler::EndFrame()
+{
+	m_Current.End = Now();
+	m_Current.Events.clear();
+	m_Current.Gpu.clear();
+
+	{
+		std::scoped_lock lock(m_BuffersMutex);
+
+		for (const std::unique_ptr<ThreadBuffer>& buffer : m_Buffers)
+		{
+			while (buffer->Events.TryPop([](const ProfileEvent& event) { m_Current.Events.push_back(event); }))
+				;
+		}
+	}
+
+	// Parents are recorded after their children, ordering by start puts them back first
+	std::sort(m_Current.Events.begin(), m_Current.Events.end(), [](const ProfileEvent& a, const ProfileEvent& b)
+		{
+			return a.Thread != b.Thread ? a.Thread < b.Thread : a.Start < b.Start;
+		});
+
+	if (m_History.empty())
+		m_History.resize(HistorySize);
+
+	// Swapped so the vectors of the oldest frame are reused by the next one
+	std::swap(m_History[m_FrameIndex % HistorySize], m_Current);
+	m_FrameIndex++;
+
+	ReadGpuQueries();
+}
+
+void Profiler::ReadGpuQueries()
+{
+	size_t kept = 0;
+
+	for (const GpuQuery& query : m_PendingQueries)
+	{
+		// Recent queries are most likely not done yet, asking would only waste time
+		bool done = query.Frame + GpuLatency <= m_FrameIndex;
+
+		if (done)
+		{
+			int32_t available = 0;
+			glGetQueryObjectiv(query.Handle, GL_QUERY_RESULT_AVAILABLE, &available);
+			done = available != 0;
+		}
+
+		if (!done)
+		{
+			m_PendingQueries[kept++] = query;
+			continue;
+		}
+
+		uint64_t duration = 0;
+		glGetQueryObjectui64v(query.Handle, GL_QUERY_RESULT, &duration);
+		m_FreeQueries.push_back(query.Handle);
+
+		// The frame may have left the history if the GPU is very late
+		if (m_FrameIndex - query.Frame <= HistorySize)
+			m_History[query.Frame % HistorySize].Gpu.push_back(GpuTiming{ query.Name, query.Start, static_cast<int64_t>(duration) });
+	}
+
+	m_PendingQueries.resize(kept);
+}
+
+void Profiler::Shutdown()
+{
+	for (const GpuQuery& query : m_PendingQueries)
+		m_FreeQueries.push_back(query.Handle);
+
+	if (!m_FreeQueries.empty())
+		glDeleteQueries(static_cast<int32_t>(m_FreeQueries.size()), m_FreeQueries.data());
+
+	m_FreeQueries.clear();
+	m_PendingQueries.clear();
+}
+
+int64_t Profiler::PushScope()
+{
+	GetThreadBuffer().Depth++;
+	return Now();
+}
+
+void Profiler::PopScope(const char* const name, const int64_t start)
+{
+	const int64_t end = Now();
+	ThreadBuffer& buffer = GetThreadBuffer();
+
+	buffer.Depth--;
+
+	const bool pushed = buffer.Events.TryPush([&](ProfileEvent& event)
+		{
+			event = ProfileEvent{ name, start, end, buffer.Depth, buffer.Index };
+		});
+
+	if (!pushed)
+		m_Dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Profiler::BeginGpu(const char* const name)
+{
+	Assert::IsTrue(!m_GpuActive, "GPU passes can't be nested");
+	m_GpuActive = true;
+
+	uint32_t handle;
+
+	if (m_FreeQueries.empty())
+	{
+		glGenQueries(1, &handle);
+	}
+	else
+	{
+		handle = m_FreeQueries.back();
+		m_FreeQueries.pop_back();
+	}
+
+	glBeginQuery(GL_TIME_ELAPSED, handle);
+	m_PendingQueries.push_back(GpuQuery{ handle, name, Now(), m_FrameIndex });
+}
+
+void Profiler::EndGpu()
+{
+	Assert::IsTrue(m_GpuActive, "No GPU pass to end");
+	m_GpuActive = false;
+
+	glEndQuery(GL_TIME_ELAPSED);
+}
+
+bool Profiler::ExportTrace(const std::filesystem::path& path)
+{
+	std::ofstream file(path);
+
+	if (!file)
+	{
+		Log::Warning("Couldn't open {} to export the profiler trace", path.string());
+		return false;
+	}
+
+	// Chrome traces are in microseconds
+	const auto writeEvent = [&file](const char* const name, const int64_t start, const int64_t duration, const uint32_t thread)
+		{
+			file << ",\n{\"name\":\"" << name << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << thread
+				<< ",\"ts\":" << start / 1000.0 << ",\"dur\":" << duration / 1000.0 << "}";
+		};
+
+	file << std::fixed;
+	file.precision(3);
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+	file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << GpuTraceThread << ",\"args\":{\"name\":\"GPU\"}}";
+
+	uint32_t threadCount = 1;
+
+	for (uint32_t age = GetFrameCount(); age-- > 0;)
+	{
+		const ProfileFrame& frame = GetFrame(age);
+
+		writeEvent("Frame", frame.Start, frame.End - frame.Start, 0);
+
+		for (const ProfileEvent& event : frame.Events)
+		{
+			writeEvent(event.Name, event.Start, event.End - event.Start, event.Thread);
+			threadCount = std::max(threadCount, event.Thread + 1);
+		}
+
+		// GPU passes are placed at the time they were issued, only their duration is measured
+		for (const GpuTiming& timing : frame.Gpu)
+			writeEvent(timing.Name, timing.Start, timing.Duration, GpuTraceThread);
+	}
+
+	for (uint32_t thread = 0; thread < threadCount; thread++)
+	{
+		const std::string name = thread == 0 ? "Main" : "Thread " + std::to_string(thread);
+
+		file << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << thread
+			<< ",\"args\":{\"name\":\"" << name << "\"}}";
+	}
+
+	file << "\n]}\n";
+
+	return file.good();
+}
+
+const ProfileFrame& Profiler::GetFrame(const uint32_t age)
+{
+	Assert::IsTrue(age < GetFrameCount(), "Frame out of the profiler history");
+
+	return m_History[(m_FrameIndex - 1 - age) % HistorySize];
+}
+
+uint32_t Profiler::GetFrameCount()
+{
+	return static_cast<uint32_t>(std::min<uint64_t>(m_FrameIndex, HistorySize));
+}
+
+uint64_t Profiler::GetFrameIndex()
+{
+	return m_FrameIndex;
+}
+
+uint32_t Profiler::GetDroppedCount()
+{
+	return m_Dropped.load(std::memory_order_relaxed);
+}
@@ -1,20 +1,217 @@
 #include "core/engine_ui.hpp"
 
+#include <cmath>
+#include <algorithm>
+#include <cfloat>
+#include <unordered_map>
+
+#include "renderer/camera.hpp"
+#include "renderer/frame_ring.hpp"
+
 #include "ImGui/imgui.h"
 
 #include "core/debug/log.hpp"
+#include "core/debug/profiler.hpp"
 
 Object* EngineUi::m_SelectedObject;
 
 void EngineUi::DrawSceneGraph(Scene& scene)
 {
 	ImGui::Begin("Scene graph");
+	ImGui::Text("Recomputed matrices : %u", Transform::GetRecomputedCount());
+
+	const CullingStats& culling = scene.GetCullingStats();
+	ImGui::Text("Objects tested : %u, culled : %u, drawn : %u", culling.Tested, culling.Culled, culling.Drawn);
+
+	bool indirect = scene.m_Queue.GetMode() == RenderMode::INDIRECT;
+	if (ImGui::Checkbox("Multi draw indirect", &indirect))
+		scene.m_Queue.SetMode(indirect ? RenderMode::INDIRECT : RenderMode::INSTANCED);
+
+	const RenderStats& render = scene.GetRenderStats();
+	ImGui::Text("Draw calls : %u, instances : %u", render.DrawCalls, render.Instances);
+	ImGui::Text("Program binds : %u, texture binds : %u", render.ProgramBinds, render.TextureBinds);
+
+	if (const FrameRing* const ring = FrameRing::Instance())
+	{
+		ImGui::Text("Frame ring : %zu / %zu KB, stalls : %u", ring->GetUsedSize() / 1024, ring->GetFrameSize() / 1024,
+			ring->GetStallCount());
+	}
+
+	ImGui::Separator();
 	DrawSceneGraph_Object(scene.m_Root);
 	ImGui::End();
 	
+	PickObject(scene);
 	DrawSelectedObject();
 }
 
+void EngineUi::DrawProfiler()
+{
+	ImGui::Begin("Profiler");
+
+	const uint32_t frameCount = Profiler::GetFrameCount();
+
+	if (frameCount == 0)
+	{
+		ImGui::End();
+		return;
+	}
+
+	constexpr float nsToMs = 1e-6f;
+
+	// Rolling statistics of the scopes, their names are string literals so they are told apart by address
+	struct ScopeStats
+	{
+		float Total;
+		float Max;
+	};
+
+	std::unordered_map<const char*, ScopeStats> cpuStats;
+	std::unordered_map<const char*, ScopeStats> gpuStats;
+	uint32_t gpuFrameCount = 0;
+	const ProfileFrame* gpuFrame = nullptr;
+
+	// Oldest frame first for the plot
+	static float frameTimes[Profiler::HistorySize];
+	float averageTime = 0.f;
+	float maxTime = 0.f;
+
+	for (uint32_t i = 0; i < frameCount; i++)
+	{
+		const ProfileFrame& frame = Profiler::GetFrame(frameCount - 1 - i);
+
+		frameTimes[i] = (frame.End - frame.Start) * nsToMs;
+		averageTime += frameTimes[i];
+		maxTime = std::max(maxTime, frameTimes[i]);
+
+		for (const ProfileEvent& event : frame.Events)
+		{
+			ScopeStats& stats = cpuStats[event.Name];
+			stats.Total += (event.End - event.Start) * nsToMs;
+			stats.Max = std::max(stats.Max, (event.End - event.Start) * nsToMs);
+		}
+
+		// GPU timings arrive a few frames late, the newest frames don't have them yet
+		if (frame.Gpu.empty())
+			continue;
+
+		gpuFrameCount++;
+		gpuFrame = &frame;
+
+		for (const GpuTiming& timing : frame.Gpu)
+		{
+			ScopeStats& stats = gpuStats[timing.Name];
+			stats.Total += timing.Duration * nsToMs;
+			stats.Max = std::max(stats.Max, timing.Duration * nsToMs);
+		}
+	}
+
+	averageTime /= static_cast<float>(frameCount);
+
+	ImGui::Text("Frame : %.2f ms, average : %.2f ms, max : %.2f ms", frameTimes[frameCount - 1], averageTime, maxTime);
+	ImGui::PlotLines("##Frame times", frameTimes, static_cast<int>(frameCount), 0, nullptr, 0.f, FLT_MAX, ImVec2(0.f, 60.f));
+
+	if (ImGui::Button("Export Chrome trace") && Profiler::ExportTrace("profile_trace.json"))
+		Log::Info("Profiler trace of {} frames written to profile_trace.json", frameCount);
+
+	if (Profiler::GetDroppedCount() > 0)
+		ImGui::Text("Dropped scopes : %u", Profiler::GetDroppedCount());
+
+	const auto header = [](const char* const title)
+		{
+			ImGui::Separator();
+			ImGui::Columns(4, title);
+			ImGui::TextUnformatted(title);
+			ImGui::NextColumn();
+			ImGui::Text("Last (ms)");
+			ImGui::NextColumn();
+			ImGui::Text("Avg / frame");
+			ImGui::NextColumn();
+			ImGui::Text("Max");
+			ImGui::NextColumn();
+			ImGui::Separator();
+		};
+
+	const auto row = [](const char* const name, const float last, const ScopeStats& stats, const uint32_t frames)
+		{
+			ImGui::TextUnformatted(name);
+			ImGui::NextColumn();
+			ImGui::Text("%.3f", last);
+			ImGui::NextColumn();
+			ImGui::Text("%.3f", stats.Total / static_cast<float>(frames));
+			ImGui::NextColumn();
+			ImGui::Text("%.3f", stats.Max);
+			ImGui::NextColumn();
+		};
+
+	const ProfileFrame& last = Profiler::GetFrame(0);
+
+	header("CPU");
+
+	// The events are ordered by thread, then by start, the scopes of the main thread come first as a tree
+	float workerTime = 0.f;
+
+	for (const ProfileEvent& event : last.Events)
+	{
+		const float duration = (event.End - event.Start) * nsToMs;
+
+		if (event.Thread != 0)
+		{
+			workerTime += duration;
+			continue;
+		}
+
+		const float indent = 12.f * static_cast<float>(event.Depth);
+
+		if (indent > 0.f)
+			ImGui::Indent(indent);
+
+		row(event.Name, duration, cpuStats[event.Name], frameCount);
+
+		if (indent > 0.f)
+			ImGui::Unindent(indent);
+	}
+
+	ImGui::Columns(1);
+	ImGui::Text("Worker scopes : %.3f ms", workerTime);
+
+	if (gpuFrame != nullptr)
+	{
+		header("GPU");
+
+		for (const GpuTiming& timing : gpuFrame->Gpu)
+			row(timing.Name, timing.Duration * nsToMs, gpuStats[timing.Name], gpuFrameCount);
+
+		ImGui::Columns(1);
+	}
+
+	ImGui::End();
+}
+
+void EngineUi::PickObject(const Scene& scene)
+{
+	const ImGuiIO& io = ImGui::GetIO();
+
+	if (!ImGui::IsMouseClicked(ImGuiMouseButton_Left) || io.WantCaptureMouse)
+		return;
+
+	const Camera& camera = *Camera::Instance;
+
+	// Ray through the mouse, the vertical field of view spans the height of the screen
+	const float ndcX = 2.f * io.MousePos.x / io.DisplaySize.x - 1.f;
+	const float ndcY = 1.f - 2.f * io.MousePos.y / io.DisplaySize.y;
+	const float tanY = std::tan(camera.Fov * .5f);
+	const float tanX = tanY * io.DisplaySize.x / io.DisplaySize.y;
+
+	const Vector3 direction = (camera.GetFront() + camera.GetRight() * (ndcX * tanX) + camera.GetUp() * (ndcY * tanY)).Normalize();
+
+	float distance;
+	Object* const obj = scene.Raycast(camera.Position, direction, camera.DepthFar, distance);
+
+	if (obj != nullptr)
+		m_SelectedObject = obj;
+}
+
 void EngineUi::DrawSceneGraph_Object(Object& obj)
 {
 	ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_DefaultOpen | ImGuiTreeNodeFlags_OpenOnArrow;
@@ -48,11 +245,22 @@ void EngineUi::DrawSelectedObject()
 	ImGui::Text(m_SelectedObject->Name.c_str());
 
 	ImGui::Checkbox("Outlined", &m_SelectedObject->Outlined);
-	ImGui::DragFloat3("Position", &t.Position.x, .1f);
-	ImGui::SliderAngle("Rot. X", &t.Rotation.x);
-	ImGui::SliderAngle("Rot. Y", &t.Rotation.y);
-	ImGui::SliderAngle("Rot. Z", &t.Rotation.z);
-	ImGui::DragFloat3("Scaling", &t.Scaling.x, .1f);
+
+	// Edit copies so the transform only gets marked as dirty when a value actually changes
+	Vector3 position = t.GetPosition();
+	if (ImGui::DragFloat3("Position", &position.x, .1f))
+		t.SetPosition(position);
+
+	Vector3 rotation = t.GetEulerAngles();
+	bool rotationChanged = ImGui::SliderAngle("Rot. X", &rotation.x);
+	rotationChanged |= ImGui::SliderAngle("Rot. Y", &rotation.y);
+	rotationChanged |= ImGui::SliderAngle("Rot. Z", &rotation.z);
+	if (rotationChanged)
+		t.SetEulerAngles(rotation);
+
+	Vector3 scaling = t.GetScaling();
+	if (ImGui::DragFloat3("Scaling", &scaling.x, .1f))
+		t.SetScaling(scaling);
 
 	ImGui::Separator();
 
@@ -0,0 +1,225 @@
+#include "core/maths/lu_decomposition.h"
+#include <assert.h>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+LUDecomposition::LUDecomposition()
+	: mPermutationSign(1.f), mSingular(true)
+{
+}
+
+LUDecomposition::LUDecomposition(const MatrixM& mat)
+	: LUDecomposition()
+{
+	Factor(mat);
+}
+
+bool LUDecomposition::Factor(const MatrixM& mat)
+{
+	mSingular = true;
+	mPermutationSign = 1.f;
+	mPermutation.clear();
+
+	if (!mat.IsSquare())
+	{
+		mFactors = MatrixM();
+		return false;
+	}
+
+	mFactors = mat;
+
+	const uint32_t size = mFactors.GetNbrRows();
+	const uint32_t stride = mFactors.GetStride();
+	float* data = mFactors.Data();
+
+	mPermutation.resize(size);
+
+	for (uint32_t i = 0; i < size; i++)
+		mPermutation[i] = i;
+
+	bool singular = false;
+
+	for (uint32_t k = 0; k < size; k++)
+	{
+		// Partial pivoting, the largest value of the column bounds the growth of the factors
+		uint32_t pivotRow = k;
+		float pivotValue = fabsf(data[k * stride + k]);
+
+		for (uint32_t i = k + 1; i < size; i++)
+		{
+			const float value = fabsf(data[i * stride + k]);
+			if (value > pivotValue)
+			{
+				pivotValue = value;
+				pivotRow = i;
+			}
+		}
+
+		// The column is already 0 below the diagonal, U gets a 0 on its diagonal and the elimination goes on
+		if (pivotValue == 0.f)
+		{
+			singular = true;
+			continue;
+		}
+
+		if (pivotRow != k)
+		{
+			std::swap_ranges(data + k * stride, data + k * stride + size, data + pivotRow * stride);
+			std::swap(mPermutation[k], mPermutation[pivotRow]);
+			mPermutationSign = -mPermutationSign;
+		}
+
+		const float* pivot = data + k * stride;
+
+		for (uint32_t i = k + 1; i < size; i++)
+		{
+			float* row = data + i * stride;
+
+			const float factor = row[k] / pivot[k];
+			row[k] = factor;
+
+			if (factor != 0.f)
+				MatrixM::AddScaled(row + k + 1, pivot + k + 1, -factor, size - k - 1);
+		}
+	}
+
+	mSingular = singular;
+	return !singular;
+}
+
+bool LUDecomposition::IsSingular() const
+{
+	return mSingular;
+}
+
+uint32_t LUDecomposition::Size() const
+{
+	return mFactors.GetNbrRows();
+}
+
+float LUDecomposition::Determinant() const
+{
+	// Nothing was factored, the matrix wasn't square
+	if (mSingular && Size() == 0)
+		return 0.f;
+
+	float det = mPermutationSign;
+
+	for (uint32_t i = 0; i < Size(); i++)
+		det *= mFactors[i][i];
+
+	return det;
+}
+
+bool LUDecomposition::Solve(const VectorM& b, VectorM& x) const
+{
+	if (mSingular)
+		return false;
+
+	const uint32_t size = Size();
+
+	assert(b.Size() == size && "The right hand side must have as many values as the matrix has rows");
+
+	__assume(b.Size() == size);
+
+	x = VectorM(size);
+
+	const float* src = b.Data();
+	float* dst = x.Data();
+
+	// L * y = P * b
+	for (uint32_t i = 0; i < size; i++)
+	{
+		const ConstVectorView row = mFactors[i];
+		float sum = src[mPermutation[i]];
+
+		for (uint32_t k = 0; k < i; k++)
+			sum -= row[k] * dst[k];
+
+		dst[i] = sum;
+	}
+
+	// U * x = y
+	for (uint32_t i = size; i-- > 0;)
+	{
+		const ConstVectorView row = mFactors[i];
+		float sum = dst[i];
+
+		for (uint32_t k = i + 1; k < size; k++)
+			sum -= row[k] * dst[k];
+
+		dst[i] = sum / row[i];
+	}
+
+	return true;
+}
+
+bool LUDecomposition::Solve(const MatrixM& b, MatrixM& x) const
+{
+	if (mSingular)
+		return false;
+
+	const uint32_t size = Size();
+	const uint32_t columns = b.GetNbrColumns();
+
+	assert(b.GetNbrRows() == size && "The right hand sides must have as many rows as the matrix");
+
+	__assume(b.GetNbrRows() == size);
+
+	x = MatrixM(columns, size, 0);
+
+	for (uint32_t i = 0; i < size; i++)
+		std::memcpy(x[i].Data(), b[mPermutation[i]].Data(), columns * sizeof(float));
+
+	// Whole rows of the solutions are updated at once, so every right hand side is solved in the same pass
+	for (uint32_t i = 0; i < size; i++)
+	{
+		const ConstVectorView row = mFactors[i];
+		float* dst = x[i].Data();
+
+		for (uint32_t k = 0; k < i; k++)
+		{
+			if (row[k] != 0.f)
+				MatrixM::AddScaled(dst, x[k].Data(), -row[k], columns);
+		}
+	}
+
+	for (uint32_t i = size; i-- > 0;)
+	{
+		const ConstVectorView row = mFactors[i];
+		float* dst = x[i].Data();
+
+		for (uint32_t k = i + 1; k < size; k++)
+		{
+			if (row[k] != 0.f)
+				MatrixM::AddScaled(dst, x[k].Data(), -row[k], columns);
+		}
+
+		for (uint32_t j = 0; j < columns; j++)
+			dst[j] /= row[i];
+	}
+
+	return true;
+}
+
+bool LUDecomposition::Inverse(MatrixM& dst) const
+{
+	if (mSingular)
+		return false;
+
+	MatrixM identity;
+	MatrixM::GetIdentity(Size(), identity);
+
+	return Solve(identity, dst);
+}
+
+const MatrixM& LUDecomposition::GetFactors() const
+{
+	return mFactors;
+}
+
+const std::vector<uint32_t>& LUDecomposition::GetPermutation() const
+{
+	return mPermutation;
+}
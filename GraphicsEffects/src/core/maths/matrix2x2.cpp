@@ -1,44 +1,9 @@
-#include "core/maths/Matrix2x2.h"
+#include "core/maths/matrix2x2.h"
 #include "core/maths/matrixM.h"
 #include <iostream>
 #include <assert.h>
 
-const Matrix2x2 Matrix2x2::Identity = Matrix2x2(
-	1, 0,
-	0, 1
-);
-
-Matrix2x2::Matrix2x2()
-	: Row0(), Row1()
-{
-}
-
-Matrix2x2::Matrix2x2(const float value)
-	: Row0(value), Row1(value)
-{
-}
-
-Matrix2x2::Matrix2x2(const float r00, const float r01, const float r10, const float r11)
-	: Row0(r00, r01), Row1(r10, r11)
-{
-}
-
-Matrix2x2::Matrix2x2(const Vector2 r0, const float r10, const float r11)
-	: Row0(r0), Row1(r10, r11)
-{
-}
-
-Matrix2x2::Matrix2x2(const float r00, const float r01, const Vector2 r1)
-	: Row0(r00, r01), Row1(r1)
-{
-}
-
-Matrix2x2::Matrix2x2(const Vector2 r0, const Vector2 r1)
-	: Row0(r0), Row1(r1)
-{
-}
-
-Matrix2x2::Matrix2x2(const std::initializer_list<float>& data)
+Matrix2x2::Mat(const std::initializer_list<float>& data)
 {
 	size_t size = data.size();
 	assert(size <= 4 && "Cannot construct a Matrix 2x2 with more than 4 (float) values");
@@ -59,7 +24,7 @@ Matrix2x2::Matrix2x2(const std::initializer_list<float>& data)
 		*dst++ = 0.f;
 }
 
-Matrix2x2::Matrix2x2(const std::initializer_list<Vector2>& data)
+Matrix2x2::Mat(const std::initializer_list<Vector2>& data)
 {
 	size_t size = data.size();
 	assert(size <= 2 && "Cannot construct a Matrix 2x2 with more than 2 (Vector2) values");
@@ -74,16 +39,6 @@ Matrix2x2::Matrix2x2(const std::initializer_list<Vector2>& data)
 		Row1 = Vector2(0);
 }
 
-Vector2 Matrix2x2::Diagonal() const
-{
-	return Vector2(Row0.x, Row1.y);
-}
-
-float Matrix2x2::Trace() const
-{
-	return Row0.x + Row1.y;
-}
-
 Matrix2x2& Matrix2x2::Negate()
 {
 	Row0 = -Row0;
@@ -152,8 +107,8 @@ void Matrix2x2::Augment(const MatrixM& in, MatrixM& out) const
 
 	for (uint32_t i = 0; i < 2; i++)
 	{
-		VectorM& vec = out.GetRow(i);
-		const VectorM& srcRight = in.GetRow(i);
+		VectorView vec = out.GetRow(i);
+		ConstVectorView srcRight = in.GetRow(i);
 
 		uint32_t j;
 		for (j = 0; j < 2; j++)
@@ -164,24 +119,6 @@ void Matrix2x2::Augment(const MatrixM& in, MatrixM& out) const
 	}
 }
 
-Vector2 Matrix2x2::operator[](int i) const
-{
-	assert(i == 0 || i == 1 && "Matrix 2 subscript out of range");
-
-	__assume(i == 0 || i == 1);
-
-	return (&Row0)[i];
-}
-
-Vector2& Matrix2x2::operator[](int i)
-{
-	assert(i == 0 || i == 1 && "Matrix 2 subscript out of range");
-
-	__assume(i == 0 || i == 1);
-
-	return (&Row0)[i];
-}
-
 void Matrix2x2::Log() const
 {
 	std::cout << "[ " << Row0.x << ", " << Row0.y << " ]" << std::endl;
@@ -4,78 +4,7 @@
 #include "core/maths/matrixM.h"
 #include <iostream>
 
-const Matrix3x3 Matrix3x3::Identity = Matrix3x3(
-	1, 0, 0,
-	0, 1, 0,
-	0, 0, 1
-);
-
-Matrix3x3::Matrix3x3()
-	: Row0(0), Row1(0), Row2(0)
-{
-}
-
-Matrix3x3::Matrix3x3(const float value)
-	: Row0(value), Row1(value), Row2(value)
-{
-}
-
-Matrix3x3::Matrix3x3(const float r00, const float r01, const float r02, const float r10, const float r11, const float r12, const float r20, const float r21, const float r22)
-	: Row0(r00, r01, r02), Row1(r10, r11, r12), Row2(r20, r21, r22)
-{
-}
-
-Matrix3x3::Matrix3x3(const Vector3& r0, const float r10, const float r11, const float r12, const float r20, const float r21, const float r22)
-	: Row0(r0), Row1(r10, r11, r12), Row2(r20, r21, r22)
-{
-}
-
-Matrix3x3::Matrix3x3(const float r00, const float r01, const float r02, const Vector3& r1, const float r20, const float r21, const float r22)
-	: Row0(r00, r01, r02), Row1(r1), Row2(r20, r21, r22)
-{
-}
-
-Matrix3x3::Matrix3x3(const float r00, const float r01, const float r02, const float r10, const float r11, const float r12, const Vector3& r2)
-	: Row0(r00, r01, r02), Row1(r10, r11, r12), Row2(r2)
-{
-}
-
-Matrix3x3::Matrix3x3(const Vector3& r0, const Vector3& r1, const float r20, const float r21, const float r22)
-	: Row0(r0), Row1(r1), Row2(r20, r21, r22)
-{
-}
-
-Matrix3x3::Matrix3x3(const Vector3& r0, const float r10, const float r11, const float r12, const Vector3& r2)
-	: Row0(r0), Row1(r10, r11, r12), Row2(r2)
-{
-}
-
-Matrix3x3::Matrix3x3(const float r00, const float r01, const float r02, const Vector3& r1, const Vector3& r2)
-	: Row0(r00, r01, r02), Row1(r1), Row2(r2)
-{
-}
-
-Matrix3x3::Matrix3x3(const Vector3& r0, const Vector3& r1, const Vector3& r2)
-	: Row0(r0), Row1(r1), Row2(r2)
-{
-}
-
-Matrix3x3::Matrix3x3(const Matrix2x2& mat)
-	: Row0(mat[0][0], mat[0][1], 0), Row1(mat[1][0], mat[1][1], 0), Row2(0)
-{
-}
-
-Matrix3x3::Matrix3x3(const Matrix2x2& mat, const float r02, const float r12, const float r20, const float r21, const float r22)
-	: Row0(mat[0][0], mat[0][1], r02), Row1(mat[1][0], mat[1][1], r12), Row2(r20, r21, r22)
-{
-}
-
-Matrix3x3::Matrix3x3(const Matrix2x2& mat, const float r02, const float r12, const Vector3& r2)
-	: Row0(mat[0][0], mat[0][1], r02), Row1(mat[1][0], mat[1][1], r12), Row2(r2)
-{
-}
-
-Matrix3x3::Matrix3x3(const std::initializer_list<float>& data)
+Matrix3x3::Mat(const std::initializer_list<float>& data)
 {
 	const size_t nbrElem = sizeof(Matrix3x3) / sizeof(float);
 	size_t size = data.size();
@@ -97,7 +26,7 @@ Matrix3x3::Matrix3x3(const std::initializer_list<float>& data)
 		*dst++ = 0.f;
 }
 
-Matrix3x3::Matrix3x3(const std::initializer_list<Vector3>& data)
+Matrix3x3::Mat(const std::initializer_list<Vector3>& data)
 {
 	const size_t nbrElem = sizeof(Matrix3x3) / sizeof(Vector3);
 	size_t size = data.size();
@@ -120,16 +49,6 @@ Matrix3x3::Matrix3x3(const std::initializer_list<Vector3>& data)
 		Row2 = Vector3(0);
 }
 
-Vector3 Matrix3x3::Diagonal() const
-{
-	return Vector3(Row0.x, Row1.y, Row2.z);
-}
-
-float Matrix3x3::Trace() const
-{
-	return Row0.x + Row1.y + Row2.z;
-}
-
 float Matrix3x3::Determinant() const
 {
 	const float det0 = Row1[1] * Row2[2] - Row2[1] * Row1[2];
@@ -149,8 +68,8 @@ void Matrix3x3::Augment(const MatrixM& in, MatrixM& out) const
 
 	for (uint32_t i = 0; i < 3; i++)
 	{
-		VectorM& vec = out.GetRow(i);
-		const VectorM& srcRight = in.GetRow(i);
+		VectorView vec = out.GetRow(i);
+		ConstVectorView srcRight = in.GetRow(i);
 
 		uint32_t j;
 		for (j = 0; j < 3; j++)
@@ -283,22 +202,6 @@ void Matrix3x3::Rotation(const Vector3& rotation, Matrix3x3& dst)
 }
 
 
-Vector3 Matrix3x3::operator[](int i) const
-{
-	assert(i == 0 || i == 1 || i == 2 && "Matrix 3x3 subscript out of range");
-	__assume(i == 0 || i == 1 || i == 2);
-
-	return (&Row0)[i];
-}
-
-Vector3& Matrix3x3::operator[](int i)
-{
-	assert(i == 0 || i == 1 || i == 2 && "Matrix 3x3 subscript out of range");
-	__assume(i == 0 || i == 1 || i == 2);
-
-	return (&Row0)[i];
-}
-
 void Matrix3x3::Log() const
 {
 	std::cout << "[ " << Row0.x << ", " << Row0.y << ", " << Row0.z << " ]" << std::endl;
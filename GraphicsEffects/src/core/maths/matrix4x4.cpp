@@ -1,126 +1,40 @@
 #include "core/maths/matrix4x4.h"
 #include "core/maths/matrixM.h"
+#include "core/maths/quaternion.h"
+#include "core/maths/simd.h"
 #include <assert.h>
 #include <cmath>
 #include <iostream>
 
-const Matrix4x4 Matrix4x4::Identity = Matrix4x4(
-	1, 0, 0, 0,
-	0, 1, 0, 0,
-	0, 0, 1, 0,
-	0, 0, 0, 1
-);
-
-Matrix4x4::Matrix4x4()
-	: Row0(0), Row1(0), Row2(0), Row3(0)
-{
-}
-
-Matrix4x4::Matrix4x4(const float value)
-	: Row0(value), Row1(value), Row2(value), Row3(value)
-{
-}
-
-Matrix4x4::Matrix4x4(const float r00, const float r01, const float r02, const float r03, const float r10, const float r11, const float r12, const float r13, const float r20, const float r21, const float r22, const float r23, const float r30, const float r31, const float r32, const float r33)
-	: Row0(r00, r01, r02, r03), Row1(r10, r11, r12, r13), Row2(r20, r21, r22, r23), Row3(r30, r31, r32, r33)
-{
-}
-
-Matrix4x4::Matrix4x4(const Vector4& r0, const float r10, const float r11, const float r12, const float r13, const float r20, const float r21, const float r22, const float r23, const float r30, const float r31, const float r32, const float r33)
-	: Row0(r0), Row1(r10, r11, r12, r13), Row2(r20, r21, r22, r23), Row3(r30, r31, r32, r33)
-{
-}
-
-Matrix4x4::Matrix4x4(const float r00, const float r01, const float r02, const float r03, const Vector4& r1, const float r20, const float r21, const float r22, const float r23, const float r30, const float r31, const float r32, const float r33)
-	: Row0(r00, r01, r02, r03), Row1(r1), Row2(r20, r21, r22, r23), Row3(r30, r31, r32, r33)
-{
-}
-
-Matrix4x4::Matrix4x4(const float r00, const float r01, const float r02, const float r03, const float r10, const float r11, const float r12, const float r13, const Vector4& r2, const float r30, const float r31, const float r32, const float r33)
-	: Row0(r00, r01, r02, r03), Row1(r10, r11, r12, r13), Row2(r2), Row3(r30, r31, r32, r33)
-{
-}
-
-Matrix4x4::Matrix4x4(const float r00, const float r01, const float r02, const float r03, const float r10, const float r11, const float r12, const float r13, const float r20, const float r21, const float r22, const float r23, const Vector4& r3)
-	: Row0(r00, r01, r02, r03), Row1(r10, r11, r12, r13), Row2(r20, r21, r22, r23), Row3(r3)
-{
-}
-
-Matrix4x4::Matrix4x4(const Vector4& r0, const Vector4& r1, const float r20, const float r21, const float r22, const float r23, const float r30, const float r31, const float r32, const float r33)
-	: Row0(r0), Row1(r1), Row2(r20, r21, r22, r23), Row3(r30, r31, r32, r33)
-{
-}
-
-Matrix4x4::Matrix4x4(const Vector4& r0, const float r10, const float r11, const float r12, const float r13, const Vector4& r2, const float r30, const float r31, const float r32, const float r33)
-	: Row0(r0), Row1(r10, r11, r12, r13), Row2(r2), Row3(r30, r31, r32, r33)
-{
-}
-
-Matrix4x4::Matrix4x4(const Vector4& r0, const float r10, const float r11, const float r12, const float r13, const float r20, const float r21, const float r22, const float r23, const Vector4& r3)
-	: Row0(r0), Row1(r10, r11, r12, r13), Row2(r20, r21, r22, r23), Row3(r3)
-{
-}
-
-Matrix4x4::Matrix4x4(const Vector4& r0, const Vector4& r1, const Vector4& r2, const float r30, const float r31, const float r32, const float r33)
-	: Row0(r0), Row1(r1), Row2(r2), Row3(r30, r31, r32, r33)
-{
-}
-
-Matrix4x4::Matrix4x4(const Vector4& r0, const Vector4& r1, const float r20, const float r21, const float r22, const float r23, const Vector4& r3)
-	: Row0(r0), Row1(r1), Row2(r20, r21, r22, r23), Row3(r3)
-{
-}
-
-Matrix4x4::Matrix4x4(const float r00, const float r01, const float r02, const float r03, const Vector4& r1, const Vector4& r2, const float r30, const float r31, const float r32, const float r33)
-	: Row0(r00, r01, r02, r03), Row1(r1), Row2(r2), Row3(r30, r31, r32, r33)
-{
-}
-
-Matrix4x4::Matrix4x4(const float r00, const float r01, const float r02, const float r03, const Vector4& r1, const float r20, const float r21, const float r22, const float r23, const Vector4& r3)
-	: Row0(r00, r01, r02, r03), Row1(r1), Row2(r20, r21, r22, r23), Row3(r3)
-{
-}
-
-Matrix4x4::Matrix4x4(const float r00, const float r01, const float r02, const float r03, const float r10, const float r11, const float r12, const float r13, const Vector4& r2, const Vector4& r3)
-	: Row0(r00, r01, r02, r03), Row1(r10, r11, r12, r13), Row2(r2), Row3(r3)
-{
-}
-
-Matrix4x4::Matrix4x4(const Vector4& r0, const Vector4& r1, const Vector4& r2, const Vector4& r3)
-	: Row0(r0), Row1(r1), Row2(r2), Row3(r3)
-{
-}
-
-Matrix4x4::Matrix4x4(const Matrix2x2& mat)
-	: Row0(mat[0][0], mat[0][1], 0, 0), Row1(mat[1][0], mat[1][1], 0, 0), Row2(0), Row3(0)
+#ifdef MATHS_SIMD_SSE
+static inline __m128 LoadRow(const Vector4& row)
 {
+	return _mm_loadu_ps(&row.x);
 }
 
-Matrix4x4::Matrix4x4(const Matrix2x2& mat0, const Matrix2x2& mat1, const Matrix2x2& mat2, const Matrix2x2& mat3)
-	: Row0(mat0[0][0], mat0[0][1], mat1[0][0], mat1[0][1]), Row1(mat0[1][0], mat0[1][1], mat1[1][0], mat1[1][1]),
-	  Row2(mat2[0][0], mat2[0][1], mat3[0][0], mat3[0][1]), Row3(mat2[1][0], mat2[1][1], mat3[1][0], mat3[1][1])
+static inline void StoreRow(Vector4& row, const __m128 value)
 {
+	_mm_storeu_ps(&row.x, value);
 }
 
-Matrix4x4::Matrix4x4(const Matrix3x3& mat)
-	: Row0(mat[0][0], mat[0][1], mat[0][2], 0), Row1(mat[1][0], mat[1][1], mat[1][2], 0),
-	  Row2(mat[2][0], mat[2][1], mat[2][2], 0), Row3(0)
-{
-}
-
-Matrix4x4::Matrix4x4(const Matrix3x3& mat, const float r03, const float r13, const float r23, const float r30, const float r31, const float r32, const float r33)
-	: Row0(mat[0][0], mat[0][1], mat[0][2], r03), Row1(mat[1][0], mat[1][1], mat[1][2], r13),
-	  Row2(mat[2][0], mat[2][1], mat[2][2], r23), Row3(r30, r31, r32, r33)
+// Cross product of the xyz components, w is a.w * b.w - a.w * b.w = 0
+static inline __m128 Cross(const __m128 a, const __m128 b)
 {
+	return _mm_sub_ps(
+		_mm_mul_ps(Simd::Swizzle<1, 2, 0, 3>(a), Simd::Swizzle<2, 0, 1, 3>(b)),
+		_mm_mul_ps(Simd::Swizzle<2, 0, 1, 3>(a), Simd::Swizzle<1, 2, 0, 3>(b))
+	);
 }
 
-Matrix4x4::Matrix4x4(const Matrix3x3& mat, const float r03, const float r13, const float r23, const Vector4& r3)
-	: Row0(mat[0][0], mat[0][1], mat[0][2], r03), Row1(mat[1][0], mat[1][1], mat[1][2], r13),
-	  Row2(mat[2][0], mat[2][1], mat[2][2], r23), Row3(r3)
+// Dot product of the xyz components, in every lane
+static inline __m128 Dot3(const __m128 a, const __m128 b)
 {
+	const __m128 product = _mm_mul_ps(a, b);
+	return _mm_add_ps(_mm_add_ps(Simd::Splat<0>(product), Simd::Splat<1>(product)), Simd::Splat<2>(product));
 }
+#endif
 
-Matrix4x4::Matrix4x4(const std::initializer_list<float>& data)
+Matrix4x4::Mat(const std::initializer_list<float>& data)
 {
 	const size_t nbrElem = sizeof(Matrix4x4) / sizeof(float);
 	size_t size = data.size();
@@ -142,7 +56,7 @@ Matrix4x4::Matrix4x4(const std::initializer_list<float>& data)
 		*dst++ = 0.f;
 }
 
-Matrix4x4::Matrix4x4(const std::initializer_list<Vector4>& data)
+Matrix4x4::Mat(const std::initializer_list<Vector4>& data)
 {
 	const size_t nbrElem = sizeof(Matrix4x4) / sizeof(Vector4);
 	size_t size = data.size();
@@ -170,44 +84,275 @@ Matrix4x4::Matrix4x4(const std::initializer_list<Vector4>& data)
 		Row3 = Vector4(0);
 }
 
-Vector4 Matrix4x4::Diagonal() const
+float Matrix4x4::Determinant() const
 {
-	return Vector4(Row0[0], Row1[1], Row2[2], Row3[3]);
+	// Laplace expansion along the upper and lower halves, 12 2x2 sub-determinants instead of 4 3x3 cofactors
+	const float s0 = Row0.x * Row1.y - Row1.x * Row0.y;
+	const float s1 = Row0.x * Row1.z - Row1.x * Row0.z;
+	const float s2 = Row0.x * Row1.w - Row1.x * Row0.w;
+	const float s3 = Row0.y * Row1.z - Row1.y * Row0.z;
+	const float s4 = Row0.y * Row1.w - Row1.y * Row0.w;
+	const float s5 = Row0.z * Row1.w - Row1.z * Row0.w;
+
+	const float c5 = Row2.z * Row3.w - Row3.z * Row2.w;
+	const float c4 = Row2.y * Row3.w - Row3.y * Row2.w;
+	const float c3 = Row2.y * Row3.z - Row3.y * Row2.z;
+	const float c2 = Row2.x * Row3.w - Row3.x * Row2.w;
+	const float c1 = Row2.x * Row3.z - Row3.x * Row2.z;
+	const float c0 = Row2.x * Row3.y - Row3.x * Row2.y;
+
+	return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
 }
 
-float Matrix4x4::Trace() const
+
+#ifdef MATHS_SIMD_SSE
+// 2x2 matrices packed in a single register as (m00, m01, m10, m11)
+
+// a * b
+static inline __m128 Mat2Multiply(const __m128 a, const __m128 b)
 {
-	return Row0[0] + Row1[1] + Row2[2] + Row3[3];
+	return _mm_add_ps(
+		_mm_mul_ps(a, Simd::Swizzle<0, 3, 0, 3>(b)),
+		_mm_mul_ps(Simd::Swizzle<1, 0, 3, 2>(a), Simd::Swizzle<2, 1, 2, 1>(b))
+	);
 }
 
-float Matrix4x4::Determinant() const
+// adj(a) * b
+static inline __m128 Mat2AdjMultiply(const __m128 a, const __m128 b)
+{
+	return _mm_sub_ps(
+		_mm_mul_ps(Simd::Swizzle<3, 3, 0, 0>(a), b),
+		_mm_mul_ps(Simd::Swizzle<1, 1, 2, 2>(a), Simd::Swizzle<2, 3, 0, 1>(b))
+	);
+}
+
+// a * adj(b)
+static inline __m128 Mat2MultiplyAdj(const __m128 a, const __m128 b)
 {
-	Matrix3x3 subMat;
-	float det = 0.f;
+	return _mm_sub_ps(
+		_mm_mul_ps(a, Simd::Swizzle<3, 0, 3, 0>(b)),
+		_mm_mul_ps(Simd::Swizzle<1, 0, 3, 2>(a), Simd::Swizzle<2, 1, 2, 1>(b))
+	);
+}
+#endif
+
+bool Matrix4x4::Inverse(Matrix4x4& dst) const
+{
+#ifdef MATHS_SIMD_SSE
+	// Block matrix inversion, the matrix is split in 4 2x2 sub-matrices
+	// [ A, B ]
+	// [ C, D ]
+	const __m128 r0 = LoadRow(Row0);
+	const __m128 r1 = LoadRow(Row1);
+	const __m128 r2 = LoadRow(Row2);
+	const __m128 r3 = LoadRow(Row3);
+
+	const __m128 a = _mm_movelh_ps(r0, r1);
+	const __m128 b = _mm_movehl_ps(r1, r0);
+	const __m128 c = _mm_movelh_ps(r2, r3);
+	const __m128 d = _mm_movehl_ps(r3, r2);
 
-	subMat = Matrix3x3(
-		Row1.y, Row1.z, Row1.w,
-		Row2.y, Row2.z, Row2.w,
-		Row3.y, Row3.z, Row3.w
+	// (|A|, |B|, |C|, |D|)
+	const __m128 detSub = _mm_sub_ps(
+		_mm_mul_ps(_mm_shuffle_ps(r0, r2, MATHS_SHUFFLE_MASK(0, 2, 0, 2)), _mm_shuffle_ps(r1, r3, MATHS_SHUFFLE_MASK(1, 3, 1, 3))),
+		_mm_mul_ps(_mm_shuffle_ps(r0, r2, MATHS_SHUFFLE_MASK(1, 3, 1, 3)), _mm_shuffle_ps(r1, r3, MATHS_SHUFFLE_MASK(0, 2, 0, 2)))
 	);
-	det += Row0.x * subMat.Determinant();
+	const __m128 detA = Simd::Splat<0>(detSub);
+	const __m128 detB = Simd::Splat<1>(detSub);
+	const __m128 detC = Simd::Splat<2>(detSub);
+	const __m128 detD = Simd::Splat<3>(detSub);
+
+	const __m128 dc = Mat2AdjMultiply(d, c);
+	const __m128 ab = Mat2AdjMultiply(a, b);
+
+	// Adjugates of the 4 blocks of the inverse
+	__m128 x = _mm_sub_ps(_mm_mul_ps(detD, a), Mat2Multiply(b, dc));
+	__m128 w = _mm_sub_ps(_mm_mul_ps(detA, d), Mat2Multiply(c, ab));
+	__m128 y = _mm_sub_ps(_mm_mul_ps(detB, c), Mat2MultiplyAdj(d, ab));
+	__m128 z = _mm_sub_ps(_mm_mul_ps(detC, b), Mat2MultiplyAdj(a, dc));
+
+	// |M| = |A| * |D| + |B| * |C| - tr(adj(A) * B * adj(D) * C)
+	__m128 trace = _mm_mul_ps(ab, Simd::Swizzle<0, 2, 1, 3>(dc));
+	trace = _mm_add_ps(trace, Simd::Swizzle<2, 3, 0, 1>(trace));
+	trace = _mm_add_ps(trace, Simd::Swizzle<1, 0, 3, 2>(trace));
+
+	const __m128 det = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), trace);
+
+	if (_mm_cvtss_f32(det) == 0.f)
+		return false;
+
+	// Adjugate signs are folded in the reciprocal
+	const __m128 invDet = _mm_div_ps(_mm_setr_ps(1.f, -1.f, -1.f, 1.f), det);
+
+	x = _mm_mul_ps(x, invDet);
+	y = _mm_mul_ps(y, invDet);
+	z = _mm_mul_ps(z, invDet);
+	w = _mm_mul_ps(w, invDet);
+
+	StoreRow(dst.Row0, _mm_shuffle_ps(x, y, MATHS_SHUFFLE_MASK(3, 1, 3, 1)));
+	StoreRow(dst.Row1, _mm_shuffle_ps(x, y, MATHS_SHUFFLE_MASK(2, 0, 2, 0)));
+	StoreRow(dst.Row2, _mm_shuffle_ps(z, w, MATHS_SHUFFLE_MASK(3, 1, 3, 1)));
+	StoreRow(dst.Row3, _mm_shuffle_ps(z, w, MATHS_SHUFFLE_MASK(2, 0, 2, 0)));
+
+	return true;
+#else
+	// Cofactor expansion using the 2x2 sub-determinants of the upper and lower halves
+	const float s0 = Row0.x * Row1.y - Row1.x * Row0.y;
+	const float s1 = Row0.x * Row1.z - Row1.x * Row0.z;
+	const float s2 = Row0.x * Row1.w - Row1.x * Row0.w;
+	const float s3 = Row0.y * Row1.z - Row1.y * Row0.z;
+	const float s4 = Row0.y * Row1.w - Row1.y * Row0.w;
+	const float s5 = Row0.z * Row1.w - Row1.z * Row0.w;
+
+	const float c5 = Row2.z * Row3.w - Row3.z * Row2.w;
+	const float c4 = Row2.y * Row3.w - Row3.y * Row2.w;
+	const float c3 = Row2.y * Row3.z - Row3.y * Row2.z;
+	const float c2 = Row2.x * Row3.w - Row3.x * Row2.w;
+	const float c1 = Row2.x * Row3.z - Row3.x * Row2.z;
+	const float c0 = Row2.x * Row3.y - Row3.x * Row2.y;
+
+	const float det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+
+	if (det == 0.f)
+		return false;
+
+	const float invDet = 1.f / det;
+
+	dst = Matrix4x4(
+		( Row1.y * c5 - Row1.z * c4 + Row1.w * c3) * invDet,
+		(-Row0.y * c5 + Row0.z * c4 - Row0.w * c3) * invDet,
+		( Row3.y * s5 - Row3.z * s4 + Row3.w * s3) * invDet,
+		(-Row2.y * s5 + Row2.z * s4 - Row2.w * s3) * invDet,
+
+		(-Row1.x * c5 + Row1.z * c2 - Row1.w * c1) * invDet,
+		( Row0.x * c5 - Row0.z * c2 + Row0.w * c1) * invDet,
+		(-Row3.x * s5 + Row3.z * s2 - Row3.w * s1) * invDet,
+		( Row2.x * s5 - Row2.z * s2 + Row2.w * s1) * invDet,
+
+		( Row1.x * c4 - Row1.y * c2 + Row1.w * c0) * invDet,
+		(-Row0.x * c4 + Row0.y * c2 - Row0.w * c0) * invDet,
+		( Row3.x * s4 - Row3.y * s2 + Row3.w * s0) * invDet,
+		(-Row2.x * s4 + Row2.y * s2 - Row2.w * s0) * invDet,
+
+		(-Row1.x * c3 + Row1.y * c1 - Row1.z * c0) * invDet,
+		( Row0.x * c3 - Row0.y * c1 + Row0.z * c0) * invDet,
+		(-Row3.x * s3 + Row3.y * s1 - Row3.z * s0) * invDet,
+		( Row2.x * s3 - Row2.y * s1 + Row2.z * s0) * invDet
+	);
+
+	return true;
+#endif
+}
+
+
+bool Matrix4x4::InverseAffine(Matrix4x4& dst) const
+{
+	// The inverse of the linear part L has the cross products of its rows as columns, divided by |L|
+#ifdef MATHS_SIMD_SSE
+	const __m128 r0 = LoadRow(Row0);
+	const __m128 r1 = LoadRow(Row1);
+	const __m128 r2 = LoadRow(Row2);
+
+	__m128 c0 = Cross(r1, r2);
+	__m128 c1 = Cross(r2, r0);
+	__m128 c2 = Cross(r0, r1);
 
-	subMat.Row0 = Vector3(Row0.y, Row0.z, Row0.w);
-	det -= Row1.x * subMat.Determinant();
+	const __m128 det = Dot3(r0, c0);
 
-	subMat = Matrix3x3(
-		Row0.y, Row0.z, Row0.w,
-		Row1.y, Row1.z, Row1.w,
-		Row3.y, Row3.z, Row3.w
+	if (_mm_cvtss_f32(det) == 0.f)
+		return false;
+
+	// -L^-1 * t, scaled by |L| like the columns
+	__m128 t = _mm_add_ps(_mm_add_ps(
+		_mm_mul_ps(c0, _mm_shuffle_ps(r0, r0, MATHS_SHUFFLE_MASK(3, 3, 3, 3))),
+		_mm_mul_ps(c1, _mm_shuffle_ps(r1, r1, MATHS_SHUFFLE_MASK(3, 3, 3, 3)))),
+		_mm_mul_ps(c2, _mm_shuffle_ps(r2, r2, MATHS_SHUFFLE_MASK(3, 3, 3, 3))));
+	t = _mm_sub_ps(_mm_setzero_ps(), t);
+
+	// Columns to rows, the 4th row is (0, 0, 0, 0) and replaced below
+	_MM_TRANSPOSE4_PS(c0, c1, c2, t);
+
+	const __m128 invDet = _mm_div_ps(_mm_set1_ps(1.f), det);
+
+	StoreRow(dst.Row0, _mm_mul_ps(c0, invDet));
+	StoreRow(dst.Row1, _mm_mul_ps(c1, invDet));
+	StoreRow(dst.Row2, _mm_mul_ps(c2, invDet));
+	StoreRow(dst.Row3, _mm_setr_ps(0.f, 0.f, 0.f, 1.f));
+#else
+	const Vector3 r0(Row0.x, Row0.y, Row0.z);
+	const Vector3 r1(Row1.x, Row1.y, Row1.z);
+	const Vector3 r2(Row2.x, Row2.y, Row2.z);
+
+	const Vector3 c0 = Vector3::CrossProduct(r1, r2);
+	const Vector3 c1 = Vector3::CrossProduct(r2, r0);
+	const Vector3 c2 = Vector3::CrossProduct(r0, r1);
+
+	const float det = Vector3::DotProduct(r0, c0);
+
+	if (det == 0.f)
+		return false;
+
+	const float invDet = 1.f / det;
+	const Vector3 t = -(c0 * Row0.w + c1 * Row1.w + c2 * Row2.w);
+
+	dst = Matrix4x4(
+		c0.x * invDet, c1.x * invDet, c2.x * invDet, t.x * invDet,
+		c0.y * invDet, c1.y * invDet, c2.y * invDet, t.y * invDet,
+		c0.z * invDet, c1.z * invDet, c2.z * invDet, t.z * invDet,
+		0.f, 0.f, 0.f, 1.f
 	);
-	det += Row2.x * subMat.Determinant();
+#endif
 
-	subMat.Row2 = Vector3(Row2.y, Row2.z, Row2.w);
-	det -= Row3.x * subMat.Determinant();
-	
-	return det;
+	return true;
 }
 
+bool Matrix4x4::NormalMatrix(Matrix4x4& dst) const
+{
+	// (L^-1)^T has the cross products of the rows of L as rows, divided by |L|
+#ifdef MATHS_SIMD_SSE
+	// The translation is cleared so the cross products only see the linear part
+	const __m128 mask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+	const __m128 r0 = _mm_and_ps(LoadRow(Row0), mask);
+	const __m128 r1 = _mm_and_ps(LoadRow(Row1), mask);
+	const __m128 r2 = _mm_and_ps(LoadRow(Row2), mask);
+
+	const __m128 c0 = Cross(r1, r2);
+	const __m128 det = Dot3(r0, c0);
+
+	if (_mm_cvtss_f32(det) == 0.f)
+		return false;
+
+	const __m128 invDet = _mm_div_ps(_mm_set1_ps(1.f), det);
+
+	StoreRow(dst.Row0, _mm_mul_ps(c0, invDet));
+	StoreRow(dst.Row1, _mm_mul_ps(Cross(r2, r0), invDet));
+	StoreRow(dst.Row2, _mm_mul_ps(Cross(r0, r1), invDet));
+	StoreRow(dst.Row3, _mm_setr_ps(0.f, 0.f, 0.f, 1.f));
+#else
+	const Vector3 r0(Row0.x, Row0.y, Row0.z);
+	const Vector3 r1(Row1.x, Row1.y, Row1.z);
+	const Vector3 r2(Row2.x, Row2.y, Row2.z);
+
+	const Vector3 c0 = Vector3::CrossProduct(r1, r2);
+	const float det = Vector3::DotProduct(r0, c0);
+
+	if (det == 0.f)
+		return false;
+
+	const float invDet = 1.f / det;
+	const Vector3 c1 = Vector3::CrossProduct(r2, r0);
+	const Vector3 c2 = Vector3::CrossProduct(r0, r1);
+
+	dst = Matrix4x4(
+		c0.x * invDet, c0.y * invDet, c0.z * invDet, 0.f,
+		c1.x * invDet, c1.y * invDet, c1.z * invDet, 0.f,
+		c2.x * invDet, c2.y * invDet, c2.z * invDet, 0.f,
+		0.f, 0.f, 0.f, 1.f
+	);
+#endif
+
+	return true;
+}
 
 void Matrix4x4::Augment(const MatrixM& in, MatrixM& out) const
 {
@@ -220,8 +365,8 @@ void Matrix4x4::Augment(const MatrixM& in, MatrixM& out) const
 
 	for (uint32_t i = 0; i < 4; i++)
 	{
-		VectorM& vec = out.GetRow(i);
-		const VectorM& srcRight = in.GetRow(i);
+		VectorView vec = out.GetRow(i);
+		ConstVectorView srcRight = in.GetRow(i);
 
 		uint32_t j;
 		for (j = 0; j < 4; j++)
@@ -245,6 +390,19 @@ Matrix4x4& Matrix4x4::Negate()
 
 Matrix4x4& Matrix4x4::Transpose()
 {
+#ifdef MATHS_SIMD_SSE
+	__m128 r0 = LoadRow(Row0);
+	__m128 r1 = LoadRow(Row1);
+	__m128 r2 = LoadRow(Row2);
+	__m128 r3 = LoadRow(Row3);
+
+	_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+	StoreRow(Row0, r0);
+	StoreRow(Row1, r1);
+	StoreRow(Row2, r2);
+	StoreRow(Row3, r3);
+#else
 	std::swap(Row0[1], Row1[0]);
 	std::swap(Row0[2], Row2[0]);
 	std::swap(Row0[3], Row3[0]);
@@ -253,6 +411,7 @@ Matrix4x4& Matrix4x4::Transpose()
 	std::swap(Row1[3], Row3[1]);
 
 	std::swap(Row2[3], Row3[2]);
+#endif
 
 	return *this;
 }
@@ -289,70 +448,109 @@ Matrix4x4& Matrix4x4::Multiply(const float scalar)
 
 Vector4 Matrix4x4::Multiply(const Vector4& vec)
 {
+#ifdef MATHS_SIMD_SSE
+	const __m128 v = _mm_loadu_ps(&vec.x);
+
+	// Multiply each row by the vector, then transpose so each register holds one term of every dot product
+	__m128 t0 = _mm_mul_ps(LoadRow(Row0), v);
+	__m128 t1 = _mm_mul_ps(LoadRow(Row1), v);
+	__m128 t2 = _mm_mul_ps(LoadRow(Row2), v);
+	__m128 t3 = _mm_mul_ps(LoadRow(Row3), v);
+
+	_MM_TRANSPOSE4_PS(t0, t1, t2, t3);
+
+	Vector4 result;
+	_mm_storeu_ps(&result.x, _mm_add_ps(_mm_add_ps(_mm_add_ps(t0, t1), t2), t3));
+	return result;
+#else
 	const float x = vec.x * Row0.x + vec.y * Row0.y + vec.z * Row0.z + vec.w * Row0.w;
 	const float y = vec.x * Row1.x + vec.y * Row1.y + vec.z * Row1.z + vec.w * Row1.w;
 	const float z = vec.x * Row2.x + vec.y * Row2.y + vec.z * Row2.z + vec.w * Row2.w;
 	const float w = vec.x * Row3.x + vec.y * Row3.y + vec.z * Row3.z + vec.w * Row3.w;
 
 	return Vector4(x, y, z, w);
+#endif
 }
 
 Matrix4x4& Matrix4x4::Multiply(const Matrix4x4& mat)
 {
-	Row0 = Vector4(
-		Row0[0] * mat.Row0[0] + Row0[1] * mat.Row1[0] + Row0[2] * mat.Row2[0] + Row0[3] * mat.Row3[0],
-		Row0[0] * mat.Row0[1] + Row0[1] * mat.Row1[1] + Row0[2] * mat.Row2[1] + Row0[3] * mat.Row3[1],
-		Row0[0] * mat.Row0[2] + Row0[1] * mat.Row1[2] + Row0[2] * mat.Row2[2] + Row0[3] * mat.Row3[2],
-		Row0[0] * mat.Row0[3] + Row0[1] * mat.Row1[3] + Row0[2] * mat.Row2[3] + Row0[3] * mat.Row3[3]
-	);
-	Row1 = Vector4(
-		Row1[0] * mat.Row0[0] + Row1[1] * mat.Row1[0] + Row1[2] * mat.Row2[0] + Row1[3] * mat.Row3[0],
-		Row1[0] * mat.Row0[1] + Row1[1] * mat.Row1[1] + Row1[2] * mat.Row2[1] + Row1[3] * mat.Row3[1],
-		Row1[0] * mat.Row0[2] + Row1[1] * mat.Row1[2] + Row1[2] * mat.Row2[2] + Row1[3] * mat.Row3[2],
-		Row1[0] * mat.Row0[3] + Row1[1] * mat.Row1[3] + Row1[2] * mat.Row2[3] + Row1[3] * mat.Row3[3]
-	);
-	Row2 = Vector4(
-		Row2[0] * mat.Row0[0] + Row2[1] * mat.Row1[0] + Row2[2] * mat.Row2[0] + Row2[3] * mat.Row3[0],
-		Row2[0] * mat.Row0[1] + Row2[1] * mat.Row1[1] + Row2[2] * mat.Row2[1] + Row2[3] * mat.Row3[1],
-		Row2[0] * mat.Row0[2] + Row2[1] * mat.Row1[2] + Row2[2] * mat.Row2[2] + Row2[3] * mat.Row3[2],
-		Row2[0] * mat.Row0[3] + Row2[1] * mat.Row1[3] + Row2[2] * mat.Row2[3] + Row2[3] * mat.Row3[3]
-	);
-	Row3 = Vector4(
-		Row3[0] * mat.Row0[0] + Row3[1] * mat.Row1[0] + Row3[2] * mat.Row2[0] + Row3[3] * mat.Row3[0],
-		Row3[0] * mat.Row0[1] + Row3[1] * mat.Row1[1] + Row3[2] * mat.Row2[1] + Row3[3] * mat.Row3[1],
-		Row3[0] * mat.Row0[2] + Row3[1] * mat.Row1[2] + Row3[2] * mat.Row2[2] + Row3[3] * mat.Row3[2],
-		Row3[0] * mat.Row0[3] + Row3[1] * mat.Row1[3] + Row3[2] * mat.Row2[3] + Row3[3] * mat.Row3[3]
-	);
+	// The three-argument product reads all of its sources first, so mat may be *this
+	Multiply(*this, mat, *this);
 
 	return *this;
 }
 
 void Matrix4x4::Multiply(const Matrix4x4& left, const Matrix4x4& right, Matrix4x4& dst)
 {
-	dst.Row0 = Vector4(
+	// Every path reads all of its sources before writing, so dst can alias left or right
+#if defined(MATHS_SIMD_AVX)
+	const __m256 r0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&right.Row0.x));
+	const __m256 r1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&right.Row1.x));
+	const __m256 r2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&right.Row2.x));
+	const __m256 r3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&right.Row3.x));
+
+	// Two rows of the left matrix per register
+	const __m256 l01 = _mm256_loadu_ps(&left.Row0.x);
+	const __m256 l23 = _mm256_loadu_ps(&left.Row2.x);
+
+	__m256 d01 = _mm256_mul_ps(_mm256_shuffle_ps(l01, l01, MATHS_SHUFFLE_MASK(0, 0, 0, 0)), r0);
+	d01 = _mm256_add_ps(d01, _mm256_mul_ps(_mm256_shuffle_ps(l01, l01, MATHS_SHUFFLE_MASK(1, 1, 1, 1)), r1));
+	d01 = _mm256_add_ps(d01, _mm256_mul_ps(_mm256_shuffle_ps(l01, l01, MATHS_SHUFFLE_MASK(2, 2, 2, 2)), r2));
+	d01 = _mm256_add_ps(d01, _mm256_mul_ps(_mm256_shuffle_ps(l01, l01, MATHS_SHUFFLE_MASK(3, 3, 3, 3)), r3));
+
+	__m256 d23 = _mm256_mul_ps(_mm256_shuffle_ps(l23, l23, MATHS_SHUFFLE_MASK(0, 0, 0, 0)), r0);
+	d23 = _mm256_add_ps(d23, _mm256_mul_ps(_mm256_shuffle_ps(l23, l23, MATHS_SHUFFLE_MASK(1, 1, 1, 1)), r1));
+	d23 = _mm256_add_ps(d23, _mm256_mul_ps(_mm256_shuffle_ps(l23, l23, MATHS_SHUFFLE_MASK(2, 2, 2, 2)), r2));
+	d23 = _mm256_add_ps(d23, _mm256_mul_ps(_mm256_shuffle_ps(l23, l23, MATHS_SHUFFLE_MASK(3, 3, 3, 3)), r3));
+
+	_mm256_storeu_ps(&dst.Row0.x, d01);
+	_mm256_storeu_ps(&dst.Row2.x, d23);
+#elif defined(MATHS_SIMD_SSE)
+	const __m128 r0 = LoadRow(right.Row0);
+	const __m128 r1 = LoadRow(right.Row1);
+	const __m128 r2 = LoadRow(right.Row2);
+	const __m128 r3 = LoadRow(right.Row3);
+
+	const __m128 l0 = LoadRow(left.Row0);
+	const __m128 l1 = LoadRow(left.Row1);
+	const __m128 l2 = LoadRow(left.Row2);
+	const __m128 l3 = LoadRow(left.Row3);
+
+	StoreRow(dst.Row0, Simd::LinearCombine(l0, r0, r1, r2, r3));
+	StoreRow(dst.Row1, Simd::LinearCombine(l1, r0, r1, r2, r3));
+	StoreRow(dst.Row2, Simd::LinearCombine(l2, r0, r1, r2, r3));
+	StoreRow(dst.Row3, Simd::LinearCombine(l3, r0, r1, r2, r3));
+#else
+	const Vector4 row0(
 		left.Row0[0] * right.Row0[0] + left.Row0[1] * right.Row1[0] + left.Row0[2] * right.Row2[0] + left.Row0[3] * right.Row3[0],
 		left.Row0[0] * right.Row0[1] + left.Row0[1] * right.Row1[1] + left.Row0[2] * right.Row2[1] + left.Row0[3] * right.Row3[1],
 		left.Row0[0] * right.Row0[2] + left.Row0[1] * right.Row1[2] + left.Row0[2] * right.Row2[2] + left.Row0[3] * right.Row3[2],
 		left.Row0[0] * right.Row0[3] + left.Row0[1] * right.Row1[3] + left.Row0[2] * right.Row2[3] + left.Row0[3] * right.Row3[3]
 	);
-	dst.Row1 = Vector4(
+	const Vector4 row1(
 		left.Row1[0] * right.Row0[0] + left.Row1[1] * right.Row1[0] + left.Row1[2] * right.Row2[0] + left.Row1[3] * right.Row3[0],
 		left.Row1[0] * right.Row0[1] + left.Row1[1] * right.Row1[1] + left.Row1[2] * right.Row2[1] + left.Row1[3] * right.Row3[1],
 		left.Row1[0] * right.Row0[2] + left.Row1[1] * right.Row1[2] + left.Row1[2] * right.Row2[2] + left.Row1[3] * right.Row3[2],
 		left.Row1[0] * right.Row0[3] + left.Row1[1] * right.Row1[3] + left.Row1[2] * right.Row2[3] + left.Row1[3] * right.Row3[3]
 	);
-	dst.Row2 = Vector4(
+	const Vector4 row2(
 		left.Row2[0] * right.Row0[0] + left.Row2[1] * right.Row1[0] + left.Row2[2] * right.Row2[0] + left.Row2[3] * right.Row3[0],
 		left.Row2[0] * right.Row0[1] + left.Row2[1] * right.Row1[1] + left.Row2[2] * right.Row2[1] + left.Row2[3] * right.Row3[1],
 		left.Row2[0] * right.Row0[2] + left.Row2[1] * right.Row1[2] + left.Row2[2] * right.Row2[2] + left.Row2[3] * right.Row3[2],
 		left.Row2[0] * right.Row0[3] + left.Row2[1] * right.Row1[3] + left.Row2[2] * right.Row2[3] + left.Row2[3] * right.Row3[3]
 	);
-	dst.Row3 = Vector4(
+	const Vector4 row3(
 		left.Row3[0] * right.Row0[0] + left.Row3[1] * right.Row1[0] + left.Row3[2] * right.Row2[0] + left.Row3[3] * right.Row3[0],
 		left.Row3[0] * right.Row0[1] + left.Row3[1] * right.Row1[1] + left.Row3[2] * right.Row2[1] + left.Row3[3] * right.Row3[1],
 		left.Row3[0] * right.Row0[2] + left.Row3[1] * right.Row1[2] + left.Row3[2] * right.Row2[2] + left.Row3[3] * right.Row3[2],
 		left.Row3[0] * right.Row0[3] + left.Row3[1] * right.Row1[3] + left.Row3[2] * right.Row2[3] + left.Row3[3] * right.Row3[3]
 	);
+
+	dst.Row0 = row0;
+	dst.Row1 = row1;
+	dst.Row2 = row2;
+	dst.Row3 = row3;
+#endif
 }
 
 
@@ -367,17 +565,8 @@ void Matrix4x4::Translation(const Vector3& translation, Matrix4x4& dst)
 
 void Matrix4x4::Rotation(const Vector3& rotation, Matrix4x4& dst)
 {
-	Matrix3x3 rotX;
-	Matrix3x3 rotY;
-	Matrix3x3 rotZ;
-
-	Matrix3x3::RotationX(rotation.x, rotX);
-	Matrix3x3::RotationY(rotation.y, rotY);
-	Matrix3x3::RotationZ(rotation.z, rotZ);
-
-	rotZ.Multiply(rotY).Multiply(rotX);
-
-	dst = Matrix4x4(rotZ, 0, 0, 0, 0, 0, 0, 1);
+	// Rz * Ry * Rx, going through the quaternion costs 6 sin/cos instead of 3 matrix products
+	Matrix4x4::Rotation(Quaternion::FromEuler(rotation), dst);
 }
 
 void Matrix4x4::Rotation(const float angle, const Vector3& axis, Matrix4x4& dst)
@@ -408,6 +597,24 @@ void Matrix4x4::Rotation(const float angle, const Vector3& axis, Matrix4x4& dst)
 	);
 }
 
+void Matrix4x4::Rotation(const Quaternion& rotation, Matrix4x4& dst)
+{
+	const float x2 = rotation.x + rotation.x;
+	const float y2 = rotation.y + rotation.y;
+	const float z2 = rotation.z + rotation.z;
+
+	const float xx = rotation.x * x2, yy = rotation.y * y2, zz = rotation.z * z2;
+	const float xy = rotation.x * y2, xz = rotation.x * z2, yz = rotation.y * z2;
+	const float wx = rotation.w * x2, wy = rotation.w * y2, wz = rotation.w * z2;
+
+	dst = Matrix4x4(
+		1.f - (yy + zz), xy - wz,         xz + wy,         0.f,
+		xy + wz,         1.f - (xx + zz), yz - wx,         0.f,
+		xz - wy,         yz + wx,         1.f - (xx + yy), 0.f,
+		0.f,             0.f,             0.f,             1.f
+	);
+}
+
 void Matrix4x4::Scaling(const Vector3& scaling, Matrix4x4& dst)
 {
 	dst = Identity;
@@ -418,60 +625,50 @@ void Matrix4x4::Scaling(const Vector3& scaling, Matrix4x4& dst)
 }
 
 
-void Matrix4x4::TRS(const Vector3& translation, const float angle, const Vector3& axis, const Vector3& scaling, Matrix4x4& dst)
+void Matrix4x4::ApplyScalingTranslation(const Vector3& translation, const Vector3& scaling, Matrix4x4& dst)
 {
-	Matrix4x4 scalingMat(
-		scaling.x, 0, 0, 0,
-		0, scaling.y, 0, 0,
-		0, 0, scaling.z, 0,
-		0, 0, 0, 1
-	);
+	// R * S only scales the columns of R, no need for a full matrix product
+#ifdef MATHS_SIMD_SSE
+	const __m128 scale = _mm_setr_ps(scaling.x, scaling.y, scaling.z, 1.f);
+	// Keep the 3 first lanes of the scaled row and put the translation in the last one
+	const __m128 mask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
 
-	Matrix4x4::Rotation(angle, axis, dst);
-	dst.Row3[3] = 1;
-	dst.Multiply(scalingMat);
+	StoreRow(dst.Row0, _mm_or_ps(_mm_and_ps(mask, _mm_mul_ps(LoadRow(dst.Row0), scale)), _mm_setr_ps(0.f, 0.f, 0.f, translation.x)));
+	StoreRow(dst.Row1, _mm_or_ps(_mm_and_ps(mask, _mm_mul_ps(LoadRow(dst.Row1), scale)), _mm_setr_ps(0.f, 0.f, 0.f, translation.y)));
+	StoreRow(dst.Row2, _mm_or_ps(_mm_and_ps(mask, _mm_mul_ps(LoadRow(dst.Row2), scale)), _mm_setr_ps(0.f, 0.f, 0.f, translation.z)));
+	StoreRow(dst.Row3, _mm_setr_ps(0.f, 0.f, 0.f, 1.f));
+#else
+	dst.Row0 = Vector4(dst.Row0.x * scaling.x, dst.Row0.y * scaling.y, dst.Row0.z * scaling.z, translation.x);
+	dst.Row1 = Vector4(dst.Row1.x * scaling.x, dst.Row1.y * scaling.y, dst.Row1.z * scaling.z, translation.y);
+	dst.Row2 = Vector4(dst.Row2.x * scaling.x, dst.Row2.y * scaling.y, dst.Row2.z * scaling.z, translation.z);
+	dst.Row3 = Vector4(0.f, 0.f, 0.f, 1.f);
+#endif
+}
 
-	dst.Row0[3] = translation.x;
-	dst.Row1[3] = translation.y;
-	dst.Row2[3] = translation.z;
+void Matrix4x4::TRS(const Vector3& translation, const float angle, const Vector3& axis, const Vector3& scaling, Matrix4x4& dst)
+{
+	Matrix4x4::Rotation(angle, axis, dst);
+	ApplyScalingTranslation(translation, scaling, dst);
 }
 
 void Matrix4x4::TRS(const Vector3& translation, const Vector3& rotation, const Vector3& scaling, Matrix4x4& dst)
 {
-	Matrix4x4 scalingMat(
-		scaling.x, 0, 0, 0,
-		0, scaling.y, 0, 0,
-		0, 0, scaling.z, 0,
-		0, 0, 0, 1
-	);
-
 	Matrix4x4::Rotation(rotation, dst);
-	dst.Row3[3] = 1;
-	dst.Multiply(scalingMat);
-
-	dst.Row0[3] = translation.x;
-	dst.Row1[3] = translation.y;
-	dst.Row2[3] = translation.z;
+	ApplyScalingTranslation(translation, scaling, dst);
 }
 
 void Matrix4x4::TRS(const Vector3& translation, const Matrix3x3& rotation, const Vector3& scaling, Matrix4x4& dst)
 {
-	Matrix4x4 scalingMat(
-		scaling.x, 0, 0, 0,
-		0, scaling.y, 0, 0,
-		0, 0, scaling.z, 0,
-		0, 0, 0, 1
-	);
-
 	dst = Matrix4x4(
 		rotation
 	);
-	dst.Row3[3] = 1;
-	dst.Multiply(scalingMat);
+	ApplyScalingTranslation(translation, scaling, dst);
+}
 
-	dst.Row0[3] = translation.x;
-	dst.Row1[3] = translation.y;
-	dst.Row2[3] = translation.z;
+void Matrix4x4::TRS(const Vector3& translation, const Quaternion& rotation, const Vector3& scaling, Matrix4x4& dst)
+{
+	Matrix4x4::Rotation(rotation, dst);
+	ApplyScalingTranslation(translation, scaling, dst);
 }
 
 void Matrix4x4::View(const Vector3& eye, const Vector3& center, const Vector3& up, Matrix4x4& dst)
@@ -562,22 +759,6 @@ void Matrix4x4::ProjectionOrtho(const float left, const float right, const float
 }
 
 
-Vector4 Matrix4x4::operator[](int i) const
-{
-	assert(i >= 0 && i < 4 && "Matrix 4x4 subscript out of range");
-	__assume(i >= 0 && i < 4);
-
-	return (&Row0)[i];
-}
-
-Vector4& Matrix4x4::operator[](int i)
-{
-	assert(i >= 0 && i < 4 && "Matrix 4x4 subscript out of range");
-	__assume(i >= 0 && i < 4);
-
-	return (&Row0)[i];
-}
-
 void Matrix4x4::Log() const
 {
 	std::cout << "[ " << Row0.x << ", " << Row0.y << ", " << Row0.z << ", " << Row0.w << " ]" << std::endl;
@@ -1,69 +1,205 @@
 #include "core/maths/matrixM.h"
+#include "core/maths/lu_decomposition.h"
+#include "core/maths/simd.h"
 #include "core/maths/vector2.h"
+#include "core/thread_pool.hpp"
 #include <assert.h>
+#include <cstring>
 #include <iostream>
 #include <string>
 #include <algorithm>
 
-MatrixM::MatrixM()
-	: mRows(0), mColumns(0)
+// Rows of the product computed by one task of the pool
+static constexpr uint32_t MultiplyRowBlock = 64;
+// Rows and columns of the block of the right matrix that stays in cache while a block of rows goes through it
+static constexpr uint32_t MultiplyDepthBlock = 128;
+static constexpr uint32_t MultiplyColumnBlock = 512;
+// Number of multiply-adds below which spreading the product over a pool costs more than it saves
+static constexpr uint64_t MultiplyParallelThreshold = 1 << 18;
+
+/// <summary>
+/// Gets the number of values between two rows of a matrix with the given number of columns
+/// </summary>
+static uint32_t RowStride(const uint32_t columns)
 {
-	mValues = std::make_shared<VectorM[]>(mRows);
+	return (columns + MatrixM::RowAlignment - 1) / MatrixM::RowAlignment * MatrixM::RowAlignment;
 }
 
-MatrixM::MatrixM(const uint32_t _size, const float defaultValue)
-	: mRows(_size), mColumns(_size)
+/// <summary>
+/// Adds 4 scaled rows to another, dst += s[0] * r0 + s[1] * r1 + s[2] * r2 + s[3] * r3
+/// <para>
+/// The additions are done in the same order as 4 calls to AddScaled, but dst is only loaded and stored once
+/// </para>
+/// </summary>
+static void AddScaled4(float* const dst, const float* const r0, const float* const r1, const float* const r2, const float* const r3,
+	const float* const s, const uint32_t count)
 {
-	mIsSquare = true;
-	mValues = std::make_shared<VectorM[]>(mRows);
+	uint32_t j = 0;
 
-	VectorM* vec = mValues.get();
+#ifdef MATHS_SIMD_AVX
+	const __m256 s0x8 = _mm256_set1_ps(s[0]);
+	const __m256 s1x8 = _mm256_set1_ps(s[1]);
+	const __m256 s2x8 = _mm256_set1_ps(s[2]);
+	const __m256 s3x8 = _mm256_set1_ps(s[3]);
 
-	for (uint32_t i = 0; i < mRows; i++)
-		vec[i] = VectorM(mColumns, defaultValue);
+	for (; j + 8 <= count; j += 8)
+	{
+		__m256 sum = _mm256_loadu_ps(dst + j);
+		sum = _mm256_add_ps(sum, _mm256_mul_ps(s0x8, _mm256_loadu_ps(r0 + j)));
+		sum = _mm256_add_ps(sum, _mm256_mul_ps(s1x8, _mm256_loadu_ps(r1 + j)));
+		sum = _mm256_add_ps(sum, _mm256_mul_ps(s2x8, _mm256_loadu_ps(r2 + j)));
+		sum = _mm256_add_ps(sum, _mm256_mul_ps(s3x8, _mm256_loadu_ps(r3 + j)));
+		_mm256_storeu_ps(dst + j, sum);
+	}
+#endif
+
+#ifdef MATHS_SIMD_SSE
+	const __m128 s0x4 = _mm_set1_ps(s[0]);
+	const __m128 s1x4 = _mm_set1_ps(s[1]);
+	const __m128 s2x4 = _mm_set1_ps(s[2]);
+	const __m128 s3x4 = _mm_set1_ps(s[3]);
+
+	for (; j + 4 <= count; j += 4)
+	{
+		__m128 sum = _mm_loadu_ps(dst + j);
+		sum = _mm_add_ps(sum, _mm_mul_ps(s0x4, _mm_loadu_ps(r0 + j)));
+		sum = _mm_add_ps(sum, _mm_mul_ps(s1x4, _mm_loadu_ps(r1 + j)));
+		sum = _mm_add_ps(sum, _mm_mul_ps(s2x4, _mm_loadu_ps(r2 + j)));
+		sum = _mm_add_ps(sum, _mm_mul_ps(s3x4, _mm_loadu_ps(r3 + j)));
+		_mm_storeu_ps(dst + j, sum);
+	}
+#endif
+
+	for (; j < count; j++)
+		dst[j] = (((dst[j] + s[0] * r0[j]) + s[1] * r1[j]) + s[2] * r2[j]) + s[3] * r3[j];
 }
 
-MatrixM::MatrixM(const uint32_t _columns, const uint32_t _rows, const float defaultValue)
-	: mColumns(_columns), mRows(_rows)
+/// <summary>
+/// Computes rows [firstRow, lastRow[ of result = lhs * rhs, result must be 0 on these rows
+/// </summary>
+static void MultiplyRows(const MatrixM& lhs, const MatrixM& rhs, MatrixM& result, const uint32_t firstRow, const uint32_t lastRow)
 {
-	mIsSquare = _columns == _rows;
-	mValues = std::make_shared<VectorM[]>(mRows);
+	const uint32_t depth = lhs.GetNbrColumns();
+	const uint32_t columns = rhs.GetNbrColumns();
 
-	VectorM* vec = mValues.get();
+	const float* lhsData = lhs.Data();
+	const float* rhsData = rhs.Data();
+	float* resultData = result.Data();
+
+	const size_t lhsStride = lhs.GetStride();
+	const size_t rhsStride = rhs.GetStride();
+	const size_t resultStride = result.GetStride();
+
+	for (uint32_t j0 = 0; j0 < columns; j0 += MultiplyColumnBlock)
+	{
+		const uint32_t width = std::min(MultiplyColumnBlock, columns - j0);
+
+		for (uint32_t k0 = 0; k0 < depth; k0 += MultiplyDepthBlock)
+		{
+			const uint32_t k1 = std::min(depth, k0 + MultiplyDepthBlock);
+			const float* block = rhsData + j0;
+
+			for (uint32_t i = firstRow; i < lastRow; i++)
+			{
+				const float* lhsRow = lhsData + i * lhsStride;
+				float* dst = resultData + i * resultStride + j0;
+
+				uint32_t k = k0;
+
+				for (; k + 4 <= k1; k += 4)
+				{
+					AddScaled4(dst, block + k * rhsStride, block + (k + 1) * rhsStride, block + (k + 2) * rhsStride,
+						block + (k + 3) * rhsStride, lhsRow + k, width);
+				}
+
+				for (; k < k1; k++)
+					MatrixM::AddScaled(dst, block + k * rhsStride, lhsRow[k], width);
+			}
+		}
+	}
+}
+
+MatrixM::MatrixM()
+	: mColumns(0), mRows(0), mStride(0), mIsSquare(true)
+{
+}
+
+MatrixM::MatrixM(const uint32_t _size, const float defaultValue)
+	: MatrixM(_size, _size, defaultValue)
+{
+}
+
+MatrixM::MatrixM(const uint32_t _columns, const uint32_t _rows, const float defaultValue)
+	: mValues(static_cast<size_t>(RowStride(_columns)) * _rows), mColumns(_columns), mRows(_rows), mStride(RowStride(_columns)),
+	  mIsSquare(_columns == _rows)
+{
+	if (mStride == mColumns || defaultValue == 0)
+	{
+		mValues.Fill(defaultValue);
+		return;
+	}
 
 	for (uint32_t i = 0; i < mRows; i++)
-		vec[i] = VectorM(mColumns, defaultValue);
+	{
+		float* row = RowData(i);
+
+		for (uint32_t j = 0; j < mColumns; j++)
+			row[j] = defaultValue;
+
+		for (uint32_t j = mColumns; j < mStride; j++)
+			row[j] = 0;
+	}
 }
 
 MatrixM::MatrixM(const uint32_t _columns, const uint32_t _rows, const std::initializer_list<float>& data)
-	: mColumns(_columns), mRows(_rows)
+	: MatrixM(_columns, _rows, 0)
 {
 	size_t size = data.size();
 	assert(size == mRows * mColumns && "Can only constructs a Matrix M with Rows * Columns values");
 
 	__assume(size == mRows * mColumns);
 
-	mIsSquare = _columns == _rows;
-	mValues = std::make_shared<VectorM[]>(mRows);
-	VectorM* vec = mValues.get();
 	const float* src = data.begin();
 
 	for (uint32_t i = 0; i < mRows; i++)
-	{
-		vec[i] = VectorM(mColumns);
-		for (uint32_t j = 0; j < mColumns; j++)
-			vec[i][j] = src[i * mColumns + j];
-	}
+		std::memcpy(RowData(i), src + static_cast<size_t>(i) * mColumns, mColumns * sizeof(float));
+}
+
+MatrixM::MatrixM(ConstMatrixView view)
+	: MatrixM(view.GetNbrColumns(), view.GetNbrRows(), 0)
+{
+	for (uint32_t i = 0; i < mRows; i++)
+		std::memcpy(RowData(i), view[i].Data(), mColumns * sizeof(float));
+}
+
+MatrixM::MatrixM(const MatrixM& mat)
+	: mValues(mat.mValues), mColumns(mat.mColumns), mRows(mat.mRows), mStride(mat.mStride), mIsSquare(mat.mIsSquare)
+{
+}
+
+MatrixM::MatrixM(MatrixM&& mat) noexcept
+	: mValues(std::move(mat.mValues)), mColumns(std::exchange(mat.mColumns, 0)), mRows(std::exchange(mat.mRows, 0)),
+	  mStride(std::exchange(mat.mStride, 0)), mIsSquare(std::exchange(mat.mIsSquare, true))
+{
+}
+
+float* MatrixM::RowData(const uint32_t row)
+{
+	return mValues.Data() + static_cast<size_t>(row) * mStride;
+}
+
+const float* MatrixM::RowData(const uint32_t row) const
+{
+	return mValues.Data() + static_cast<size_t>(row) * mStride;
 }
 
 VectorM MatrixM::Diagonal() const
 {
 	uint32_t size = std::min(mRows, mColumns);
 	VectorM diag(size);
-	VectorM* vec = mValues.get();
 
 	for (uint32_t i = 0; i < size; i++)
-		diag[i] = vec[i][i];
+		diag[i] = RowData(i)[i];
 
 	return diag;
 }
@@ -71,31 +207,30 @@ VectorM MatrixM::Diagonal() const
 float MatrixM::Trace() const
 {
 	uint32_t size = std::min(mRows, mColumns);
-	VectorM* vec = mValues.get();
 	float trace = 0.f;
 
 	for (uint32_t i = 0; i < size; i++)
-		trace += vec[i][i];
+		trace += RowData(i)[i];
 
 	return trace;
 }
 
-VectorM& MatrixM::GetRow(uint32_t row)
+VectorView MatrixM::GetRow(uint32_t row)
 {
 	assert(row >= 0 && row < mRows && "Matrix M subscript out of range");
 
 	__assume(row >= 0 && row < mRows);
 
-	return mValues.get()[row];
+	return VectorView(RowData(row), mColumns);
 }
 
-const VectorM& MatrixM::GetRow(uint32_t row) const
+ConstVectorView MatrixM::GetRow(uint32_t row) const
 {
 	assert(row >= 0 && row < mRows && "Matrix M subscript out of range");
 
 	__assume(row >= 0 && row < mRows);
 
-	return mValues.get()[row];
+	return ConstVectorView(RowData(row), mColumns);
 }
 
 uint32_t MatrixM::GetNbrColumns() const
@@ -108,6 +243,41 @@ uint32_t MatrixM::GetNbrRows() const
 	return mRows;
 }
 
+uint32_t MatrixM::GetStride() const
+{
+	return mStride;
+}
+
+float* MatrixM::Data()
+{
+	return mValues.Data();
+}
+
+const float* MatrixM::Data() const
+{
+	return mValues.Data();
+}
+
+MatrixView MatrixM::View()
+{
+	return MatrixView(mValues.Data(), mColumns, mRows, mStride);
+}
+
+ConstMatrixView MatrixM::View() const
+{
+	return ConstMatrixView(mValues.Data(), mColumns, mRows, mStride);
+}
+
+MatrixView MatrixM::Block(const uint32_t x, const uint32_t y, const uint32_t columns, const uint32_t rows)
+{
+	return View().Block(x, y, columns, rows);
+}
+
+ConstMatrixView MatrixM::Block(const uint32_t x, const uint32_t y, const uint32_t columns, const uint32_t rows) const
+{
+	return View().Block(x, y, columns, rows);
+}
+
 const bool MatrixM::IsSquare() const
 {
 	return mIsSquare;
@@ -115,16 +285,16 @@ const bool MatrixM::IsSquare() const
 
 const bool MatrixM::IsDiagonal() const
 {
-	VectorM* data = mValues.get();
-
 	for (uint32_t i = 0; i < mRows; i++)
 	{
+		const float* row = RowData(i);
+
 		for (uint32_t j = 0; j < mRows; j++)
 		{
 			if (i == j)
 				continue;
 
-			if (data[i][j] != 0)
+			if (row[j] != 0)
 				return false;
 		}
 	}
@@ -135,7 +305,6 @@ const bool MatrixM::IsDiagonal() const
 void MatrixM::GaussJordanPivot()
 {
 	uint32_t lastPivotIndex = 0;
-	uint8_t i = 0;
 
 	if (_ITERATOR_DEBUG_LEVEL)
 	{
@@ -146,12 +315,12 @@ void MatrixM::GaussJordanPivot()
 	for (uint32_t j = 0; j < mRows; j++)
 	{
 		// Try find pivot of current column
-		float_t pivotValue = GetRow(j)[lastPivotIndex];
-		uint8_t currPivotLine = lastPivotIndex;
+		float_t pivotValue = RowData(j)[lastPivotIndex];
+		uint32_t currPivotLine = lastPivotIndex;
 
-		for (uint8_t _y = lastPivotIndex; _y < mRows; _y++)
+		for (uint32_t _y = lastPivotIndex; _y < mRows; _y++)
 		{
-			float_t value = GetRow(_y)[j];
+			float_t value = RowData(_y)[j];
 			if (fabsf(value) > pivotValue)
 			{
 				pivotValue = value;
@@ -163,46 +332,45 @@ void MatrixM::GaussJordanPivot()
 			continue;
 
 		if (_ITERATOR_DEBUG_LEVEL)
-			std::cout << "Found pivot (" << pivotValue << ") on row " << (int)currPivotLine << std::endl;
+			std::cout << "Found pivot (" << pivotValue << ") on row " << currPivotLine << std::endl;
 
 		// Normalize pivot row
-		GetRow(currPivotLine).Divide(pivotValue);
+		float* pivotRow = RowData(currPivotLine);
+
+		for (uint32_t _x = 0; _x < mColumns; _x++)
+			pivotRow[_x] /= pivotValue;
 
 		if (_ITERATOR_DEBUG_LEVEL)
 		{
-			std::cout << "Normalizing row " << (int)currPivotLine << std::endl;
+			std::cout << "Normalizing row " << currPivotLine << std::endl;
 			Log();
 		}
-		
+
 		// Permute rows to have the pivot line at the current row
 		if (lastPivotIndex != currPivotLine)
 		{
-			VectorM& pivotRow = GetRow(currPivotLine);
-			VectorM& lastPivotRow = GetRow(lastPivotIndex);
-
-			for (uint8_t _x = 0; _x < mColumns; _x++)
-				std::swap(lastPivotRow[_x], pivotRow[_x]);
+			std::swap_ranges(pivotRow, pivotRow + mColumns, RowData(lastPivotIndex));
 
 			if (_ITERATOR_DEBUG_LEVEL)
 			{
-				std::cout << "Swapping rows " << (int)currPivotLine << " and " << lastPivotIndex << std::endl;
+				std::cout << "Swapping rows " << currPivotLine << " and " << lastPivotIndex << std::endl;
 				Log();
 			}
 		}
 
-		for (uint8_t _y = 0; _y < mRows; _y++)
+		const float* lastPivotRow = RowData(lastPivotIndex);
+
+		for (uint32_t _y = 0; _y < mRows; _y++)
 		{
 			if (_y == lastPivotIndex)
 				continue;
 
-			VectorM& row = GetRow(_y);
+			float* row = RowData(_y);
 
 			float_t alpha = row[j];
-			for (uint8_t _x = 0; _x < mColumns; _x++)
+			for (uint32_t _x = 0; _x < mColumns; _x++)
 			{
-				float_t iValue = row[_x];
-				float_t rValue = GetRow(lastPivotIndex)[_x];
-				row[_x] = iValue - rValue * alpha;
+				row[_x] -= lastPivotRow[_x] * alpha;
 
 				if (fabsf(row[_x]) < 1e-6)
 					row[_x] = 0;
@@ -210,7 +378,7 @@ void MatrixM::GaussJordanPivot()
 
 			if (_ITERATOR_DEBUG_LEVEL)
 			{
-				std::cout << "Zero-ing row " << (int)_y << std::endl;
+				std::cout << "Zero-ing row " << _y << std::endl;
 				Log();
 			}
 		}
@@ -224,36 +392,7 @@ bool MatrixM::Inverse(MatrixM& dst) const
 	if (!mIsSquare)
 		return false;
 
-	__assume(mRows == mColumns);
-
-	MatrixM identity;
-	MatrixM augmented;
-	GetIdentity(mRows, identity);
-	Augment(identity, augmented);
-	augmented.GaussJordanPivot();
-
-	augmented.Log();
-
-	if (!augmented.IsDiagonal())
-		return false;
-
-	for (uint32_t i = 0; i < mRows; i++)
-	{
-		if (augmented[i][i] != 1)
-			return false;
-	}
-
-	dst = MatrixM(mColumns, mRows, 0);
-
-	for (uint32_t i = 0; i < mRows; i++)
-	{
-		VectorM& rowDst = dst.GetRow(i);
-		VectorM& rowSrc = augmented.GetRow(i);
-		for (uint32_t j = 0; j < mColumns; j++)
-			rowDst[j] = rowSrc[mColumns + j];
-	}
-
-	return true;
+	return LUDecomposition(*this).Inverse(dst);
 }
 
 void MatrixM::Augment(const MatrixM& in, MatrixM& out) const
@@ -264,20 +403,12 @@ void MatrixM::Augment(const MatrixM& in, MatrixM& out) const
 
 	out = MatrixM(mColumns + in.mColumns, mRows, 0);
 
-	VectorM* data = out.mValues.get();
-	VectorM* srcLeft = mValues.get();
-	VectorM* srcRight = in.mValues.get();
-
 	for (uint32_t i = 0; i < mRows; i++)
 	{
-		VectorM& vec = data[i];
-
-		uint32_t j;
-		for (j = 0; j < mColumns; j++)
-			vec[j] = srcLeft[i][j];
-	
-		for (uint32_t k = 0; k < in.mColumns; k++)
-			vec[j++] = srcRight[i][k];
+		float* row = out.RowData(i);
+
+		std::memcpy(row, RowData(i), mColumns * sizeof(float));
+		std::memcpy(row + mColumns, in.RowData(i), in.mColumns * sizeof(float));
 	}
 }
 
@@ -285,31 +416,38 @@ void MatrixM::Transpose(MatrixM& out) const
 {
 	out = MatrixM(mRows, mColumns, 0);
 
-	VectorM* vec = mValues.get();
-
 	for (uint32_t i = 0; i < mRows; i++)
 	{
+		const float* row = RowData(i);
+
 		for (uint32_t j = 0; j < mColumns; j++)
-			out[j][i] = vec[i][j];
+			out.RowData(j)[i] = row[j];
 	}
 }
 
 MatrixM& MatrixM::Negate()
 {
-	VectorM* vec = mValues.get();
-
 	for (uint32_t i = 0; i < mRows; i++)
-		vec->Negate();
+	{
+		float* row = RowData(i);
+
+		for (uint32_t j = 0; j < mColumns; j++)
+			row[j] = -row[j];
+	}
 
 	return *this;
 }
 
 MatrixM& MatrixM::Add(const float scalar)
 {
-	VectorM* vec = mValues.get();
-
+	// The padding is left untouched so it stays 0
 	for (uint32_t i = 0; i < mRows; i++)
-		vec->Add(scalar);
+	{
+		float* row = RowData(i);
+
+		for (uint32_t j = 0; j < mColumns; j++)
+			row[j] += scalar;
+	}
 
 	return *this;
 }
@@ -320,42 +458,55 @@ MatrixM& MatrixM::Add(const MatrixM& mat)
 
 	__assume(mat.mColumns == mColumns && mat.mRows == mRows);
 
-	VectorM* vec = mValues.get();
+	// Both matrices have the same stride, the padding is 0 on both sides
+	float* dst = mValues.Data();
+	const float* src = mat.mValues.Data();
+	const size_t size = mValues.Size();
 
-	for (uint32_t i = 0; i < mRows; i++)
-		vec[i].Add(mat[i]);
+	for (size_t i = 0; i < size; i++)
+		dst[i] += src[i];
 
 	return *this;
 }
 
 MatrixM& MatrixM::Multiply(const float scalar)
 {
-	VectorM* vec = mValues.get();
-
 	for (uint32_t i = 0; i < mRows; i++)
-		vec->Multiply(scalar);
+	{
+		float* row = RowData(i);
+
+		for (uint32_t j = 0; j < mColumns; j++)
+			row[j] *= scalar;
+	}
 
 	return *this;
 }
 
-MatrixM& MatrixM::Multiply(const MatrixM& mat)
+MatrixM& MatrixM::Multiply(const MatrixM& mat, ThreadPool* const pool)
 {
 	assert(mColumns == mat.mRows && "Can only multiply matrices where the number of column/row differ");
 
 	__assume(mColumns == mat.mRows);
 
-	MatrixM result(mRows, mat.mColumns, 0);
+	MatrixM result(mat.mColumns, mRows, 0);
+
+	const uint32_t blockCount = (mRows + MultiplyRowBlock - 1) / MultiplyRowBlock;
+	const uint64_t work = static_cast<uint64_t>(mRows) * mColumns * mat.mColumns;
 
-	for (size_t i = 0; i < result.mRows; i++)
+	if (pool != nullptr && blockCount > 1 && work >= MultiplyParallelThreshold)
 	{
-		for (size_t j = 0; j < result.mColumns; j++)
-		{
-			for (size_t k = 0; k < mColumns; k++)
-				result[i][j] += mValues[i][k] * mat[k][j];
-		}
+		// Every task writes its own rows of the result
+		pool->ParallelFor(blockCount, [&](const uint32_t block)
+			{
+				MultiplyRows(*this, mat, result, block * MultiplyRowBlock, std::min(mRows, (block + 1) * MultiplyRowBlock));
+			});
+	}
+	else
+	{
+		MultiplyRows(*this, mat, result, 0, mRows);
 	}
 
-	result.DeepCopy(*this);
+	*this = std::move(result);
 
 	return *this;
 }
@@ -365,26 +516,7 @@ float MatrixM::Determinant() const
 	if (!mIsSquare)
 		return 0.f;
 
-	if (mRows == 2)
-	{
-		return mValues[0][0] * mValues[1][1] - mValues[0][1] * mValues[1][0];
-	}
-
-	float det = 0.f;
-
-	MatrixM buffer;
-	for (uint32_t i = 0; i < mRows; i++)
-	{
-		SubMatrix((i + 1) % mRows, 1, mRows - 1, mColumns - 1, false, buffer);
-		float subDet = buffer.Determinant();
-		subDet *= mValues[i][0];
-		if (i & 1)
-			det -= subDet;
-		else
-			det += subDet;
-	}
-
-	return det;
+	return LUDecomposition(*this).Determinant();
 }
 
 void MatrixM::SubMatrix(const uint32_t x, const uint32_t y, const uint32_t sizeX, const uint32_t sizeY,
@@ -401,54 +533,39 @@ void MatrixM::SubMatrix(const uint32_t x, const uint32_t y, const uint32_t sizeX
 
 	for (uint32_t i = 0; i < sizeX; i++)
 	{
+		const float* src = i < overflow ? RowData(i) : RowData(x + i - overflow);
+		float* row = dst.RowData(i);
+
 		for (uint32_t j = 0; j < sizeY; j++)
-		{
-			if (i < overflow)
-				dst[i][j] = mValues[i][y + j];
-			else
-				dst[i][j] = mValues[x + i - overflow][y + j];
-		}
+			row[j] = src[y + j];
 	}
 }
 
-void MatrixM::ShallowCopy(MatrixM& out)
-{
-	out.mRows = mRows;
-	out.mColumns = mColumns;
-	out.mIsSquare = mIsSquare;
-	out.mValues = mValues;
-}
-
 void MatrixM::DeepCopy(MatrixM& out) const
 {
 	out.mRows = mRows;
 	out.mColumns = mColumns;
+	out.mStride = mStride;
 	out.mIsSquare = mIsSquare;
-
-	out.mValues = std::make_shared<VectorM[]>(mRows);
-	VectorM* dst = out.mValues.get();
-	VectorM* src = mValues.get();
-	
-	for (uint32_t i = 0; i < mRows; i++)
-		src[i].DeepCopy(dst[i]);
+	out.mValues = mValues;
 }
 
-VectorM& MatrixM::operator[](uint32_t i)
+VectorView MatrixM::operator[](uint32_t i)
 {
 	assert(i >= 0 && i < mRows && "Matrix M subscript out of range");
 
 	__assume(i >= 0 && i < mRows);
 
-	return mValues.get()[i];
+	return VectorView(RowData(i), mColumns);
 }
 
-const VectorM& MatrixM::operator[](uint32_t i) const
+ConstVectorView MatrixM::operator[](uint32_t i) const
 {
 	assert(i >= 0 && i < mRows && "Matrix M subscript out of range");
 
 	__assume(i >= 0 && i < mRows);
 
-	return mValues.get()[i];
+	return ConstVectorView(RowData(i), mColumns);
 }
 
 MatrixM& MatrixM::operator=(const MatrixM& mat)
@@ -457,23 +574,55 @@ MatrixM& MatrixM::operator=(const MatrixM& mat)
 	return *this;
 }
 
+MatrixM& MatrixM::operator=(MatrixM&& mat) noexcept
+{
+	mValues = std::move(mat.mValues);
+	mColumns = std::exchange(mat.mColumns, 0);
+	mRows = std::exchange(mat.mRows, 0);
+	mStride = std::exchange(mat.mStride, 0);
+	mIsSquare = std::exchange(mat.mIsSquare, true);
+	return *this;
+}
+
 void MatrixM::GetIdentity(uint32_t size, MatrixM& out)
 {
 	out = MatrixM(size, 0);
 	for (uint32_t i = 0; i < size; i++)
-		out[i][i] = 1;
+		out.RowData(i)[i] = 1;
 }
 
-void MatrixM::Log()
+void MatrixM::AddScaled(float* const dst, const float* const src, const float scale, const uint32_t count)
 {
-	VectorM* vec = mValues.get();
+	uint32_t j = 0;
+
+#ifdef MATHS_SIMD_AVX
+	const __m256 scale8 = _mm256_set1_ps(scale);
+
+	for (; j + 8 <= count; j += 8)
+		_mm256_storeu_ps(dst + j, _mm256_add_ps(_mm256_loadu_ps(dst + j), _mm256_mul_ps(scale8, _mm256_loadu_ps(src + j))));
+#endif
+
+#ifdef MATHS_SIMD_SSE
+	const __m128 scale4 = _mm_set1_ps(scale);
 
+	for (; j + 4 <= count; j += 4)
+		_mm_storeu_ps(dst + j, _mm_add_ps(_mm_loadu_ps(dst + j), _mm_mul_ps(scale4, _mm_loadu_ps(src + j))));
+#endif
+
+	for (; j < count; j++)
+		dst[j] += scale * src[j];
+}
+
+void MatrixM::Log() const
+{
 	for (uint32_t i = 0; i < mRows; i++)
 	{
+		const float* row = RowData(i);
+
 		std::cout << "[ ";
 		for (uint32_t j = 0; j < mColumns; j++)
 		{
-			std::cout << std::to_string(vec[i][j]);
+			std::cout << std::to_string(row[j]);
 			if (j != mColumns - 1)
 				std::cout << ", ";
 		}
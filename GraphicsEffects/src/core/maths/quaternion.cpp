@@ -0,0 +1,262 @@
+#include "core/maths/quaternion.h"
+#include "core/maths/vector3.h"
+#include "core/maths/matrix3x3.h"
+#include "core/maths/matrix4x4.h"
+#include "core/maths/simd.h"
+#include <cmath>
+
+const Quaternion Quaternion::Identity = Quaternion(0.f, 0.f, 0.f, 1.f);
+
+#ifdef MATHS_SIMD_SSE
+static inline __m128 Load(const Quaternion& q)
+{
+	return _mm_loadu_ps(&q.x);
+}
+
+static inline void Store(Quaternion& q, const __m128 value)
+{
+	_mm_storeu_ps(&q.x, value);
+}
+#endif
+
+/// <summary>
+/// Converts a rotation matrix given by its elements (Shepperd's method, divides by the largest diagonal term)
+/// </summary>
+static Quaternion FromRotation(
+	const float r00, const float r01, const float r02,
+	const float r10, const float r11, const float r12,
+	const float r20, const float r21, const float r22)
+{
+	const float trace = r00 + r11 + r22;
+
+	if (trace > 0.f)
+	{
+		const float s = std::sqrt(trace + 1.f) * 2.f;
+		return Quaternion((r21 - r12) / s, (r02 - r20) / s, (r10 - r01) / s, 0.25f * s);
+	}
+
+	if (r00 > r11 && r00 > r22)
+	{
+		const float s = std::sqrt(1.f + r00 - r11 - r22) * 2.f;
+		return Quaternion(0.25f * s, (r01 + r10) / s, (r02 + r20) / s, (r21 - r12) / s);
+	}
+
+	if (r11 > r22)
+	{
+		const float s = std::sqrt(1.f + r11 - r00 - r22) * 2.f;
+		return Quaternion((r01 + r10) / s, 0.25f * s, (r12 + r21) / s, (r02 - r20) / s);
+	}
+
+	const float s = std::sqrt(1.f + r22 - r00 - r11) * 2.f;
+	return Quaternion((r02 + r20) / s, (r12 + r21) / s, 0.25f * s, (r10 - r01) / s);
+}
+
+Quaternion::Quaternion()
+	: x(0.f), y(0.f), z(0.f), w(1.f)
+{
+}
+
+Quaternion::Quaternion(const float _x, const float _y, const float _z, const float _w)
+	: x(_x), y(_y), z(_z), w(_w)
+{
+}
+
+Quaternion Quaternion::FromAxisAngle(const float angle, const Vector3& axis)
+{
+	const float s = std::sin(angle * 0.5f);
+	return Quaternion(axis.x * s, axis.y * s, axis.z * s, std::cos(angle * 0.5f));
+}
+
+Quaternion Quaternion::FromEuler(const Vector3& euler)
+{
+	// qz * qy * qx, expanded
+	const float cx = std::cos(euler.x * 0.5f);
+	const float sx = std::sin(euler.x * 0.5f);
+	const float cy = std::cos(euler.y * 0.5f);
+	const float sy = std::sin(euler.y * 0.5f);
+	const float cz = std::cos(euler.z * 0.5f);
+	const float sz = std::sin(euler.z * 0.5f);
+
+	return Quaternion(
+		sx * cy * cz - cx * sy * sz,
+		cx * sy * cz + sx * cy * sz,
+		cx * cy * sz - sx * sy * cz,
+		cx * cy * cz + sx * sy * sz
+	);
+}
+
+Quaternion Quaternion::FromMatrix(const Matrix3x3& mat)
+{
+	return FromRotation(
+		mat.Row0.x, mat.Row0.y, mat.Row0.z,
+		mat.Row1.x, mat.Row1.y, mat.Row1.z,
+		mat.Row2.x, mat.Row2.y, mat.Row2.z
+	);
+}
+
+Quaternion Quaternion::FromMatrix(const Matrix4x4& mat)
+{
+	return FromRotation(
+		mat.Row0.x, mat.Row0.y, mat.Row0.z,
+		mat.Row1.x, mat.Row1.y, mat.Row1.z,
+		mat.Row2.x, mat.Row2.y, mat.Row2.z
+	);
+}
+
+Vector3 Quaternion::ToEuler() const
+{
+	const float r00 = 1.f - 2.f * (y * y + z * z), r01 = 2.f * (x * y - w * z), r02 = 2.f * (x * z + w * y);
+	const float r10 = 2.f * (x * y + w * z),       r11 = 1.f - 2.f * (x * x + z * z), r12 = 2.f * (y * z - w * x);
+	const float r20 = 2.f * (x * z - w * y),       r21 = 2.f * (y * z + w * x),       r22 = 1.f - 2.f * (x * x + y * y);
+
+	// The angle around Z is solved once the one around X is removed, so it stays right at gimbal lock where r21 and r22 are 0
+	const float angleX = std::atan2(r21, r22);
+	const float sinX = std::sin(angleX);
+	const float cosX = std::cos(angleX);
+
+	return Vector3(
+		angleX,
+		std::atan2(-r20, std::sqrt(r00 * r00 + r10 * r10)),
+		std::atan2(sinX * r02 - cosX * r01, cosX * r11 - sinX * r12)
+	);
+}
+
+void Quaternion::ToMatrix(Matrix3x3& dst) const
+{
+	const float xx = x * x, yy = y * y, zz = z * z;
+	const float xy = x * y, xz = x * z, yz = y * z;
+	const float wx = w * x, wy = w * y, wz = w * z;
+
+	dst = Matrix3x3(
+		1.f - 2.f * (yy + zz), 2.f * (xy - wz),       2.f * (xz + wy),
+		2.f * (xy + wz),       1.f - 2.f * (xx + zz), 2.f * (yz - wx),
+		2.f * (xz - wy),       2.f * (yz + wx),       1.f - 2.f * (xx + yy)
+	);
+}
+
+float Quaternion::Norm() const
+{
+	return std::sqrt(NormSquared());
+}
+
+float Quaternion::NormSquared() const
+{
+	return x * x + y * y + z * z + w * w;
+}
+
+Quaternion Quaternion::Normalize() const
+{
+	const float norm = Norm();
+
+	if (norm == 0.f)
+		return Identity;
+
+	return Quaternion(x / norm, y / norm, z / norm, w / norm);
+}
+
+Quaternion Quaternion::Conjugate() const
+{
+	return Quaternion(-x, -y, -z, w);
+}
+
+Vector3 Quaternion::Rotate(const Vector3& vec) const
+{
+	// v + 2w (q x v) + 2 q x (q x v)
+	const Vector3 q(x, y, z);
+	const Vector3 t = Vector3::CrossProduct(q, vec) * 2.f;
+
+	return vec + t * w + Vector3::CrossProduct(q, t);
+}
+
+float Quaternion::DotProduct(const Quaternion& a, const Quaternion& b)
+{
+	return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+}
+
+Quaternion Quaternion::Multiply(const Quaternion& a, const Quaternion& b)
+{
+	Quaternion result;
+
+#ifdef MATHS_SIMD_SSE
+	// Hamilton product, one column of terms per component of a
+	const __m128 va = Load(a);
+	const __m128 vb = Load(b);
+
+	const __m128 signX = _mm_setr_ps(0.f, -0.f, 0.f, -0.f);
+	const __m128 signY = _mm_setr_ps(0.f, 0.f, -0.f, -0.f);
+	const __m128 signZ = _mm_setr_ps(-0.f, 0.f, 0.f, -0.f);
+
+	__m128 sum = _mm_mul_ps(Simd::Splat<3>(va), vb);
+	sum = _mm_add_ps(sum, _mm_xor_ps(_mm_mul_ps(Simd::Splat<0>(va), Simd::Swizzle<3, 2, 1, 0>(vb)), signX));
+	sum = _mm_add_ps(sum, _mm_xor_ps(_mm_mul_ps(Simd::Splat<1>(va), Simd::Swizzle<2, 3, 0, 1>(vb)), signY));
+	sum = _mm_add_ps(sum, _mm_xor_ps(_mm_mul_ps(Simd::Splat<2>(va), Simd::Swizzle<1, 0, 3, 2>(vb)), signZ));
+
+	Store(result, sum);
+#else
+	result.x = a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y;
+	result.y = a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x;
+	result.z = a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w;
+	result.w = a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z;
+#endif
+
+	return result;
+}
+
+Quaternion Quaternion::Slerp(const Quaternion& a, const Quaternion& b, const float t)
+{
+	float dot = DotProduct(a, b);
+
+	// q and -q are the same rotation, going to the closest one takes the shortest arc
+	const float sign = dot < 0.f ? -1.f : 1.f;
+	dot *= sign;
+
+	// sin(theta) tends to 0, the arc is short enough to be a line
+	if (dot > 0.9995f)
+		return Nlerp(a, b, t);
+
+	const float theta = std::acos(dot);
+	const float invSin = 1.f / std::sin(theta);
+	const float wa = std::sin((1.f - t) * theta) * invSin;
+	const float wb = std::sin(t * theta) * invSin * sign;
+
+	return Quaternion(
+		a.x * wa + b.x * wb,
+		a.y * wa + b.y * wb,
+		a.z * wa + b.z * wb,
+		a.w * wa + b.w * wb
+	);
+}
+
+Quaternion Quaternion::Nlerp(const Quaternion& a, const Quaternion& b, const float t)
+{
+	const float wa = 1.f - t;
+	const float wb = DotProduct(a, b) < 0.f ? -t : t;
+
+	return Quaternion(
+		a.x * wa + b.x * wb,
+		a.y * wa + b.y * wb,
+		a.z * wa + b.z * wb,
+		a.w * wa + b.w * wb
+	).Normalize();
+}
+
+Quaternion Quaternion::operator*(const Quaternion& q) const
+{
+	return Multiply(*this, q);
+}
+
+Quaternion& Quaternion::operator*=(const Quaternion& q)
+{
+	*this = Multiply(*this, q);
+	return *this;
+}
+
+bool Quaternion::operator==(const Quaternion& q) const
+{
+	return x == q.x && y == q.y && z == q.z && w == q.w;
+}
+
+bool Quaternion::operator!=(const Quaternion& q) const
+{
+	return !(*this == q);
+}
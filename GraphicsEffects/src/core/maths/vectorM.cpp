@@ -1,6 +1,7 @@
 #include "core/maths/vectorM.h"
 #include <assert.h>
 #include <cmath>
+#include <cstring>
 #include <iostream>
 
 #include "core/maths/vector2.h"
@@ -10,37 +11,41 @@
 VectorM::VectorM()
 	: mSize(0)
 {
-	mValues.resize(0);
 }
 
 VectorM::VectorM(const uint32_t _size)
-	: mSize(_size)
+	: mValues(_size), mSize(_size)
 {
-	mValues.resize(mSize);
 }
 
 VectorM::VectorM(const uint32_t _size, const float defaultValue)
-	: mSize(_size)
+	: mValues(_size), mSize(_size)
 {
-	mValues.resize(mSize);
-
-	for (uint32_t i = 0; i < _size; i++)
-		mValues[i] = defaultValue;
+	mValues.Fill(defaultValue);
 }
 
 VectorM::VectorM(const std::initializer_list<float>& data)
-	: mSize(data.size())
+	: mValues(data.size()), mSize(static_cast<uint32_t>(data.size()))
 {
-	mValues.resize(mSize);
+	if (mSize != 0)
+		std::memcpy(mValues.Data(), data.begin(), mSize * sizeof(float));
+}
 
-	const float* it = data.begin();
-	for (uint32_t i = 0; i < mSize; i++)
-		mValues[i] = *it++;
+VectorM::VectorM(ConstVectorView view)
+	: mValues(view.Size()), mSize(view.Size())
+{
+	if (mSize != 0)
+		std::memcpy(mValues.Data(), view.Data(), mSize * sizeof(float));
 }
 
 VectorM::VectorM(const VectorM& vec)
+	: mValues(vec.mValues), mSize(vec.mSize)
+{
+}
+
+VectorM::VectorM(VectorM&& vec) noexcept
+	: mValues(std::move(vec.mValues)), mSize(std::exchange(vec.mSize, 0))
 {
-	vec.DeepCopy(*this);
 }
 
 VectorM::~VectorM()
@@ -193,19 +198,10 @@ float VectorM::Distance(const VectorM& a, const VectorM& b)
 	return std::sqrt(dist);
 }
 
-void VectorM::ShallowCopy(VectorM& out)
-{
-	out.mValues = mValues;
-	out.mSize = mSize;
-}
-
 void VectorM::DeepCopy(VectorM& out) const
 {
-	out.mValues = std::vector<float>(mSize);
+	out.mValues = mValues;
 	out.mSize = mSize;
-
-	for (uint32_t i = 0; i < mSize; i++)
-		out.mValues[i] = mValues[i];
 }
 
 void VectorM::Log() const
@@ -220,12 +216,39 @@ void VectorM::Log() const
 	std::cout << " ]" << std::endl;
 }
 
+VectorView VectorM::View()
+{
+	return VectorView(mValues.Data(), mSize);
+}
+
+ConstVectorView VectorM::View() const
+{
+	return ConstVectorView(mValues.Data(), mSize);
+}
+
+float* VectorM::Data()
+{
+	return mValues.Data();
+}
+
+const float* VectorM::Data() const
+{
+	return mValues.Data();
+}
+
 VectorM& VectorM::operator=(const VectorM& vec)
 {
 	vec.DeepCopy(*this);
 	return *this;
 }
 
+VectorM& VectorM::operator=(VectorM&& vec) noexcept
+{
+	mValues = std::move(vec.mValues);
+	mSize = std::exchange(vec.mSize, 0);
+	return *this;
+}
+
 float& VectorM::operator[](int i)
 {
 	int32_t size = mSize;
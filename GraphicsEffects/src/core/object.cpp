@@ -7,7 +7,8 @@ Shader* Object::m_OutlineShader;
 
 
 Object::Object(Shader* const shader, Model* const model, Texture* const texture, const Vector4 outlineColor)
-	: m_Shader(shader), m_Model(model), m_Texture(texture), Transformation(*this), m_OutlineColor(outlineColor)
+	: m_Shader(shader), m_Model(model), m_Texture(texture), Transformation(*this), m_OutlineColor(outlineColor),
+	  Outlined(false), Color(1.f)
 {
 	if (shader == nullptr || model == nullptr || texture == nullptr)
 		m_Hidden = true;
@@ -19,8 +20,9 @@ Object::Object(Shader* const shader, Model* const model, Texture* const texture,
 }
 
 Object::Object(Shader* const shader, Model* const model, Texture* const texture, const Vector4 outlineColor,
-	const Vector3& position, const Vector3& rotation, const Vector3& scaling)
-	: m_Shader(shader), m_Model(model), m_Texture(texture), m_OutlineColor(outlineColor), Transformation(*this, position, rotation, scaling)
+	const Vector3& position, const Quaternion& rotation, const Vector3& scaling)
+	: m_Shader(shader), m_Model(model), m_Texture(texture), m_OutlineColor(outlineColor), Transformation(*this, position, rotation, scaling),
+	  Outlined(false), Color(1.f)
 {
 	m_Components.clear();
 	if (shader == nullptr || model == nullptr || texture == nullptr)
@@ -92,63 +94,64 @@ Shader& Object::GetShader()
 	return *m_Shader;
 }
 
-void Object::Render()
+bool Object::HasTexture() const
 {
-	Transformation.UpdateTransformation();
+	return m_Texture != nullptr;
+}
 
-	if (m_Hidden)
-		return;
+Texture& Object::GetTexture()
+{
+	return *m_Texture;
+}
 
-	OnPreRender();
-	Camera* cam = Camera::Instance;
+bool Object::IsHidden() const
+{
+	return m_Hidden;
+}
 
-	Matrix4x4 mvp;
-	const Matrix4x4& model = Transformation.GetGlobalTransform();
-	Matrix4x4::Multiply(cam->GetProjView(), model, mvp);
+bool Object::HasModel() const
+{
+	return m_Model != nullptr;
+}
 
-	glActiveTexture(GL_TEXTURE0);
-	m_Texture->Use();
-	m_Shader->Use();
+Model& Object::GetModel()
+{
+	return *m_Model;
+}
 
-	m_Shader->SetUniform("mvp", mvp);
-	m_Shader->SetUniform("model", model);
-	cam->SendToShader(*m_Shader);
+void Object::BeginOutline()
+{
+	glEnable(GL_STENCIL_TEST);
+	glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
+	glStencilFunc(GL_ALWAYS, 1, 0xFF);
+	glStencilMask(0xFF);
+}
 
-	m_Shader->Use();
-	
-	if (Outlined)
-	{
-		glEnable(GL_STENCIL_TEST);
-		glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
-		glStencilFunc(GL_ALWAYS, 1, 0xFF);
-		glStencilMask(0xFF);
-	}
-	
+bool Object::DrawOutline(const Matrix4x4& projView)
+{
+	if (m_OutlineShader == nullptr)
+		return false;
+
+	glStencilFunc(GL_NOTEQUAL, 1, 0xFF);
+	glStencilMask(0x00);
+	glDisable(GL_DEPTH_TEST);
+
+	m_OutlineShader->Use();
+	m_OutlineShader->SetUniform("Color", m_OutlineColor);
+	// Scaling the model by 1.1 is the same as appending a scaling to the global matrix,
+	// this way the transform isn't modified and doesn't need to be recomputed
+	Matrix4x4 outlineScaling, outlineModel, mvp;
+	Matrix4x4::Scaling(Vector3(1.1f), outlineScaling);
+	Matrix4x4::Multiply(Transformation.GetGlobalTransform(), outlineScaling, outlineModel);
+	Matrix4x4::Multiply(projView, outlineModel, mvp);
+	m_OutlineShader->SetUniform(ShaderUniform::MVP, mvp);
 	m_Model->Render();
 
-	if (Outlined)
-	{
-		glStencilFunc(GL_NOTEQUAL, 1, 0xFF);
-		glStencilMask(0x00);
-		glDisable(GL_DEPTH_TEST);
-
-		m_OutlineShader->Use();
-		m_OutlineShader->SetUniform("Color", m_OutlineColor);
-		Vector3 scale = Transformation.Scaling;
-		Transformation.Scaling *= 1.1f;
-		Transformation.UpdateTransformation();
-		const Matrix4x4& model = Transformation.GetGlobalTransform();
-		Matrix4x4::Multiply(cam->GetProjView(), model, mvp);
-		m_OutlineShader->SetUniform("mvp", mvp);
-		m_Model->Render();
-		Transformation.Scaling = scale;
-
-		glStencilMask(0xFF);
-		glStencilFunc(GL_ALWAYS, 1, 0xFF);
-		glEnable(GL_DEPTH_TEST);
-	}
+	glStencilMask(0xFF);
+	glStencilFunc(GL_ALWAYS, 1, 0xFF);
+	glEnable(GL_DEPTH_TEST);
 
-	OnPostRender();
+	return true;
 }
 
 void Object::OnGui()
@@ -1,11 +1,14 @@
 #include "core/scene.hpp"
+#include "renderer/camera.hpp"
+#include "renderer/frustum.hpp"
 
-#include "resources/shader.hpp"
+#include <cmath>
 
 #include "ImGui/imgui.h"
 
 #include "core/debug/log.hpp"
 #include "core/debug/assert.hpp"
+#include "core/debug/profiler.hpp"
 
 Scene* Scene::m_CurrentScene;
 
@@ -15,8 +18,9 @@ Scene* Scene::CurrentScene()
 	return m_CurrentScene;
 }
 
-Scene::Scene(const std::string& name)
-	: m_Root(nullptr, nullptr, nullptr, Vector4(0.f)), m_Name(name)
+Scene::Scene(const std::string& name, ThreadPool* const pool)
+	: m_Root(nullptr, nullptr, nullptr, Vector4(0.f)), m_Name(name), m_DirLightBuffer(LightBinding::DIRECTIONAL),
+	  m_PointLightBuffer(LightBinding::POINT), m_SpotLightBuffer(LightBinding::SPOT), m_Clusters(pool), m_CullingStats(), m_Queue(pool)
 {
 	if (m_CurrentScene == nullptr)
 		m_CurrentScene = this;
@@ -60,52 +64,232 @@ void Scene::RemoveSpotLight(SpotLight* const light)
 	std::erase(m_SpotLights, light);
 }
 
-void Scene::ApplyLights(Shader& shader)
+template <typename T>
+static void GetLightBounds(const std::vector<T*>& lights, std::vector<LightBounds>& bounds)
 {
-	// There is probably a better way to do this
-	shader.Use();
+	bounds.resize(lights.size());
 
-	shader.SetUniform("nbrDirLights", static_cast<int32_t>(m_DirLights.size()));
-	for (size_t i = 0; i < m_DirLights.size(); i++)
+	for (size_t i = 0; i < lights.size(); i++)
+		bounds[i] = LightBounds{ lights[i]->Owner->Transformation.GetPosition(), lights[i]->Radius };
+}
+
+void Scene::ApplyLights(const Camera& camera)
+{
+	m_DirLightBuffer.Update(m_DirLights);
+	m_PointLightBuffer.Update(m_PointLights);
+	m_SpotLightBuffer.Update(m_SpotLights);
+
+	m_DirLightBuffer.Bind();
+	m_PointLightBuffer.Bind();
+	m_SpotLightBuffer.Bind();
+
+	// Directional lights light everything, they aren't clustered
+	GetLightBounds(m_PointLights, m_PointBounds);
+	GetLightBounds(m_SpotLights, m_SpotBounds);
+
+	const ClusterView view{ camera.Position, camera.GetRight(), camera.GetUp(), camera.GetFront(),
+		camera.Fov, camera.ScreenSize, camera.DepthNear, camera.DepthFar };
+
+	ProfileScope scope("Light clusters");
+
+	m_Clusters.Build(view, m_PointBounds, m_SpotBounds);
+	m_Clusters.Upload();
+}
+
+void Scene::Update()
+{
 	{
-		DirectionalLight* l = m_DirLights[i];
+		ProfileScope scope("Transforms");
+		m_Transforms.Sync(m_Root.Transformation);
+	}
 
-		l->ForwardToShader(shader, static_cast<uint32_t>(i));
+	{
+		ProfileScope scope("BVH update");
+		UpdateBvh();
 	}
 
-	shader.SetUniform("nbrPointLights", static_cast<int32_t>(m_PointLights.size()));
-	for (size_t i = 0; i < m_PointLights.size(); i++)
+	Camera& camera = *Camera::Instance;
+
+	// Culls the objects and submits the visible ones
 	{
-		PointLight* l = m_PointLights[i];
+		ProfileScope scope("Culling");
+
+		m_Renderables.clear();
+		m_BoundsX.clear();
+		m_BoundsY.clear();
+		m_BoundsZ.clear();
+		m_BoundsRadius.clear();
 
-		l->ForwardToShader(shader, static_cast<uint32_t>(i));
+		const Frustum frustum(camera.GetProjView());
+
+		// The hierarchy rejects whole groups of objects, the ones left are tested with their tighter bounding sphere
+		m_Bvh.Query(frustum, [this](const uint32_t proxy)
+			{
+				Object* const obj = m_ProxyObjects[proxy];
+
+				if (obj->IsHidden())
+					return;
+
+				const BoundingSphere& bounds = m_ProxySpheres[proxy];
+
+				m_Renderables.push_back(obj);
+				m_BoundsX.push_back(bounds.Center.x);
+				m_BoundsY.push_back(bounds.Center.y);
+				m_BoundsZ.push_back(bounds.Center.z);
+				m_BoundsRadius.push_back(bounds.Radius);
+			});
+
+		const size_t count = m_Renderables.size();
+		m_Visible.resize(count);
+
+		frustum.Cull(m_BoundsX.data(), m_BoundsY.data(), m_BoundsZ.data(), m_BoundsRadius.data(), count, m_Visible.data());
+
+		m_CullingStats = CullingStats{ static_cast<uint32_t>(m_Proxies.size()), 0, 0 };
+		m_Queue.Clear();
+
+		const Vector3& front = camera.GetFront();
+		const float depthScale = 1.f / (camera.DepthFar - camera.DepthNear);
+
+		for (size_t i = 0; i < count; i++)
+		{
+			if (!m_Visible[i])
+				continue;
+
+			// Distance of the center along the view direction
+			const float depth = (m_BoundsX[i] - camera.Position.x) * front.x + (m_BoundsY[i] - camera.Position.y) * front.y
+				+ (m_BoundsZ[i] - camera.Position.z) * front.z;
+
+			m_Queue.Submit(*m_Renderables[i], (depth - camera.DepthNear) * depthScale);
+			m_CullingStats.Drawn++;
+		}
+
+		m_CullingStats.Culled = m_CullingStats.Tested - m_CullingStats.Drawn;
 	}
 
-	shader.SetUniform("nbrSpotLights", static_cast<int32_t>(m_SpotLights.size()));
-	for (size_t i = 0; i < m_SpotLights.size(); i++)
+	m_Queue.Sort();
+	m_Queue.Execute(camera);
+}
+
+void Scene::UpdateBvh()
+{
+	if (m_Transforms.WasRebuilt())
+	{
+		RebuildBvh();
+	}
+	else
 	{
-		SpotLight* l = m_SpotLights[i];
+		for (Transform* const t : m_Transforms.GetChanged())
+		{
+			const auto it = m_Proxies.find(&t->GetOwner());
+
+			if (it == m_Proxies.end())
+				continue;
+
+			Model& model = t->GetOwner().GetModel();
+
+			m_ProxySpheres[it->second] = t->GetWorldBounds(model.GetBoundingSphere());
+			m_Bvh.Move(it->second, t->GetWorldBounds(model.GetBoundingBox()));
+		}
 
-		l->ForwardToShader(shader, static_cast<uint32_t>(i));
+		// Models are loaded asynchronously, objects have no bounds until then
+		std::erase_if(m_PendingObjects, [this](Object* const obj)
+			{
+				if (!obj->GetModel().IsLoaded())
+					return false;
+
+				AddToBvh(*obj);
+				return true;
+			});
 	}
 
-	shader.Unuse();
+	m_Bvh.Update();
 }
 
-void Scene::Update()
+void Scene::RebuildBvh()
 {
-	UpdateChildren(m_Root);
+	m_Bvh.Clear();
+	m_Proxies.clear();
+	m_ProxyObjects.clear();
+	m_ProxySpheres.clear();
+	m_PendingObjects.clear();
+
+	std::vector<Object*> stack{ &m_Root };
+
+	while (!stack.empty())
+	{
+		Object* const obj = stack.back();
+		stack.pop_back();
+
+		if (obj->HasModel())
+		{
+			if (obj->GetModel().IsLoaded())
+				AddToBvh(*obj);
+			else
+				m_PendingObjects.push_back(obj);
+		}
+
+		for (Transform* const t : obj->Transformation.GetChildren())
+			stack.push_back(&t->GetOwner());
+	}
 }
 
-void Scene::UpdateChildren(Object& obj)
+void Scene::AddToBvh(Object& obj)
 {
-	//if (obj.HasShader())
-	//	ApplyLights(obj.GetShader());
+	const Model& model = obj.GetModel();
+	const uint32_t proxy = m_Bvh.Insert(obj.Transformation.GetWorldBounds(model.GetBoundingBox()));
 
-	obj.Render();
-
-	for (Transform* t : obj.Transformation.GetChildren())
+	if (proxy >= m_ProxyObjects.size())
 	{
-		UpdateChildren(t->GetOwner());
+		m_ProxyObjects.resize(proxy + 1);
+		m_ProxySpheres.resize(proxy + 1);
 	}
+
+	m_ProxyObjects[proxy] = &obj;
+	m_ProxySpheres[proxy] = obj.Transformation.GetWorldBounds(model.GetBoundingSphere());
+	m_Proxies[&obj] = proxy;
+}
+
+Object* Scene::Raycast(const Vector3& origin, const Vector3& direction, const float maxDistance, float& distance) const
+{
+	const uint32_t proxy = m_Bvh.Raycast(origin, direction, maxDistance, [this, &origin, &direction](const uint32_t p)
+		{
+			if (m_ProxyObjects[p]->IsHidden())
+				return -1.f;
+
+			// Closest intersection with the bounding sphere
+			const BoundingSphere& sphere = m_ProxySpheres[p];
+			const Vector3 toCenter = sphere.Center - origin;
+			const float projection = Vector3::DotProduct(toCenter, direction);
+			const float discriminant = projection * projection - toCenter.NormSquared() + sphere.Radius * sphere.Radius;
+
+			if (discriminant < 0.f)
+				return -1.f;
+
+			const float root = std::sqrt(discriminant);
+
+			// The origin can be inside the sphere
+			return projection - root >= 0.f ? projection - root : projection + root;
+		}, distance);
+
+	return proxy == Bvh::Null ? nullptr : m_ProxyObjects[proxy];
+}
+
+void Scene::Query(const BoundingSphere& sphere, std::vector<Object*>& objects) const
+{
+	objects.clear();
+
+	m_Bvh.Query(sphere, [this, &objects](const uint32_t proxy)
+		{
+			objects.push_back(m_ProxyObjects[proxy]);
+		});
+}
+
+const CullingStats& Scene::GetCullingStats() const
+{
+	return m_CullingStats;
+}
+
+const RenderStats& Scene::GetRenderStats() const
+{
+	return m_Queue.GetStats();
 }
@@ -0,0 +1,100 @@
+#include "core/thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+ThreadPool::ThreadPool(const uint32_t threadCount)
+	: m_Running(true)
+{
+	const uint32_t count = threadCount != 0 ? threadCount : std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+	m_Threads.reserve(count);
+	for (uint32_t i = 0; i < count; i++)
+		m_Threads.emplace_back(&ThreadPool::Run, this);
+}
+
+ThreadPool::~ThreadPool()
+{
+	// Set not running and wake up every thread one last time to fully stop them
+	{
+		std::scoped_lock lock(m_Mutex);
+		m_Running = false;
+	}
+	m_CondVar.notify_all();
+
+	for (std::thread& thread : m_Threads)
+		thread.join();
+}
+
+void ThreadPool::Run()
+{
+	while (true)
+	{
+		std::function<void()> task;
+
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			m_CondVar.wait(lock, [this]() { return !m_Tasks.empty() || !m_Running; });
+
+			if (!m_Running)
+				return;
+
+			task = std::move(m_Tasks.front());
+			m_Tasks.pop();
+		}
+
+		task();
+	}
+}
+
+void ThreadPool::Enqueue(std::function<void()> task)
+{
+	{
+		std::scoped_lock lock(m_Mutex);
+		m_Tasks.push(std::move(task));
+	}
+	m_CondVar.notify_one();
+}
+
+void ThreadPool::ParallelFor(const uint32_t count, std::function<void(uint32_t)> task)
+{
+	// Shared with the workers, a worker starting after the loop is done must still find it alive
+	struct State
+	{
+		std::function<void(uint32_t)> task;
+		uint32_t count;
+		std::atomic<uint32_t> next = 0;
+		std::atomic<uint32_t> done = 0;
+	};
+
+	const std::shared_ptr<State> state = std::make_shared<State>();
+	state->task = std::move(task);
+	state->count = count;
+
+	const auto work = [](State& s)
+		{
+			for (uint32_t i = s.next.fetch_add(1, std::memory_order_relaxed); i < s.count; i = s.next.fetch_add(1, std::memory_order_relaxed))
+			{
+				s.task(i);
+
+				if (s.done.fetch_add(1, std::memory_order_acq_rel) + 1 == s.count)
+					s.done.notify_all();
+			}
+		};
+
+	// The calling thread takes part, so one index is left to it
+	const uint32_t helpers = std::min(GetThreadCount(), count > 0 ? count - 1 : 0);
+	for (uint32_t i = 0; i < helpers; i++)
+		Enqueue([state, work]() { work(*state); });
+
+	work(*state);
+
+	for (uint32_t done = state->done.load(std::memory_order_acquire); done != count; done = state->done.load(std::memory_order_acquire))
+		state->done.wait(done, std::memory_order_acquire);
+}
+
+uint32_t ThreadPool::GetThreadCount() const
+{
+	return static_cast<uint32_t>(m_Threads.size());
+}
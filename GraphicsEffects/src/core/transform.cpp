@@ -1,26 +1,48 @@
 #include "core/transform.hpp"
 #include "core/object.hpp"
 
+#include <cmath>
+#include <algorithm>
+
+uint64_t Transform::m_HierarchyVersion;
+
+uint32_t Transform::m_RecomputedCount;
+
+uint64_t Transform::GetHierarchyVersion()
+{
+	return m_HierarchyVersion;
+}
+
+uint32_t Transform::GetRecomputedCount()
+{
+	return m_RecomputedCount;
+}
+
+void Transform::ResetRecomputedCount()
+{
+	m_RecomputedCount = 0;
+}
+
 Transform::Transform(Object& owner)
-	: m_Owner(owner)
+	: m_Owner(owner), m_LocalDirty(true), m_GlobalDirty(true)
 {
-	Position = Vector3(0.f);
-	Rotation = Vector3(0.f);
-	Scaling = Vector3(1.f);
+	m_Position = Vector3(0.f);
+	m_Rotation = Quaternion::Identity;
+	m_EulerAngles = Vector3(0.f);
+	m_Scaling = Vector3(1.f);
 
 	m_Parent = nullptr;
 	UpdateTransformation();
 }
 
-Transform::Transform(Object& owner, const Vector3& position, const Vector3& rotation, const Vector3& scaling)
-	: m_Owner(owner), Position(position), Rotation(rotation), Scaling(scaling)
+Transform::Transform(Object& owner, const Vector3& position, const Quaternion& rotation, const Vector3& scaling)
+	: m_Owner(owner), m_Parent(nullptr), m_Position(position), m_Rotation(rotation), m_Scaling(scaling), m_EulerAngles(rotation.ToEuler()), m_LocalDirty(true), m_GlobalDirty(true)
 {
-	m_Parent = nullptr;
 	UpdateTransformation();
 }
 
-Transform::Transform(Object& owner, const Vector3& position, const Vector3& rotation, const Vector3& scaling, Transform* const parent)
-	: m_Owner(owner), Position(position), Rotation(rotation), Scaling(scaling), m_Parent(parent)
+Transform::Transform(Object& owner, const Vector3& position, const Quaternion& rotation, const Vector3& scaling, Transform* const parent)
+	: m_Owner(owner), m_Parent(parent), m_Position(position), m_Rotation(rotation), m_Scaling(scaling), m_EulerAngles(rotation.ToEuler()), m_LocalDirty(true), m_GlobalDirty(true)
 {
 	UpdateTransformation();
 }
@@ -32,6 +54,7 @@ Transform::~Transform()
 		delete child;
 	*/
 	// FIXME fix the bad way i'm handling memory
+	m_HierarchyVersion++;
 }
 
 void Transform::SetParent(Transform* const parent)
@@ -41,26 +64,100 @@ void Transform::SetParent(Transform* const parent)
 
 	m_Parent = parent;
 	parent->AddChildren(this);
+
+	m_GlobalDirty = true;
 }
 
 void Transform::RemoveChildren(Transform* const child)
 {
 	std::erase(m_Children, child);
+	m_HierarchyVersion++;
 }
 
 void Transform::AddChildren(Transform* const child)
 {
 	m_Children.push_back(child);
+	m_HierarchyVersion++;
 }
 
 void Transform::UpdateTransformation()
 {
-	Matrix4x4::TRS(Position, Rotation, Scaling, m_LocalTrs);
+	if (m_LocalDirty)
+	{
+		Matrix4x4::TRS(m_Position, m_Rotation, m_Scaling, m_LocalTrs);
+		m_LocalDirty = false;
+		m_GlobalDirty = true;
+	}
+
+	if (!m_GlobalDirty)
+		return;
 
 	if (m_Parent != nullptr)
 		Matrix4x4::Multiply(m_Parent->m_GlobalTrs, m_LocalTrs, m_GlobalTrs);
 	else
 		m_GlobalTrs = m_LocalTrs;
+
+	m_GlobalDirty = false;
+	m_RecomputedCount++;
+
+	MarkChildrenDirty();
+}
+
+void Transform::MarkChildrenDirty()
+{
+	for (Transform* const child : m_Children)
+		child->m_GlobalDirty = true;
+}
+
+const Vector3& Transform::GetPosition() const
+{
+	return m_Position;
+}
+
+const Quaternion& Transform::GetRotation() const
+{
+	return m_Rotation;
+}
+
+const Vector3& Transform::GetScaling() const
+{
+	return m_Scaling;
+}
+
+const Vector3& Transform::GetEulerAngles() const
+{
+	return m_EulerAngles;
+}
+
+void Transform::SetPosition(const Vector3& position)
+{
+	m_Position = position;
+	m_LocalDirty = true;
+}
+
+void Transform::SetRotation(const Quaternion& rotation)
+{
+	m_Rotation = rotation;
+	m_EulerAngles = rotation.ToEuler();
+	m_LocalDirty = true;
+}
+
+void Transform::SetScaling(const Vector3& scaling)
+{
+	m_Scaling = scaling;
+	m_LocalDirty = true;
+}
+
+void Transform::SetEulerAngles(const Vector3& angles)
+{
+	m_Rotation = Quaternion::FromEuler(angles);
+	m_EulerAngles = angles;
+	m_LocalDirty = true;
+}
+
+bool Transform::IsDirty() const
+{
+	return m_LocalDirty || m_GlobalDirty;
 }
 
 bool Transform::HasParent() const
@@ -78,6 +175,46 @@ const Matrix4x4& Transform::GetGlobalTransform() const
 	return m_GlobalTrs;
 }
 
+BoundingBox Transform::GetWorldBounds(const BoundingBox& local) const
+{
+	const Matrix4x4& m = m_GlobalTrs;
+	const Vector3 center = (local.Min + local.Max) * .5f;
+	const Vector3 extents = (local.Max - local.Min) * .5f;
+
+	// The extents of the rotated box on each axis are the sum of the absolute projections of the local extents
+	const Vector3 worldCenter(
+		m.Row0.x * center.x + m.Row0.y * center.y + m.Row0.z * center.z + m.Row0.w,
+		m.Row1.x * center.x + m.Row1.y * center.y + m.Row1.z * center.z + m.Row1.w,
+		m.Row2.x * center.x + m.Row2.y * center.y + m.Row2.z * center.z + m.Row2.w
+	);
+	const Vector3 worldExtents(
+		std::abs(m.Row0.x) * extents.x + std::abs(m.Row0.y) * extents.y + std::abs(m.Row0.z) * extents.z,
+		std::abs(m.Row1.x) * extents.x + std::abs(m.Row1.y) * extents.y + std::abs(m.Row1.z) * extents.z,
+		std::abs(m.Row2.x) * extents.x + std::abs(m.Row2.y) * extents.y + std::abs(m.Row2.z) * extents.z
+	);
+
+	return BoundingBox{ worldCenter - worldExtents, worldCenter + worldExtents };
+}
+
+BoundingSphere Transform::GetWorldBounds(const BoundingSphere& local) const
+{
+	const Matrix4x4& m = m_GlobalTrs;
+	const Vector3& c = local.Center;
+
+	const Vector3 worldCenter(
+		m.Row0.x * c.x + m.Row0.y * c.y + m.Row0.z * c.z + m.Row0.w,
+		m.Row1.x * c.x + m.Row1.y * c.y + m.Row1.z * c.z + m.Row1.w,
+		m.Row2.x * c.x + m.Row2.y * c.y + m.Row2.z * c.z + m.Row2.w
+	);
+
+	// The columns of the matrix are the scaled axes
+	const float scaleX = m.Row0.x * m.Row0.x + m.Row1.x * m.Row1.x + m.Row2.x * m.Row2.x;
+	const float scaleY = m.Row0.y * m.Row0.y + m.Row1.y * m.Row1.y + m.Row2.y * m.Row2.y;
+	const float scaleZ = m.Row0.z * m.Row0.z + m.Row1.z * m.Row1.z + m.Row2.z * m.Row2.z;
+
+	return BoundingSphere{ worldCenter, local.Radius * std::sqrt(std::max({ scaleX, scaleY, scaleZ })) };
+}
+
 Object& Transform::GetOwner() const
 {
 	return m_Owner;
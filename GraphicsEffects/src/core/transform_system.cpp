@@ -0,0 +1,388 @@
+#include "core/transform_system.hpp"
+#include "core/transform.hpp"
+#include "core/maths/simd.h"
+
+#include <assert.h>
+#include <cmath>
+#include <algorithm>
+
+TransformSystem::TransformSystem()
+	: m_RecomputedCount(0), m_BoundVersion(0), m_Rebuilt(false), m_Count(0)
+{
+}
+
+void TransformSystem::Resize(const uint32_t count)
+{
+	// Padding nodes are identity transforms
+	const size_t padded = (static_cast<size_t>(count) + 3) & ~static_cast<size_t>(3);
+
+	m_PositionX.resize(padded, 0.f);
+	m_PositionY.resize(padded, 0.f);
+	m_PositionZ.resize(padded, 0.f);
+
+	m_RotationX.resize(padded, 0.f);
+	m_RotationY.resize(padded, 0.f);
+	m_RotationZ.resize(padded, 0.f);
+	m_RotationW.resize(padded, 1.f);
+
+	m_ScalingX.resize(padded, 1.f);
+	m_ScalingY.resize(padded, 1.f);
+	m_ScalingZ.resize(padded, 1.f);
+
+	m_Parents.resize(count);
+	m_Local.resize(padded);
+	m_Global.resize(count);
+	m_Dirty.resize(padded, 0);
+
+	m_Count = count;
+}
+
+void TransformSystem::Clear()
+{
+	m_PositionX.clear();
+	m_PositionY.clear();
+	m_PositionZ.clear();
+
+	m_RotationX.clear();
+	m_RotationY.clear();
+	m_RotationZ.clear();
+	m_RotationW.clear();
+
+	m_ScalingX.clear();
+	m_ScalingY.clear();
+	m_ScalingZ.clear();
+
+	m_Parents.clear();
+	m_Local.clear();
+	m_Global.clear();
+	m_Dirty.clear();
+	m_RecomputedCount = 0;
+
+	m_Bound.clear();
+	m_BoundVersion = 0;
+	m_Changed.clear();
+	m_Count = 0;
+}
+
+uint32_t TransformSystem::Add(const Vector3& position, const Quaternion& rotation, const Vector3& scaling, const int32_t parent)
+{
+	assert(parent < static_cast<int32_t>(m_Count) && "A parent must be added before its children");
+
+	const uint32_t index = m_Count;
+	Resize(m_Count + 1);
+
+	m_Parents[index] = parent;
+	m_Dirty[index] = 1;
+	SetPosition(index, position);
+	SetRotation(index, rotation);
+	SetScaling(index, scaling);
+
+	return index;
+}
+
+void TransformSystem::SetPosition(const uint32_t index, const Vector3& position)
+{
+	assert(index < m_Count && "Transform system subscript out of range");
+
+	m_PositionX[index] = position.x;
+	m_PositionY[index] = position.y;
+	m_PositionZ[index] = position.z;
+	m_Dirty[index] = 1;
+}
+
+void TransformSystem::SetRotation(const uint32_t index, const Quaternion& rotation)
+{
+	assert(index < m_Count && "Transform system subscript out of range");
+
+	m_RotationX[index] = rotation.x;
+	m_RotationY[index] = rotation.y;
+	m_RotationZ[index] = rotation.z;
+	m_RotationW[index] = rotation.w;
+	m_Dirty[index] = 1;
+}
+
+void TransformSystem::SetScaling(const uint32_t index, const Vector3& scaling)
+{
+	assert(index < m_Count && "Transform system subscript out of range");
+
+	m_ScalingX[index] = scaling.x;
+	m_ScalingY[index] = scaling.y;
+	m_ScalingZ[index] = scaling.z;
+	m_Dirty[index] = 1;
+}
+
+void TransformSystem::UpdateLocal()
+{
+	// Same result as Matrix4x4::TRS, the rotation matrix of the quaternion only takes products, no trig
+	// r00 = 1 - 2 (yy + zz)    r01 = 2 (xy - wz)        r02 = 2 (xz + wy)
+	// r10 = 2 (xy + wz)        r11 = 1 - 2 (xx + zz)    r12 = 2 (yz - wx)
+	// r20 = 2 (xz - wy)        r21 = 2 (yz + wx)        r22 = 1 - 2 (xx + yy)
+	const size_t padded = m_Local.size();
+
+#ifdef MATHS_SIMD_SSE
+	const __m128 one = _mm_set1_ps(1.f);
+
+	for (size_t i = 0; i < padded; i += 4)
+	{
+		// Nodes are computed 4 by 4, only skip the block if none of them changed
+		if ((m_Dirty[i] | m_Dirty[i + 1] | m_Dirty[i + 2] | m_Dirty[i + 3]) == 0)
+			continue;
+
+		const __m128 x = _mm_loadu_ps(&m_RotationX[i]);
+		const __m128 y = _mm_loadu_ps(&m_RotationY[i]);
+		const __m128 z = _mm_loadu_ps(&m_RotationZ[i]);
+		const __m128 w = _mm_loadu_ps(&m_RotationW[i]);
+
+		const __m128 x2 = _mm_add_ps(x, x);
+		const __m128 y2 = _mm_add_ps(y, y);
+		const __m128 z2 = _mm_add_ps(z, z);
+
+		const __m128 xx = _mm_mul_ps(x, x2);
+		const __m128 yy = _mm_mul_ps(y, y2);
+		const __m128 zz = _mm_mul_ps(z, z2);
+		const __m128 xy = _mm_mul_ps(x, y2);
+		const __m128 xz = _mm_mul_ps(x, z2);
+		const __m128 yz = _mm_mul_ps(y, z2);
+		const __m128 wx = _mm_mul_ps(w, x2);
+		const __m128 wy = _mm_mul_ps(w, y2);
+		const __m128 wz = _mm_mul_ps(w, z2);
+
+		const __m128 scaleX = _mm_loadu_ps(&m_ScalingX[i]);
+		const __m128 scaleY = _mm_loadu_ps(&m_ScalingY[i]);
+		const __m128 scaleZ = _mm_loadu_ps(&m_ScalingZ[i]);
+
+		// Each register holds the same matrix element of 4 nodes
+		__m128 r00 = _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(yy, zz)), scaleX);
+		__m128 r01 = _mm_mul_ps(_mm_sub_ps(xy, wz), scaleY);
+		__m128 r02 = _mm_mul_ps(_mm_add_ps(xz, wy), scaleZ);
+		__m128 r03 = _mm_loadu_ps(&m_PositionX[i]);
+
+		__m128 r10 = _mm_mul_ps(_mm_add_ps(xy, wz), scaleX);
+		__m128 r11 = _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, zz)), scaleY);
+		__m128 r12 = _mm_mul_ps(_mm_sub_ps(yz, wx), scaleZ);
+		__m128 r13 = _mm_loadu_ps(&m_PositionY[i]);
+
+		__m128 r20 = _mm_mul_ps(_mm_sub_ps(xz, wy), scaleX);
+		__m128 r21 = _mm_mul_ps(_mm_add_ps(yz, wx), scaleY);
+		__m128 r22 = _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, yy)), scaleZ);
+		__m128 r23 = _mm_loadu_ps(&m_PositionZ[i]);
+
+		// Back to one matrix row per register
+		_MM_TRANSPOSE4_PS(r00, r01, r02, r03);
+		_MM_TRANSPOSE4_PS(r10, r11, r12, r13);
+		_MM_TRANSPOSE4_PS(r20, r21, r22, r23);
+
+		const __m128 row3 = _mm_setr_ps(0.f, 0.f, 0.f, 1.f);
+		const __m128 rows[4][3] = {
+			{ r00, r10, r20 },
+			{ r01, r11, r21 },
+			{ r02, r12, r22 },
+			{ r03, r13, r23 }
+		};
+
+		for (size_t j = 0; j < 4; j++)
+		{
+			Matrix4x4& local = m_Local[i + j];
+			_mm_storeu_ps(&local.Row0.x, rows[j][0]);
+			_mm_storeu_ps(&local.Row1.x, rows[j][1]);
+			_mm_storeu_ps(&local.Row2.x, rows[j][2]);
+			_mm_storeu_ps(&local.Row3.x, row3);
+		}
+	}
+#else
+	for (size_t i = 0; i < padded; i++)
+	{
+		if (!m_Dirty[i])
+			continue;
+
+		const float x = m_RotationX[i];
+		const float y = m_RotationY[i];
+		const float z = m_RotationZ[i];
+		const float w = m_RotationW[i];
+
+		const float xx = 2.f * x * x, yy = 2.f * y * y, zz = 2.f * z * z;
+		const float xy = 2.f * x * y, xz = 2.f * x * z, yz = 2.f * y * z;
+		const float wx = 2.f * w * x, wy = 2.f * w * y, wz = 2.f * w * z;
+
+		const float scaleX = m_ScalingX[i];
+		const float scaleY = m_ScalingY[i];
+		const float scaleZ = m_ScalingZ[i];
+
+		m_Local[i] = Matrix4x4(
+			(1.f - (yy + zz)) * scaleX, (xy - wz) * scaleY,         (xz + wy) * scaleZ,         m_PositionX[i],
+			(xy + wz) * scaleX,         (1.f - (xx + zz)) * scaleY, (yz - wx) * scaleZ,         m_PositionY[i],
+			(xz - wy) * scaleX,         (yz + wx) * scaleY,         (1.f - (xx + yy)) * scaleZ, m_PositionZ[i],
+			0.f,                        0.f,                        0.f,                        1.f
+		);
+	}
+#endif
+}
+
+void TransformSystem::UpdateGlobal()
+{
+	m_RecomputedCount = 0;
+
+	// Parents are always before their children, so their global matrix is already up to date
+	// and their dirty flag has already been propagated
+	for (uint32_t i = 0; i < m_Count; i++)
+	{
+		const int32_t parent = m_Parents[i];
+
+		if (parent >= 0 && m_Dirty[parent])
+			m_Dirty[i] = 1;
+
+		if (!m_Dirty[i])
+			continue;
+
+		m_RecomputedCount++;
+
+		if (parent < 0)
+			m_Global[i] = m_Local[i];
+		else
+			Matrix4x4::Multiply(m_Global[parent], m_Local[i], m_Global[i]);
+	}
+}
+
+void TransformSystem::ClearDirty()
+{
+	std::fill(m_Dirty.begin(), m_Dirty.end(), static_cast<uint8_t>(0));
+}
+
+void TransformSystem::Update()
+{
+	UpdateLocal();
+	UpdateGlobal();
+	ClearDirty();
+}
+
+void TransformSystem::Build(Transform& root)
+{
+	Clear();
+
+	// Depth first traversal with an explicit stack, pairs of (transform, parent index)
+	std::vector<std::pair<Transform*, int32_t>> stack;
+	stack.emplace_back(&root, -1);
+
+	while (!stack.empty())
+	{
+		const std::pair<Transform*, int32_t> node = stack.back();
+		stack.pop_back();
+
+		Transform* const t = node.first;
+		const int32_t index = static_cast<int32_t>(Add(t->m_Position, t->m_Rotation, t->m_Scaling, node.second));
+		m_Bound.push_back(t);
+
+		t->m_LocalDirty = false;
+		t->m_GlobalDirty = false;
+
+		const std::vector<Transform*>& children = t->GetChildren();
+		for (size_t i = children.size(); i > 0; i--)
+			stack.emplace_back(children[i - 1], index);
+	}
+
+	m_BoundVersion = Transform::GetHierarchyVersion();
+}
+
+void TransformSystem::Gather()
+{
+	for (uint32_t i = 0; i < m_Count; i++)
+	{
+		Transform* const t = m_Bound[i];
+
+		if (!t->IsDirty())
+			continue;
+
+		// A transform only marked globally dirty (e.g. re-parented) keeps the same values, copying them is harmless
+		m_PositionX[i] = t->m_Position.x;
+		m_PositionY[i] = t->m_Position.y;
+		m_PositionZ[i] = t->m_Position.z;
+
+		m_RotationX[i] = t->m_Rotation.x;
+		m_RotationY[i] = t->m_Rotation.y;
+		m_RotationZ[i] = t->m_Rotation.z;
+		m_RotationW[i] = t->m_Rotation.w;
+
+		m_ScalingX[i] = t->m_Scaling.x;
+		m_ScalingY[i] = t->m_Scaling.y;
+		m_ScalingZ[i] = t->m_Scaling.z;
+
+		m_Dirty[i] = 1;
+		t->m_LocalDirty = false;
+		t->m_GlobalDirty = false;
+	}
+}
+
+void TransformSystem::Scatter()
+{
+	m_Changed.clear();
+
+	for (uint32_t i = 0; i < m_Count; i++)
+	{
+		if (!m_Dirty[i])
+			continue;
+
+		Transform* const t = m_Bound[i];
+
+		t->m_LocalTrs = m_Local[i];
+		t->m_GlobalTrs = m_Global[i];
+		m_Changed.push_back(t);
+	}
+
+	Transform::m_RecomputedCount += m_RecomputedCount;
+}
+
+void TransformSystem::Sync(Transform& root)
+{
+	m_Rebuilt = m_Bound.empty() || m_Bound[0] != &root || m_BoundVersion != Transform::GetHierarchyVersion();
+
+	if (m_Rebuilt)
+		Build(root);
+	else
+		Gather();
+
+	UpdateLocal();
+	UpdateGlobal();
+	Scatter();
+	ClearDirty();
+}
+
+uint32_t TransformSystem::GetCount() const
+{
+	return m_Count;
+}
+
+uint32_t TransformSystem::GetRecomputedCount() const
+{
+	return m_RecomputedCount;
+}
+
+const std::vector<Transform*>& TransformSystem::GetChanged() const
+{
+	return m_Changed;
+}
+
+bool TransformSystem::WasRebuilt() const
+{
+	return m_Rebuilt;
+}
+
+int32_t TransformSystem::GetParent(const uint32_t index) const
+{
+	assert(index < m_Count && "Transform system subscript out of range");
+
+	return m_Parents[index];
+}
+
+const Matrix4x4& TransformSystem::GetLocal(const uint32_t index) const
+{
+	assert(index < m_Count && "Transform system subscript out of range");
+
+	return m_Local[index];
+}
+
+const Matrix4x4& TransformSystem::GetGlobal(const uint32_t index) const
+{
+	assert(index < m_Count && "Transform system subscript out of range");
+
+	return m_Global[index];
+}
@@ -1,9 +1,15 @@
 #include <iostream>
 #include "core/application.hpp"
+#include "core/benchmark.hpp"
 
-int main()
+int main(int argc, char** argv)
 {
-	Application::Init();
-	Application::MainLoop();
+	BenchmarkSettings benchmark;
+	const bool runBenchmark = BenchmarkSettings::Parse(argc, argv, benchmark);
+
+	Application::Init(runBenchmark ? &benchmark : nullptr);
+	const bool success = Application::MainLoop();
 	Application::Shutdown();
+
+	return success ? 0 : 1;
 }
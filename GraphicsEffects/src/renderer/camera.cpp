@@ -3,6 +3,7 @@
 
 #define _USE_MATH_DEFINES
 #include <math.h>
+#include <algorithm>
 
 Camera* Camera::Instance;
 
@@ -29,12 +30,8 @@ Camera::Camera(const float_t fov, const Vector2 screenSize, const float_t depthN
 
 void Camera::SendToShader(const Shader& shader)
 {
-	shader.Use();
-
-	if (shader.HasVariable(ShaderVariables::VIEW_POS))
-		shader.SetUniform("viewPos", Position);
-
-	shader.Unuse();
+	// Does nothing if the shader doesn't use the view position
+	shader.SetUniform(ShaderUniform::VIEW_POS, Position);
 }
 
 void Camera::Update()
@@ -73,11 +70,21 @@ const Matrix4x4& Camera::GetProjView()
 	return m_ProjView;
 }
 
-const Vector3& Camera::GetFront()
+const Vector3& Camera::GetFront() const
 {
 	return m_Front;
 }
 
+const Vector3& Camera::GetRight() const
+{
+	return m_Right;
+}
+
+const Vector3& Camera::GetUp() const
+{
+	return m_Up;
+}
+
 void Camera::CalculateProjView()
 {
 	Matrix4x4::Multiply(m_Projection, m_View, m_ProjView);
@@ -95,6 +102,16 @@ void Camera::UpdateVectors()
 	m_Up = Vector3::CrossProduct(m_Right, m_Front).Normalize();
 }
 
+void Camera::LookAt(const Vector3& target)
+{
+	const Vector3 direction = (target - Position).Normalize();
+
+	m_Yaw = std::atan2(direction.z, direction.x);
+	m_Pitch = std::asin(std::clamp(direction.y, -1.f, 1.f));
+
+	UpdateVectors();
+}
+
 void Camera::ProcessKeyboard(const CameraMovement movement, const float deltaTime)
 {
 	const float velocity = MovementSpeed * deltaTime;
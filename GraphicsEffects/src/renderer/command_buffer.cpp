@@ -0,0 +1,52 @@
+#include "renderer/command_buffer.hpp"
+
+#include <algorithm>
+
+void CommandBuffer::Build(const std::vector<IndirectBatch>& batches, ThreadPool* const pool)
+{
+	const uint32_t count = static_cast<uint32_t>(batches.size());
+	m_Commands.resize(count);
+	m_Draws.clear();
+
+	const auto fillChunk = [this, &batches, count](const uint32_t chunk)
+		{
+			const uint32_t end = std::min(count, (chunk + 1) * ChunkSize);
+
+			for (uint32_t i = chunk * ChunkSize; i < end; i++)
+			{
+				const IndirectBatch& batch = batches[i];
+				m_Commands[i] = DrawElementsIndirectCommand{ batch.Mesh.IndexCount, batch.InstanceCount, batch.Mesh.FirstIndex,
+					static_cast<int32_t>(batch.Mesh.BaseVertex), batch.BaseInstance };
+			}
+		};
+
+	const uint32_t chunkCount = (count + ChunkSize - 1) / ChunkSize;
+
+	if (pool != nullptr && chunkCount > 1)
+	{
+		pool->ParallelFor(chunkCount, fillChunk);
+	}
+	else
+	{
+		for (uint32_t chunk = 0; chunk < chunkCount; chunk++)
+			fillChunk(chunk);
+	}
+
+	for (uint32_t i = 0; i < count; i++)
+	{
+		if (!m_Draws.empty() && m_Draws.back().State == batches[i].State)
+			m_Draws.back().CommandCount++;
+		else
+			m_Draws.push_back(MultiDraw{ batches[i].State, i, 1 });
+	}
+}
+
+const std::vector<DrawElementsIndirectCommand>& CommandBuffer::GetCommands() const
+{
+	return m_Commands;
+}
+
+const std::vector<MultiDraw>& CommandBuffer::GetDraws() const
+{
+	return m_Draws;
+}
@@ -1,5 +1,4 @@
 #include "renderer/directional_light.hpp"
-#include "resources/shader.hpp"
 #include "core/object.hpp"
 #include "core/scene.hpp"
 
@@ -15,15 +14,13 @@ DirectionalLight::~DirectionalLight()
 	Scene::CurrentScene()->RemoveDirectionalLight(this);
 }
 
-void DirectionalLight::ForwardToShader(Shader& shader, uint32_t i) const
+void DirectionalLight::Pack(DirectionalLightData& data) const
 {
-	std::string baseName = std::string("dirLights[").append(std::to_string(i)).append("].");
+	data.Direction = Direction;
 
-	shader.SetUniform(baseName + "direction", Direction);
-	shader.SetUniform(baseName + "ambient", Ambient);
-	shader.SetUniform(baseName + "diffuse", Diffuse);
-	shader.SetUniform(baseName + "specular", Specular);
-	shader.SetUniform(baseName + "radius", Radius);
+	data.Ambient = Ambient;
+	data.Diffuse = Diffuse;
+	data.Specular = Specular;
 }
 
 void DirectionalLight::OnGui()
@@ -0,0 +1,146 @@
+#include "renderer/frame_ring.hpp"
+
+#include <algorithm>
+
+#include "core/debug/assert.hpp"
+#include "core/debug/log.hpp"
+
+#include "glad/glad.h"
+
+FrameRing* FrameRing::m_Instance;
+
+FrameRing::FrameRing(const size_t frameSize)
+	: m_Handle(0), m_Mapping(nullptr), m_FrameSize(0), m_Alignment(0), m_Frame(FrameCount - 1), m_Offset(0), m_Fences(),
+	  m_StallCount(0)
+{
+	Assert::IsTrue(m_Instance == nullptr, "Only one frame ring can exist");
+	m_Instance = this;
+
+	int32_t alignment = 0;
+	glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+	// Also satisfies the 4 bytes alignment of the indirect commands
+	m_Alignment = std::max<size_t>(static_cast<size_t>(alignment), 16);
+
+	// Every region starts aligned
+	m_FrameSize = (frameSize + m_Alignment - 1) / m_Alignment * m_Alignment;
+
+	constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+	const GLsizeiptr size = static_cast<GLsizeiptr>(m_FrameSize * FrameCount);
+
+	glGenBuffers(1, &m_Handle);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_Handle);
+	glBufferStorage(GL_SHADER_STORAGE_BUFFER, size, nullptr, flags);
+	m_Mapping = static_cast<uint8_t*>(glMapBufferRange(GL_SHADER_STORAGE_BUFFER, 0, size, flags));
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+	if (m_Mapping == nullptr)
+		Log::Warning("Frame ring of {} bytes couldn't be mapped, per frame data falls back to buffer uploads", size);
+}
+
+FrameRing::~FrameRing()
+{
+	for (__GLsync*& fence : m_Fences)
+	{
+		if (fence != nullptr)
+			glDeleteSync(fence);
+	}
+
+	if (m_Mapping != nullptr)
+	{
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_Handle);
+		glUnmapBuffer(GL_SHADER_STORAGE_BUFFER);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+	}
+
+	glDeleteBuffers(1, &m_Handle);
+
+	if (m_Instance == this)
+		m_Instance = nullptr;
+}
+
+FrameRing* FrameRing::Instance()
+{
+	return m_Instance;
+}
+
+void FrameRing::BeginFrame()
+{
+	m_Frame = (m_Frame + 1) % FrameCount;
+	m_Offset = 0;
+
+	__GLsync*& fence = m_Fences[m_Frame];
+
+	if (fence == nullptr)
+		return;
+
+	// Only blocks when the CPU is more than FrameCount - 1 frames ahead of the GPU
+	GLenum status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+
+	if (status == GL_TIMEOUT_EXPIRED)
+	{
+		m_StallCount++;
+
+		constexpr GLuint64 timeout = 1'000'000;
+
+		do
+			status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+		while (status == GL_TIMEOUT_EXPIRED);
+	}
+
+	if (status == GL_WAIT_FAILED)
+		Log::Warning("Waiting for the fence of frame region {} failed", m_Frame);
+
+	glDeleteSync(fence);
+	fence = nullptr;
+}
+
+void FrameRing::EndFrame()
+{
+	__GLsync*& fence = m_Fences[m_Frame];
+
+	if (fence != nullptr)
+		glDeleteSync(fence);
+
+	fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+RingAllocation FrameRing::Allocate(const size_t size)
+{
+	const size_t offset = (m_Offset + m_Alignment - 1) / m_Alignment * m_Alignment;
+
+	if (m_Mapping == nullptr || size == 0 || offset + size > m_FrameSize)
+		return RingAllocation();
+
+	m_Offset = offset + size;
+
+	const size_t bufferOffset = m_Frame * m_FrameSize + offset;
+	return RingAllocation{ m_Mapping + bufferOffset, bufferOffset, size };
+}
+
+void FrameRing::BindRange(const uint32_t binding, const RingAllocation& allocation) const
+{
+	Assert::IsTrue(allocation.Data != nullptr, "Only a valid allocation of the frame ring can be bound");
+
+	glBindBufferRange(GL_SHADER_STORAGE_BUFFER, binding, m_Handle, static_cast<GLintptr>(allocation.Offset),
+		static_cast<GLsizeiptr>(allocation.Size));
+}
+
+void FrameRing::BindIndirect() const
+{
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_Handle);
+}
+
+size_t FrameRing::GetFrameSize() const
+{
+	return m_FrameSize;
+}
+
+size_t FrameRing::GetUsedSize() const
+{
+	return m_Offset;
+}
+
+uint32_t FrameRing::GetStallCount() const
+{
+	return m_StallCount;
+}
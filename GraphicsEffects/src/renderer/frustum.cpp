@@ -0,0 +1,92 @@
+#include "renderer/frustum.hpp"
+#include "core/maths/simd.h"
+
+#include <cmath>
+
+Frustum::Frustum(const Matrix4x4& projView)
+{
+	// Gribb-Hartmann : a point is inside when -w <= x, y, z <= w in clip space
+	const Vector4& r0 = projView.Row0;
+	const Vector4& r1 = projView.Row1;
+	const Vector4& r2 = projView.Row2;
+	const Vector4& r3 = projView.Row3;
+
+	m_Planes[0] = r3 + r0; // Left
+	m_Planes[1] = r3 - r0; // Right
+	m_Planes[2] = r3 + r1; // Bottom
+	m_Planes[3] = r3 - r1; // Top
+	m_Planes[4] = r3 + r2; // Near
+	m_Planes[5] = r3 - r2; // Far
+
+	for (Vector4& plane : m_Planes)
+	{
+		const float length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+		plane = plane / length;
+	}
+}
+
+bool Frustum::Intersects(const BoundingSphere& sphere) const
+{
+	const Vector3& c = sphere.Center;
+
+	for (const Vector4& plane : m_Planes)
+	{
+		if (plane.x * c.x + plane.y * c.y + plane.z * c.z + plane.w < -sphere.Radius)
+			return false;
+	}
+
+	return true;
+}
+
+bool Frustum::Intersects(const BoundingBox& box) const
+{
+	for (const Vector4& plane : m_Planes)
+	{
+		// Corner of the box the furthest along the plane normal
+		const float x = plane.x >= 0.f ? box.Max.x : box.Min.x;
+		const float y = plane.y >= 0.f ? box.Max.y : box.Min.y;
+		const float z = plane.z >= 0.f ? box.Max.z : box.Min.z;
+
+		if (plane.x * x + plane.y * y + plane.z * z + plane.w < 0.f)
+			return false;
+	}
+
+	return true;
+}
+
+void Frustum::Cull(const float* const x, const float* const y, const float* const z, const float* const radius,
+	const size_t count, uint8_t* const visible) const
+{
+	size_t i = 0;
+
+#ifdef MATHS_SIMD_SSE
+	for (; i + 4 <= count; i += 4)
+	{
+		const __m128 cx = _mm_loadu_ps(x + i);
+		const __m128 cy = _mm_loadu_ps(y + i);
+		const __m128 cz = _mm_loadu_ps(z + i);
+		const __m128 negRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(radius + i));
+
+		__m128 outside = _mm_setzero_ps();
+
+		for (const Vector4& plane : m_Planes)
+		{
+			__m128 distance = _mm_mul_ps(_mm_set1_ps(plane.x), cx);
+			distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(plane.y), cy));
+			distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(plane.z), cz));
+			distance = _mm_add_ps(distance, _mm_set1_ps(plane.w));
+
+			outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, negRadius));
+		}
+
+		const int mask = _mm_movemask_ps(outside);
+		visible[i] = !(mask & 1);
+		visible[i + 1] = !(mask & 2);
+		visible[i + 2] = !(mask & 4);
+		visible[i + 3] = !(mask & 8);
+	}
+#endif
+
+	for (; i < count; i++)
+		visible[i] = Intersects(BoundingSphere{ Vector3(x[i], y[i], z[i]), radius[i] });
+}
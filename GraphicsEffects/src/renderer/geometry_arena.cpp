@@ -0,0 +1,101 @@
+#include "renderer/geometry_arena.hpp"
+#include "resources/model.hpp"
+
+#include "core/debug/assert.hpp"
+#include "core/debug/log.hpp"
+
+#include "glad/glad.h"
+
+GeometryArena* GeometryArena::m_Instance;
+
+GeometryArena::GeometryArena(const uint32_t vertexCapacity, const uint32_t indexCapacity)
+	: m_Vertices(vertexCapacity), m_Indices(indexCapacity), m_Vao(0), m_Vbo(0), m_Ebo(0)
+{
+	Assert::IsTrue(m_Instance == nullptr, "Only one geometry arena can exist");
+	m_Instance = this;
+
+	glGenVertexArrays(1, &m_Vao);
+	glGenBuffers(1, &m_Vbo);
+	glGenBuffers(1, &m_Ebo);
+
+	glBindVertexArray(m_Vao);
+
+	glBindBuffer(GL_ARRAY_BUFFER, m_Vbo);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * static_cast<size_t>(vertexCapacity), nullptr, GL_STATIC_DRAW);
+	Model::SetupAttributes();
+
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_Ebo);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint32_t) * static_cast<size_t>(indexCapacity), nullptr, GL_STATIC_DRAW);
+
+	glBindVertexArray(0);
+}
+
+GeometryArena::~GeometryArena()
+{
+	glDeleteVertexArrays(1, &m_Vao);
+	glDeleteBuffers(1, &m_Vbo);
+	glDeleteBuffers(1, &m_Ebo);
+
+	if (m_Instance == this)
+		m_Instance = nullptr;
+}
+
+GeometryArena* GeometryArena::Instance()
+{
+	return m_Instance;
+}
+
+bool GeometryArena::Add(const Vertex* const vertices, const size_t vertexCount, const uint32_t* const indices, const size_t indexCount, MeshRange& range)
+{
+	const uint32_t baseVertex = m_Vertices.Allocate(static_cast<uint32_t>(vertexCount));
+
+	if (baseVertex == RangeAllocator::InvalidOffset)
+	{
+		Log::Warning("Geometry arena is full, {} vertices can't be added", vertexCount);
+		return false;
+	}
+
+	const uint32_t firstIndex = m_Indices.Allocate(static_cast<uint32_t>(indexCount));
+
+	if (firstIndex == RangeAllocator::InvalidOffset)
+	{
+		m_Vertices.Free(baseVertex, static_cast<uint32_t>(vertexCount));
+		Log::Warning("Geometry arena is full, {} indices can't be added", indexCount);
+		return false;
+	}
+
+	range = MeshRange{ firstIndex, static_cast<uint32_t>(indexCount), baseVertex, static_cast<uint32_t>(vertexCount) };
+
+	glBindBuffer(GL_ARRAY_BUFFER, m_Vbo);
+	glBufferSubData(GL_ARRAY_BUFFER, sizeof(Vertex) * static_cast<size_t>(baseVertex), sizeof(Vertex) * vertexCount, vertices);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	// The element buffer is part of the vertex array state, it can't be bound on its own while another vertex array is bound
+	glBindVertexArray(0);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_Ebo);
+	glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint32_t) * static_cast<size_t>(firstIndex), sizeof(uint32_t) * indexCount, indices);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+	return true;
+}
+
+void GeometryArena::Remove(const MeshRange& range)
+{
+	m_Vertices.Free(range.BaseVertex, range.VertexCount);
+	m_Indices.Free(range.FirstIndex, range.IndexCount);
+}
+
+uint32_t GeometryArena::GetVao() const
+{
+	return m_Vao;
+}
+
+const RangeAllocator& GeometryArena::GetVertices() const
+{
+	return m_Vertices;
+}
+
+const RangeAllocator& GeometryArena::GetIndices() const
+{
+	return m_Indices;
+}
@@ -6,6 +6,9 @@
 
 #include "ImGui/imgui.h"
 
+#include <cmath>
+#include <limits>
+
 Light::Light(Object* const obj, const Vector4& diffuse, const Vector4& ambient, const Vector4& specular, const float radius)
 	: Component(obj), Diffuse(diffuse), Ambient(ambient), Specular(specular), Radius(radius)
 {
@@ -18,3 +21,17 @@ void Light::OnGui()
 	ImGui::SliderFloat4("Specular", &Specular.x, 0.f, 1.f);
 	ImGui::SliderFloat("Radius", &Radius, 0.f, 100.f);
 }
+
+float Light::GetRange(const float linearAtt, const float quadAtt)
+{
+	// Root of quadratic * d * d + linear * d + 1 - 1 / MinAttenuation = 0
+	const float c = 1.f - 1.f / MinAttenuation;
+
+	if (quadAtt > 0.f)
+		return (-linearAtt + std::sqrt(linearAtt * linearAtt - 4.f * quadAtt * c)) / (2.f * quadAtt);
+
+	if (linearAtt > 0.f)
+		return -c / linearAtt;
+
+	return std::numeric_limits<float>::infinity();
+}
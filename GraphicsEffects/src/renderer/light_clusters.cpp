@@ -0,0 +1,329 @@
+#include "renderer/light_clusters.hpp"
+#include "renderer/light_buffer.hpp"
+#include "renderer/frame_ring.hpp"
+#include "core/maths/simd.h"
+#include "core/debug/profiler.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+
+static constexpr uint32_t TilesPerSlice = LightClusters::TileCountX * LightClusters::TileCountY;
+
+/// <summary>
+/// Depth of the near face of a slice, slices are exponentially distributed so that clusters keep a similar shape
+/// </summary>
+static float SliceDepth(const uint32_t slice, const float zNear, const float zFar)
+{
+	return zNear * std::pow(zFar / zNear, static_cast<float>(slice) / LightClusters::SliceCount);
+}
+
+/// <summary>
+/// Moves a light to view space, with the depth axis pointing forward
+/// </summary>
+static void ToView(const ClusterView& view, const LightBounds& light, float& x, float& y, float& z)
+{
+	const Vector3 offset = light.Position - view.Position;
+
+	x = Vector3::DotProduct(offset, view.Right);
+	y = Vector3::DotProduct(offset, view.Up);
+	z = Vector3::DotProduct(offset, view.Front);
+}
+
+LightClusters::LightClusters(ThreadPool* const pool)
+	: m_Pool(pool), m_Fov(0.f), m_Aspect(0.f), m_Near(0.f), m_Far(0.f), m_PointCount(0),
+	  m_Slices(SliceCount), m_Header(), m_Clusters(ClusterCount, Cluster())
+{
+}
+
+void LightClusters::ComputeBounds(const float fov, const float aspect, const float zNear, const float zFar, std::vector<Bounds>& bounds)
+{
+	bounds.resize(ClusterCount);
+
+	const float tanY = std::tan(fov * .5f);
+	const float tanX = tanY * aspect;
+
+	for (uint32_t s = 0; s < SliceCount; s++)
+	{
+		const float d0 = SliceDepth(s, zNear, zFar);
+		const float d1 = SliceDepth(s + 1, zNear, zFar);
+
+		for (uint32_t y = 0; y < TileCountY; y++)
+		{
+			const float y0 = (-1.f + 2.f * y / TileCountY) * tanY;
+			const float y1 = (-1.f + 2.f * (y + 1) / TileCountY) * tanY;
+
+			for (uint32_t x = 0; x < TileCountX; x++)
+			{
+				const float x0 = (-1.f + 2.f * x / TileCountX) * tanX;
+				const float x1 = (-1.f + 2.f * (x + 1) / TileCountX) * tanX;
+
+				// The cluster is a frustum, its extents are on its near or far face
+				Bounds& b = bounds[(s * TileCountY + y) * TileCountX + x];
+				b.MinX = std::min(x0 * d0, x0 * d1);
+				b.MaxX = std::max(x1 * d0, x1 * d1);
+				b.MinY = std::min(y0 * d0, y0 * d1);
+				b.MaxY = std::max(y1 * d0, y1 * d1);
+				b.MinZ = d0;
+				b.MaxZ = d1;
+			}
+		}
+	}
+}
+
+bool LightClusters::Intersects(const Bounds& bounds, const float x, const float y, const float z, const float radiusSquared)
+{
+	// Distance from the sphere center to the box, on each axis
+	const float dx = std::max(std::max(bounds.MinX - x, x - bounds.MaxX), 0.f);
+	const float dy = std::max(std::max(bounds.MinY - y, y - bounds.MaxY), 0.f);
+	const float dz = std::max(std::max(bounds.MinZ - z, z - bounds.MaxZ), 0.f);
+
+	return dx * dx + dy * dy + dz * dz <= radiusSquared;
+}
+
+void LightClusters::Build(const ClusterView& view, const std::vector<LightBounds>& pointLights, const std::vector<LightBounds>& spotLights)
+{
+	const float aspect = view.ScreenSize.x / view.ScreenSize.y;
+
+	// The bounds only depend on the projection
+	if (view.Fov != m_Fov || aspect != m_Aspect || view.Near != m_Near || view.Far != m_Far)
+	{
+		ComputeBounds(view.Fov, aspect, view.Near, view.Far, m_Bounds);
+		m_Fov = view.Fov;
+		m_Aspect = aspect;
+		m_Near = view.Near;
+		m_Far = view.Far;
+	}
+
+	const float logRatio = std::log(view.Far / view.Near);
+
+	m_Header.TileCountX = TileCountX;
+	m_Header.TileCountY = TileCountY;
+	m_Header.SliceCount = SliceCount;
+	m_Header.ScreenSize = view.ScreenSize;
+	m_Header.SliceScale = SliceCount / logRatio;
+	m_Header.SliceBias = -(SliceCount * std::log(view.Near)) / logRatio;
+	m_Header.Front = view.Front;
+
+	m_PointCount = static_cast<uint32_t>(pointLights.size());
+	const size_t count = pointLights.size() + spotLights.size();
+
+	m_X.resize(count);
+	m_Y.resize(count);
+	m_Z.resize(count);
+	m_Radius.resize(count);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		const LightBounds& light = i < m_PointCount ? pointLights[i] : spotLights[i - m_PointCount];
+
+		ToView(view, light, m_X[i], m_Y[i], m_Z[i]);
+		m_Radius[i] = light.Radius;
+	}
+
+	if (m_Pool != nullptr)
+	{
+		m_Pool->ParallelFor(SliceCount, [this](const uint32_t slice) { BinSlice(slice); });
+	}
+	else
+	{
+		for (uint32_t s = 0; s < SliceCount; s++)
+			BinSlice(s);
+	}
+
+	// Gather the slices, clusters are ordered by slice, then by row, then by column
+	m_Lights.clear();
+
+	for (uint32_t s = 0; s < SliceCount; s++)
+	{
+		const Slice& slice = m_Slices[s];
+		const uint32_t base = static_cast<uint32_t>(m_Lights.size());
+
+		for (uint32_t t = 0; t < TilesPerSlice; t++)
+		{
+			Cluster& cluster = m_Clusters[s * TilesPerSlice + t];
+			cluster = slice.Clusters[t];
+			cluster.Offset += base;
+		}
+
+		m_Lights.insert(m_Lights.end(), slice.Lights.begin(), slice.Lights.end());
+	}
+}
+
+void LightClusters::BinSlice(const uint32_t s)
+{
+	ProfileScope scope("Bin light slice");
+	Slice& slice = m_Slices[s];
+	const Bounds* const bounds = &m_Bounds[s * TilesPerSlice];
+
+	slice.X.clear();
+	slice.Y.clear();
+	slice.Z.clear();
+	slice.RadiusSquared.clear();
+	slice.Indices.clear();
+	slice.Lights.clear();
+
+	// Only keep the lights overlapping the depth range of the slice, every cluster of the slice shares it
+	for (uint32_t i = 0; i < static_cast<uint32_t>(m_X.size()); i++)
+	{
+		const float dz = std::max(std::max(bounds->MinZ - m_Z[i], m_Z[i] - bounds->MaxZ), 0.f);
+		const float radiusSquared = m_Radius[i] * m_Radius[i];
+
+		// Lights without radius light nothing, as in the shaders
+		if (m_Radius[i] <= 0.f || dz * dz > radiusSquared)
+			continue;
+
+		slice.X.push_back(m_X[i]);
+		slice.Y.push_back(m_Y[i]);
+		slice.Z.push_back(m_Z[i]);
+		slice.RadiusSquared.push_back(radiusSquared);
+		slice.Indices.push_back(i);
+	}
+
+	// Pad to a multiple of 4 with lights that never intersect
+	while (slice.X.size() % 4 != 0)
+	{
+		slice.X.push_back(0.f);
+		slice.Y.push_back(0.f);
+		slice.Z.push_back(0.f);
+		slice.RadiusSquared.push_back(-1.f);
+		slice.Indices.push_back(0);
+	}
+
+	const size_t candidates = slice.X.size();
+
+	for (uint32_t t = 0; t < TilesPerSlice; t++)
+	{
+		const Bounds& b = bounds[t];
+		Cluster& cluster = slice.Clusters[t];
+		cluster.Offset = static_cast<uint32_t>(slice.Lights.size());
+
+#ifdef MATHS_SIMD_SSE
+		const __m128 minX = _mm_set1_ps(b.MinX), maxX = _mm_set1_ps(b.MaxX);
+		const __m128 minY = _mm_set1_ps(b.MinY), maxY = _mm_set1_ps(b.MaxY);
+		const __m128 minZ = _mm_set1_ps(b.MinZ), maxZ = _mm_set1_ps(b.MaxZ);
+		const __m128 zero = _mm_setzero_ps();
+#endif
+
+		for (size_t j = 0; j < candidates; j += 4)
+		{
+#ifdef MATHS_SIMD_SSE
+			// Same operations as Intersects, on 4 lights
+			const __m128 x = _mm_loadu_ps(&slice.X[j]);
+			const __m128 y = _mm_loadu_ps(&slice.Y[j]);
+			const __m128 z = _mm_loadu_ps(&slice.Z[j]);
+
+			const __m128 dx = _mm_max_ps(_mm_max_ps(_mm_sub_ps(minX, x), _mm_sub_ps(x, maxX)), zero);
+			const __m128 dy = _mm_max_ps(_mm_max_ps(_mm_sub_ps(minY, y), _mm_sub_ps(y, maxY)), zero);
+			const __m128 dz = _mm_max_ps(_mm_max_ps(_mm_sub_ps(minZ, z), _mm_sub_ps(z, maxZ)), zero);
+
+			const __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+			uint32_t mask = static_cast<uint32_t>(_mm_movemask_ps(_mm_cmple_ps(distance, _mm_loadu_ps(&slice.RadiusSquared[j]))));
+#else
+			uint32_t mask = 0;
+			for (uint32_t k = 0; k < 4; k++)
+				mask |= Intersects(b, slice.X[j + k], slice.Y[j + k], slice.Z[j + k], slice.RadiusSquared[j + k]) << k;
+#endif
+
+			for (; mask != 0; mask &= mask - 1)
+				slice.Lights.push_back(slice.Indices[j + std::countr_zero(mask)]);
+		}
+
+		// Indices are in increasing order, so the point lights come first
+		const auto first = slice.Lights.begin() + cluster.Offset;
+		const auto firstSpot = std::lower_bound(first, slice.Lights.end(), m_PointCount);
+
+		cluster.PointCount = static_cast<uint32_t>(firstSpot - first);
+		cluster.SpotCount = static_cast<uint32_t>(slice.Lights.end() - firstSpot);
+		cluster.Padding = 0;
+
+		// Spot lights are indexed in their own buffer
+		for (auto it = firstSpot; it != slice.Lights.end(); it++)
+			*it -= m_PointCount;
+	}
+}
+
+void LightClusters::BuildReference(const ClusterView& view, const std::vector<LightBounds>& pointLights,
+	const std::vector<LightBounds>& spotLights, std::vector<Cluster>& clusters, std::vector<uint32_t>& lights)
+{
+	std::vector<Bounds> bounds;
+	ComputeBounds(view.Fov, view.ScreenSize.x / view.ScreenSize.y, view.Near, view.Far, bounds);
+
+	clusters.assign(ClusterCount, Cluster());
+	lights.clear();
+
+	const auto intersects = [&view](const Bounds& b, const LightBounds& light)
+		{
+			float x, y, z;
+			ToView(view, light, x, y, z);
+			return light.Radius > 0.f && Intersects(b, x, y, z, light.Radius * light.Radius);
+		};
+
+	for (uint32_t c = 0; c < ClusterCount; c++)
+	{
+		Cluster& cluster = clusters[c];
+		cluster.Offset = static_cast<uint32_t>(lights.size());
+
+		for (uint32_t i = 0; i < static_cast<uint32_t>(pointLights.size()); i++)
+		{
+			if (intersects(bounds[c], pointLights[i]))
+			{
+				lights.push_back(i);
+				cluster.PointCount++;
+			}
+		}
+
+		for (uint32_t i = 0; i < static_cast<uint32_t>(spotLights.size()); i++)
+		{
+			if (intersects(bounds[c], spotLights[i]))
+			{
+				lights.push_back(i);
+				cluster.SpotCount++;
+			}
+		}
+	}
+}
+
+void LightClusters::Upload()
+{
+	const size_t clusterSize = sizeof(Header) + ClusterCount * sizeof(Cluster);
+	// Never empty so that it can always be bound
+	const size_t lightSize = std::max<size_t>(m_Lights.size(), 1) * sizeof(uint32_t);
+
+	// The clusters are rebuilt every frame, they are written straight to the frame ring when there is room
+	if (FrameRing* const ring = FrameRing::Instance())
+	{
+		const RingAllocation clusters = ring->Allocate(clusterSize);
+		const RingAllocation lights = clusters.Data != nullptr ? ring->Allocate(lightSize) : RingAllocation();
+
+		if (lights.Data != nullptr)
+		{
+			uint8_t* const clusterData = static_cast<uint8_t*>(clusters.Data);
+			std::memcpy(clusterData, &m_Header, sizeof(Header));
+			std::memcpy(clusterData + sizeof(Header), m_Clusters.data(), ClusterCount * sizeof(Cluster));
+
+			if (!m_Lights.empty())
+				std::memcpy(lights.Data, m_Lights.data(), m_Lights.size() * sizeof(uint32_t));
+
+			ring->BindRange(static_cast<uint32_t>(LightBinding::CLUSTERS), clusters);
+			ring->BindRange(static_cast<uint32_t>(LightBinding::CLUSTER_LIGHTS), lights);
+			return;
+		}
+	}
+
+	if (m_ClusterBuffer.GetSize() != clusterSize)
+		m_ClusterBuffer.Allocate(clusterSize);
+
+	m_ClusterBuffer.Update(0, sizeof(Header), &m_Header);
+	m_ClusterBuffer.Update(sizeof(Header), ClusterCount * sizeof(Cluster), m_Clusters.data());
+
+	if (m_LightBuffer.GetSize() < lightSize)
+		m_LightBuffer.Allocate(std::max(lightSize, m_LightBuffer.GetSize() * 2));
+
+	if (!m_Lights.empty())
+		m_LightBuffer.Update(0, m_Lights.size() * sizeof(uint32_t), m_Lights.data());
+
+	m_ClusterBuffer.Bind(static_cast<uint32_t>(LightBinding::CLUSTERS));
+	m_LightBuffer.Bind(static_cast<uint32_t>(LightBinding::CLUSTER_LIGHTS));
+}
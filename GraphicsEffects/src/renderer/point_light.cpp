@@ -1,5 +1,4 @@
 #include "renderer/point_light.hpp"
-#include "resources/shader.hpp"
 #include "core/object.hpp"
 #include "core/scene.hpp"
 
@@ -26,20 +25,18 @@ PointLight::~PointLight()
 	Scene::CurrentScene()->RemovePointLight(this);
 }
 
-void PointLight::ForwardToShader(Shader& shader, uint32_t i) const
+void PointLight::Pack(PointLightData& data) const
 {
-	std::string baseName = std::string("pointLights[").append(std::to_string(i)).append("].");
+	data.Position = Owner->Transformation.GetPosition();
+	data.Radius = Radius;
 
-	shader.SetUniform(baseName + "position", Owner->Transformation.Position);
+	data.Ambient = Ambient;
+	data.Diffuse = Diffuse;
+	data.Specular = Specular;
 
-	shader.SetUniform(baseName + "ambient", Ambient);
-	shader.SetUniform(baseName + "diffuse", Diffuse);
-	shader.SetUniform(baseName + "specular", Specular);
-
-	shader.SetUniform(baseName + "constant", ConstantAttenuation);
-	shader.SetUniform(baseName + "linear", LinearAttenuation);
-	shader.SetUniform(baseName + "quadratic", QuadraticAttenuation);
-	shader.SetUniform(baseName + "radius", Radius);
+	data.Constant = ConstantAttenuation;
+	data.Linear = LinearAttenuation;
+	data.Quadratic = QuadraticAttenuation;
 }
 
 void PointLight::OnGui()
@@ -50,4 +47,8 @@ void PointLight::OnGui()
 	ImGui::SliderFloat("Linear att.", &LinearAttenuation, 0.f, 1.f);
 	ImGui::SliderFloat("Quadratic att.", &QuadraticAttenuation, 0.f, 1.f);
 	ImGui::Text("Radius %f", Radius);
+
+	std::vector<Object*> objects;
+	Scene::CurrentScene()->Query(BoundingSphere{ Owner->Transformation.GetPosition(), Radius }, objects);
+	ImGui::Text("Objects in range : %zu", objects.size());
 }
@@ -0,0 +1,351 @@
+#include "renderer/render_queue.hpp"
+#include "renderer/camera.hpp"
+#include "core/object.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <glad/glad.h>
+
+#include "core/debug/assert.hpp"
+#include "core/debug/profiler.hpp"
+
+RenderQueue::RenderQueue(ThreadPool* const pool)
+	: m_Mode(RenderMode::INSTANCED), m_Pool(pool), m_InstanceRange(), m_InstanceCapacity(0), m_CommandCapacity(0), m_CommandOffset(0),
+	  m_BoundShader(nullptr), m_BoundTexture(nullptr), m_Stats()
+{
+}
+
+void RenderQueue::Clear()
+{
+	m_Packets.clear();
+}
+
+void RenderQueue::Submit(Object& obj, const float depth)
+{
+	Assert::IsTrue(obj.HasShader() && obj.HasTexture() && obj.HasModel(), "Only objects with a shader, a texture and a model can be drawn");
+
+	const uint64_t key = MakeKey(obj.GetShader().GetHandle(), obj.GetTexture().GetHandle(), obj.GetModel().GetId(), depth, obj.Outlined);
+	m_Packets.push_back(DrawPacket{ key, &obj });
+}
+
+void RenderQueue::Sort()
+{
+	ProfileScope scope("Render queue sort");
+	RadixSort(m_Packets, m_Scratch);
+}
+
+void RenderQueue::BuildBatches()
+{
+	m_Batches.clear();
+
+	const uint32_t count = static_cast<uint32_t>(m_Packets.size());
+
+	for (uint32_t i = 0; i < count;)
+	{
+		Object& first = *m_Packets[i].Obj;
+		uint32_t end = i + 1;
+
+		// The keys only hold the low bits of the handles, so the states are compared directly
+		// Outlined objects need their own stencil pass, they are never batched
+		if (!first.Outlined)
+		{
+			while (end < count)
+			{
+				Object& obj = *m_Packets[end].Obj;
+
+				if (obj.Outlined || &obj.GetShader() != &first.GetShader() || &obj.GetTexture() != &first.GetTexture()
+					|| &obj.GetModel() != &first.GetModel())
+					break;
+
+				end++;
+			}
+		}
+
+		m_Batches.push_back(Batch{ i, end - i });
+		i = end;
+	}
+
+	// Instances are in the order of the packets, each worker packs a chunk of them
+	constexpr uint32_t chunkSize = 1024;
+	const uint32_t chunkCount = (count + chunkSize - 1) / chunkSize;
+
+	InstanceData* const instances = MapInstances(count);
+
+	const auto packChunk = [this, count, instances](const uint32_t chunk)
+		{
+			ProfileScope scope("Pack instances");
+			const uint32_t end = std::min(count, (chunk + 1) * chunkSize);
+
+			for (uint32_t i = chunk * chunkSize; i < end; i++)
+			{
+				Object& obj = *m_Packets[i].Obj;
+				const Matrix4x4& model = obj.Transformation.GetGlobalTransform();
+				InstanceData& instance = instances[i];
+
+				instance.Model = model;
+				instance.Color = obj.Color;
+
+				// A zero scaling has no inverse, the normals of a flattened object don't matter much
+				if (!model.NormalMatrix(instance.Normal))
+					instance.Normal = model;
+			}
+		};
+
+	if (m_Pool != nullptr && chunkCount > 1)
+	{
+		m_Pool->ParallelFor(chunkCount, packChunk);
+	}
+	else
+	{
+		for (uint32_t chunk = 0; chunk < chunkCount; chunk++)
+			packChunk(chunk);
+	}
+}
+
+InstanceData* RenderQueue::MapInstances(const size_t count)
+{
+	// The instances are packed straight into the mapped memory of the ring, the GPU reads them as they were written
+	FrameRing* const ring = FrameRing::Instance();
+	m_InstanceRange = ring != nullptr ? ring->Allocate(count * sizeof(InstanceData)) : RingAllocation();
+
+	if (m_InstanceRange.Data != nullptr)
+	{
+		m_Instances.clear();
+		return static_cast<InstanceData*>(m_InstanceRange.Data);
+	}
+
+	m_Instances.resize(count);
+	return m_Instances.data();
+}
+
+void RenderQueue::UploadInstances()
+{
+	if (m_InstanceRange.Data != nullptr)
+	{
+		FrameRing::Instance()->BindRange(InstanceBinding, m_InstanceRange);
+		return;
+	}
+
+	if (m_Instances.empty())
+		return;
+
+	if (m_Instances.size() > m_InstanceCapacity)
+	{
+		m_InstanceCapacity = std::max(m_InstanceCapacity * 2, std::max(m_Instances.size(), MinInstanceCapacity));
+		m_InstanceBuffer.Allocate(m_InstanceCapacity * sizeof(InstanceData));
+	}
+
+	m_InstanceBuffer.Update(0, m_Instances.size() * sizeof(InstanceData), m_Instances.data());
+	m_InstanceBuffer.Bind(InstanceBinding);
+}
+
+void RenderQueue::UploadCamera(Camera& camera)
+{
+	const CameraData data{ camera.GetProjView() };
+
+	FrameRing* const ring = FrameRing::Instance();
+	const RingAllocation range = ring != nullptr ? ring->Allocate(sizeof(CameraData)) : RingAllocation();
+
+	if (range.Data != nullptr)
+	{
+		std::memcpy(range.Data, &data, sizeof(CameraData));
+		ring->BindRange(CameraBinding, range);
+		return;
+	}
+
+	if (m_CameraBuffer.GetSize() == 0)
+		m_CameraBuffer.Allocate(sizeof(CameraData));
+
+	m_CameraBuffer.Update(0, sizeof(CameraData), &data);
+	m_CameraBuffer.Bind(CameraBinding);
+}
+
+void RenderQueue::UploadCommands()
+{
+	const std::vector<DrawElementsIndirectCommand>& commands = m_Commands.GetCommands();
+
+	if (commands.empty())
+		return;
+
+	const size_t size = commands.size() * sizeof(DrawElementsIndirectCommand);
+
+	FrameRing* const ring = FrameRing::Instance();
+	const RingAllocation range = ring != nullptr ? ring->Allocate(size) : RingAllocation();
+
+	if (range.Data != nullptr)
+	{
+		std::memcpy(range.Data, commands.data(), size);
+		ring->BindIndirect();
+		m_CommandOffset = range.Offset;
+		return;
+	}
+
+	m_CommandOffset = 0;
+
+	if (commands.size() > m_CommandCapacity)
+	{
+		m_CommandCapacity = std::max(m_CommandCapacity * 2, std::max(commands.size(), MinInstanceCapacity));
+		m_CommandBuffer.Allocate(m_CommandCapacity * sizeof(DrawElementsIndirectCommand));
+	}
+
+	m_CommandBuffer.Update(0, size, commands.data());
+	m_CommandBuffer.BindIndirect();
+}
+
+void RenderQueue::BindState(Object& obj, Camera& camera)
+{
+	Shader& shader = obj.GetShader();
+	Texture& texture = obj.GetTexture();
+
+	if (&shader != m_BoundShader)
+	{
+		shader.Use();
+		camera.SendToShader(shader);
+		m_BoundShader = &shader;
+		m_Stats.ProgramBinds++;
+	}
+
+	if (&texture != m_BoundTexture)
+	{
+		texture.Use();
+		m_BoundTexture = &texture;
+		m_Stats.TextureBinds++;
+	}
+}
+
+void RenderQueue::DrawBatch(const Batch& batch, const Matrix4x4& projView)
+{
+	Object& first = *m_Packets[batch.First].Obj;
+
+	for (uint32_t i = batch.First; i < batch.First + batch.Count; i++)
+		m_Packets[i].Obj->OnPreRender();
+
+	if (first.Outlined)
+		Object::BeginOutline();
+
+	first.GetModel().RenderInstanced(batch.Count, batch.First);
+	m_Stats.DrawCalls++;
+	m_Stats.Instances += batch.Count;
+
+	for (uint32_t i = batch.First; i < batch.First + batch.Count; i++)
+		m_Packets[i].Obj->OnPostRender();
+
+	if (first.Outlined && first.DrawOutline(projView))
+	{
+		m_Stats.DrawCalls++;
+		// The outline shader replaced the program
+		m_BoundShader = nullptr;
+	}
+}
+
+void RenderQueue::ExecuteIndirect(Camera& camera)
+{
+	m_IndirectBatches.clear();
+
+	uint32_t state = 0;
+
+	for (size_t b = 0; b < m_Batches.size(); b++)
+	{
+		Object& obj = *m_Packets[m_Batches[b].First].Obj;
+		const Model& model = obj.GetModel();
+
+		if (b > 0)
+		{
+			Object& previous = *m_Packets[m_Batches[b - 1].First].Obj;
+
+			// Outlined objects and models outside of the arena can't be part of a multi draw, they get a state of their own
+			const bool direct = obj.Outlined || !model.IsInArena();
+			const bool previousDirect = previous.Outlined || !previous.GetModel().IsInArena();
+
+			if (direct || previousDirect || &obj.GetShader() != &previous.GetShader() || &obj.GetTexture() != &previous.GetTexture())
+				state++;
+		}
+
+		m_IndirectBatches.push_back(IndirectBatch{ state, model.GetMeshRange(), m_Batches[b].Count, m_Batches[b].First });
+	}
+
+	m_Commands.Build(m_IndirectBatches, m_Pool);
+	UploadCommands();
+
+	const Matrix4x4& projView = camera.GetProjView();
+
+	for (const MultiDraw& draw : m_Commands.GetDraws())
+	{
+		const Batch& batch = m_Batches[draw.FirstCommand];
+		Object& first = *m_Packets[batch.First].Obj;
+
+		BindState(first, camera);
+
+		if (first.Outlined || !first.GetModel().IsInArena())
+		{
+			DrawBatch(batch, projView);
+			continue;
+		}
+
+		// The batches of a multi draw are consecutive, so are their packets
+		const Batch& last = m_Batches[draw.FirstCommand + draw.CommandCount - 1];
+		const uint32_t packetEnd = last.First + last.Count;
+
+		for (uint32_t i = batch.First; i < packetEnd; i++)
+			m_Packets[i].Obj->OnPreRender();
+
+		glBindVertexArray(GeometryArena::Instance()->GetVao());
+		glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT,
+			reinterpret_cast<const void*>(m_CommandOffset + sizeof(DrawElementsIndirectCommand) * draw.FirstCommand), static_cast<int>(draw.CommandCount), 0);
+		glBindVertexArray(0);
+
+		m_Stats.DrawCalls++;
+		m_Stats.Instances += packetEnd - batch.First;
+
+		for (uint32_t i = batch.First; i < packetEnd; i++)
+			m_Packets[i].Obj->OnPostRender();
+	}
+}
+
+void RenderQueue::Execute(Camera& camera)
+{
+	ProfileScope scope("Render queue execute");
+	m_Stats = RenderStats();
+	m_BoundShader = nullptr;
+	m_BoundTexture = nullptr;
+
+	BuildBatches();
+	UploadInstances();
+	UploadCamera(camera);
+
+	glActiveTexture(GL_TEXTURE0);
+
+	if (m_Mode == RenderMode::INDIRECT)
+	{
+		ExecuteIndirect(camera);
+		return;
+	}
+
+	const Matrix4x4& projView = camera.GetProjView();
+
+	for (const Batch& batch : m_Batches)
+	{
+		BindState(*m_Packets[batch.First].Obj, camera);
+		DrawBatch(batch, projView);
+	}
+}
+
+void RenderQueue::SetMode(const RenderMode mode)
+{
+	m_Mode = mode;
+}
+
+RenderMode RenderQueue::GetMode() const
+{
+	return m_Mode;
+}
+
+const std::vector<DrawPacket>& RenderQueue::GetPackets() const
+{
+	return m_Packets;
+}
+
+const RenderStats& RenderQueue::GetStats() const
+{
+	return m_Stats;
+}
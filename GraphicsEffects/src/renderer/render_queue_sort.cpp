@@ -0,0 +1,67 @@
+#include "renderer/render_queue.hpp"
+
+#include <algorithm>
+
+// The keys and their sort only work on packets, kept apart from the GL side of the queue so they can be tested on their own
+
+uint64_t RenderQueue::MakeKey(const uint32_t shader, const uint32_t texture, const uint32_t model, const float depth, const bool outlined)
+{
+	constexpr uint64_t idMask = (1ull << IdBits) - 1;
+	constexpr uint32_t maxDepth = (1u << DepthBits) - 1;
+
+	const uint64_t quantizedDepth = static_cast<uint64_t>(std::clamp(depth, 0.f, 1.f) * maxDepth);
+
+	return static_cast<uint64_t>(outlined) << OutlineShift
+		| (shader & idMask) << ShaderShift
+		| (texture & idMask) << TextureShift
+		| (model & idMask) << ModelShift
+		| quantizedDepth << DepthShift;
+}
+
+void RenderQueue::RadixSort(std::vector<DrawPacket>& packets, std::vector<DrawPacket>& scratch)
+{
+	const size_t count = packets.size();
+
+	if (count < 2)
+		return;
+
+	scratch.resize(count);
+
+	// One histogram per byte, all filled in a single pass over the keys
+	uint32_t histograms[8][256] = {};
+
+	for (const DrawPacket& packet : packets)
+	{
+		for (uint32_t b = 0; b < 8; b++)
+			histograms[b][(packet.Key >> (b * 8)) & 0xFF]++;
+	}
+
+	DrawPacket* source = packets.data();
+	DrawPacket* destination = scratch.data();
+
+	for (uint32_t b = 0; b < 8; b++)
+	{
+		uint32_t* const histogram = histograms[b];
+
+		// Every key has the same byte, the pass wouldn't move anything
+		if (histogram[(source[0].Key >> (b * 8)) & 0xFF] == count)
+			continue;
+
+		uint32_t offset = 0;
+
+		for (uint32_t i = 0; i < 256; i++)
+		{
+			const uint32_t bucketSize = histogram[i];
+			histogram[i] = offset;
+			offset += bucketSize;
+		}
+
+		for (size_t i = 0; i < count; i++)
+			destination[histogram[(source[i].Key >> (b * 8)) & 0xFF]++] = source[i];
+
+		std::swap(source, destination);
+	}
+
+	if (source != packets.data())
+		packets.swap(scratch);
+}
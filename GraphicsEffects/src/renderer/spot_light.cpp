@@ -1,5 +1,4 @@
 #include "renderer/spot_light.hpp"
-#include "resources/shader.hpp"
 
 #include "glad/glad.h"
 
@@ -34,23 +33,22 @@ SpotLight::~SpotLight()
 	Scene::CurrentScene()->RemoveSpotLight(this);
 }
 
-void SpotLight::ForwardToShader(Shader& shader, uint32_t i) const
+void SpotLight::Pack(SpotLightData& data) const
 {
-	std::string baseName = std::string("spotLights[").append(std::to_string(i)).append("].");
+	data.Position = Owner->Transformation.GetPosition();
+	data.Radius = Radius;
 
-	shader.SetUniform(baseName + "position", Owner->Transformation.Position);
-	shader.SetUniform(baseName + "direction", Direction);
+	data.Direction = Direction;
+	data.CutOff = std::cos(CutOff);
+	data.OuterCutOff = std::cos(OuterCutOff);
 
-	shader.SetUniform(baseName + "cutOff", std::cos(CutOff));
-	shader.SetUniform(baseName + "outerCutOff", std::cos(OuterCutOff));
+	data.Constant = ConstantAttenuation;
+	data.Linear = LinearAttenuation;
+	data.Quadratic = QuadraticAttenuation;
 
-	shader.SetUniform(baseName + "constant", ConstantAttenuation);
-	shader.SetUniform(baseName + "linear", LinearAttenuation);
-	shader.SetUniform(baseName + "quadratic", QuadraticAttenuation);
-
-	shader.SetUniform(baseName + "ambient", Ambient);
-	shader.SetUniform(baseName + "diffuse", Diffuse);
-	shader.SetUniform(baseName + "specular", Specular);
+	data.Ambient = Ambient;
+	data.Diffuse = Diffuse;
+	data.Specular = Specular;
 }
 
 void SpotLight::OnGui()
@@ -0,0 +1,48 @@
+#include "renderer/storage_buffer.hpp"
+
+#include "core/debug/assert.hpp"
+
+#include "glad/glad.h"
+
+StorageBuffer::StorageBuffer()
+	: m_Handle(0), m_Size(0)
+{
+}
+
+StorageBuffer::~StorageBuffer()
+{
+	if (m_Handle != 0)
+		glDeleteBuffers(1, &m_Handle);
+}
+
+void StorageBuffer::Allocate(const size_t size)
+{
+	// Created on the first allocation, so it can be constructed before the GL context
+	if (m_Handle == 0)
+		glGenBuffers(1, &m_Handle);
+
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_Handle);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+	m_Size = size;
+}
+
+void StorageBuffer::Update(const size_t offset, const size_t size, const void* const data)
+{
+	Assert::IsTrue(offset + size <= m_Size, "Storage buffer update out of bounds");
+
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_Handle);
+	glBufferSubData(GL_SHADER_STORAGE_BUFFER, offset, size, data);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+void StorageBuffer::Bind(const uint32_t binding) const
+{
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, m_Handle);
+}
+
+void StorageBuffer::BindIndirect() const
+{
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_Handle);
+}
@@ -0,0 +1,104 @@
+#include "resources/mapped_file.hpp"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::string& path)
+	: m_Data(nullptr), m_Size(0), m_Open(false)
+{
+#ifdef _WIN32
+	m_Mapping = nullptr;
+	m_File = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+	if (m_File == INVALID_HANDLE_VALUE)
+		return;
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(m_File, &size))
+		return;
+
+	m_Size = static_cast<size_t>(size.QuadPart);
+	m_Open = true;
+
+	// Empty files can't be mapped
+	if (m_Size == 0)
+		return;
+
+	m_Mapping = CreateFileMappingA(m_File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (m_Mapping == nullptr)
+	{
+		m_Open = false;
+		return;
+	}
+
+	m_Data = static_cast<const char*>(MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0));
+	m_Open = m_Data != nullptr;
+#else
+	m_File = open(path.c_str(), O_RDONLY);
+
+	if (m_File < 0)
+		return;
+
+	struct stat st;
+	if (fstat(m_File, &st) != 0)
+		return;
+
+	m_Size = static_cast<size_t>(st.st_size);
+	m_Open = true;
+
+	if (m_Size == 0)
+		return;
+
+	void* const data = mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, m_File, 0);
+	if (data == MAP_FAILED)
+	{
+		m_Open = false;
+		return;
+	}
+
+	m_Data = static_cast<const char*>(data);
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+#ifdef _WIN32
+	if (m_Data != nullptr)
+		UnmapViewOfFile(m_Data);
+
+	if (m_Mapping != nullptr)
+		CloseHandle(m_Mapping);
+
+	if (m_File != INVALID_HANDLE_VALUE)
+		CloseHandle(m_File);
+#else
+	if (m_Data != nullptr)
+		munmap(const_cast<char*>(m_Data), m_Size);
+
+	if (m_File >= 0)
+		close(m_File);
+#endif
+}
+
+bool MappedFile::IsOpen() const
+{
+	return m_Open;
+}
+
+const char* MappedFile::GetData() const
+{
+	return m_Data;
+}
+
+size_t MappedFile::GetSize() const
+{
+	return m_Size;
+}
@@ -0,0 +1,193 @@
+#include "resources/mesh_cache.hpp"
+
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+	// Alignment of the streams in the file
+	constexpr uint64_t StreamAlignment = 16;
+
+	inline uint64_t Align(const uint64_t offset)
+	{
+		return (offset + StreamAlignment - 1) & ~(StreamAlignment - 1);
+	}
+
+	bool GetSourceInfo(const std::string& source, uint64_t& size, int64_t& time)
+	{
+		std::error_code error;
+
+		size = std::filesystem::file_size(source, error);
+		if (error)
+			return false;
+
+		time = std::filesystem::last_write_time(source, error).time_since_epoch().count();
+		return !error;
+	}
+}
+
+std::string MeshCache::GetCookedPath(const std::string& source)
+{
+	return source + ".mesh";
+}
+
+uint64_t MeshCache::Hash(const char* const data, const size_t size)
+{
+	uint64_t hash = 14695981039346656037ull;
+
+	for (size_t i = 0; i < size; i++)
+	{
+		hash ^= static_cast<uint8_t>(data[i]);
+		hash *= 1099511628211ull;
+	}
+
+	return hash;
+}
+
+bool MeshCache::Write(const std::string& source, const char* const sourceData, const size_t sourceSize,
+	const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
+	const Vector3& boundsMin, const Vector3& boundsMax)
+{
+	CookedMeshHeader header;
+	header.magic = CookedMeshHeader::Magic;
+	header.version = CookedMeshHeader::Version;
+	header.vertexSize = sizeof(Vertex);
+	header.vertexCount = static_cast<uint32_t>(vertices.size());
+	header.indexCount = static_cast<uint32_t>(indices.size());
+	header.padding = 0;
+
+	// The source must not have changed since it was read
+	if (!GetSourceInfo(source, header.sourceSize, header.sourceTime) || header.sourceSize != sourceSize)
+		return false;
+
+	header.sourceHash = Hash(sourceData, sourceSize);
+
+	header.boundsMin = boundsMin;
+	header.boundsMax = boundsMax;
+
+	header.vertexOffset = Align(sizeof(CookedMeshHeader));
+	header.indexOffset = Align(header.vertexOffset + sizeof(Vertex) * vertices.size());
+
+	// Write to a temporary file first so a partially written file is never picked up
+	const std::string path = GetCookedPath(source);
+	const std::string tmpPath = path + ".tmp";
+
+	bool written = false;
+	{
+		std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+		if (file.is_open())
+		{
+			const char zeros[StreamAlignment] = {};
+
+			file.write(reinterpret_cast<const char*>(&header), sizeof(CookedMeshHeader));
+			file.write(zeros, header.vertexOffset - sizeof(CookedMeshHeader));
+			file.write(reinterpret_cast<const char*>(vertices.data()), sizeof(Vertex) * vertices.size());
+			file.write(zeros, header.indexOffset - header.vertexOffset - sizeof(Vertex) * vertices.size());
+			file.write(reinterpret_cast<const char*>(indices.data()), sizeof(uint32_t) * indices.size());
+
+			file.close();
+			written = file.good();
+		}
+	}
+
+	std::error_code error;
+	if (written)
+		std::filesystem::rename(tmpPath, path, error);
+
+	// Never leave a partially written temporary file behind
+	if (!written || error)
+	{
+		std::filesystem::remove(tmpPath, error);
+		return false;
+	}
+
+	return true;
+}
+
+CookedMesh::CookedMesh(const std::string& source)
+	: m_File(MeshCache::GetCookedPath(source)), m_Header(nullptr)
+{
+	if (m_File.GetSize() < sizeof(CookedMeshHeader))
+		return;
+
+	m_Header = reinterpret_cast<const CookedMeshHeader*>(m_File.GetData());
+
+	if (!Validate(source))
+		m_Header = nullptr;
+}
+
+bool CookedMesh::Validate(const std::string& source) const
+{
+	if (m_Header->magic != CookedMeshHeader::Magic
+		|| m_Header->version != CookedMeshHeader::Version
+		|| m_Header->vertexSize != sizeof(Vertex))
+		return false;
+
+	// Streams must fit in the file, written so that corrupt offsets and counts can't overflow
+	const uint64_t fileSize = m_File.GetSize();
+	if (m_Header->vertexOffset > fileSize || m_Header->vertexCount > (fileSize - m_Header->vertexOffset) / sizeof(Vertex)
+		|| m_Header->indexOffset > fileSize || m_Header->indexCount > (fileSize - m_Header->indexOffset) / sizeof(uint32_t))
+		return false;
+
+	// Streams are reinterpreted in place so they must be aligned
+	if (m_Header->vertexOffset % alignof(Vertex) != 0 || m_Header->indexOffset % alignof(uint32_t) != 0)
+		return false;
+
+	uint64_t size;
+	int64_t time;
+	if (!GetSourceInfo(source, size, time) || size != m_Header->sourceSize)
+		return false;
+
+	// The source was touched, but its content may be the same
+	if (time != m_Header->sourceTime)
+	{
+		const MappedFile sourceFile(source);
+		if (!sourceFile.IsOpen() || MeshCache::Hash(sourceFile.GetData(), sourceFile.GetSize()) != m_Header->sourceHash)
+			return false;
+	}
+
+	// Indices go straight to the GPU, reject them like ObjParser does when they are out of range
+	const uint32_t* const indices = GetIndices();
+	for (uint32_t i = 0; i < m_Header->indexCount; i++)
+	{
+		if (indices[i] >= m_Header->vertexCount)
+			return false;
+	}
+
+	return true;
+}
+
+bool CookedMesh::IsValid() const
+{
+	return m_Header != nullptr;
+}
+
+const Vertex* CookedMesh::GetVertices() const
+{
+	return reinterpret_cast<const Vertex*>(m_File.GetData() + m_Header->vertexOffset);
+}
+
+uint32_t CookedMesh::GetVertexCount() const
+{
+	return m_Header->vertexCount;
+}
+
+const uint32_t* CookedMesh::GetIndices() const
+{
+	return reinterpret_cast<const uint32_t*>(m_File.GetData() + m_Header->indexOffset);
+}
+
+uint32_t CookedMesh::GetIndexCount() const
+{
+	return m_Header->indexCount;
+}
+
+const Vector3& CookedMesh::GetBoundsMin() const
+{
+	return m_Header->boundsMin;
+}
+
+const Vector3& CookedMesh::GetBoundsMax() const
+{
+	return m_Header->boundsMax;
+}
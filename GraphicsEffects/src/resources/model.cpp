@@ -1,23 +1,40 @@
 #include "resources/model.hpp"
-#include "core/debug/assert.hpp"
+#include "resources/mapped_file.hpp"
+#include "resources/obj_parser.hpp"
+#include "resources/mesh_cache.hpp"
+#include "resources/resource_manager.hpp"
 
 #include "glad/glad.h"
 
 #include "core/debug/log.hpp"
 
-#include <fstream>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
 
-void Model::SetupMesh()
+std::atomic<uint32_t> Model::m_NextId;
+
+Model::~Model()
 {
-	glGenVertexArrays(1, &m_Vao);
-	glGenBuffers(1, &m_Vbo);
-	glGenBuffers(1, &m_Ebo);
+	if (m_InArena)
+	{
+		// The arena may already be gone, its buffers with it
+		if (GeometryArena* const arena = GeometryArena::Instance())
+			arena->Remove(m_Range);
 
-	glBindVertexArray(m_Vao);
+		return;
+	}
 
-	glBindBuffer(GL_ARRAY_BUFFER, m_Vbo);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * m_Vertices.size(), m_Vertices.data(), GL_STATIC_DRAW);
+	if (m_Vao != 0)
+	{
+		glDeleteVertexArrays(1, &m_Vao);
+		glDeleteBuffers(1, &m_Vbo);
+		glDeleteBuffers(1, &m_Ebo);
+	}
+}
 
+void Model::SetupAttributes()
+{
 	// Position
 	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Position));
 	glEnableVertexAttribArray(0);
@@ -31,87 +48,166 @@ void Model::SetupMesh()
 	glEnableVertexAttribArray(2);
 }
 
-void Model::Load()
+void Model::SetupMesh(const Vertex* const vertices, const size_t vertexCount, const uint32_t* const indices, const size_t indexCount)
+{
+	m_IndexCount = static_cast<uint32_t>(indexCount);
+
+	GeometryArena* const arena = GeometryArena::Instance();
+
+	// Falls back to buffers of its own when there is no arena or when it is full
+	if (arena != nullptr && arena->Add(vertices, vertexCount, indices, indexCount, m_Range))
+	{
+		m_Vao = arena->GetVao();
+		m_InArena = true;
+		return;
+	}
+
+	m_Range = MeshRange{ 0, m_IndexCount, 0, static_cast<uint32_t>(vertexCount) };
+
+	glGenVertexArrays(1, &m_Vao);
+	glGenBuffers(1, &m_Vbo);
+	glGenBuffers(1, &m_Ebo);
+
+	glBindVertexArray(m_Vao);
+
+	glBindBuffer(GL_ARRAY_BUFFER, m_Vbo);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * vertexCount, vertices, GL_STATIC_DRAW);
+	SetupAttributes();
+
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_Ebo);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint32_t) * indexCount, indices, GL_STATIC_DRAW);
+
+	glBindVertexArray(0);
+}
+
+void Model::ComputeBoundingRadius(const Vertex* const vertices, const size_t vertexCount)
+{
+	const Vector3 center = (m_BoundsMin + m_BoundsMax) * .5f;
+	float radiusSquared = 0.f;
+
+	// Tighter than the half diagonal of the box for round models
+	for (size_t i = 0; i < vertexCount; i++)
+		radiusSquared = std::max(radiusSquared, Vector3::DistanceSquared(vertices[i].Position, center));
+
+	m_BoundingRadius = std::sqrt(radiusSquared);
+}
+
+void Model::Cook()
+{
+	const MappedFile file(m_Name);
+
+	// A missing or malformed file isn't a programming error, LoadAsync reports it and marks the model as failed
+	if (!file.IsOpen())
+		throw std::runtime_error(std::string("Couldn't open model : ").append(m_Name));
+
+	// Shares the decoding workers instead of starting threads, Cook usually runs on one of them
+	const bool parsed = ObjParser::Parse(file.GetData(), file.GetSize(), m_Vertices, m_Indices, ResourceManager::GetPool());
+	if (!parsed)
+		throw std::runtime_error(std::string("Couldn't parse model : ").append(m_Name));
+
+	m_BoundsMin = m_Vertices.empty() ? Vector3() : m_Vertices[0].Position;
+	m_BoundsMax = m_BoundsMin;
+
+	for (const Vertex& v : m_Vertices)
+	{
+		m_BoundsMin = Vector3(std::min(m_BoundsMin.x, v.Position.x), std::min(m_BoundsMin.y, v.Position.y), std::min(m_BoundsMin.z, v.Position.z));
+		m_BoundsMax = Vector3(std::max(m_BoundsMax.x, v.Position.x), std::max(m_BoundsMax.y, v.Position.y), std::max(m_BoundsMax.z, v.Position.z));
+	}
+
+	ComputeBoundingRadius(m_Vertices.data(), m_Vertices.size());
+
+	if (!MeshCache::Write(m_Name, file.GetData(), file.GetSize(), m_Vertices, m_Indices, m_BoundsMin, m_BoundsMax))
+		Log::LogWarning(std::string("Couldn't write the cooked mesh of : ").append(m_Name));
+}
+
+void Model::Decode()
 {
-	std::ifstream file(m_Name);
-	std::vector<Vector3> positions;
-	std::vector<Vector2> uvs;
-	std::vector<Vector3> normals;
+	m_Cooked = std::make_unique<CookedMesh>(m_Name);
 
-	Assert::IsTrue(file.is_open(), std::string("Couldn't load model : ").append(m_Name).c_str());
+	if (!m_Cooked->IsValid())
+	{
+		m_Cooked.reset();
+		Cook();
+		return;
+	}
+
+	m_BoundsMin = m_Cooked->GetBoundsMin();
+	m_BoundsMax = m_Cooked->GetBoundsMax();
+
+	ComputeBoundingRadius(m_Cooked->GetVertices(), m_Cooked->GetVertexCount());
+}
 
-	while (!file.eof())
+void Model::Upload()
+{
+	if (m_Cooked)
 	{
-		std::string line;
-		std::getline(file, line);
-
-		if (line[0] == '#')
-			continue;
-
-		if (line[0] == 'f')
-		{
-			uint32_t indices[3][3];
-			int32_t a = sscanf_s(line.c_str(), "f %d/%d/%d %d/%d/%d %d/%d/%d",
-				&indices[0][0], &indices[0][1], &indices[0][2],
-				&indices[1][0], &indices[1][1], &indices[1][2],
-				&indices[2][0], &indices[2][1], &indices[2][2]
-			);
-
-			m_Vertices.push_back(Vertex(
-				positions[indices[0][0] - 1],
-				uvs[indices[0][1] - 1],
-				normals[indices[0][2] - 1]
-			));
-
-			m_Vertices.push_back(Vertex(
-				positions[indices[1][0] - 1],
-				uvs[indices[1][1] - 1],
-				normals[indices[1][2] - 1]
-			));
-
-			m_Vertices.push_back(Vertex(
-				positions[indices[2][0] - 1],
-				uvs[indices[2][1] - 1],
-				normals[indices[2][2] - 1]
-			));
-			continue;
-		}
-		
-		if (line[0] == 'v')
-		{
-			if (line[1] == 't')
-			{
-				Vector2 v;
-				// Ignore no discard warning
-				int32_t a = sscanf_s(line.c_str(), "vt %f %f", &v.x, &v.y);
-				// Invert Y uvs
-				v.y = 1.f - v.y;
-				uvs.push_back(v);
-			}
-			else if (line[1] == 'n')
-			{
-				Vector3 v;
-				// Ignore no discard warning
-				int32_t a = sscanf_s(line.c_str(), "vn %f %f %f", &v.x, &v.y, &v.z);
-				normals.push_back(v);
-			}
-			else
-			{
-				Vector3 v;
-				// Ignore no discard warning
-				int32_t a = sscanf_s(line.c_str(), "v %f %f %f", &v.x, &v.y, &v.z);
-				positions.push_back(v);
-			}
-		}
+		// The streams are uploaded straight from the mapping
+		SetupMesh(m_Cooked->GetVertices(), m_Cooked->GetVertexCount(), m_Cooked->GetIndices(), m_Cooked->GetIndexCount());
+		m_Cooked.reset();
+		return;
 	}
 
-	file.close();
-	SetupMesh();
+	SetupMesh(m_Vertices.data(), m_Vertices.size(), m_Indices.data(), m_Indices.size());
+
+	// Release the CPU copies
+	std::vector<Vertex>().swap(m_Vertices);
+	std::vector<uint32_t>().swap(m_Indices);
 }
 
 void Model::Render()
 {
+	if (!m_Loaded)
+		return;
+
+	glBindVertexArray(m_Vao);
+	glDrawElementsBaseVertex(GL_TRIANGLES, static_cast<int>(m_IndexCount), GL_UNSIGNED_INT,
+		reinterpret_cast<const void*>(sizeof(uint32_t) * m_Range.FirstIndex), static_cast<int>(m_Range.BaseVertex));
+	glBindVertexArray(0);
+}
+
+void Model::RenderInstanced(const uint32_t instanceCount, const uint32_t baseInstance)
+{
+	if (!m_Loaded)
+		return;
+
 	glBindVertexArray(m_Vao);
-	glDrawArrays(GL_TRIANGLES, 0, static_cast<int>(m_Vertices.size()));
+	glDrawElementsInstancedBaseVertexBaseInstance(GL_TRIANGLES, static_cast<int>(m_IndexCount), GL_UNSIGNED_INT,
+		reinterpret_cast<const void*>(sizeof(uint32_t) * m_Range.FirstIndex), static_cast<int>(instanceCount),
+		static_cast<int>(m_Range.BaseVertex), baseInstance);
 	glBindVertexArray(0);
 }
+
+uint32_t Model::GetId() const
+{
+	return m_Id;
+}
+
+bool Model::IsInArena() const
+{
+	return m_InArena;
+}
+
+const MeshRange& Model::GetMeshRange() const
+{
+	return m_Range;
+}
+
+const Vector3& Model::GetBoundsMin() const
+{
+	return m_BoundsMin;
+}
+
+const Vector3& Model::GetBoundsMax() const
+{
+	return m_BoundsMax;
+}
+
+BoundingBox Model::GetBoundingBox() const
+{
+	return BoundingBox{ m_BoundsMin, m_BoundsMax };
+}
+
+BoundingSphere Model::GetBoundingSphere() const
+{
+	return BoundingSphere{ (m_BoundsMin + m_BoundsMax) * .5f, m_BoundingRadius };
+}
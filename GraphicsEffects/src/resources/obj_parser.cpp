@@ -0,0 +1,412 @@
+#include "resources/obj_parser.hpp"
+
+#include "core/debug/log.hpp"
+
+#include <charconv>
+#include <algorithm>
+
+namespace
+{
+	// Chunks smaller than this aren't worth a task
+	constexpr size_t MinChunkSize = 64 * 1024;
+
+	// Index of a missing uv or normal
+	constexpr int32_t MissingIndex = INT32_MIN;
+
+	// Flags of the corner components that are relative to the start of the chunk (negative OBJ indices)
+	constexpr uint8_t RelativePosition = 1 << 0;
+	constexpr uint8_t RelativeUv = 1 << 1;
+	constexpr uint8_t RelativeNormal = 1 << 2;
+
+	struct Chunk
+	{
+		const char* begin;
+		const char* end;
+
+		std::vector<Vector3> positions;
+		std::vector<Vector2> uvs;
+		std::vector<Vector3> normals;
+
+		// Position/uv/normal index of every triangle corner, 0 based
+		std::vector<int32_t> corners;
+		// One RelativeX mask per corner
+		std::vector<uint8_t> relative;
+		// Number of positions/uvs/normals of the chunk declared before each triangle, its corners can't refer past them
+		std::vector<uint32_t> declared;
+
+		bool valid = true;
+	};
+
+	inline bool IsBlank(const char c)
+	{
+		return c == ' ' || c == '\t';
+	}
+
+	inline bool IsEndOfLine(const char c)
+	{
+		return c == '\n' || c == '\r';
+	}
+
+	inline void SkipBlanks(const char*& ptr, const char* const end)
+	{
+		while (ptr < end && IsBlank(*ptr))
+			ptr++;
+	}
+
+	inline void SkipLine(const char*& ptr, const char* const end)
+	{
+		while (ptr < end && *ptr != '\n')
+			ptr++;
+
+		if (ptr < end)
+			ptr++;
+	}
+
+	inline bool ParseFloat(const char*& ptr, const char* const end, float& value)
+	{
+		SkipBlanks(ptr, end);
+
+		// from_chars doesn't accept an explicit positive sign
+		if (ptr < end && *ptr == '+')
+			ptr++;
+
+		const std::from_chars_result result = std::from_chars(ptr, end, value);
+		if (result.ec != std::errc())
+			return false;
+
+		ptr = result.ptr;
+		return true;
+	}
+
+	/// <summary>
+	/// Parses an OBJ index and converts it to a 0 based index, negative indices are converted relative to the start of the chunk
+	/// </summary>
+	inline bool ParseIndex(const char*& ptr, const char* const end, const size_t localCount, int32_t& index, bool& relative)
+	{
+		int32_t value;
+		const std::from_chars_result result = std::from_chars(ptr, end, value);
+		if (result.ec != std::errc() || value == 0)
+			return false;
+
+		ptr = result.ptr;
+		relative = value < 0;
+		index = relative ? static_cast<int32_t>(localCount) + value : value - 1;
+		return true;
+	}
+
+	bool ParseCorner(const char*& ptr, const char* const end, Chunk& chunk, int32_t corner[3], uint8_t& relative)
+	{
+		bool rel;
+		relative = 0;
+		corner[1] = MissingIndex;
+		corner[2] = MissingIndex;
+
+		if (!ParseIndex(ptr, end, chunk.positions.size(), corner[0], rel))
+			return false;
+		relative |= rel ? RelativePosition : 0;
+
+		if (ptr >= end || *ptr != '/')
+			return true;
+		ptr++;
+
+		// v//vn
+		if (ptr < end && *ptr != '/')
+		{
+			if (!ParseIndex(ptr, end, chunk.uvs.size(), corner[1], rel))
+				return false;
+			relative |= rel ? RelativeUv : 0;
+		}
+
+		if (ptr >= end || *ptr != '/')
+			return true;
+		ptr++;
+
+		if (!ParseIndex(ptr, end, chunk.normals.size(), corner[2], rel))
+			return false;
+		relative |= rel ? RelativeNormal : 0;
+
+		return true;
+	}
+
+	bool ParseFace(const char*& ptr, const char* const end, Chunk& chunk)
+	{
+		int32_t first[3], previous[3], current[3];
+		uint8_t firstRel = 0, previousRel = 0, currentRel;
+		uint32_t count = 0;
+
+		while (true)
+		{
+			SkipBlanks(ptr, end);
+			if (ptr >= end || IsEndOfLine(*ptr))
+				break;
+
+			if (!ParseCorner(ptr, end, chunk, current, currentRel))
+				return false;
+
+			if (count == 0)
+			{
+				std::copy_n(current, 3, first);
+				firstRel = currentRel;
+			}
+			else if (count >= 2)
+			{
+				// Fan triangulation
+				chunk.corners.insert(chunk.corners.end(), first, first + 3);
+				chunk.corners.insert(chunk.corners.end(), previous, previous + 3);
+				chunk.corners.insert(chunk.corners.end(), current, current + 3);
+				chunk.relative.push_back(firstRel);
+				chunk.relative.push_back(previousRel);
+				chunk.relative.push_back(currentRel);
+				chunk.declared.push_back(static_cast<uint32_t>(chunk.positions.size()));
+				chunk.declared.push_back(static_cast<uint32_t>(chunk.uvs.size()));
+				chunk.declared.push_back(static_cast<uint32_t>(chunk.normals.size()));
+			}
+
+			std::copy_n(current, 3, previous);
+			previousRel = currentRel;
+			count++;
+		}
+
+		return count >= 3;
+	}
+
+	void ParseChunk(Chunk& chunk)
+	{
+		const char* ptr = chunk.begin;
+		const char* const end = chunk.end;
+
+		while (ptr < end)
+		{
+			SkipBlanks(ptr, end);
+			if (ptr >= end)
+				break;
+
+			bool valid = true;
+
+			if (ptr[0] == 'v' && ptr + 1 < end)
+			{
+				if (IsBlank(ptr[1]))
+				{
+					ptr++;
+					Vector3 v;
+					valid = ParseFloat(ptr, end, v.x) && ParseFloat(ptr, end, v.y) && ParseFloat(ptr, end, v.z);
+					chunk.positions.push_back(v);
+				}
+				else if (ptr[1] == 't')
+				{
+					ptr += 2;
+					Vector2 v;
+					valid = ParseFloat(ptr, end, v.x) && ParseFloat(ptr, end, v.y);
+					// Invert Y uvs
+					v.y = 1.f - v.y;
+					chunk.uvs.push_back(v);
+				}
+				else if (ptr[1] == 'n')
+				{
+					ptr += 2;
+					Vector3 v;
+					valid = ParseFloat(ptr, end, v.x) && ParseFloat(ptr, end, v.y) && ParseFloat(ptr, end, v.z);
+					chunk.normals.push_back(v);
+				}
+			}
+			else if (ptr[0] == 'f' && ptr + 1 < end && IsBlank(ptr[1]))
+			{
+				ptr++;
+				valid = ParseFace(ptr, end, chunk);
+			}
+
+			if (!valid)
+			{
+				chunk.valid = false;
+				return;
+			}
+
+			// Comments, unsupported statements and the rest of the line (e.g. the w component)
+			SkipLine(ptr, end);
+		}
+	}
+
+	/// <summary>
+	/// Open addressing hash table mapping a position/uv/normal triplet to a vertex index
+	/// </summary>
+	class VertexTable
+	{
+	private:
+		struct Entry
+		{
+			uint32_t position;
+			uint32_t uv;
+			uint32_t normal;
+			uint32_t vertex;
+		};
+
+		static constexpr uint32_t Empty = UINT32_MAX;
+
+		std::vector<Entry> m_Entries;
+		size_t m_Mask;
+
+	public:
+		VertexTable(const size_t maxCount)
+		{
+			size_t capacity = 16;
+			while (capacity < maxCount * 2)
+				capacity <<= 1;
+
+			m_Entries.resize(capacity, Entry{ 0, 0, 0, Empty });
+			m_Mask = capacity - 1;
+		}
+
+		/// <summary>
+		/// Finds the vertex index of a triplet, or inserts it with the given index
+		/// </summary>
+		/// <returns>Whether the triplet was inserted</returns>
+		bool FindOrInsert(const uint32_t position, const uint32_t uv, const uint32_t normal, uint32_t& vertex)
+		{
+			size_t slot = (position * 73856093u ^ uv * 19349663u ^ normal * 83492791u) & m_Mask;
+
+			while (true)
+			{
+				Entry& entry = m_Entries[slot];
+
+				if (entry.vertex == Empty)
+				{
+					entry = Entry{ position, uv, normal, vertex };
+					return true;
+				}
+
+				if (entry.position == position && entry.uv == uv && entry.normal == normal)
+				{
+					vertex = entry.vertex;
+					return false;
+				}
+
+				slot = (slot + 1) & m_Mask;
+			}
+		}
+	};
+
+	inline bool ResolveIndex(const int32_t index, const bool relative, const size_t offset, const size_t count, uint32_t& resolved)
+	{
+		const int64_t value = relative ? static_cast<int64_t>(offset) + index : index;
+		if (value < 0 || value >= static_cast<int64_t>(count))
+			return false;
+
+		resolved = static_cast<uint32_t>(value);
+		return true;
+	}
+}
+
+bool ObjParser::Parse(const char* const data, const size_t size, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices,
+	ThreadPool* const pool)
+{
+	vertices.clear();
+	indices.clear();
+
+	if (data == nullptr || size == 0)
+		return false;
+
+	// One chunk per worker and one for the calling thread
+	const size_t maxChunks = pool != nullptr ? pool->GetThreadCount() + 1 : 1;
+	const size_t chunkCount = std::clamp<size_t>(size / MinChunkSize, 1, maxChunks);
+
+	// Split the text at line boundaries
+	std::vector<Chunk> chunks(chunkCount);
+	const char* const end = data + size;
+	const char* begin = data;
+
+	for (size_t i = 0; i < chunkCount; i++)
+	{
+		const char* chunkEnd = i == chunkCount - 1 ? end : data + size * (i + 1) / chunkCount;
+		chunkEnd = std::max(chunkEnd, begin);
+		SkipLine(chunkEnd, end);
+
+		chunks[i].begin = begin;
+		chunks[i].end = chunkEnd;
+		begin = chunkEnd;
+	}
+
+	// Parse the chunks, the calling thread takes part so this is safe from a worker of the same pool
+	if (chunkCount > 1)
+		pool->ParallelFor(static_cast<uint32_t>(chunkCount), [&chunks](const uint32_t chunk) { ParseChunk(chunks[chunk]); });
+	else
+		ParseChunk(chunks[0]);
+
+	// Concatenate the attributes
+	size_t positionCount = 0, uvCount = 0, normalCount = 0, cornerCount = 0;
+	for (const Chunk& chunk : chunks)
+	{
+		if (!chunk.valid)
+		{
+			Log::LogError("Malformed OBJ statement");
+			return false;
+		}
+
+		positionCount += chunk.positions.size();
+		uvCount += chunk.uvs.size();
+		normalCount += chunk.normals.size();
+		cornerCount += chunk.relative.size();
+	}
+
+	std::vector<Vector3> positions;
+	std::vector<Vector2> uvs;
+	std::vector<Vector3> normals;
+	positions.reserve(positionCount);
+	uvs.reserve(uvCount);
+	normals.reserve(normalCount);
+
+	// Deduplicate the triangle corners
+	VertexTable table(cornerCount);
+	indices.reserve(cornerCount);
+	vertices.reserve(cornerCount / 3);
+
+	for (const Chunk& chunk : chunks)
+	{
+		const size_t positionOffset = positions.size();
+		const size_t uvOffset = uvs.size();
+		const size_t normalOffset = normals.size();
+
+		positions.insert(positions.end(), chunk.positions.begin(), chunk.positions.end());
+		uvs.insert(uvs.end(), chunk.uvs.begin(), chunk.uvs.end());
+		normals.insert(normals.end(), chunk.normals.begin(), chunk.normals.end());
+
+		for (size_t i = 0; i < chunk.relative.size(); i++)
+		{
+			const int32_t* const corner = &chunk.corners[i * 3];
+			const uint8_t relative = chunk.relative[i];
+			const uint32_t* const declared = &chunk.declared[i / 3 * 3];
+
+			uint32_t position = 0, uv = UINT32_MAX, normal = UINT32_MAX;
+
+			// Indices can only refer to attributes declared before the face, whichever chunk they are in
+			bool valid = ResolveIndex(corner[0], relative & RelativePosition, positionOffset, positionOffset + declared[0], position);
+
+			if (corner[1] != MissingIndex)
+				valid &= ResolveIndex(corner[1], relative & RelativeUv, uvOffset, uvOffset + declared[1], uv);
+
+			if (corner[2] != MissingIndex)
+				valid &= ResolveIndex(corner[2], relative & RelativeNormal, normalOffset, normalOffset + declared[2], normal);
+
+			if (!valid)
+			{
+				Log::LogError("OBJ face index out of range");
+				vertices.clear();
+				indices.clear();
+				return false;
+			}
+
+			uint32_t vertex = static_cast<uint32_t>(vertices.size());
+			if (table.FindOrInsert(position, uv, normal, vertex))
+			{
+				vertices.emplace_back(
+					positions[position],
+					uv == UINT32_MAX ? Vector2() : uvs[uv],
+					normal == UINT32_MAX ? Vector3() : normals[normal]
+				);
+			}
+
+			indices.push_back(vertex);
+		}
+	}
+
+	return true;
+}
@@ -1,7 +1,52 @@
 #include "resources/resource_manager.hpp"
 
+#include <chrono>
+
 std::unordered_map<std::string, Resource*> ResourceManager::m_Resources;
 
+ThreadPool* ResourceManager::m_Pool;
+MpscQueue<Resource*> ResourceManager::m_Uploads;
+
+void ResourceManager::Init(ThreadPool* const pool)
+{
+	m_Pool = pool;
+}
+
+ThreadPool* ResourceManager::GetPool()
+{
+	return m_Pool;
+}
+
+void ResourceManager::Shutdown()
+{
+	m_Pool = nullptr;
+
+	while (m_Uploads.TryPop())
+		;
+
+	DeleteAll();
+}
+
+uint32_t ResourceManager::ProcessUploads(const float budget)
+{
+	using Clock = std::chrono::steady_clock;
+
+	const Clock::time_point start = Clock::now();
+	uint32_t count = 0;
+
+	while (std::optional<Resource*> res = m_Uploads.TryPop())
+	{
+		(*res)->Upload();
+		(*res)->m_Loaded = true;
+		count++;
+
+		if (std::chrono::duration<float, std::milli>(Clock::now() - start).count() >= budget)
+			break;
+	}
+
+	return count;
+}
+
 void ResourceManager::Delete(const std::string& name)
 {
 	m_Resources.erase(name);
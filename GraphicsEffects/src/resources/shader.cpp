@@ -3,6 +3,9 @@
 
 #include "core/debug/log.hpp"
 
+#include <algorithm>
+#include <vector>
+
 #include "glad/glad.h"
 
 ShaderVariables operator|(ShaderVariables left, ShaderVariables right)
@@ -20,6 +23,12 @@ bool operator&(ShaderVariables left, ShaderVariables right)
 	return static_cast<uint32_t>(left) & static_cast<uint32_t>(right);
 }
 
+uint32_t Shader::m_BoundHandle = 0;
+
+// Names of the built-in uniforms, in the order of ShaderUniform
+static const char* const BuiltInNames[] = { "mvp", "model", "viewPos" };
+static_assert(std::size(BuiltInNames) == static_cast<size_t>(ShaderUniform::COUNT), "Every built-in uniform needs a name");
+
 void Shader::Load(const std::filesystem::path& vertex, const std::filesystem::path& fragment)
 {
 	const ShaderPart vShader(m_Name + " vertex", ShaderType::VERTEX, vertex);
@@ -39,17 +48,76 @@ void Shader::Load(const std::filesystem::path& vertex, const std::filesystem::pa
 		char infoLog[512];
 		glGetProgramInfoLog(m_Handle, sizeof(infoLog), nullptr, infoLog);
 		Log::LogError(std::string("Failed to link shader : ").append(m_Name).append(" : ").append(infoLog));
+		return;
+	}
+
+	CacheUniforms();
+}
+
+void Shader::CacheUniforms()
+{
+	int32_t count = 0, maxLength = 0;
+	glGetProgramiv(m_Handle, GL_ACTIVE_UNIFORMS, &count);
+	glGetProgramiv(m_Handle, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+	m_Uniforms.reserve(count);
+	std::vector<char> buffer(std::max(maxLength, 1));
+
+	for (int32_t i = 0; i < count; i++)
+	{
+		int32_t length = 0, size = 0;
+		uint32_t type;
+		glGetActiveUniform(m_Handle, i, maxLength, &length, &size, &type, buffer.data());
+
+		const std::string name(buffer.data(), length);
+		const int32_t location = glGetUniformLocation(m_Handle, name.c_str());
+
+		// Uniforms inside blocks don't have a location
+		if (location == -1)
+			continue;
+
+		m_Uniforms.emplace(name, location);
+
+		// Arrays of basic types are only listed by their first element, the other elements have consecutive locations
+		if (name.ends_with("[0]"))
+		{
+			const std::string baseName = name.substr(0, name.size() - 3);
+			m_Uniforms.emplace(baseName, location);
+
+			for (int32_t j = 1; j < size; j++)
+				m_Uniforms.emplace(std::string(baseName).append("[").append(std::to_string(j)).append("]"), location + j);
+		}
+	}
+
+	// The built-ins are optional, shaders only declare the ones they use
+	for (uint32_t i = 0; i < static_cast<uint32_t>(ShaderUniform::COUNT); i++)
+	{
+		const auto it = m_Uniforms.find(BuiltInNames[i]);
+		m_BuiltIns[i] = it != m_Uniforms.end() ? it->second : -1;
 	}
 }
 
 void Shader::Use() const
 {
+	if (m_BoundHandle == m_Handle)
+		return;
+
 	glUseProgram(m_Handle);
+	m_BoundHandle = m_Handle;
 }
 
 void Shader::Unuse() const
 {
+	if (m_BoundHandle == 0)
+		return;
+
 	glUseProgram(0);
+	m_BoundHandle = 0;
+}
+
+uint32_t Shader::GetHandle() const
+{
+	return m_Handle;
 }
 
 bool Shader::HasVariable(const ShaderVariables variable) const
@@ -57,72 +125,136 @@ bool Shader::HasVariable(const ShaderVariables variable) const
 	return m_Variables & variable;
 }
 
+int32_t Shader::GetUniformLocation(const std::string& name) const
+{
+	const auto it = m_Uniforms.find(name);
+	if (it == m_Uniforms.end())
+	{
+		Log::Warning("Variable {} doesn't exist in shader {}", name, m_Name);
+		return -1;
+	}
+
+	return it->second;
+}
+
+void Shader::SetUniform(const ShaderUniform uniform, const Vector3& value) const
+{
+	SetUniform(m_BuiltIns[static_cast<uint32_t>(uniform)], value);
+}
+
+void Shader::SetUniform(const ShaderUniform uniform, const Vector4& value) const
+{
+	SetUniform(m_BuiltIns[static_cast<uint32_t>(uniform)], value);
+}
+
+void Shader::SetUniform(const ShaderUniform uniform, const Matrix4x4& value) const
+{
+	SetUniform(m_BuiltIns[static_cast<uint32_t>(uniform)], value);
+}
+
+void Shader::SetUniform(const int32_t location, const bool value) const
+{
+	Use();
+	glUniform1i(location, value);
+}
+
+void Shader::SetUniform(const int32_t location, const int32_t value) const
+{
+	Use();
+	glUniform1i(location, value);
+}
+
+void Shader::SetUniform(const int32_t location, const float_t value) const
+{
+	Use();
+	glUniform1f(location, value);
+}
+
+void Shader::SetUniform(const int32_t location, const Vector2 value) const
+{
+	Use();
+	glUniform2fv(location, 1, &value.x);
+}
+
+void Shader::SetUniform(const int32_t location, const Vector3& value) const
+{
+	Use();
+	glUniform3fv(location, 1, &value.x);
+}
+
+void Shader::SetUniform(const int32_t location, const Vector4& value) const
+{
+	Use();
+	glUniform4fv(location, 1, &value.x);
+}
+
+void Shader::SetUniform(const int32_t location, const Matrix2x2& value) const
+{
+	Use();
+	glUniformMatrix2fv(location, 1, GL_TRUE, &value.Row0.x);
+}
+
+void Shader::SetUniform(const int32_t location, const Matrix3x3& value) const
+{
+	Use();
+	glUniformMatrix3fv(location, 1, GL_TRUE, &value.Row0.x);
+}
+
+void Shader::SetUniform(const int32_t location, const Matrix4x4& value) const
+{
+	Use();
+	glUniformMatrix4fv(location, 1, GL_TRUE, &value.Row0.x);
+}
+
 void Shader::SetUniform(const std::string& name, const bool value) const
 {
-	glUseProgram(m_Handle);
-	glUniform1i(GetUniform(name), value);
+	SetUniform(GetUniformLocation(name), value);
 }
 
 void Shader::SetUniform(const std::string& name, const int32_t value) const
 {
-	glUseProgram(m_Handle);
-	glUniform1i(GetUniform(name), value);
+	SetUniform(GetUniformLocation(name), value);
 }
 
 void Shader::SetUniform(const std::string& name, const float_t value) const
 {
-	glUseProgram(m_Handle);
-	glUniform1f(GetUniform(name), value);
+	SetUniform(GetUniformLocation(name), value);
 }
 
 void Shader::SetUniform(const std::string& name, const Vector2 value) const
 {
-	glUseProgram(m_Handle);
-	glUniform2fv(GetUniform(name), 1, &value.x);
+	SetUniform(GetUniformLocation(name), value);
 }
 
 void Shader::SetUniform(const std::string& name, const Vector3& value) const
 {
-	glUseProgram(m_Handle);
-	glUniform3fv(GetUniform(name), 1, &value.x);
+	SetUniform(GetUniformLocation(name), value);
 }
 
 void Shader::SetUniform(const std::string& name, const Vector4& value) const
 {
-	glUseProgram(m_Handle);
-	glUniform4fv(GetUniform(name), 1, &value.x);
+	SetUniform(GetUniformLocation(name), value);
 }
 
 void Shader::SetUniform(const std::string& name, const Matrix2x2& value) const
 {
-	glUseProgram(m_Handle);
-	glUniformMatrix2fv(GetUniform(name), 1, GL_TRUE, &value.Row0.x);
+	SetUniform(GetUniformLocation(name), value);
 }
 
 void Shader::SetUniform(const std::string& name, const Matrix3x3& value) const
 {
-	glUseProgram(m_Handle);
-	glUniformMatrix3fv(GetUniform(name), 1, GL_TRUE, &value.Row0.x);
+	SetUniform(GetUniformLocation(name), value);
 }
 
 void Shader::SetUniform(const std::string& name, const Matrix4x4& value) const
 {
-	glUniformMatrix4fv(GetUniform(name), 1, GL_TRUE, &value.Row0.x);
-}
-
-inline int32_t Shader::GetUniform(const std::string& name) const
-{
-	int32_t result = glGetUniformLocation(m_Handle, name.c_str());
-	if (result == -1)
-	{
-		Log::LogWarning(std::string("Variable ").append(name).append(" doesn't exist in shader ").append(m_Name));
-	}
-	return result;
+	SetUniform(GetUniformLocation(name), value);
 }
 
-
-
 Shader::~Shader()
 {
+	if (m_BoundHandle == m_Handle)
+		m_BoundHandle = 0;
+
 	glDeleteProgram(m_Handle);
 }
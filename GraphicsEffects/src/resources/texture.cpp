@@ -1,19 +1,30 @@
 #include "resources/texture.hpp"
 
-#include "core/debug/assert.hpp"
-
 #include "StbImage/stb_image.h"
 #include <vector>
+#include <stdexcept>
 #include "core/maths/vector4.h"
 
 #include "glad/glad.h"
 
 Texture::~Texture()
 {
+	if (m_Data != nullptr)
+		stbi_image_free(m_Data);
+
 	glDeleteTextures(1, &m_Handle);
 }
 
-void Texture::Load()
+void Texture::Decode()
+{
+	m_Data = stbi_load(m_Name.c_str(), &m_Width, &m_Height, &m_NbrChannels, 0);
+
+	// A missing or corrupt file isn't a programming error, LoadAsync reports it and marks the texture as failed
+	if (m_Data == nullptr)
+		throw std::runtime_error(std::string("Couldn't load texture : ").append(m_Name).append(" : ").append(stbi_failure_reason()));
+}
+
+void Texture::Upload()
 {
 	glGenTextures(1, &m_Handle);
 	glBindTexture(GL_TEXTURE_2D, m_Handle);
@@ -21,23 +32,22 @@ void Texture::Load()
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 
-	int32_t width;
-	int32_t height;
-	int32_t nbrChannels;
-	const uint8_t* const data = stbi_load(m_Name.c_str(), &width, &height, &nbrChannels, 0);
-
-	Assert::IsTrue(data != nullptr, std::string("Couldn't load texture : ").append(m_Name).c_str());
-
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height,
-		0, nbrChannels == 4 ? GL_RGBA : GL_RGB, GL_UNSIGNED_BYTE, data);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_Width, m_Height,
+		0, m_NbrChannels == 4 ? GL_RGBA : GL_RGB, GL_UNSIGNED_BYTE, m_Data);
 	glGenerateMipmap(GL_TEXTURE_2D);
 
 	glBindTexture(GL_TEXTURE_2D, 0);
 
-	delete data;
+	stbi_image_free(m_Data);
+	m_Data = nullptr;
 }
 
 void Texture::Use()
 {
 	glBindTexture(GL_TEXTURE_2D, m_Handle);
 }
+
+uint32_t Texture::GetHandle() const
+{
+	return m_Handle;
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+/// <summary>
+/// Microbenchmarks of the engine, every benchmark registers itself with the BENCHMARK macro and is run by main.
+/// <para>
+/// Measure runs a function several times and keeps the fastest run, which is the least disturbed by the rest of the system.
+/// </para>
+/// </summary>
+class Bench
+{
+public:
+	using Function = void(*)();
+
+private:
+	struct Entry
+	{
+		const char* Name;
+		Function Func;
+	};
+
+	static std::vector<Entry>& GetEntries();
+
+	// Written through a volatile so the compiler can't drop the computations feeding it
+	static volatile uint32_t m_Sink;
+
+public:
+	static constexpr uint32_t Repetitions = 7;
+
+	Bench() = delete;
+
+	/// <summary>
+	/// Adds a benchmark to the list run by RunAll, called by the BENCHMARK macro
+	/// </summary>
+	/// <param name="name">Name of the benchmark</param>
+	/// <param name="func">Benchmark</param>
+	/// <returns>Always true, so it can initialize a static</returns>
+	static bool Register(const char* const name, const Function func);
+
+	/// <summary>
+	/// Runs the benchmarks
+	/// </summary>
+	/// <param name="filter">Only the benchmarks whose name contains it are run, nullptr to run every benchmark</param>
+	static void RunAll(const char* const filter);
+
+	/// <summary>
+	/// Prints a result line
+	/// </summary>
+	/// <param name="name">Name of the measure</param>
+	/// <param name="value">Measure</param>
+	/// <param name="unit">Unit of the measure</param>
+	static void Report(const std::string& name, const double value, const char* const unit);
+
+	/// <summary>
+	/// Keeps a value alive, so the computation producing it can't be optimized away
+	/// </summary>
+	/// <param name="value">Value</param>
+	template <typename T>
+	static void Keep(const T& value)
+	{
+		const volatile uint8_t* const bytes = reinterpret_cast<const volatile uint8_t*>(&value);
+		m_Sink = m_Sink + bytes[0];
+	}
+
+	/// <summary>
+	/// Times a function over a number of iterations, a warm-up run is done first
+	/// </summary>
+	/// <param name="iterations">Number of times the function is called per run</param>
+	/// <param name="func">Function, called with the iteration index</param>
+	/// <returns>Nanoseconds per iteration of the fastest run</returns>
+	template <typename F>
+	static double Measure(const uint32_t iterations, F&& func)
+	{
+		using Clock = std::chrono::steady_clock;
+
+		double best = 0.;
+
+		for (uint32_t run = 0; run <= Repetitions; run++)
+		{
+			const Clock::time_point start = Clock::now();
+
+			for (uint32_t i = 0; i < iterations; i++)
+				func(i);
+
+			const double elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterations;
+
+			// Run 0 warms up the caches and the branch predictors
+			if (run == 1 || (run > 1 && elapsed < best))
+				best = elapsed;
+		}
+
+		return best;
+	}
+};
+
+#define BENCHMARK(name) \
+	static void name(); \
+	static const bool name##Registered = Bench::Register(#name, name); \
+	static void name()
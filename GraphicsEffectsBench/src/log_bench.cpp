@@ -0,0 +1,106 @@
+#include "bench.hpp"
+
+#include <atomic>
+#include <thread>
+
+#include "core/debug/log.hpp"
+
+// Cost of a log call on the calling thread, the formatting is left to the logger thread
+
+/// <summary>
+/// Logger counting the logs it receives, so a run can wait until the previous one is drained
+/// </summary>
+class CountingLogger : public ILogger
+{
+public:
+	static std::atomic<uint64_t> Count;
+
+	void Log(const LogData&) override
+	{
+		Count.fetch_add(1, std::memory_order_relaxed);
+	}
+};
+
+std::atomic<uint64_t> CountingLogger::Count = 0;
+
+// Half of the ring buffer of the logger, so no log of a run is dropped
+static constexpr uint32_t Burst = 2048;
+
+/// <summary>
+/// Times Burst log calls, waiting for the logger thread to drain every log before each run
+/// </summary>
+/// <returns>Nanoseconds per call of the fastest run</returns>
+template <typename F>
+static double MeasureLogs(F&& log)
+{
+	using Clock = std::chrono::steady_clock;
+
+	double best = 0.;
+	uint64_t sent = CountingLogger::Count.load();
+
+	for (uint32_t run = 0; run <= Bench::Repetitions; run++)
+	{
+		while (CountingLogger::Count.load() < sent)
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+		const Clock::time_point start = Clock::now();
+
+		for (uint32_t i = 0; i < Burst; i++)
+			log(i);
+
+		const double elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / Burst;
+		sent += Burst;
+
+		if (run == 1 || (run > 1 && elapsed < best))
+			best = elapsed;
+	}
+
+	while (CountingLogger::Count.load() < sent)
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+	return best;
+}
+
+BENCHMARK(LogProducer)
+{
+	Log::Init();
+	Log::AddLogger<CountingLogger>();
+
+	const std::string inlineString = "sphere.obj";
+	// Longer than the arguments of a record, it is moved to the heap
+	const std::string heapString(LogRecord::ArgsCapacity * 2, 'x');
+	const float value = 3.5f;
+
+	Bench::Report("Info, no argument", MeasureLogs([](const uint32_t)
+		{
+			Log::Info("Frame done");
+		}), "ns");
+
+	Bench::Report("Info, integer and float", MeasureLogs([value](const uint32_t i)
+		{
+			Log::Info("Object {} moved by {}", i, value);
+		}), "ns");
+
+	Bench::Report("Info, string literal", MeasureLogs([](const uint32_t i)
+		{
+			Log::Info("Loaded {} in {} ms", "sphere.obj", i);
+		}), "ns");
+
+	Bench::Report("Info, inline std::string", MeasureLogs([&inlineString](const uint32_t i)
+		{
+			Log::Info("Loaded {} in {} ms", inlineString, i);
+		}), "ns");
+
+	Bench::Report("Info, heap std::string", MeasureLogs([&heapString](const uint32_t i)
+		{
+			Log::Info("Loaded {} in {} ms", heapString, i);
+		}), "ns");
+
+	// The message is built on the calling thread, as every log did before the binary records
+	Bench::Report("LogInfo, message built by the caller", MeasureLogs([&inlineString](const uint32_t i)
+		{
+			Log::LogInfo(std::string("Loaded ").append(inlineString).append(" in ").append(std::to_string(i)).append(" ms"));
+		}), "ns");
+
+	Log::Stop();
+}
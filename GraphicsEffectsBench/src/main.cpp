@@ -0,0 +1,63 @@
+#include "bench.hpp"
+
+#include <cstring>
+#include <cstdio>
+#include <iostream>
+
+#include "core/maths/simd.h"
+
+volatile uint32_t Bench::m_Sink;
+
+std::vector<Bench::Entry>& Bench::GetEntries()
+{
+	// Function local so that the benchmarks of every translation unit can register during static initialization
+	static std::vector<Entry> entries;
+	return entries;
+}
+
+bool Bench::Register(const char* const name, const Function func)
+{
+	GetEntries().push_back(Entry{ name, func });
+	return true;
+}
+
+void Bench::RunAll(const char* const filter)
+{
+	for (const Entry& entry : GetEntries())
+	{
+		if (filter != nullptr && std::strstr(entry.Name, filter) == nullptr)
+			continue;
+
+		std::cout << entry.Name << std::endl;
+		entry.Func();
+	}
+}
+
+void Bench::Report(const std::string& name, const double value, const char* const unit)
+{
+	char line[256];
+	std::snprintf(line, sizeof(line), "    %-48s %12.2f %s", name.c_str(), value, unit);
+	std::cout << line << std::endl;
+}
+
+static const char* GetSimdBackend()
+{
+#if defined(MATHS_SIMD_AVX)
+	return "AVX";
+#elif defined(MATHS_SIMD_SSE)
+	return "SSE";
+#else
+	return "scalar";
+#endif
+}
+
+/// <summary>
+/// Runs the benchmarks : GraphicsEffectsBench [filter], should be run on a Release build
+/// </summary>
+int main(int argc, char** argv)
+{
+	std::cout << "Maths backend : " << GetSimdBackend() << std::endl;
+
+	Bench::RunAll(argc > 1 ? argv[1] : nullptr);
+	return 0;
+}
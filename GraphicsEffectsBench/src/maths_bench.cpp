@@ -0,0 +1,142 @@
+#include "bench.hpp"
+#include "maths_reference.hpp"
+
+// Compares the maths backend of the build against the scalar reference of the tests,
+// build with MathsSimd=NONE or AVX (see the project file) to time the other backends
+
+static constexpr uint32_t Count = 1024;
+
+struct MathsData
+{
+	std::vector<Vector4> Vectors;
+	std::vector<Matrix4x4> Matrices;
+	std::vector<Vector3> Translations;
+	std::vector<Quaternion> Rotations;
+	std::vector<Vector3> Scalings;
+
+	MathsData()
+	{
+		Reference::Random random;
+
+		for (uint32_t i = 0; i < Count; i++)
+		{
+			Vectors.push_back(random.Vec4(-10.f, 10.f));
+			Translations.push_back(random.Vec3(-100.f, 100.f));
+			Rotations.push_back(random.Rotation());
+			Scalings.push_back(random.Vec3(0.1f, 10.f));
+
+			Matrix4x4 trs;
+			Matrix4x4::TRS(Translations.back(), Rotations.back(), Scalings.back(), trs);
+			Matrices.push_back(trs);
+		}
+	}
+};
+
+BENCHMARK(Vector4Operations)
+{
+	const MathsData data;
+	const uint32_t mask = Count - 1;
+
+	Bench::Report("a * b + c", Bench::Measure(1 << 20, [&](const uint32_t i)
+		{
+			Bench::Keep(data.Vectors[i & mask] * data.Vectors[(i + 1) & mask] + data.Vectors[(i + 2) & mask]);
+		}), "ns");
+
+	Bench::Report("DotProduct", Bench::Measure(1 << 20, [&](const uint32_t i)
+		{
+			Bench::Keep(Vector4::DotProduct(data.Vectors[i & mask], data.Vectors[(i + 1) & mask]));
+		}), "ns");
+
+	Bench::Report("Normalize", Bench::Measure(1 << 20, [&](const uint32_t i)
+		{
+			Bench::Keep(data.Vectors[i & mask].Normalize());
+		}), "ns");
+}
+
+BENCHMARK(Matrix4x4Multiply)
+{
+	const MathsData data;
+	const uint32_t mask = Count - 1;
+	Matrix4x4 result;
+
+	Bench::Report("Multiply", Bench::Measure(1 << 20, [&](const uint32_t i)
+		{
+			Matrix4x4::Multiply(data.Matrices[i & mask], data.Matrices[(i + 1) & mask], result);
+			Bench::Keep(result);
+		}), "ns");
+
+	Bench::Report("Multiply, scalar reference", Bench::Measure(1 << 20, [&](const uint32_t i)
+		{
+			Bench::Keep(Reference::Multiply(data.Matrices[i & mask], data.Matrices[(i + 1) & mask]));
+		}), "ns");
+
+	Bench::Report("Multiply vector", Bench::Measure(1 << 20, [&](const uint32_t i)
+		{
+			Matrix4x4 m = data.Matrices[i & mask];
+			Bench::Keep(m.Multiply(data.Vectors[i & mask]));
+		}), "ns");
+
+	Bench::Report("Multiply vector, scalar reference", Bench::Measure(1 << 20, [&](const uint32_t i)
+		{
+			Bench::Keep(Reference::Multiply(data.Matrices[i & mask], data.Vectors[i & mask]));
+		}), "ns");
+}
+
+BENCHMARK(Matrix4x4Transpose)
+{
+	const MathsData data;
+	const uint32_t mask = Count - 1;
+
+	Bench::Report("Transpose", Bench::Measure(1 << 20, [&](const uint32_t i)
+		{
+			Matrix4x4 m = data.Matrices[i & mask];
+			Bench::Keep(m.Transpose());
+		}), "ns");
+
+	Bench::Report("Transpose, scalar reference", Bench::Measure(1 << 20, [&](const uint32_t i)
+		{
+			Bench::Keep(Reference::Transpose(data.Matrices[i & mask]));
+		}), "ns");
+}
+
+BENCHMARK(Matrix4x4TRS)
+{
+	const MathsData data;
+	const uint32_t mask = Count - 1;
+	Matrix4x4 result;
+
+	Bench::Report("TRS", Bench::Measure(1 << 20, [&](const uint32_t i)
+		{
+			Matrix4x4::TRS(data.Translations[i & mask], data.Rotations[i & mask], data.Scalings[i & mask], result);
+			Bench::Keep(result);
+		}), "ns");
+
+	Bench::Report("T * R * S, scalar reference", Bench::Measure(1 << 20, [&](const uint32_t i)
+		{
+			Bench::Keep(Reference::TRS(data.Translations[i & mask], data.Rotations[i & mask], data.Scalings[i & mask]));
+		}), "ns");
+}
+
+BENCHMARK(Matrix4x4Inverse)
+{
+	const MathsData data;
+	const uint32_t mask = Count - 1;
+	Matrix4x4 result;
+
+	Bench::Report("Inverse", Bench::Measure(1 << 20, [&](const uint32_t i)
+		{
+			Bench::Keep(data.Matrices[i & mask].Inverse(result));
+			Bench::Keep(result);
+		}), "ns");
+
+	Bench::Report("InverseAffine", Bench::Measure(1 << 20, [&](const uint32_t i)
+		{
+			Bench::Keep(data.Matrices[i & mask].InverseAffine(result));
+			Bench::Keep(result);
+		}), "ns");
+
+	Bench::Report("Determinant", Bench::Measure(1 << 20, [&](const uint32_t i)
+		{
+			Bench::Keep(data.Matrices[i & mask].Determinant());
+		}), "ns");
+}
@@ -0,0 +1,209 @@
+#include "bench.hpp"
+#include "maths_reference.hpp"
+
+#include <cmath>
+#include <memory>
+
+#include "core/maths/matrixM.h"
+
+// Compares MatrixM with the layout it replaced, where every row was a VectorM owning a std::vector
+
+/// <summary>
+/// The former MatrixM : a shared array of rows, each allocated on its own, with the algorithms it used
+/// </summary>
+class LegacyMatrix
+{
+private:
+	std::shared_ptr<std::vector<float>[]> m_Rows;
+	uint32_t m_Columns;
+	uint32_t m_RowCount;
+
+public:
+	LegacyMatrix(const uint32_t columns, const uint32_t rows, const float value)
+		: m_Rows(std::make_shared<std::vector<float>[]>(rows)), m_Columns(columns), m_RowCount(rows)
+	{
+		for (uint32_t i = 0; i < rows; i++)
+			m_Rows[i] = std::vector<float>(columns, value);
+	}
+
+	LegacyMatrix(const LegacyMatrix& mat)
+		: m_Rows(std::make_shared<std::vector<float>[]>(mat.m_RowCount)), m_Columns(mat.m_Columns), m_RowCount(mat.m_RowCount)
+	{
+		// DeepCopy, one allocation per row
+		for (uint32_t i = 0; i < m_RowCount; i++)
+			m_Rows[i] = mat.m_Rows[i];
+	}
+
+	std::vector<float>& operator[](const uint32_t i) { return m_Rows[i]; }
+	const std::vector<float>& operator[](const uint32_t i) const { return m_Rows[i]; }
+
+	/// <summary>
+	/// this = this * mat, with the naive loop order reading mat by columns
+	/// </summary>
+	void Multiply(const LegacyMatrix& mat)
+	{
+		LegacyMatrix result(mat.m_Columns, m_RowCount, 0.f);
+
+		for (uint32_t i = 0; i < m_RowCount; i++)
+		{
+			for (uint32_t j = 0; j < mat.m_Columns; j++)
+			{
+				for (uint32_t k = 0; k < m_Columns; k++)
+					result[i][j] += m_Rows[i][k] * mat[k][j];
+			}
+		}
+
+		*this = result;
+	}
+
+	/// <summary>
+	/// Gauss-Jordan elimination of the matrix augmented with the identity, with partial pivoting
+	/// </summary>
+	bool Inverse(LegacyMatrix& dst) const
+	{
+		const uint32_t n = m_RowCount;
+		LegacyMatrix augmented(2 * n, n, 0.f);
+
+		for (uint32_t i = 0; i < n; i++)
+		{
+			std::copy(m_Rows[i].begin(), m_Rows[i].end(), augmented[i].begin());
+			augmented[i][n + i] = 1.f;
+		}
+
+		for (uint32_t j = 0; j < n; j++)
+		{
+			uint32_t pivot = j;
+			for (uint32_t i = j + 1; i < n; i++)
+			{
+				if (std::abs(augmented[i][j]) > std::abs(augmented[pivot][j]))
+					pivot = i;
+			}
+
+			if (augmented[pivot][j] == 0.f)
+				return false;
+
+			std::swap(augmented[pivot], augmented[j]);
+
+			const float inverse = 1.f / augmented[j][j];
+			for (float& value : augmented[j])
+				value *= inverse;
+
+			for (uint32_t i = 0; i < n; i++)
+			{
+				if (i == j)
+					continue;
+
+				const float alpha = augmented[i][j];
+				for (uint32_t k = 0; k < 2 * n; k++)
+					augmented[i][k] -= augmented[j][k] * alpha;
+			}
+		}
+
+		dst = LegacyMatrix(n, n, 0.f);
+		for (uint32_t i = 0; i < n; i++)
+			std::copy(augmented[i].begin() + n, augmented[i].end(), dst[i].begin());
+
+		return true;
+	}
+
+	LegacyMatrix& operator=(const LegacyMatrix& mat)
+	{
+		// Assignments were deep copies too
+		LegacyMatrix copy(mat);
+		m_Rows = std::move(copy.m_Rows);
+		m_Columns = copy.m_Columns;
+		m_RowCount = copy.m_RowCount;
+		return *this;
+	}
+};
+
+/// <summary>
+/// Number of calls per run, so that every size runs for a similar time
+/// </summary>
+static uint32_t Iterations(const uint32_t size, const uint32_t power)
+{
+	const double work = std::pow(static_cast<double>(size), power);
+	return static_cast<uint32_t>(std::max(1., static_cast<double>(1 << 24) / work));
+}
+
+static std::string Name(const char* const operation, const uint32_t size, const bool legacy)
+{
+	return std::string(operation) + ", " + std::to_string(size) + "x" + std::to_string(size) + (legacy ? ", row vectors" : "");
+}
+
+BENCHMARK(MatrixMOperations)
+{
+	Reference::Random random;
+
+	for (const uint32_t size : { 4u, 16u, 64u, 256u, 1024u })
+	{
+		// Diagonally dominant, so both inverses exist and take the same path
+		MatrixM mat(size, 0.f);
+		LegacyMatrix legacy(size, size, 0.f);
+
+		for (uint32_t i = 0; i < size; i++)
+		{
+			for (uint32_t j = 0; j < size; j++)
+			{
+				const float value = random.Float() + (i == j ? static_cast<float>(size) : 0.f);
+				mat[i][j] = value;
+				legacy[i][j] = value;
+			}
+		}
+
+		const uint32_t squareIterations = Iterations(size, 2);
+		const uint32_t cubeIterations = Iterations(size, 3);
+
+		Bench::Report(Name("Construct", size, false), Bench::Measure(squareIterations, [size](const uint32_t)
+			{
+				const MatrixM m(size, 1.f);
+				Bench::Keep(m[0][0]);
+			}) / 1000., "us");
+
+		Bench::Report(Name("Construct", size, true), Bench::Measure(squareIterations, [size](const uint32_t)
+			{
+				const LegacyMatrix m(size, size, 1.f);
+				Bench::Keep(m[0][0]);
+			}) / 1000., "us");
+
+		Bench::Report(Name("Copy", size, false), Bench::Measure(squareIterations, [&mat](const uint32_t)
+			{
+				const MatrixM m(mat);
+				Bench::Keep(m[0][0]);
+			}) / 1000., "us");
+
+		Bench::Report(Name("Copy", size, true), Bench::Measure(squareIterations, [&legacy](const uint32_t)
+			{
+				const LegacyMatrix m(legacy);
+				Bench::Keep(m[0][0]);
+			}) / 1000., "us");
+
+		Bench::Report(Name("Multiply", size, false), Bench::Measure(cubeIterations, [&mat](const uint32_t)
+			{
+				MatrixM m(mat);
+				m.Multiply(mat);
+				Bench::Keep(m[0][0]);
+			}) / 1000., "us");
+
+		Bench::Report(Name("Multiply", size, true), Bench::Measure(cubeIterations, [&legacy](const uint32_t)
+			{
+				LegacyMatrix m(legacy);
+				m.Multiply(legacy);
+				Bench::Keep(m[0][0]);
+			}) / 1000., "us");
+
+		Bench::Report(Name("Inverse", size, false), Bench::Measure(cubeIterations, [&mat](const uint32_t)
+			{
+				MatrixM inverse;
+				Bench::Keep(mat.Inverse(inverse));
+				Bench::Keep(inverse[0][0]);
+			}) / 1000., "us");
+
+		Bench::Report(Name("Inverse", size, true), Bench::Measure(cubeIterations, [&legacy](const uint32_t)
+			{
+				LegacyMatrix inverse(0, 0, 0.f);
+				Bench::Keep(legacy.Inverse(inverse));
+				Bench::Keep(inverse[0][0]);
+			}) / 1000., "us");
+	}
+}
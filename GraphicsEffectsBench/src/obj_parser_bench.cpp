@@ -0,0 +1,166 @@
+#include "bench.hpp"
+#include "maths_reference.hpp"
+
+#include <cstdio>
+#include <sstream>
+#include <string>
+
+#include "resources/obj_parser.hpp"
+#include "core/thread_pool.hpp"
+
+// Compares ObjParser with the getline/sscanf_s loop that Model::Load used before, on text generated in memory
+
+/// <summary>
+/// The former loader : one getline and one sscanf_s per line, every triangle corner gets its own vertex.
+/// Only v/vt/vn triangles are supported.
+/// </summary>
+static void LegacyParse(const std::string& text, std::vector<Vertex>& vertices)
+{
+	std::istringstream file(text);
+	std::vector<Vector3> positions;
+	std::vector<Vector2> uvs;
+	std::vector<Vector3> normals;
+
+	vertices.clear();
+
+	while (!file.eof())
+	{
+		std::string line;
+		std::getline(file, line);
+
+		if (line[0] == '#')
+			continue;
+
+		if (line[0] == 'f')
+		{
+			uint32_t indices[3][3];
+			const int32_t read = sscanf_s(line.c_str(), "f %d/%d/%d %d/%d/%d %d/%d/%d",
+				&indices[0][0], &indices[0][1], &indices[0][2],
+				&indices[1][0], &indices[1][1], &indices[1][2],
+				&indices[2][0], &indices[2][1], &indices[2][2]
+			);
+			Bench::Keep(read);
+
+			for (uint32_t i = 0; i < 3; i++)
+				vertices.push_back(Vertex(positions[indices[i][0] - 1], uvs[indices[i][1] - 1], normals[indices[i][2] - 1]));
+
+			continue;
+		}
+
+		if (line[0] == 'v')
+		{
+			if (line[1] == 't')
+			{
+				Vector2 v;
+				Bench::Keep(sscanf_s(line.c_str(), "vt %f %f", &v.x, &v.y));
+				// Invert Y uvs
+				v.y = 1.f - v.y;
+				uvs.push_back(v);
+			}
+			else if (line[1] == 'n')
+			{
+				Vector3 v;
+				Bench::Keep(sscanf_s(line.c_str(), "vn %f %f %f", &v.x, &v.y, &v.z));
+				normals.push_back(v);
+			}
+			else
+			{
+				Vector3 v;
+				Bench::Keep(sscanf_s(line.c_str(), "v %f %f %f", &v.x, &v.y, &v.z));
+				positions.push_back(v);
+			}
+		}
+	}
+}
+
+/// <summary>
+/// OBJ text with the statement counts of viking_room.obj, written the way Blender exports it.
+/// Uvs follow the positions and normals are shared by neighbouring positions, so about as many corners are deduplicated.
+/// </summary>
+/// <param name="copies">Number of copies of the model in the file</param>
+static std::string VikingRoomLike(const uint32_t copies)
+{
+	constexpr uint32_t PositionCount = 4675;
+	constexpr uint32_t NormalCount = 2868;
+	constexpr uint32_t FaceCount = 3828;
+
+	Reference::Random random;
+	std::string text = "# Blender v2.82 (sub 7) OBJ File: ''\n# www.blender.org\n";
+	char line[128];
+
+	for (uint32_t copy = 0; copy < copies; copy++)
+	{
+		const uint32_t first = copy * PositionCount;
+		const uint32_t firstNormal = copy * NormalCount;
+
+		for (uint32_t i = 0; i < PositionCount; i++)
+		{
+			const Vector3 v = random.Vec3(-2.f, 2.f);
+			std::snprintf(line, sizeof(line), "v %f %f %f\n", v.x, v.y, v.z);
+			text += line;
+		}
+
+		for (uint32_t i = 0; i < PositionCount; i++)
+		{
+			std::snprintf(line, sizeof(line), "vt %f %f\n", random.Float(0.f, 1.f), random.Float(0.f, 1.f));
+			text += line;
+		}
+
+		for (uint32_t i = 0; i < NormalCount; i++)
+		{
+			const Vector3 n = random.Vec3().Normalize();
+			std::snprintf(line, sizeof(line), "vn %.4f %.4f %.4f\n", n.x, n.y, n.z);
+			text += line;
+		}
+
+		for (uint32_t i = 0; i < FaceCount; i++)
+		{
+			text += "f";
+
+			const uint32_t base = static_cast<uint32_t>(random.Float(0.f, static_cast<float>(PositionCount - 8)));
+			for (uint32_t c = 0; c < 3; c++)
+			{
+				const uint32_t position = base + static_cast<uint32_t>(random.Float(0.f, 8.f));
+				const uint32_t normal = position * NormalCount / PositionCount;
+				std::snprintf(line, sizeof(line), " %u/%u/%u", first + position + 1, first + position + 1, firstNormal + normal + 1);
+				text += line;
+			}
+
+			text += "\n";
+		}
+	}
+
+	return text;
+}
+
+BENCHMARK(ObjParserParse)
+{
+	for (const uint32_t copies : { 1u, 30u })
+	{
+		const std::string text = VikingRoomLike(copies);
+		const std::string size = copies == 1 ? "viking_room" : "viking_room x" + std::to_string(copies);
+
+		std::vector<Vertex> vertices;
+		std::vector<uint32_t> indices;
+
+		Bench::Report("getline/sscanf_s, " + size, Bench::Measure(1, [&](const uint32_t)
+			{
+				LegacyParse(text, vertices);
+				Bench::Keep(vertices.size());
+			}) / 1e6, "ms");
+		Bench::Report("getline/sscanf_s, " + size, static_cast<double>(vertices.size()), "vertices");
+
+		ThreadPool pool;
+
+		for (ThreadPool* const parsePool : { static_cast<ThreadPool*>(nullptr), &pool })
+		{
+			Bench::Report("ObjParser, " + size + (parsePool != nullptr ? ", every thread" : ", 1 thread"), Bench::Measure(1, [&](const uint32_t)
+				{
+					Bench::Keep(ObjParser::Parse(text.data(), text.size(), vertices, indices, parsePool));
+					Bench::Keep(vertices.size());
+				}) / 1e6, "ms");
+		}
+
+		Bench::Report("ObjParser, " + size, static_cast<double>(vertices.size()), "vertices");
+	}
+}
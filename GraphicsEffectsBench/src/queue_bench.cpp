@@ -0,0 +1,95 @@
+#include "bench.hpp"
+
+#include <atomic>
+#include <optional>
+#include <queue>
+#include <thread>
+
+#include "core/data_structures/mpsc_queue.hpp"
+#include "core/data_structures/tsqueue.hpp"
+
+// Producers push as fast as they can while a single consumer drains the queue, as the logger and the upload queue do
+
+static constexpr uint32_t ItemCount = 1 << 20;
+
+static std::optional<uint64_t> TryPop(MpscQueue<uint64_t>& queue)
+{
+	return queue.TryPop();
+}
+
+static std::optional<uint64_t> TryPop(TsQueue<uint64_t>& queue)
+{
+	// The old consumers checked Empty before popping, each call takes the lock
+	if (queue.Empty())
+		return std::nullopt;
+
+	return queue.PopFront();
+}
+
+/// <summary>
+/// Times the transfer of ItemCount items from the producers to the consumer
+/// </summary>
+/// <returns>Nanoseconds per item of the fastest run</returns>
+template <typename Queue>
+static double MeasureContention(const uint32_t producerCount)
+{
+	using Clock = std::chrono::steady_clock;
+
+	double best = 0.;
+
+	for (uint32_t run = 0; run <= Bench::Repetitions; run++)
+	{
+		Queue queue;
+		std::atomic<bool> start = false;
+		std::vector<std::thread> producers;
+
+		for (uint32_t p = 0; p < producerCount; p++)
+		{
+			producers.emplace_back([&queue, &start, p, producerCount]()
+				{
+					while (!start.load(std::memory_order_acquire))
+						std::this_thread::yield();
+
+					for (uint32_t i = p; i < ItemCount; i += producerCount)
+						queue.Push(i);
+				});
+		}
+
+		const Clock::time_point begin = Clock::now();
+		start.store(true, std::memory_order_release);
+
+		uint64_t sum = 0;
+		for (uint32_t received = 0; received < ItemCount;)
+		{
+			if (const std::optional<uint64_t> item = TryPop(queue))
+			{
+				sum += *item;
+				received++;
+			}
+		}
+
+		const double elapsed = std::chrono::duration<double, std::nano>(Clock::now() - begin).count() / ItemCount;
+
+		for (std::thread& producer : producers)
+			producer.join();
+
+		Bench::Keep(sum);
+
+		// Run 0 warms up the allocator
+		if (run == 1 || (run > 1 && elapsed < best))
+			best = elapsed;
+	}
+
+	return best;
+}
+
+BENCHMARK(QueueContention)
+{
+	for (uint32_t producers = 1; producers <= 16; producers *= 2)
+	{
+		const std::string suffix = std::string(", ") + std::to_string(producers) + (producers == 1 ? " producer" : " producers");
+
+		Bench::Report("MpscQueue" + suffix, MeasureContention<MpscQueue<uint64_t>>(producers), "ns/item");
+		Bench::Report("TsQueue" + suffix, MeasureContention<TsQueue<uint64_t>>(producers), "ns/item");
+	}
+}
@@ -0,0 +1,321 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <utility>
+
+#include "core/maths/vector3.h"
+#include "core/maths/vector4.h"
+#include "core/maths/matrix4x4.h"
+#include "core/maths/quaternion.h"
+#include "renderer/frustum.hpp"
+
+/// <summary>
+/// Scalar versions of the SIMD operations of the maths library, written the plain way so they don't depend on the backend.
+/// <para>
+/// Sums are done in the same order as the library, the SIMD results must match them bit for bit where the library promises it.
+/// </para>
+/// </summary>
+namespace Reference
+{
+	inline Matrix4x4 Multiply(const Matrix4x4& left, const Matrix4x4& right)
+	{
+		Matrix4x4 result;
+
+		for (int r = 0; r < 4; r++)
+		{
+			for (int c = 0; c < 4; c++)
+			{
+				float sum = left[r][0] * right[0][c];
+				for (int k = 1; k < 4; k++)
+					sum += left[r][k] * right[k][c];
+
+				result[r][c] = sum;
+			}
+		}
+
+		return result;
+	}
+
+	inline Vector4 Multiply(const Matrix4x4& mat, const Vector4& vec)
+	{
+		Vector4 result;
+
+		for (int r = 0; r < 4; r++)
+		{
+			float sum = vec[0] * mat[r][0];
+			for (int k = 1; k < 4; k++)
+				sum += vec[k] * mat[r][k];
+
+			result[r] = sum;
+		}
+
+		return result;
+	}
+
+	inline Matrix4x4 Transpose(const Matrix4x4& mat)
+	{
+		Matrix4x4 result;
+
+		for (int r = 0; r < 4; r++)
+		{
+			for (int c = 0; c < 4; c++)
+				result[c][r] = mat[r][c];
+		}
+
+		return result;
+	}
+
+	/// <summary>
+	/// T * R * S as full matrix products
+	/// </summary>
+	inline Matrix4x4 TRS(const Vector3& translation, const Quaternion& rotation, const Vector3& scaling)
+	{
+		Matrix4x4 t, r, s;
+		Matrix4x4::Translation(translation, t);
+		Matrix4x4::Rotation(rotation, r);
+		Matrix4x4::Scaling(scaling, s);
+
+		return Multiply(Multiply(t, r), s);
+	}
+
+	/// <summary>
+	/// Hamilton product, a applied after b
+	/// </summary>
+	inline Quaternion Multiply(const Quaternion& a, const Quaternion& b)
+	{
+		return Quaternion(
+			a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+			a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+			a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+			a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z
+		);
+	}
+
+	/// <summary>
+	/// Rz * Ry * Rx as full matrix products of the rotations around each axis
+	/// </summary>
+	inline Matrix4x4 EulerRotation(const Vector3& euler)
+	{
+		const float cx = std::cos(euler.x), sx = std::sin(euler.x);
+		const float cy = std::cos(euler.y), sy = std::sin(euler.y);
+		const float cz = std::cos(euler.z), sz = std::sin(euler.z);
+
+		const Matrix4x4 rx(
+			1.f, 0.f, 0.f, 0.f,
+			0.f, cx,  -sx, 0.f,
+			0.f, sx,  cx,  0.f,
+			0.f, 0.f, 0.f, 1.f
+		);
+		const Matrix4x4 ry(
+			cy,  0.f, sy,  0.f,
+			0.f, 1.f, 0.f, 0.f,
+			-sy, 0.f, cy,  0.f,
+			0.f, 0.f, 0.f, 1.f
+		);
+		const Matrix4x4 rz(
+			cz,  -sz, 0.f, 0.f,
+			sz,  cz,  0.f, 0.f,
+			0.f, 0.f, 1.f, 0.f,
+			0.f, 0.f, 0.f, 1.f
+		);
+
+		return Multiply(Multiply(rz, ry), rx);
+	}
+
+	/// <summary>
+	/// Inverse by Gauss-Jordan elimination with partial pivoting, in double precision
+	/// </summary>
+	/// <returns>False if the matrix is singular</returns>
+	inline bool Inverse(const Matrix4x4& mat, double dst[4][4])
+	{
+		double a[4][8];
+
+		for (int r = 0; r < 4; r++)
+		{
+			for (int c = 0; c < 4; c++)
+			{
+				a[r][c] = mat[r][c];
+				a[r][c + 4] = r == c ? 1. : 0.;
+			}
+		}
+
+		for (int c = 0; c < 4; c++)
+		{
+			int pivot = c;
+			for (int r = c + 1; r < 4; r++)
+			{
+				if (std::abs(a[r][c]) > std::abs(a[pivot][c]))
+					pivot = r;
+			}
+
+			if (a[pivot][c] == 0.)
+				return false;
+
+			std::swap(a[c], a[pivot]);
+
+			const double invPivot = 1. / a[c][c];
+			for (int k = 0; k < 8; k++)
+				a[c][k] *= invPivot;
+
+			for (int r = 0; r < 4; r++)
+			{
+				if (r == c)
+					continue;
+
+				const double factor = a[r][c];
+				for (int k = 0; k < 8; k++)
+					a[r][k] -= factor * a[c][k];
+			}
+		}
+
+		for (int r = 0; r < 4; r++)
+		{
+			for (int c = 0; c < 4; c++)
+				dst[r][c] = a[r][c + 4];
+		}
+
+		return true;
+	}
+
+	/// <summary>
+	/// Determinant as the product of the pivots of a Gaussian elimination, in double precision
+	/// </summary>
+	inline double Determinant(const Matrix4x4& mat)
+	{
+		double a[4][4];
+
+		for (int r = 0; r < 4; r++)
+		{
+			for (int c = 0; c < 4; c++)
+				a[r][c] = mat[r][c];
+		}
+
+		double det = 1.;
+
+		for (int c = 0; c < 4; c++)
+		{
+			int pivot = c;
+			for (int r = c + 1; r < 4; r++)
+			{
+				if (std::abs(a[r][c]) > std::abs(a[pivot][c]))
+					pivot = r;
+			}
+
+			if (a[pivot][c] == 0.)
+				return 0.;
+
+			if (pivot != c)
+			{
+				std::swap(a[c], a[pivot]);
+				det = -det;
+			}
+
+			det *= a[c][c];
+
+			for (int r = c + 1; r < 4; r++)
+			{
+				const double factor = a[r][c] / a[c][c];
+				for (int k = c; k < 4; k++)
+					a[r][k] -= factor * a[c][k];
+			}
+		}
+
+		return det;
+	}
+
+	/// <summary>
+	/// Largest difference between a matrix and a double precision one, relative to the largest element of the latter
+	/// </summary>
+	inline double RelativeError(const Matrix4x4& mat, const double ref[4][4])
+	{
+		double error = 0.;
+		double scale = 0.;
+
+		for (int r = 0; r < 4; r++)
+		{
+			for (int c = 0; c < 4; c++)
+			{
+				error = std::max(error, std::abs(mat[r][c] - ref[r][c]));
+				scale = std::max(scale, std::abs(ref[r][c]));
+			}
+		}
+
+		return error / std::max(scale, 1e-30);
+	}
+
+	inline bool BitEqual(const float a, const float b)
+	{
+		return std::memcmp(&a, &b, sizeof(float)) == 0;
+	}
+
+	inline bool BitEqual(const Vector4& a, const Vector4& b)
+	{
+		return std::memcmp(&a, &b, sizeof(Vector4)) == 0;
+	}
+
+	inline bool BitEqual(const Matrix4x4& a, const Matrix4x4& b)
+	{
+		return std::memcmp(&a, &b, sizeof(Matrix4x4)) == 0;
+	}
+
+	inline bool BitEqual(const Quaternion& a, const Quaternion& b)
+	{
+		return std::memcmp(&a, &b, sizeof(Quaternion)) == 0;
+	}
+
+	/// <summary>
+	/// Frustum of a camera looking from eye to center with the y axis up, for a 16:9 viewport
+	/// </summary>
+	inline Frustum MakeFrustum(const Vector3& eye, const Vector3& center, const float fovY, const float zNear, const float zFar)
+	{
+		Matrix4x4 view, projection, projView;
+		Matrix4x4::View(eye, center, Vector3(0.f, 1.f, 0.f), view);
+		Matrix4x4::Projection(fovY, 16.f / 9.f, zNear, zFar, projection);
+		Matrix4x4::Multiply(projection, view, projView);
+
+		return Frustum(projView);
+	}
+
+	/// <summary>
+	/// Random values in [min, max), seeded so every run checks the same values
+	/// </summary>
+	class Random
+	{
+	private:
+		std::mt19937 m_Engine;
+
+	public:
+		Random(const uint32_t seed = 42)
+			: m_Engine(seed)
+		{
+		}
+
+		_NODISCARD float Float(const float min = -1.f, const float max = 1.f)
+		{
+			return std::uniform_real_distribution<float>(min, max)(m_Engine);
+		}
+
+		_NODISCARD Vector3 Vec3(const float min = -1.f, const float max = 1.f)
+		{
+			return Vector3(Float(min, max), Float(min, max), Float(min, max));
+		}
+
+		_NODISCARD Vector4 Vec4(const float min = -1.f, const float max = 1.f)
+		{
+			return Vector4(Float(min, max), Float(min, max), Float(min, max), Float(min, max));
+		}
+
+		_NODISCARD Matrix4x4 Mat4(const float min = -1.f, const float max = 1.f)
+		{
+			return Matrix4x4(Vec4(min, max), Vec4(min, max), Vec4(min, max), Vec4(min, max));
+		}
+
+		_NODISCARD Quaternion Rotation()
+		{
+			return Quaternion(Float(), Float(), Float(), Float()).Normalize();
+		}
+	};
+}
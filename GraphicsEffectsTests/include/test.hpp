@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cmath>
+#include <vector>
+#include <stdint.h>
+
+/// <summary>
+/// Headless unit tests of the engine, every test registers itself with the TEST macro and is run by main.
+/// <para>
+/// Nothing here needs a window or a GL context, the tests only exercise the CPU side of the engine.
+/// </para>
+/// </summary>
+class Test
+{
+public:
+	using Function = void(*)();
+
+private:
+	struct Entry
+	{
+		const char* Name;
+		Function Func;
+	};
+
+	static std::vector<Entry>& GetEntries();
+
+	// Failed checks of the running test
+	static uint32_t m_Failures;
+
+public:
+	Test() = delete;
+
+	/// <summary>
+	/// Adds a test to the list run by RunAll, called by the TEST macro
+	/// </summary>
+	/// <param name="name">Name of the test</param>
+	/// <param name="func">Test</param>
+	/// <returns>Always true, so it can initialize a static</returns>
+	static bool Register(const char* const name, const Function func);
+
+	/// <summary>
+	/// Reports a failed check of the running test
+	/// </summary>
+	/// <param name="expression">Expression checked</param>
+	/// <param name="file">File of the check</param>
+	/// <param name="line">Line of the check</param>
+	static void Fail(const char* const expression, const char* const file, const int32_t line);
+
+	/// <summary>
+	/// Runs the tests
+	/// </summary>
+	/// <param name="filter">Only the tests whose name contains it are run, nullptr to run every test</param>
+	/// <returns>Number of tests that failed</returns>
+	static uint32_t RunAll(const char* const filter);
+};
+
+#define TEST(name) \
+	static void name(); \
+	static const bool name##Registered = Test::Register(#name, name); \
+	static void name()
+
+#define CHECK(condition) \
+	do { if (!(condition)) Test::Fail(#condition, __FILE__, __LINE__); } while (false)
+
+#define CHECK_NEAR(a, b, epsilon) \
+	do { if (!(std::abs((a) - (b)) <= (epsilon))) Test::Fail(#a " ~= " #b, __FILE__, __LINE__); } while (false)
@@ -0,0 +1,408 @@
+#include "test.hpp"
+#include "maths_reference.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <functional>
+
+#include "core/bvh.hpp"
+
+// Every query of the tree is checked against a scan of all the boxes, after a build, a refit and a rebuild
+
+/// <summary>
+/// Boxes given to the tree, indexed by proxy
+/// </summary>
+struct Boxes
+{
+	std::vector<BoundingBox> Bounds;
+	std::vector<uint8_t> Alive;
+
+	void Set(const uint32_t proxy, const BoundingBox& box)
+	{
+		if (proxy >= Bounds.size())
+		{
+			Bounds.resize(proxy + 1);
+			Alive.resize(proxy + 1, 0);
+		}
+
+		Bounds[proxy] = box;
+		Alive[proxy] = 1;
+	}
+};
+
+static BoundingBox RandomBox(Reference::Random& random, const float extent, const float maxSize)
+{
+	const Vector3 center = random.Vec3(-extent, extent);
+	const Vector3 half = random.Vec3(0.f, maxSize * .5f);
+
+	return BoundingBox{ center - half, center + half };
+}
+
+static bool Touches(const BoundingBox& box, const BoundingSphere& sphere)
+{
+	const Vector3 closest(std::clamp(sphere.Center.x, box.Min.x, box.Max.x), std::clamp(sphere.Center.y, box.Min.y, box.Max.y),
+		std::clamp(sphere.Center.z, box.Min.z, box.Max.z));
+	const Vector3 d = sphere.Center - closest;
+
+	return d.x * d.x + d.y * d.y + d.z * d.z <= sphere.Radius * sphere.Radius;
+}
+
+/// <summary>
+/// Distance at which a ray enters a box, negative if it misses it
+/// </summary>
+static float Entry(const BoundingBox& box, const Vector3& origin, const Vector3& direction, const float maxDistance)
+{
+	float tNear = 0.f, tFar = maxDistance;
+
+	for (int32_t axis = 0; axis < 3; axis++)
+	{
+		const float inv = 1.f / direction[axis];
+		const float t0 = (box.Min[axis] - origin[axis]) * inv;
+		const float t1 = (box.Max[axis] - origin[axis]) * inv;
+
+		tNear = std::max(tNear, std::min(t0, t1));
+		tFar = std::min(tFar, std::max(t0, t1));
+	}
+
+	return tNear <= tFar ? tNear : -1.f;
+}
+
+/// <summary>
+/// Checks that the query reports the expected proxies, each of them once
+/// </summary>
+template <typename Query>
+static bool SameProxies(const Boxes& boxes, const std::function<bool(const BoundingBox&)>& expected, Query&& query)
+{
+	std::vector<uint32_t> found;
+	query([&found](const uint32_t proxy) { found.push_back(proxy); });
+	std::sort(found.begin(), found.end());
+
+	std::vector<uint32_t> scanned;
+	for (uint32_t proxy = 0; proxy < boxes.Bounds.size(); proxy++)
+	{
+		if (boxes.Alive[proxy] && expected(boxes.Bounds[proxy]))
+			scanned.push_back(proxy);
+	}
+
+	return found == scanned;
+}
+
+/// <summary>
+/// Runs frustum, sphere and ray queries around the boxes
+/// </summary>
+/// <returns>Number of hits of every kind, so the callers can check the queries weren't all empty</returns>
+static uint32_t CheckQueries(const Bvh& bvh, const Boxes& boxes, Reference::Random& random, const float extent)
+{
+	uint32_t hits = 0;
+
+	bool frustumsMatch = true;
+	for (uint32_t i = 0; i < 20; i++)
+	{
+		const Frustum frustum = Reference::MakeFrustum(random.Vec3(-extent, extent), random.Vec3(-extent, extent), random.Float(.5f, 2.f), .1f, extent);
+
+		const auto inside = [&](const BoundingBox& box)
+			{
+				const bool intersects = frustum.Intersects(box);
+				hits += intersects;
+				return intersects;
+			};
+
+		frustumsMatch &= SameProxies(boxes, inside,
+			[&](const std::function<void(uint32_t)>& callback) { bvh.Query(frustum, callback); });
+	}
+
+	CHECK(frustumsMatch);
+
+	bool spheresMatch = true;
+	for (uint32_t i = 0; i < 100; i++)
+	{
+		// Some spheres are points
+		const BoundingSphere sphere{ random.Vec3(-extent, extent), i % 10 == 0 ? 0.f : random.Float(0.f, extent * .3f) };
+
+		const auto inside = [&](const BoundingBox& box)
+			{
+				const bool touches = Touches(box, sphere);
+				hits += touches;
+				return touches;
+			};
+
+		spheresMatch &= SameProxies(boxes, inside,
+			[&](const std::function<void(uint32_t)>& callback) { bvh.Query(sphere, callback); });
+	}
+
+	CHECK(spheresMatch);
+
+	bool raysMatch = true;
+	for (uint32_t i = 0; i < 200; i++)
+	{
+		const Vector3 origin = random.Vec3(-extent * 1.2f, extent * 1.2f);
+		const Vector3 direction = random.Vec3().Normalize();
+		const float maxDistance = i % 2 == 0 ? FLT_MAX : random.Float(0.f, extent);
+
+		// Boxes of odd proxies are hollow, so the closest box isn't always the closest hit
+		const auto hit = [&](const uint32_t proxy)
+			{
+				return proxy % 2 == 0 ? Entry(boxes.Bounds[proxy], origin, direction, maxDistance) : -1.f;
+			};
+
+		uint32_t expected = Bvh::Null;
+		float expectedDistance = maxDistance;
+
+		for (uint32_t proxy = 0; proxy < boxes.Bounds.size(); proxy++)
+		{
+			const float d = boxes.Alive[proxy] ? hit(proxy) : -1.f;
+
+			if (d >= 0.f && d < expectedDistance)
+			{
+				expected = proxy;
+				expectedDistance = d;
+			}
+		}
+
+		float distance;
+		const uint32_t closest = bvh.Raycast(origin, direction, maxDistance, hit, distance);
+
+		// Another proxy at the same distance is as good
+		raysMatch &= distance == expectedDistance && (closest == expected || (closest != Bvh::Null && hit(closest) == distance));
+		hits += expected != Bvh::Null;
+	}
+
+	CHECK(raysMatch);
+
+	return hits;
+}
+
+TEST(BvhQueriesAfterBuild)
+{
+	Reference::Random random;
+	Bvh bvh;
+	Boxes boxes;
+
+	for (uint32_t i = 0; i < 1000; i++)
+	{
+		const BoundingBox box = RandomBox(random, 50.f, 6.f);
+		boxes.Set(bvh.Insert(box), box);
+	}
+
+	// Proxies are only found after the next update
+	uint32_t found = 0;
+	bvh.Query(BoundingSphere{ Vector3(0.f), 1000.f }, [&found](const uint32_t) { found++; });
+	CHECK(found == 0);
+
+	bvh.Update();
+
+	CHECK(bvh.GetNodeCount() > 1);
+	CHECK(CheckQueries(bvh, boxes, random, 50.f) != 0);
+
+	// Nothing changed, the update keeps the tree
+	const uint32_t nodeCount = bvh.GetNodeCount();
+	bvh.Update();
+	CHECK(bvh.GetNodeCount() == nodeCount);
+}
+
+TEST(BvhQueriesAfterMove)
+{
+	Reference::Random random;
+	Bvh bvh;
+	Boxes boxes;
+
+	for (uint32_t i = 0; i < 1000; i++)
+	{
+		const BoundingBox box = RandomBox(random, 50.f, 6.f);
+		boxes.Set(bvh.Insert(box), box);
+	}
+
+	bvh.Update();
+	const uint32_t nodeCount = bvh.GetNodeCount();
+
+	// Small moves are refitted, the topology stays
+	for (uint32_t step = 0; step < 3; step++)
+	{
+		for (uint32_t proxy = step; proxy < boxes.Bounds.size(); proxy += 3)
+		{
+			const Vector3 offset = random.Vec3(-.5f, .5f);
+			boxes.Bounds[proxy] = BoundingBox{ boxes.Bounds[proxy].Min + offset, boxes.Bounds[proxy].Max + offset };
+			bvh.Move(proxy, boxes.Bounds[proxy]);
+		}
+
+		bvh.Update();
+
+		CHECK(bvh.GetNodeCount() == nodeCount);
+		CHECK(CheckQueries(bvh, boxes, random, 50.f) != 0);
+	}
+
+	// Moving everything somewhere else makes the refitted tree too expensive, whether it is rebuilt or not the results are the same
+	for (uint32_t proxy = 0; proxy < boxes.Bounds.size(); proxy++)
+	{
+		boxes.Bounds[proxy] = RandomBox(random, 50.f, 6.f);
+		bvh.Move(proxy, boxes.Bounds[proxy]);
+	}
+
+	bvh.Update();
+	CHECK(CheckQueries(bvh, boxes, random, 50.f) != 0);
+
+	// The same proxy moved several times before an update
+	for (uint32_t i = 0; i < 5; i++)
+	{
+		boxes.Bounds[7] = RandomBox(random, 50.f, 6.f);
+		bvh.Move(7, boxes.Bounds[7]);
+	}
+
+	bvh.Update();
+	CHECK(CheckQueries(bvh, boxes, random, 50.f) != 0);
+}
+
+TEST(BvhQueriesAfterRemoveInsert)
+{
+	Reference::Random random;
+	Bvh bvh;
+	Boxes boxes;
+
+	for (uint32_t i = 0; i < 1000; i++)
+	{
+		const BoundingBox box = RandomBox(random, 50.f, 6.f);
+		boxes.Set(bvh.Insert(box), box);
+	}
+
+	bvh.Update();
+
+	for (uint32_t step = 0; step < 4; step++)
+	{
+		// Removed proxies are never reported, their indices are given to the new ones
+		for (uint32_t i = 0; i < 150; i++)
+		{
+			const uint32_t proxy = static_cast<uint32_t>(random.Float(0.f, static_cast<float>(boxes.Bounds.size()))) % boxes.Bounds.size();
+
+			if (boxes.Alive[proxy])
+			{
+				bvh.Remove(proxy);
+				boxes.Alive[proxy] = 0;
+			}
+		}
+
+		// Moves mixed with the changes are applied by the rebuild
+		for (uint32_t proxy = 0; proxy < boxes.Bounds.size(); proxy += 11)
+		{
+			if (boxes.Alive[proxy])
+			{
+				boxes.Bounds[proxy] = RandomBox(random, 50.f, 6.f);
+				bvh.Move(proxy, boxes.Bounds[proxy]);
+			}
+		}
+
+		for (uint32_t i = 0; i < 100 * step; i++)
+		{
+			const BoundingBox box = RandomBox(random, 50.f, 6.f);
+			const uint32_t proxy = bvh.Insert(box);
+
+			CHECK(proxy >= boxes.Bounds.size() || !boxes.Alive[proxy]);
+			boxes.Set(proxy, box);
+		}
+
+		bvh.Update();
+		CHECK(CheckQueries(bvh, boxes, random, 50.f) != 0);
+	}
+
+	// Down to nothing
+	for (uint32_t proxy = 0; proxy < boxes.Bounds.size(); proxy++)
+	{
+		if (boxes.Alive[proxy])
+			bvh.Remove(proxy);
+
+		boxes.Alive[proxy] = 0;
+	}
+
+	bvh.Update();
+	CHECK(bvh.GetNodeCount() == 0);
+	CHECK(CheckQueries(bvh, boxes, random, 50.f) == 0);
+
+	bvh.Clear();
+	CHECK(bvh.GetNodeCount() == 0);
+	CHECK(bvh.Insert(RandomBox(random, 50.f, 6.f)) == 0);
+}
+
+TEST(BvhIdenticalCentroids)
+{
+	Reference::Random random;
+	Bvh bvh;
+	Boxes boxes;
+
+	// Nested boxes around the same center, no split plane separates them
+	for (uint32_t i = 0; i < 100; i++)
+	{
+		const Vector3 half = random.Vec3(.1f, 20.f);
+		const BoundingBox box{ Vector3(3.f, -2.f, 1.f) - half, Vector3(3.f, -2.f, 1.f) + half };
+		boxes.Set(bvh.Insert(box), box);
+	}
+
+	bvh.Update();
+
+	CHECK(bvh.GetNodeCount() > 1);
+	CHECK(CheckQueries(bvh, boxes, random, 30.f) != 0);
+
+	// The same, among boxes that can be split, and stacked copies of one box
+	for (uint32_t i = 0; i < 300; i++)
+	{
+		const BoundingBox box = RandomBox(random, 30.f, 4.f);
+		boxes.Set(bvh.Insert(box), box);
+	}
+
+	const BoundingBox copy = RandomBox(random, 30.f, 4.f);
+	for (uint32_t i = 0; i < 50; i++)
+		boxes.Set(bvh.Insert(copy), copy);
+
+	bvh.Update();
+	CHECK(CheckQueries(bvh, boxes, random, 30.f) != 0);
+}
+
+TEST(BvhZeroAreaBoxes)
+{
+	Reference::Random random;
+	Bvh bvh;
+	Boxes boxes;
+
+	// Points and flat boxes, all in the same plane so the centers have no extent on y
+	for (uint32_t i = 0; i < 600; i++)
+	{
+		BoundingBox box = RandomBox(random, 40.f, 5.f);
+		box.Min.y = 0.f;
+		box.Max.y = 0.f;
+
+		if (i % 3 == 0)
+			box.Max = box.Min;
+		else if (i % 3 == 1)
+			box.Max.x = box.Min.x;
+
+		boxes.Set(bvh.Insert(box), box);
+	}
+
+	bvh.Update();
+
+	CHECK(bvh.GetNodeCount() > 1);
+	CHECK(CheckQueries(bvh, boxes, random, 40.f) != 0);
+
+	// A tree of points at the same place has no area at all
+	Bvh points;
+	Boxes pointBoxes;
+
+	for (uint32_t i = 0; i < 40; i++)
+	{
+		const BoundingBox point{ Vector3(1.f, 2.f, 3.f), Vector3(1.f, 2.f, 3.f) };
+		pointBoxes.Set(points.Insert(point), point);
+	}
+
+	points.Update();
+
+	CHECK(points.GetCost() == 0.f);
+	CheckQueries(points, pointBoxes, random, 5.f);
+
+	// Found by a sphere around them and by a ray through them
+	uint32_t found = 0;
+	points.Query(BoundingSphere{ Vector3(1.f, 2.f, 3.f), 0.f }, [&found](const uint32_t) { found++; });
+	CHECK(found == 40);
+
+	float distance;
+	const uint32_t closest = points.Raycast(Vector3(0.f, 1.f, 2.f), Vector3(1.f).Normalize(), 10.f, [](const uint32_t) { return 3.f; }, distance);
+	CHECK(closest != Bvh::Null);
+	CHECK(distance == 3.f);
+}
@@ -0,0 +1,92 @@
+#include "test.hpp"
+
+#include "renderer/command_buffer.hpp"
+
+static IndirectBatch MakeBatch(const uint32_t state, const uint32_t i)
+{
+	return IndirectBatch{ state, MeshRange{ i * 36, 36 + i % 3, i * 24, 24 }, 1 + i % 7, i * 8 };
+}
+
+static bool CommandMatches(const DrawElementsIndirectCommand& command, const IndirectBatch& batch)
+{
+	return command.Count == batch.Mesh.IndexCount && command.InstanceCount == batch.InstanceCount
+		&& command.FirstIndex == batch.Mesh.FirstIndex && command.BaseVertex == static_cast<int32_t>(batch.Mesh.BaseVertex)
+		&& command.BaseInstance == batch.BaseInstance;
+}
+
+TEST(CommandBufferEmpty)
+{
+	CommandBuffer buffer;
+
+	buffer.Build({ MakeBatch(0, 0), MakeBatch(1, 1) });
+	buffer.Build({});
+
+	CHECK(buffer.GetCommands().empty());
+	CHECK(buffer.GetDraws().empty());
+}
+
+TEST(CommandBufferGroupsByState)
+{
+	CommandBuffer buffer;
+
+	// Only consecutive batches are grouped, state 1 comes back after state 2
+	const uint32_t states[] = { 0, 0, 0, 1, 2, 2, 1, 3 };
+	std::vector<IndirectBatch> batches;
+
+	for (uint32_t i = 0; i < std::size(states); i++)
+		batches.push_back(MakeBatch(states[i], i));
+
+	buffer.Build(batches);
+
+	const std::vector<MultiDraw>& draws = buffer.GetDraws();
+	const MultiDraw expected[] = { { 0, 0, 3 }, { 1, 3, 1 }, { 2, 4, 2 }, { 1, 6, 1 }, { 3, 7, 1 } };
+
+	CHECK(draws.size() == std::size(expected));
+
+	for (size_t d = 0; d < draws.size() && d < std::size(expected); d++)
+	{
+		CHECK(draws[d].State == expected[d].State);
+		CHECK(draws[d].FirstCommand == expected[d].FirstCommand);
+		CHECK(draws[d].CommandCount == expected[d].CommandCount);
+	}
+
+	CHECK(buffer.GetCommands().size() == batches.size());
+
+	for (size_t i = 0; i < batches.size() && i < buffer.GetCommands().size(); i++)
+		CHECK(CommandMatches(buffer.GetCommands()[i], batches[i]));
+}
+
+TEST(CommandBufferParallel)
+{
+	ThreadPool pool(3);
+	CommandBuffer serial, parallel;
+
+	// Several chunks and a partial one, with state runs crossing the chunk borders
+	std::vector<IndirectBatch> batches;
+	for (uint32_t i = 0; i < 5000; i++)
+		batches.push_back(MakeBatch(i / 700, i));
+
+	serial.Build(batches);
+	parallel.Build(batches, &pool);
+
+	CHECK(parallel.GetCommands().size() == batches.size());
+
+	bool commandsMatch = true;
+	for (size_t i = 0; i < batches.size() && i < parallel.GetCommands().size(); i++)
+		commandsMatch &= CommandMatches(parallel.GetCommands()[i], batches[i]) && CommandMatches(serial.GetCommands()[i], batches[i]);
+
+	CHECK(commandsMatch);
+
+	const std::vector<MultiDraw>& draws = parallel.GetDraws();
+	CHECK(draws.size() == 8);
+	CHECK(serial.GetDraws().size() == draws.size());
+
+	uint32_t first = 0;
+	for (size_t d = 0; d < draws.size(); d++)
+	{
+		CHECK(draws[d].State == d);
+		CHECK(draws[d].FirstCommand == first);
+		CHECK(draws[d].CommandCount == (d < 7 ? 700 : 100));
+		first += draws[d].CommandCount;
+	}
+}
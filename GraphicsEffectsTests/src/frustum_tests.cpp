@@ -0,0 +1,88 @@
+#include "test.hpp"
+#include "maths_reference.hpp"
+
+#include "renderer/frustum.hpp"
+
+// Cull tests 4 spheres at a time with SSE and the remaining ones with Intersects, both must agree on every sphere
+
+TEST(FrustumCullMatchesIntersects)
+{
+	Reference::Random random;
+
+	const Frustum frustums[] =
+	{
+		Reference::MakeFrustum(Vector3(0.f, 0.f, 5.f), Vector3(0.f), 1.0471976f, .1f, 100.f),
+		Reference::MakeFrustum(Vector3(20.f, 10.f, -3.f), Vector3(-5.f, 0.f, 2.f), 1.5707964f, .5f, 50.f),
+	};
+
+	// Every remainder of count % 4, and a slice not starting on a group of 4
+	constexpr size_t MaxCount = 39;
+	constexpr uint8_t Untouched = 0xCD;
+
+	for (const Frustum& frustum : frustums)
+	{
+		uint32_t visibleCount = 0, culledCount = 0;
+
+		for (size_t count = 0; count <= MaxCount; count++)
+		{
+			for (const size_t first : { size_t(0), size_t(1) })
+			{
+				std::vector<float> x, y, z, radius;
+
+				for (size_t i = 0; i < first + count; i++)
+				{
+					const Vector3 center = random.Vec3(-60.f, 60.f);
+					x.push_back(center.x);
+					y.push_back(center.y);
+					z.push_back(center.z);
+					// Some spheres are points
+					radius.push_back(i % 5 == 0 ? 0.f : random.Float(.1f, 10.f));
+				}
+
+				std::vector<uint8_t> visible(first + count + 4, Untouched);
+				frustum.Cull(x.data() + first, y.data() + first, z.data() + first, radius.data() + first, count, visible.data() + first);
+
+				for (size_t i = first; i < first + count; i++)
+				{
+					const bool expected = frustum.Intersects(BoundingSphere{ Vector3(x[i], y[i], z[i]), radius[i] });
+					CHECK(visible[i] == (expected ? 1 : 0));
+
+					expected ? visibleCount++ : culledCount++;
+				}
+
+				// Nothing is written outside of the range
+				for (size_t i = 0; i < first; i++)
+					CHECK(visible[i] == Untouched);
+				for (size_t i = first + count; i < visible.size(); i++)
+					CHECK(visible[i] == Untouched);
+			}
+		}
+
+		// Both outcomes are covered
+		CHECK(visibleCount != 0);
+		CHECK(culledCount != 0);
+	}
+}
+
+TEST(FrustumCullPlanes)
+{
+	const Frustum frustum = Reference::MakeFrustum(Vector3(0.f), Vector3(0.f, 0.f, -1.f), 1.5707964f, 1.f, 10.f);
+
+	// Spheres around the near and far planes and the sides, tested in a group of 4 and in the tail
+	const float x[] = { 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, -30.f, 30.f, -30.f };
+	const float y[] = { 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f };
+	const float z[] = { -.5f, -.5f, -10.5f, -10.5f, 1.f, -5.f, -5.f, -5.f, -5.f };
+	const float radius[] = { .4f, .6f, .4f, .6f, 1.5f, 0.f, 1.f, 30.f, 1.f };
+	constexpr size_t Count = std::size(x);
+
+	uint8_t visible[Count];
+	frustum.Cull(x, y, z, radius, Count, visible);
+
+	const uint8_t expected[Count] = { 0, 1, 0, 1, 0, 1, 0, 1, 0 };
+
+	for (size_t i = 0; i < Count; i++)
+	{
+		CHECK(visible[i] == expected[i]);
+		CHECK(visible[i] == (frustum.Intersects(BoundingSphere{ Vector3(x[i], y[i], z[i]), radius[i] }) ? 1 : 0));
+	}
+}
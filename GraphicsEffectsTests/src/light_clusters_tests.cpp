@@ -0,0 +1,304 @@
+#include "test.hpp"
+#include "maths_reference.hpp"
+
+#include <cmath>
+
+#include "renderer/light_clusters.hpp"
+
+// Build bins the lights per slice, in parallel and 4 at a time, BuildReference tests every light against every cluster
+
+static ClusterView MakeView(const float yaw, const Vector3& position, const float fov, const float zNear, const float zFar)
+{
+	ClusterView view;
+	view.Position = position;
+	view.Right = Vector3(std::cos(yaw), 0.f, std::sin(yaw));
+	view.Up = Vector3(0.f, 1.f, 0.f);
+	view.Front = Vector3(std::sin(yaw), 0.f, -std::cos(yaw));
+	view.Fov = fov;
+	view.ScreenSize = Vector2(1920.f, 1080.f);
+	view.Near = zNear;
+	view.Far = zFar;
+	return view;
+}
+
+/// <summary>
+/// Light at a view space position, the depth axis pointing forward
+/// </summary>
+static LightBounds MakeLight(const ClusterView& view, const float x, const float y, const float z, const float radius)
+{
+	return LightBounds{ view.Position + view.Right * x + view.Up * y + view.Front * z, radius };
+}
+
+/// <summary>
+/// Depth of the near face of a slice, as computed by LightClusters
+/// </summary>
+static float SliceDepth(const ClusterView& view, const uint32_t slice)
+{
+	return view.Near * std::pow(view.Far / view.Near, static_cast<float>(slice) / LightClusters::SliceCount);
+}
+
+static std::vector<LightBounds> RandomLights(Reference::Random& random, const ClusterView& view, const uint32_t count,
+	const float extent, const float minRadius, const float maxRadius)
+{
+	std::vector<LightBounds> lights;
+
+	for (uint32_t i = 0; i < count; i++)
+	{
+		// In front of the camera and behind it
+		const float x = random.Float(-extent, extent);
+		const float y = random.Float(-extent, extent);
+		const float z = random.Float(-extent * .25f, extent);
+		lights.push_back(MakeLight(view, x, y, z, random.Float(minRadius, maxRadius)));
+	}
+
+	return lights;
+}
+
+/// <summary>
+/// Bins the lights with and without worker threads and checks both against the reference, cluster by cluster
+/// </summary>
+/// <returns>Lights of the reference, for the checks of the callers</returns>
+static std::vector<uint32_t> CheckBuild(LightClusters& serial, LightClusters& parallel, const ClusterView& view,
+	const std::vector<LightBounds>& pointLights, const std::vector<LightBounds>& spotLights)
+{
+	std::vector<Cluster> clusters;
+	std::vector<uint32_t> lights;
+	LightClusters::BuildReference(view, pointLights, spotLights, clusters, lights);
+
+	CHECK(clusters.size() == LightClusters::ClusterCount);
+
+	for (LightClusters* const built : { &serial, &parallel })
+	{
+		built->Build(view, pointLights, spotLights);
+
+		CHECK(built->GetClusters().size() == clusters.size());
+		CHECK(built->GetLights() == lights);
+
+		uint32_t mismatches = 0;
+		for (size_t c = 0; c < clusters.size() && c < built->GetClusters().size(); c++)
+		{
+			const Cluster& expected = clusters[c];
+			const Cluster& actual = built->GetClusters()[c];
+
+			if (actual.Offset != expected.Offset || actual.PointCount != expected.PointCount || actual.SpotCount != expected.SpotCount)
+				mismatches++;
+		}
+
+		CHECK(mismatches == 0);
+	}
+
+	return lights;
+}
+
+TEST(LightClustersRandomLights)
+{
+	Reference::Random random;
+	ThreadPool pool(3);
+	LightClusters serial;
+	LightClusters parallel(&pool);
+
+	// The same instances are reused with other projections, so the cached cluster bounds are rebuilt
+	const ClusterView views[] =
+	{
+		MakeView(0.f, Vector3(0.f), 1.0471976f, .1f, 100.f),
+		MakeView(.7f, Vector3(3.f, -2.f, 5.f), 1.5707964f, .5f, 300.f),
+		MakeView(-2.1f, Vector3(-10.f, 4.f, 1.f), .7853982f, .05f, 50.f),
+	};
+
+	for (const ClusterView& view : views)
+	{
+		const std::vector<LightBounds> points = RandomLights(random, view, 300, view.Far * .5f, .1f, view.Far * .1f);
+		const std::vector<LightBounds> spots = RandomLights(random, view, 150, view.Far * .5f, .1f, view.Far * .1f);
+
+		CHECK(!CheckBuild(serial, parallel, view, points, spots).empty());
+	}
+}
+
+TEST(LightClustersBehindCamera)
+{
+	ThreadPool pool(3);
+	LightClusters serial;
+	LightClusters parallel(&pool);
+
+	const ClusterView view = MakeView(.4f, Vector3(1.f, 2.f, 3.f), 1.0471976f, .1f, 100.f);
+
+	const std::vector<LightBounds> points =
+	{
+		// Entirely behind the camera
+		MakeLight(view, 0.f, 0.f, -5.f, 1.f),
+		MakeLight(view, 2.f, -1.f, -.5f, .5f),
+		// Behind the camera but reaching past the near plane
+		MakeLight(view, 0.f, 0.f, -1.f, 1.5f),
+		// Centered on the camera
+		MakeLight(view, 0.f, 0.f, 0.f, .3f),
+	};
+
+	const std::vector<LightBounds> spots =
+	{
+		MakeLight(view, -1.f, 1.f, -20.f, 10.f),
+		MakeLight(view, .5f, .5f, -3.f, 3.5f),
+	};
+
+	const std::vector<uint32_t> lights = CheckBuild(serial, parallel, view, points, spots);
+
+	uint32_t pointHits[4] = {}, spotHits[2] = {};
+	for (const Cluster& cluster : serial.GetClusters())
+	{
+		for (uint32_t i = 0; i < cluster.PointCount; i++)
+			pointHits[lights[cluster.Offset + i]]++;
+		for (uint32_t i = 0; i < cluster.SpotCount; i++)
+			spotHits[lights[cluster.Offset + cluster.PointCount + i]]++;
+	}
+
+	CHECK(pointHits[0] == 0);
+	CHECK(pointHits[1] == 0);
+	CHECK(pointHits[2] != 0);
+	CHECK(pointHits[3] != 0);
+	CHECK(spotHits[0] == 0);
+	CHECK(spotHits[1] != 0);
+}
+
+TEST(LightClustersBorders)
+{
+	ThreadPool pool(3);
+	LightClusters serial;
+	LightClusters parallel(&pool);
+
+	// Axis aligned at the origin, so the view space positions are exact
+	const ClusterView view = MakeView(0.f, Vector3(0.f), 1.0471976f, .1f, 100.f);
+	const float tanY = std::tan(view.Fov * .5f);
+	const float tanX = tanY * (view.ScreenSize.x / view.ScreenSize.y);
+
+	const auto tileBorder = [](const uint32_t border, const uint32_t count, const float tan)
+		{
+			return (-1.f + 2.f * border / count) * tan;
+		};
+
+	const auto tileCenter = [](const uint32_t tile, const uint32_t count, const float tan)
+		{
+			return (-1.f + (2.f * tile + 1.f) / count) * tan;
+		};
+
+	std::vector<LightBounds> points;
+
+	// Down to tiny lights, a radius of 0 lights nothing
+	for (const float radius : { 1e-6f, 1e-3f, .05f })
+	{
+		// On the faces between two depth slices
+		for (uint32_t s = 1; s < LightClusters::SliceCount; s++)
+		{
+			const float depth = SliceDepth(view, s);
+			points.push_back(MakeLight(view, tileCenter(s % LightClusters::TileCountX, LightClusters::TileCountX, tanX) * depth,
+				tileCenter(s % LightClusters::TileCountY, LightClusters::TileCountY, tanY) * depth, depth, radius));
+		}
+
+		// On the planes between two tiles, in the middle of a slice
+		for (uint32_t x = 1; x < LightClusters::TileCountX; x++)
+		{
+			const float depth = (SliceDepth(view, x) + SliceDepth(view, x + 1)) * .5f;
+			points.push_back(MakeLight(view, tileBorder(x, LightClusters::TileCountX, tanX) * depth,
+				tileCenter(x % LightClusters::TileCountY, LightClusters::TileCountY, tanY) * depth, depth, radius));
+		}
+
+		for (uint32_t y = 1; y < LightClusters::TileCountY; y++)
+		{
+			const float depth = (SliceDepth(view, y) + SliceDepth(view, y + 1)) * .5f;
+			points.push_back(MakeLight(view, tileCenter(y, LightClusters::TileCountX, tanX) * depth,
+				tileBorder(y, LightClusters::TileCountY, tanY) * depth, depth, radius));
+		}
+	}
+
+	// On the near and far planes
+	points.push_back(MakeLight(view, 0.f, 0.f, view.Near, 1e-6f));
+	points.push_back(MakeLight(view, 0.f, 0.f, view.Far, 1e-6f));
+
+	const std::vector<uint32_t> lights = CheckBuild(serial, parallel, view, points, {});
+
+	// Every light between two clusters is listed by both
+	std::vector<uint32_t> hits(points.size(), 0);
+	for (const uint32_t light : lights)
+		hits[light]++;
+
+	bool shared = true;
+	for (size_t i = 0; i + 2 < points.size(); i++)
+		shared &= hits[i] >= 2;
+
+	CHECK(shared);
+	CHECK(hits[points.size() - 2] != 0);
+	CHECK(hits[points.size() - 1] != 0);
+}
+
+TEST(LightClustersNoLight)
+{
+	ThreadPool pool(3);
+	LightClusters serial;
+	LightClusters parallel(&pool);
+
+	const ClusterView view = MakeView(1.f, Vector3(5.f, 0.f, -2.f), 1.0471976f, .1f, 100.f);
+
+	CHECK(CheckBuild(serial, parallel, view, {}, {}).empty());
+
+	bool empty = true;
+	for (const Cluster& cluster : serial.GetClusters())
+		empty &= cluster.Offset == 0 && cluster.PointCount == 0 && cluster.SpotCount == 0;
+
+	CHECK(empty);
+
+	// Going back to no light after a frame with lights
+	Reference::Random random;
+	CheckBuild(serial, parallel, view, RandomLights(random, view, 64, 50.f, .5f, 5.f), {});
+	CHECK(CheckBuild(serial, parallel, view, {}, {}).empty());
+}
+
+TEST(LightClustersZeroRadius)
+{
+	ThreadPool pool(3);
+	LightClusters serial;
+	LightClusters parallel(&pool);
+
+	const ClusterView view = MakeView(-.6f, Vector3(0.f, 0.f, 4.f), 1.0471976f, .1f, 100.f);
+
+	// Lights with a radius <= 0 light nothing, even the clusters they are in
+	const std::vector<LightBounds> points =
+	{
+		MakeLight(view, 0.f, 0.f, 10.f, 0.f),
+		MakeLight(view, 0.f, 0.f, 10.f, 2.f),
+		MakeLight(view, 1.f, -1.f, 10.f, -3.f),
+		MakeLight(view, 0.f, 0.f, 0.f, 0.f),
+	};
+	const std::vector<LightBounds> spots =
+	{
+		MakeLight(view, 0.f, 0.f, 20.f, 5.f),
+		MakeLight(view, 0.f, 0.f, 20.f, -5.f),
+	};
+
+	CHECK(!CheckBuild(serial, parallel, view, points, spots).empty());
+
+	bool onlyLit = true;
+	for (const Cluster& cluster : serial.GetClusters())
+	{
+		for (uint32_t i = 0; i < cluster.PointCount; i++)
+			onlyLit &= serial.GetLights()[cluster.Offset + i] == 1;
+
+		for (uint32_t i = 0; i < cluster.SpotCount; i++)
+			onlyLit &= serial.GetLights()[cluster.Offset + cluster.PointCount + i] == 0;
+	}
+
+	CHECK(onlyLit);
+}
+
+TEST(LightClustersManyLights)
+{
+	Reference::Random random;
+	ThreadPool pool(3);
+	LightClusters serial;
+	LightClusters parallel(&pool);
+
+	const ClusterView view = MakeView(.3f, Vector3(0.f, 1.f, 0.f), 1.0471976f, .1f, 200.f);
+
+	// Thousands of lights per slice, the spot light count isn't a multiple of 4 so the last group of a slice is padded
+	const std::vector<LightBounds> points = RandomLights(random, view, 6000, 100.f, .5f, 10.f);
+	const std::vector<LightBounds> spots = RandomLights(random, view, 2001, 100.f, .5f, 10.f);
+
+	CHECK(CheckBuild(serial, parallel, view, points, spots).size() > 4096);
+}
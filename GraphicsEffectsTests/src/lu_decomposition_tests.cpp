@@ -0,0 +1,120 @@
+#include "test.hpp"
+#include "maths_reference.hpp"
+
+#include "core/maths/lu_decomposition.h"
+
+static bool IsIdentity(const MatrixM& mat, const float epsilon)
+{
+	bool identity = true;
+
+	for (uint32_t i = 0; i < mat.GetNbrRows(); i++)
+	{
+		for (uint32_t j = 0; j < mat.GetNbrColumns(); j++)
+			identity &= std::abs(mat[i][j] - (i == j ? 1.f : 0.f)) <= epsilon;
+	}
+
+	return identity;
+}
+
+TEST(LUDecompositionBadlyScaled)
+{
+	// Regular matrices whose entries differ by orders of magnitude
+	const MatrixM diagonal(2, 2, { 1e8f, 0.f, 0.f, 1.f });
+	const LUDecomposition lu(diagonal);
+
+	CHECK(!lu.IsSingular());
+	CHECK(lu.Determinant() == 1e8f);
+
+	MatrixM inverse;
+	const bool inverted = diagonal.Inverse(inverse);
+	CHECK(inverted);
+
+	if (inverted)
+	{
+		CHECK(inverse[0][0] == 1e-8f);
+		CHECK(inverse[1][1] == 1.f);
+		CHECK(inverse[0][1] == 0.f && inverse[1][0] == 0.f);
+	}
+
+	const MatrixM rows(3, 3, { 1e8f, 2e8f, 0.f, 1.f, 3.f, 0.f, 0.f, 0.f, 1e-6f });
+	const LUDecomposition rowsLu(rows);
+
+	CHECK(!rowsLu.IsSingular());
+	CHECK_NEAR(rowsLu.Determinant(), 1e2f, 1e-3f);
+
+	const bool rowsInverted = rows.Inverse(inverse);
+	CHECK(rowsInverted);
+
+	if (rowsInverted)
+	{
+		MatrixM product(rows);
+		product.Multiply(inverse);
+		CHECK(IsIdentity(product, 1e-5f));
+	}
+}
+
+TEST(LUDecompositionSingular)
+{
+	// The second row is twice the first one, the elimination gives an exact 0
+	const MatrixM twice(2, 2, { 1.f, 2.f, 2.f, 4.f });
+	const LUDecomposition lu(twice);
+
+	CHECK(lu.IsSingular());
+	CHECK(lu.Determinant() == 0.f);
+
+	MatrixM inverse;
+	CHECK(!lu.Inverse(inverse));
+	CHECK(!twice.Inverse(inverse));
+
+	VectorM x;
+	CHECK(!lu.Solve(VectorM({ 1.f, 2.f }), x));
+
+	// A zero column, the elimination goes on past it and the determinant is the product of U
+	const MatrixM column(3, 3, { 1.f, 0.f, 2.f, 3.f, 0.f, 4.f, 5.f, 0.f, 6.f });
+	const LUDecomposition columnLu(column);
+
+	CHECK(columnLu.IsSingular());
+	CHECK(columnLu.Determinant() == 0.f);
+	CHECK(column.Determinant() == 0.f);
+
+	// Not square, nothing is factored
+	const MatrixM wide(3, 2, 1.f);
+	LUDecomposition wideLu;
+
+	CHECK(!wideLu.Factor(wide));
+	CHECK(wideLu.Determinant() == 0.f);
+	CHECK(LUDecomposition().Determinant() == 0.f);
+}
+
+TEST(LUDecompositionRandom)
+{
+	Reference::Random random;
+
+	for (int i = 0; i < 1000; i++)
+	{
+		const Matrix4x4 m = random.Mat4(-10.f, 10.f);
+		const MatrixM mat(4, 4, { m[0][0], m[0][1], m[0][2], m[0][3], m[1][0], m[1][1], m[1][2], m[1][3],
+			m[2][0], m[2][1], m[2][2], m[2][3], m[3][0], m[3][1], m[3][2], m[3][3] });
+
+		const double expected = Reference::Determinant(m);
+		const LUDecomposition lu(mat);
+
+		CHECK(!lu.IsSingular());
+		CHECK(std::abs(lu.Determinant() - expected) <= 1e-4 * std::max(1., std::abs(expected)));
+
+		// A * x = b
+		const VectorM b({ random.Float(), random.Float(), random.Float(), random.Float() });
+		VectorM x;
+		CHECK(lu.Solve(b, x));
+
+		// Relative to the norm of the solution, random matrices can be badly conditioned
+		for (uint32_t r = 0; r < 4; r++)
+		{
+			float sum = 0.f;
+			for (uint32_t c = 0; c < 4; c++)
+				sum += mat[r][c] * x[c];
+
+			CHECK_NEAR(sum, b[r], 1e-3f * std::max(1.f, x.Norm()));
+		}
+	}
+}
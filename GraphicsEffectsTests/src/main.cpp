@@ -0,0 +1,80 @@
+#include "test.hpp"
+
+#include <cstring>
+#include <iostream>
+
+#include "core/maths/simd.h"
+
+uint32_t Test::m_Failures;
+
+std::vector<Test::Entry>& Test::GetEntries()
+{
+	// Function local so that the tests of every translation unit can register during static initialization
+	static std::vector<Entry> entries;
+	return entries;
+}
+
+bool Test::Register(const char* const name, const Function func)
+{
+	GetEntries().push_back(Entry{ name, func });
+	return true;
+}
+
+void Test::Fail(const char* const expression, const char* const file, const int32_t line)
+{
+	// Only the first failures of a test are printed, a broken loop would flood the output
+	if (m_Failures++ < 10)
+		std::cout << "    " << file << "(" << line << ") : CHECK(" << expression << ") failed\n";
+}
+
+uint32_t Test::RunAll(const char* const filter)
+{
+	uint32_t run = 0;
+	uint32_t failed = 0;
+
+	for (const Entry& entry : GetEntries())
+	{
+		if (filter != nullptr && std::strstr(entry.Name, filter) == nullptr)
+			continue;
+
+		std::cout << "[ RUN  ] " << entry.Name << std::endl;
+
+		m_Failures = 0;
+		entry.Func();
+		run++;
+
+		if (m_Failures != 0)
+		{
+			std::cout << "[ FAIL ] " << entry.Name << " (" << m_Failures << " failed checks)" << std::endl;
+			failed++;
+		}
+		else
+		{
+			std::cout << "[  OK  ] " << entry.Name << std::endl;
+		}
+	}
+
+	std::cout << run - failed << "/" << run << " tests passed" << std::endl;
+	return failed;
+}
+
+static const char* GetSimdBackend()
+{
+#if defined(MATHS_SIMD_AVX)
+	return "AVX";
+#elif defined(MATHS_SIMD_SSE)
+	return "SSE";
+#else
+	return "scalar";
+#endif
+}
+
+/// <summary>
+/// Runs the tests : GraphicsEffectsTests [filter]
+/// </summary>
+int main(int argc, char** argv)
+{
+	std::cout << "Maths backend : " << GetSimdBackend() << std::endl;
+
+	return Test::RunAll(argc > 1 ? argv[1] : nullptr) == 0 ? 0 : 1;
+}
@@ -0,0 +1,119 @@
+#include "test.hpp"
+
+#include <type_traits>
+
+#include "core/maths/mat.h"
+#include "core/maths/matrix2x2.h"
+#include "core/maths/matrix3x3.h"
+#include "core/maths/matrix4x4.h"
+
+// Compile time only : the vector and matrix operators must stay usable in constant expressions,
+// this file stops building as soon as one of them isn't constexpr anymore
+
+// Vector2
+static_assert(Vector2(1.f, 2.f) + Vector2(3.f, 4.f) == Vector2(4.f, 6.f));
+static_assert(Vector2(1.f, 2.f) - Vector2(3.f, 5.f) == Vector2(-2.f, -3.f));
+static_assert(Vector2(1.f, 2.f) * Vector2(3.f, 4.f) == Vector2(3.f, 8.f));
+static_assert(Vector2(3.f, 8.f) / Vector2(3.f, 4.f) == Vector2(1.f, 2.f));
+static_assert(Vector2(1.f, 2.f) * 2.f == Vector2(2.f, 4.f));
+static_assert(Vector2(2.f, 4.f) / 2.f == Vector2(1.f, 2.f));
+static_assert(-Vector2(1.f, -2.f) == Vector2(-1.f, 2.f));
+static_assert(Vector2(1.f, 2.f)[1] == 2.f);
+static_assert(Vector2(3.f, 4.f).NormSquared() == 25.f);
+static_assert(Vector2::DotProduct(Vector2(1.f, 2.f), Vector2(3.f, 4.f)) == 11.f);
+static_assert(Vector2::CrossProduct(Vector2(1.f, 0.f), Vector2(0.f, 1.f)) == 1.f);
+static_assert(Vector2::DistanceSquared(Vector2(1.f, 1.f), Vector2(4.f, 5.f)) == 25.f);
+static_assert([]()
+	{
+		Vector2 v(1.f, 2.f);
+		v += Vector2(1.f, 1.f);
+		v *= 2.f;
+		return v;
+	}() == Vector2(4.f, 6.f));
+
+// Vector3
+static_assert(Vector3(1.f, 2.f, 3.f) + Vector3(4.f, 5.f, 6.f) == Vector3(5.f, 7.f, 9.f));
+static_assert(Vector3(1.f, 2.f, 3.f) - Vector3(4.f, 5.f, 6.f) == Vector3(-3.f));
+static_assert(Vector3(1.f, 2.f, 3.f) * 3.f == Vector3(3.f, 6.f, 9.f));
+static_assert(-Vector3(1.f, 2.f, 3.f) == Vector3(-1.f, -2.f, -3.f));
+static_assert(Vector3(Vector2(1.f, 2.f), 3.f)[2] == 3.f);
+static_assert(Vector3::DotProduct(Vector3(1.f, 2.f, 3.f), Vector3(4.f, 5.f, 6.f)) == 32.f);
+static_assert(Vector3::CrossProduct(Vector3(1.f, 0.f, 0.f), Vector3(0.f, 1.f, 0.f)) == Vector3(0.f, 0.f, 1.f));
+static_assert(Vector3::CrossProduct(Vector3(1.f, 2.f, 3.f), Vector3(4.f, 5.f, 6.f)) == Vector3(-3.f, 6.f, -3.f));
+static_assert(Vector3::DistanceSquared(Vector3(1.f), Vector3(2.f, 3.f, 4.f)) == 14.f);
+static_assert([]()
+	{
+		Vector3 v(1.f, 2.f, 3.f);
+		v += Vector3(1.f);
+		v *= Vector3(2.f, 1.f, .5f);
+		return v;
+	}() == Vector3(4.f, 3.f, 2.f));
+
+// Vector4, the SSE paths are only taken outside constant evaluation
+static_assert(Vector4(1.f, 2.f, 3.f, 4.f) + Vector4(4.f, 3.f, 2.f, 1.f) == Vector4(5.f));
+static_assert(Vector4(1.f, 2.f, 3.f, 4.f) - Vector4(1.f) == Vector4(0.f, 1.f, 2.f, 3.f));
+static_assert(Vector4(1.f, 2.f, 3.f, 4.f) * Vector4(2.f) == Vector4(2.f, 4.f, 6.f, 8.f));
+static_assert(Vector4(2.f, 4.f, 6.f, 8.f) / 2.f == Vector4(1.f, 2.f, 3.f, 4.f));
+static_assert(-Vector4(1.f, 2.f, 3.f, 4.f) == Vector4(-1.f, -2.f, -3.f, -4.f));
+static_assert(Vector4(Vector3(1.f, 2.f, 3.f), 4.f)[3] == 4.f);
+static_assert(Vector4::DotProduct(Vector4(1.f, 2.f, 3.f, 4.f), Vector4(4.f, 3.f, 2.f, 1.f)) == 20.f);
+static_assert(Vector4(1.f, 2.f, 3.f, 4.f).NormSquared() == 30.f);
+static_assert([]()
+	{
+		Vector4 v(1.f, 2.f, 3.f, 4.f);
+		v += 1.f;
+		v *= Vector4(2.f);
+		return v;
+	}() == Vector4(4.f, 6.f, 8.f, 10.f));
+
+// Matrix products with the identity
+constexpr Matrix2x2 M2(1.f, 2.f, 3.f, 4.f);
+static_assert(Matrix2x2::Identity * M2 == M2);
+static_assert(M2 * Matrix2x2::Identity == M2);
+static_assert(M2 * M2 == Matrix2x2(7.f, 10.f, 15.f, 22.f));
+static_assert(M2 * Vector2(1.f, 1.f) == Vector2(3.f, 7.f));
+static_assert(M2.Trace() == 5.f);
+
+constexpr Matrix3x3 M3(Vector3(1.f, 2.f, 3.f), Vector3(4.f, 5.f, 6.f), Vector3(7.f, 8.f, 10.f));
+static_assert(Matrix3x3::Identity * M3 == M3);
+static_assert(M3 * Matrix3x3::Identity == M3);
+static_assert(M3 * Vector3(1.f, 0.f, 0.f) == Vector3(1.f, 4.f, 7.f));
+static_assert(M3.Diagonal() == Vector3(1.f, 5.f, 10.f));
+
+constexpr Matrix4x4 M4(
+	Vector4(1.f, 2.f, 3.f, 4.f),
+	Vector4(5.f, 6.f, 7.f, 8.f),
+	Vector4(9.f, 10.f, 11.f, 12.f),
+	Vector4(13.f, 14.f, 15.f, 16.f));
+static_assert(Matrix4x4::Identity * M4 == M4);
+static_assert(M4 * Matrix4x4::Identity == M4);
+static_assert(Matrix4x4::Identity * Matrix4x4::Identity == Matrix4x4::Identity);
+static_assert(M4 * Vector4(0.f, 0.f, 0.f, 1.f) == Vector4(4.f, 8.f, 12.f, 16.f));
+static_assert((M4 * M4)[0] == Vector4(90.f, 100.f, 110.f, 120.f));
+static_assert(M4.Trace() == 34.f);
+
+// Generic sizes, not aliases of the specializations
+static_assert(Vec<float, 5>(1.f) + Vec<float, 5>(2.f) == Vec<float, 5>(3.f));
+static_assert(Vec<float, 5>::DotProduct(Vec<float, 5>(2.f), Vec<float, 5>(3.f)) == 30.f);
+static_assert(Vec<int, 3>(2) * 3 == Vec<int, 3>(6));
+
+static_assert(Mat<int, 3, 3>::GetIdentity() * Mat<int, 3, 3>(2) == Mat<int, 3, 3>(2));
+static_assert((Mat<float, 2, 3>(1.f) * Mat<float, 3, 2>(2.f)) == Mat<float, 2, 2>(6.f));
+static_assert(Mat<float, 2, 3>(1.f).GetTransposed() == Mat<float, 3, 2>(1.f));
+static_assert(Mat<float, 3, 4>(1.f) * Vector4(1.f, 2.f, 3.f, 4.f) == Vector3(10.f));
+
+// Generic matrices multiplied by the specializations
+constexpr Mat<float, 3, 4> M34 = []()
+	{
+		Mat<float, 3, 4> m;
+		for (int r = 0; r < 3; r++)
+		{
+			for (int c = 0; c < 4; c++)
+				m[r][c] = static_cast<float>(r * 4 + c + 1);
+		}
+		return m;
+	}();
+static_assert(M34 * Matrix4x4::Identity == M34);
+// A 4x3 * 3x4 product lands on Matrix4x4
+static_assert(std::is_same_v<decltype(M34.GetTransposed() * M34), Matrix4x4>);
+static_assert((M34.GetTransposed() * M34)[0] == Vector4(107.f, 122.f, 137.f, 152.f));
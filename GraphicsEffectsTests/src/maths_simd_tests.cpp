@@ -0,0 +1,483 @@
+#include "test.hpp"
+#include "maths_reference.hpp"
+
+// The maths backend is chosen at build time (see core/maths/simd.h), every backend is checked against the same scalar code
+
+static constexpr int Iterations = 10000;
+
+static bool Equal(const Matrix4x4& a, const Matrix4x4& b)
+{
+	// Value equality, 0 and -0 are the same
+	for (int r = 0; r < 4; r++)
+	{
+		for (int c = 0; c < 4; c++)
+		{
+			if (a[r][c] != b[r][c])
+				return false;
+		}
+	}
+	return true;
+}
+
+TEST(Vector4Arithmetic)
+{
+	Reference::Random random;
+
+	for (int i = 0; i < Iterations; i++)
+	{
+		const Vector4 a = random.Vec4(-100.f, 100.f);
+		const Vector4 b = random.Vec4(0.5f, 100.f);
+		const float s = random.Float(0.5f, 100.f);
+
+		CHECK(Reference::BitEqual(a + b, Vector4(a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w)));
+		CHECK(Reference::BitEqual(a - b, Vector4(a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w)));
+		CHECK(Reference::BitEqual(a * b, Vector4(a.x * b.x, a.y * b.y, a.z * b.z, a.w * b.w)));
+		CHECK(Reference::BitEqual(a / b, Vector4(a.x / b.x, a.y / b.y, a.z / b.z, a.w / b.w)));
+
+		CHECK(Reference::BitEqual(a + s, Vector4(a.x + s, a.y + s, a.z + s, a.w + s)));
+		CHECK(Reference::BitEqual(a - s, Vector4(a.x - s, a.y - s, a.z - s, a.w - s)));
+		CHECK(Reference::BitEqual(a * s, Vector4(a.x * s, a.y * s, a.z * s, a.w * s)));
+		CHECK(Reference::BitEqual(a / s, Vector4(a.x / s, a.y / s, a.z / s, a.w / s)));
+
+		CHECK(Reference::BitEqual(-a, Vector4(-a.x, -a.y, -a.z, -a.w)));
+
+		Vector4 c = a;
+		c += b;
+		c *= s;
+		CHECK(Reference::BitEqual(c, Vector4((a.x + b.x) * s, (a.y + b.y) * s, (a.z + b.z) * s, (a.w + b.w) * s)));
+	}
+}
+
+TEST(Vector4DotProduct)
+{
+	Reference::Random random;
+
+	for (int i = 0; i < Iterations; i++)
+	{
+		const Vector4 a = random.Vec4(-100.f, 100.f);
+		const Vector4 b = random.Vec4(-100.f, 100.f);
+
+		// Summed in order, ((x + y) + z) + w
+		const float expected = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+
+		CHECK(Reference::BitEqual(Vector4::DotProduct(a, b), expected));
+	}
+}
+
+TEST(Vector4Normalize)
+{
+	Reference::Random random;
+
+	for (int i = 0; i < Iterations; i++)
+	{
+		const Vector4 a = random.Vec4(-100.f, 100.f);
+		const Vector4 n = a.Normalize();
+		const double norm = std::sqrt(static_cast<double>(a.x) * a.x + static_cast<double>(a.y) * a.y
+			+ static_cast<double>(a.z) * a.z + static_cast<double>(a.w) * a.w);
+
+		CHECK_NEAR(n.x, a.x / norm, 1e-6);
+		CHECK_NEAR(n.y, a.y / norm, 1e-6);
+		CHECK_NEAR(n.z, a.z / norm, 1e-6);
+		CHECK_NEAR(n.w, a.w / norm, 1e-6);
+	}
+}
+
+TEST(Matrix4x4Multiply)
+{
+	Reference::Random random;
+
+	for (int i = 0; i < Iterations; i++)
+	{
+		const Matrix4x4 a = random.Mat4(-10.f, 10.f);
+		const Matrix4x4 b = random.Mat4(-10.f, 10.f);
+		const Matrix4x4 expected = Reference::Multiply(a, b);
+
+		Matrix4x4 result;
+		Matrix4x4::Multiply(a, b, result);
+		CHECK(Reference::BitEqual(result, expected));
+
+		CHECK(Reference::BitEqual(a * b, expected));
+
+		Matrix4x4 inPlace = a;
+		inPlace.Multiply(b);
+		CHECK(Reference::BitEqual(inPlace, expected));
+
+		// The destination can be one of the operands
+		Matrix4x4 left = a;
+		Matrix4x4::Multiply(left, b, left);
+		CHECK(Reference::BitEqual(left, expected));
+
+		Matrix4x4 right = b;
+		Matrix4x4::Multiply(a, right, right);
+		CHECK(Reference::BitEqual(right, expected));
+
+		// The in-place product can take the matrix itself
+		Matrix4x4 squared = a;
+		squared.Multiply(squared);
+		CHECK(Reference::BitEqual(squared, Reference::Multiply(a, a)));
+	}
+}
+
+TEST(Matrix4x4MultiplyVector)
+{
+	Reference::Random random;
+
+	for (int i = 0; i < Iterations; i++)
+	{
+		Matrix4x4 m = random.Mat4(-10.f, 10.f);
+		const Vector4 v = random.Vec4(-10.f, 10.f);
+		const Vector4 expected = Reference::Multiply(m, v);
+
+		CHECK(Reference::BitEqual(m.Multiply(v), expected));
+		CHECK(Reference::BitEqual(m * v, expected));
+	}
+}
+
+TEST(Matrix4x4Transpose)
+{
+	Reference::Random random;
+
+	for (int i = 0; i < Iterations; i++)
+	{
+		const Matrix4x4 m = random.Mat4(-10.f, 10.f);
+
+		Matrix4x4 transposed = m;
+		transposed.Transpose();
+		CHECK(Reference::BitEqual(transposed, Reference::Transpose(m)));
+
+		transposed.Transpose();
+		CHECK(Reference::BitEqual(transposed, m));
+	}
+}
+
+TEST(Matrix4x4TRS)
+{
+	Reference::Random random;
+
+	for (int i = 0; i < Iterations; i++)
+	{
+		const Vector3 t = random.Vec3(-100.f, 100.f);
+		const Quaternion q = random.Rotation();
+		const Vector3 s = random.Vec3(0.1f, 10.f);
+
+		// Scaling the columns of R then setting the translation does the same multiplications as the full products
+		Matrix4x4 trs;
+		Matrix4x4::TRS(t, q, s, trs);
+		CHECK(Equal(trs, Reference::TRS(t, q, s)));
+
+		const Vector3 euler = random.Vec3(-3.f, 3.f);
+		Matrix4x4::TRS(t, euler, s, trs);
+		CHECK(Equal(trs, Reference::TRS(t, Quaternion::FromEuler(euler), s)));
+	}
+}
+
+TEST(Matrix4x4Determinant)
+{
+	Reference::Random random;
+
+	for (int i = 0; i < Iterations; i++)
+	{
+		const Matrix4x4 m = random.Mat4(-10.f, 10.f);
+		const double expected = Reference::Determinant(m);
+
+		// The 2x2 sub-determinants cancel out, the error is relative to the size of the terms rather than to the result
+		CHECK_NEAR(m.Determinant(), expected, 1e-5 * 10000.);
+	}
+}
+
+TEST(Matrix4x4Inverse)
+{
+	Reference::Random random;
+
+	for (int i = 0; i < Iterations; i++)
+	{
+		// Kept away from singular by a dominant diagonal
+		Matrix4x4 m = random.Mat4();
+		for (int k = 0; k < 4; k++)
+			m[k][k] += 4.f;
+
+		double expected[4][4];
+		Reference::Inverse(m, expected);
+
+		Matrix4x4 inverse;
+		CHECK(m.Inverse(inverse));
+		CHECK(Reference::RelativeError(inverse, expected) < 1e-5);
+
+		Matrix4x4 trs;
+		Matrix4x4::TRS(random.Vec3(-100.f, 100.f), random.Rotation(), random.Vec3(0.1f, 10.f), trs);
+		Reference::Inverse(trs, expected);
+
+		CHECK(trs.Inverse(inverse));
+		CHECK(Reference::RelativeError(inverse, expected) < 1e-5);
+
+		CHECK(trs.InverseAffine(inverse));
+		CHECK(Reference::RelativeError(inverse, expected) < 1e-5);
+
+		// The normal matrix is the transposed inverse of the linear part
+		Matrix4x4 normal;
+		CHECK(trs.NormalMatrix(normal));
+
+		for (int r = 0; r < 3; r++)
+		{
+			for (int c = 0; c < 3; c++)
+				CHECK_NEAR(normal[r][c], expected[c][r], 1e-5 * 10.);
+		}
+	}
+}
+
+TEST(Matrix4x4InverseSingular)
+{
+	const Matrix4x4 singular(
+		1.f, 2.f, 3.f, 4.f,
+		2.f, 4.f, 6.f, 8.f,
+		0.f, 1.f, 0.f, 1.f,
+		1.f, 0.f, 1.f, 0.f
+	);
+
+	const Matrix4x4 untouched = Matrix4x4(7.f);
+	Matrix4x4 inverse = untouched;
+
+	CHECK(!singular.Inverse(inverse));
+	CHECK(Reference::BitEqual(inverse, untouched));
+
+	Matrix4x4 flat;
+	Matrix4x4::TRS(Vector3(1.f, 2.f, 3.f), Quaternion::Identity, Vector3(1.f, 0.f, 1.f), flat);
+
+	CHECK(!flat.InverseAffine(inverse));
+	CHECK(!flat.NormalMatrix(inverse));
+	CHECK(Reference::BitEqual(inverse, untouched));
+}
+
+static bool Near(const Quaternion& a, const Quaternion& b, const float epsilon)
+{
+	return std::abs(a.x - b.x) <= epsilon && std::abs(a.y - b.y) <= epsilon && std::abs(a.z - b.z) <= epsilon && std::abs(a.w - b.w) <= epsilon;
+}
+
+/// <summary>
+/// q and -q are the same rotation
+/// </summary>
+static bool SameRotation(const Quaternion& a, const Quaternion& b, const float epsilon)
+{
+	return Near(a, b, epsilon) || Near(a, Quaternion(-b.x, -b.y, -b.z, -b.w), epsilon);
+}
+
+static bool Near(const Matrix4x4& a, const Matrix4x4& b, const float epsilon)
+{
+	for (int r = 0; r < 4; r++)
+	{
+		for (int c = 0; c < 4; c++)
+		{
+			if (!(std::abs(a[r][c] - b[r][c]) <= epsilon))
+				return false;
+		}
+	}
+	return true;
+}
+
+static Matrix4x4 ToMatrix(const Quaternion& q)
+{
+	Matrix4x4 mat;
+	Matrix4x4::Rotation(q, mat);
+	return mat;
+}
+
+/// <summary>
+/// Angle of the rotation going from a to b, from the chord between them rather than an acos which is imprecise for small angles
+/// </summary>
+static float Angle(const Quaternion& a, const Quaternion& b)
+{
+	const float sign = Quaternion::DotProduct(a, b) < 0.f ? -1.f : 1.f;
+	const Quaternion difference(a.x - b.x * sign, a.y - b.y * sign, a.z - b.z * sign, a.w - b.w * sign);
+	const Quaternion sum(a.x + b.x * sign, a.y + b.y * sign, a.z + b.z * sign, a.w + b.w * sign);
+
+	return 4.f * std::atan2(difference.Norm(), sum.Norm());
+}
+
+TEST(QuaternionMultiply)
+{
+	Reference::Random random;
+
+	for (int i = 0; i < Iterations; i++)
+	{
+		// Not normalized, every sign of every component
+		const Quaternion a(random.Float(-10.f, 10.f), random.Float(-10.f, 10.f), random.Float(-10.f, 10.f), random.Float(-10.f, 10.f));
+		const Quaternion b(random.Float(-10.f, 10.f), random.Float(-10.f, 10.f), random.Float(-10.f, 10.f), random.Float(-10.f, 10.f));
+		const Quaternion expected = Reference::Multiply(a, b);
+
+		CHECK(Reference::BitEqual(Quaternion::Multiply(a, b), expected));
+		CHECK(Reference::BitEqual(a * b, expected));
+
+		Quaternion inPlace = a;
+		inPlace *= b;
+		CHECK(Reference::BitEqual(inPlace, expected));
+
+		// The product applies b then a
+		const Quaternion ra = random.Rotation();
+		const Quaternion rb = random.Rotation();
+		CHECK(Near(ToMatrix(ra * rb), Reference::Multiply(ToMatrix(ra), ToMatrix(rb)), 1e-5f));
+	}
+
+	// Basis products, i * j = k, j * k = i, k * i = j, i * i = -1
+	const Quaternion i(1.f, 0.f, 0.f, 0.f), j(0.f, 1.f, 0.f, 0.f), k(0.f, 0.f, 1.f, 0.f);
+
+	CHECK(Quaternion::Multiply(i, j) == k);
+	CHECK(Quaternion::Multiply(j, k) == i);
+	CHECK(Quaternion::Multiply(k, i) == j);
+	CHECK(Quaternion::Multiply(j, i) == Quaternion(0.f, 0.f, -1.f, 0.f));
+	CHECK(Quaternion::Multiply(i, i) == Quaternion(0.f, 0.f, 0.f, -1.f));
+}
+
+TEST(QuaternionEuler)
+{
+	Reference::Random random;
+
+	bool fromEuler = true, roundTrip = true, inRange = true;
+
+	for (int i = 0; i < Iterations; i++)
+	{
+		const Vector3 euler = random.Vec3(-3.1f, 3.1f);
+		fromEuler &= Near(ToMatrix(Quaternion::FromEuler(euler)), Reference::EulerRotation(euler), 1e-5f);
+
+		// The angles differ from the ones the rotation was made of, the rotation doesn't
+		const Quaternion q = random.Rotation();
+		const Vector3 angles = q.ToEuler();
+
+		roundTrip &= Near(ToMatrix(Quaternion::FromEuler(angles)), ToMatrix(q), 1e-5f);
+		inRange &= std::abs(angles.y) <= 1.5707964f;
+	}
+
+	CHECK(fromEuler);
+	CHECK(roundTrip);
+	CHECK(inRange);
+
+	// Angles that are their own representation
+	const Vector3 euler(.3f, -1.2f, 2.5f);
+	const Vector3 angles = Quaternion::FromEuler(euler).ToEuler();
+	CHECK_NEAR(angles.x, euler.x, 1e-5f);
+	CHECK_NEAR(angles.y, euler.y, 1e-5f);
+	CHECK_NEAR(angles.z, euler.z, 1e-5f);
+
+	// Gimbal lock, only the sum or the difference of the angles around X and Z is known
+	for (const float y : { 1.5707964f, -1.5707964f })
+	{
+		const Quaternion q = Quaternion::FromEuler(Vector3(.4f, y, -.7f));
+		const Vector3 angles = q.ToEuler();
+
+		CHECK(Near(ToMatrix(Quaternion::FromEuler(angles)), ToMatrix(q), 1e-5f));
+		CHECK_NEAR(std::abs(angles.y), 1.5707964f, 1e-3f);
+	}
+}
+
+TEST(QuaternionFromMatrix)
+{
+	Reference::Random random;
+
+	// Shepperd's method divides by the largest of w, x, y and z, each of them is made the largest in turn
+	bool matches[4] = { true, true, true, true };
+
+	for (int i = 0; i < Iterations; i++)
+	{
+		const int largest = i % 4;
+		float components[4] = { random.Float(), random.Float(), random.Float(), random.Float() };
+		components[largest] = std::copysign(random.Float(1.f, 3.f), components[largest]);
+
+		const Quaternion q = Quaternion(components[0], components[1], components[2], components[3]).Normalize();
+
+		Matrix3x3 mat3;
+		q.ToMatrix(mat3);
+
+		matches[largest] &= SameRotation(Quaternion::FromMatrix(mat3), q, 1e-5f);
+		matches[largest] &= SameRotation(Quaternion::FromMatrix(ToMatrix(q)), q, 1e-5f);
+	}
+
+	CHECK(matches[0]);
+	CHECK(matches[1]);
+	CHECK(matches[2]);
+	CHECK(matches[3]);
+
+	// Half turns, the trace is -1
+	for (const Quaternion& q : { Quaternion(1.f, 0.f, 0.f, 0.f), Quaternion(0.f, 1.f, 0.f, 0.f), Quaternion(0.f, 0.f, 1.f, 0.f),
+		Quaternion(0.f, .6f, .8f, 0.f), Quaternion::Identity })
+	{
+		CHECK(SameRotation(Quaternion::FromMatrix(ToMatrix(q)), q, 1e-6f));
+	}
+}
+
+TEST(QuaternionSlerp)
+{
+	Reference::Random random;
+
+	bool endpoints = true, midpoints = true, speeds = true, shortest = true, normalized = true;
+
+	for (int i = 0; i < Iterations; i++)
+	{
+		const Quaternion a = random.Rotation();
+		const Quaternion b = random.Rotation();
+		const Quaternion negated(-b.x, -b.y, -b.z, -b.w);
+		const float sign = Quaternion::DotProduct(a, b) < 0.f ? -1.f : 1.f;
+
+		endpoints &= Near(Quaternion::Slerp(a, b, 0.f), a, 1e-5f);
+		endpoints &= Near(Quaternion::Slerp(a, b, 1.f), Quaternion(b.x * sign, b.y * sign, b.z * sign, b.w * sign), 1e-5f);
+
+		// Halfway on the shortest arc is the normalized sum
+		const Quaternion sum(a.x + b.x * sign, a.y + b.y * sign, a.z + b.z * sign, a.w + b.w * sign);
+		midpoints &= Near(Quaternion::Slerp(a, b, .5f), sum.Normalize(), 1e-5f);
+
+		// Constant angular speed, the angle is at most pi
+		const float t = random.Float(0.f, 1.f);
+		const Quaternion q = Quaternion::Slerp(a, b, t);
+		speeds &= std::abs(Angle(a, q) - t * Angle(a, b)) <= 1e-5f;
+
+		// Going to -b takes the same path
+		shortest &= Near(Quaternion::Slerp(a, negated, t), q, 1e-5f);
+		normalized &= std::abs(q.Norm() - 1.f) <= 1e-5f;
+	}
+
+	CHECK(endpoints);
+	CHECK(midpoints);
+	CHECK(speeds);
+	CHECK(shortest);
+	CHECK(normalized);
+
+	// Close rotations go through Nlerp
+	const Quaternion a = Quaternion::FromAxisAngle(.5f, Vector3(0.f, 1.f, 0.f));
+	const Quaternion b = Quaternion::FromAxisAngle(.51f, Vector3(0.f, 1.f, 0.f));
+	CHECK(SameRotation(Quaternion::Slerp(a, b, .5f), Quaternion::FromAxisAngle(.505f, Vector3(0.f, 1.f, 0.f)), 1e-6f));
+	CHECK(Near(Quaternion::Slerp(a, a, .3f), a, 1e-6f));
+}
+
+TEST(QuaternionNlerp)
+{
+	Reference::Random random;
+
+	bool endpoints = true, midpoints = true, monotonic = true, shortest = true, normalized = true;
+
+	for (int i = 0; i < Iterations; i++)
+	{
+		const Quaternion a = random.Rotation();
+		const Quaternion b = random.Rotation();
+		const Quaternion negated(-b.x, -b.y, -b.z, -b.w);
+
+		endpoints &= Near(Quaternion::Nlerp(a, b, 0.f), a, 1e-6f);
+		endpoints &= SameRotation(Quaternion::Nlerp(a, b, 1.f), b, 1e-6f);
+
+		// Both interpolations are symmetric, they meet halfway
+		midpoints &= Near(Quaternion::Nlerp(a, b, .5f), Quaternion::Slerp(a, b, .5f), 1e-5f);
+
+		// The angular speed isn't constant but the rotation still goes from a to b
+		const float t0 = random.Float(0.f, .5f);
+		const float t1 = t0 + random.Float(.01f, .5f);
+		const Quaternion q0 = Quaternion::Nlerp(a, b, t0);
+		const Quaternion q1 = Quaternion::Nlerp(a, b, t1);
+		monotonic &= Angle(a, q0) <= Angle(a, q1) + 1e-4f && Angle(q1, b) <= Angle(q0, b) + 1e-4f;
+
+		shortest &= Near(Quaternion::Nlerp(a, negated, t0), q0, 1e-6f);
+		normalized &= std::abs(q0.Norm() - 1.f) <= 1e-6f;
+	}
+
+	CHECK(endpoints);
+	CHECK(midpoints);
+	CHECK(monotonic);
+	CHECK(shortest);
+	CHECK(normalized);
+}
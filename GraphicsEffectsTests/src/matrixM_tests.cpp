@@ -0,0 +1,306 @@
+#include "test.hpp"
+#include "maths_reference.hpp"
+
+#include <utility>
+#include <vector>
+
+#include "core/maths/matrixM.h"
+#include "core/thread_pool.hpp"
+
+// The blocked product is checked against a double precision triple loop, on shapes that aren't multiples of the
+// SIMD widths nor of the cache blocks, on the calling thread and spread over a pool.
+// The storage tests use 5 columns, so every row is followed by 3 values of padding that must stay 0
+
+static MatrixM RandomMatrix(Reference::Random& random, const uint32_t columns, const uint32_t rows)
+{
+	MatrixM mat(columns, rows, 0.f);
+
+	for (uint32_t i = 0; i < rows; i++)
+	{
+		for (uint32_t j = 0; j < columns; j++)
+			mat[i][j] = random.Float();
+	}
+
+	return mat;
+}
+
+static bool IsPaddingZero(const MatrixM& mat)
+{
+	bool zero = true;
+
+	for (uint32_t i = 0; i < mat.GetNbrRows(); i++)
+	{
+		const float* row = mat.Data() + static_cast<size_t>(i) * mat.GetStride();
+
+		for (uint32_t j = mat.GetNbrColumns(); j < mat.GetStride(); j++)
+			zero &= row[j] == 0.f;
+	}
+
+	return zero;
+}
+
+/// <summary>
+/// Checks lhs * rhs against the product in double precision, every value within the rounding bound of a float dot product
+/// </summary>
+static bool MatchesReference(const MatrixM& lhs, const MatrixM& rhs, const MatrixM& product)
+{
+	const uint32_t rows = lhs.GetNbrRows();
+	const uint32_t depth = lhs.GetNbrColumns();
+	const uint32_t columns = rhs.GetNbrColumns();
+
+	if (product.GetNbrRows() != rows || product.GetNbrColumns() != columns)
+		return false;
+
+	bool matches = true;
+
+	for (uint32_t i = 0; i < rows; i++)
+	{
+		for (uint32_t j = 0; j < columns; j++)
+		{
+			double sum = 0., absSum = 0.;
+
+			for (uint32_t k = 0; k < depth; k++)
+			{
+				sum += static_cast<double>(lhs[i][k]) * rhs[k][j];
+				absSum += std::abs(static_cast<double>(lhs[i][k]) * rhs[k][j]);
+			}
+
+			matches &= std::abs(product[i][j] - sum) <= depth * 1.2e-7 * absSum + 1e-30;
+		}
+	}
+
+	return matches;
+}
+
+TEST(MatrixMMultiply)
+{
+	Reference::Random random;
+	ThreadPool pool(3);
+
+	struct Shape
+	{
+		uint32_t rows, depth, columns;
+	};
+
+	// The last two are above the threshold for the pool and have several blocks of rows
+	for (const Shape shape : { Shape{ 1, 1, 1 }, Shape{ 3, 5, 7 }, Shape{ 130, 70, 513 }, Shape{ 257, 1030, 3 } })
+	{
+		const MatrixM lhs = RandomMatrix(random, shape.depth, shape.rows);
+		const MatrixM rhs = RandomMatrix(random, shape.columns, shape.depth);
+
+		MatrixM product(lhs);
+		product.Multiply(rhs);
+
+		CHECK(MatchesReference(lhs, rhs, product));
+		CHECK(IsPaddingZero(product));
+
+		// Every block of rows runs the same code whichever thread it is on
+		MatrixM pooled(lhs);
+		pooled.Multiply(rhs, &pool);
+
+		CHECK(pooled.GetNbrRows() == product.GetNbrRows() && pooled.GetNbrColumns() == product.GetNbrColumns());
+		CHECK(std::memcmp(pooled.Data(), product.Data(), sizeof(float) * product.GetStride() * product.GetNbrRows()) == 0);
+	}
+}
+
+TEST(MatrixMAddScaled)
+{
+	Reference::Random random;
+
+	// Every count around the SIMD widths, from aligned and unaligned addresses
+	for (uint32_t offset = 0; offset < 4; offset++)
+	{
+		for (uint32_t count = 0; count <= 20; count++)
+		{
+			std::vector<float> dst(offset + count + 1), src(offset + count);
+			for (float& v : dst)
+				v = random.Float();
+			for (float& v : src)
+				v = random.Float();
+
+			const float scale = random.Float(-4.f, 4.f);
+			const std::vector<float> before = dst;
+
+			MatrixM::AddScaled(dst.data() + offset, src.data() + offset, scale, count);
+
+			bool matches = true;
+			for (uint32_t j = 0; j < count; j++)
+				matches &= std::abs(dst[offset + j] - (before[offset + j] + scale * src[offset + j])) <= 1e-6f;
+
+			CHECK(matches);
+
+			// Nothing is written around the range
+			for (uint32_t j = 0; j < offset; j++)
+				CHECK(dst[j] == before[j]);
+			CHECK(dst[offset + count] == before[offset + count]);
+		}
+	}
+}
+
+/// <summary>
+/// Matrix whose value at (i, j) is 10 * i + j + 1, so every value is different and not 0
+/// </summary>
+static MatrixM IndexedMatrix(const uint32_t columns, const uint32_t rows)
+{
+	MatrixM mat(columns, rows, 0.f);
+
+	for (uint32_t i = 0; i < rows; i++)
+	{
+		for (uint32_t j = 0; j < columns; j++)
+			mat[i][j] = static_cast<float>(10 * i + j + 1);
+	}
+
+	return mat;
+}
+
+static bool IsIndexed(const MatrixM& mat, const float scale, const float offset)
+{
+	bool indexed = true;
+
+	for (uint32_t i = 0; i < mat.GetNbrRows(); i++)
+	{
+		for (uint32_t j = 0; j < mat.GetNbrColumns(); j++)
+			indexed &= mat[i][j] == static_cast<float>(10 * i + j + 1) * scale + offset;
+	}
+
+	return indexed;
+}
+
+TEST(MatrixMStorage)
+{
+	const MatrixM filled(5, 3, 2.f);
+	CHECK(filled.GetStride() == 8);
+	CHECK(IsPaddingZero(filled));
+	CHECK(filled[2][4] == 2.f);
+
+	const MatrixM listed(5, 2, { 1.f, 2.f, 3.f, 4.f, 5.f, 11.f, 12.f, 13.f, 14.f, 15.f });
+	CHECK(IsIndexed(listed, 1.f, 0.f));
+	CHECK(IsPaddingZero(listed));
+}
+
+TEST(MatrixMElementWise)
+{
+	// Every row is updated, not only the first one, and the padding stays 0
+	MatrixM mat = IndexedMatrix(5, 3);
+
+	mat.Negate();
+	CHECK(IsIndexed(mat, -1.f, 0.f));
+	CHECK(IsPaddingZero(mat));
+
+	mat.Multiply(-2.f);
+	CHECK(IsIndexed(mat, 2.f, 0.f));
+	CHECK(IsPaddingZero(mat));
+
+	mat.Add(3.f);
+	CHECK(IsIndexed(mat, 2.f, 3.f));
+	CHECK(IsPaddingZero(mat));
+
+	mat.Add(IndexedMatrix(5, 3));
+	CHECK(IsIndexed(mat, 3.f, 3.f));
+	CHECK(IsPaddingZero(mat));
+}
+
+TEST(MatrixMTranspose)
+{
+	const MatrixM mat = IndexedMatrix(5, 3);
+
+	MatrixM transposed;
+	mat.Transpose(transposed);
+
+	CHECK(transposed.GetNbrColumns() == 3 && transposed.GetNbrRows() == 5);
+	CHECK(IsPaddingZero(transposed));
+
+	bool matches = true;
+	for (uint32_t i = 0; i < 3; i++)
+	{
+		for (uint32_t j = 0; j < 5; j++)
+			matches &= transposed[j][i] == mat[i][j];
+	}
+
+	CHECK(matches);
+
+	// The product of a matrix by its transpose has the shape of the rows
+	MatrixM product(mat);
+	product.Multiply(transposed);
+
+	CHECK(product.GetNbrColumns() == 3 && product.GetNbrRows() == 3);
+	CHECK(MatchesReference(mat, transposed, product));
+	CHECK(IsPaddingZero(product));
+}
+
+TEST(MatrixMCopyAndMove)
+{
+	const MatrixM source = IndexedMatrix(5, 3);
+
+	// Copies don't share the values
+	MatrixM copy(source);
+	CHECK(copy.Data() != source.Data());
+	copy[1][2] = -1.f;
+	CHECK(IsIndexed(source, 1.f, 0.f));
+
+	MatrixM assigned;
+	assigned = source;
+	CHECK(assigned.Data() != source.Data());
+	assigned[2][4] = -1.f;
+	CHECK(IsIndexed(source, 1.f, 0.f));
+	CHECK(IsPaddingZero(assigned));
+
+	// Moves take the values and leave an empty matrix behind
+	MatrixM moved(std::move(copy));
+	CHECK(moved[1][2] == -1.f);
+	CHECK(copy.GetNbrColumns() == 0 && copy.GetNbrRows() == 0 && copy.GetStride() == 0);
+	CHECK(copy.Data() == nullptr);
+
+	MatrixM moveAssigned(2, 2, 1.f);
+	moveAssigned = std::move(assigned);
+	CHECK(moveAssigned.GetNbrColumns() == 5 && moveAssigned.GetNbrRows() == 3);
+	CHECK(moveAssigned[2][4] == -1.f);
+	CHECK(assigned.GetNbrColumns() == 0 && assigned.GetNbrRows() == 0 && assigned.Data() == nullptr);
+}
+
+TEST(MatrixMViews)
+{
+	MatrixM mat = IndexedMatrix(5, 3);
+
+	// Rows
+	const ConstVectorView row = std::as_const(mat).GetRow(1);
+	CHECK(row.Size() == 5);
+	CHECK(row[0] == 11.f && row[4] == 15.f && row[-1] == 15.f);
+
+	mat.GetRow(2)[3] = -1.f;
+	CHECK(mat[2][3] == -1.f);
+	mat[2][3] = 24.f;
+
+	// A block reads and writes the values it covers, and nothing else
+	const MatrixView block = mat.Block(1, 1, 3, 2);
+	CHECK(block.GetNbrColumns() == 3 && block.GetNbrRows() == 2 && block.GetStride() == mat.GetStride());
+	CHECK(block[0][0] == 12.f && block[1][2] == 24.f);
+
+	for (uint32_t i = 0; i < 2; i++)
+	{
+		for (uint32_t j = 0; j < 3; j++)
+			block[i][j] = 0.f;
+	}
+
+	bool outside = true;
+	for (uint32_t i = 0; i < 3; i++)
+	{
+		for (uint32_t j = 0; j < 5; j++)
+		{
+			const bool inside = i >= 1 && j >= 1 && j <= 3;
+			outside &= mat[i][j] == (inside ? 0.f : static_cast<float>(10 * i + j + 1));
+		}
+	}
+
+	CHECK(outside);
+	CHECK(IsPaddingZero(mat));
+
+	// Nested blocks and copies of a block
+	const ConstMatrixView corner = std::as_const(mat).Block(3, 0, 2, 3).Block(1, 1, 1, 2);
+	CHECK(corner[0][0] == 15.f && corner[1][0] == 25.f);
+
+	const MatrixM copied(corner);
+	CHECK(copied.GetNbrColumns() == 1 && copied.GetNbrRows() == 2);
+	CHECK(copied[0][0] == 15.f && copied[1][0] == 25.f);
+	CHECK(IsPaddingZero(copied));
+}
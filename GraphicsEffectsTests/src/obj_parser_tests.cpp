@@ -0,0 +1,307 @@
+#include "test.hpp"
+#include "maths_reference.hpp"
+
+#include <string>
+
+#include "resources/obj_parser.hpp"
+#include "core/thread_pool.hpp"
+
+// The text is split in chunks of at least 64 KiB, one per pool worker and one for the calling thread,
+// every input is parsed with several pool sizes and must give the same result with all of them
+
+static bool VertexEqual(const Vertex& a, const Vertex& b)
+{
+	return Reference::BitEqual(a.Position.x, b.Position.x) && Reference::BitEqual(a.Position.y, b.Position.y)
+		&& Reference::BitEqual(a.Position.z, b.Position.z) && Reference::BitEqual(a.Uv.x, b.Uv.x) && Reference::BitEqual(a.Uv.y, b.Uv.y)
+		&& Reference::BitEqual(a.Normal.x, b.Normal.x) && Reference::BitEqual(a.Normal.y, b.Normal.y) && Reference::BitEqual(a.Normal.z, b.Normal.z);
+}
+
+/// <summary>
+/// Parses the text on 1 to 7 threads, checks that the results are identical and returns the single threaded one
+/// </summary>
+static bool ParseAll(const std::string& text, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)
+{
+	const bool valid = ObjParser::Parse(text.data(), text.size(), vertices, indices);
+
+	for (const uint32_t workerCount : { 1u, 3u, 6u })
+	{
+		ThreadPool pool(workerCount);
+
+		std::vector<Vertex> threadedVertices;
+		std::vector<uint32_t> threadedIndices;
+		const bool threadedValid = ObjParser::Parse(text.data(), text.size(), threadedVertices, threadedIndices, &pool);
+
+		CHECK(threadedValid == valid);
+		CHECK(threadedIndices == indices);
+		CHECK(threadedVertices.size() == vertices.size());
+
+		bool identical = true;
+		for (size_t i = 0; i < vertices.size() && i < threadedVertices.size(); i++)
+			identical &= VertexEqual(threadedVertices[i], vertices[i]);
+
+		CHECK(identical);
+	}
+
+	// Nothing is left behind by a failed parse
+	if (!valid)
+		CHECK(vertices.empty() && indices.empty());
+
+	return valid;
+}
+
+/// <summary>
+/// Comment lines, enough of them to split the text in several chunks
+/// </summary>
+static std::string Padding(const size_t size)
+{
+	const std::string line = "# " + std::string(61, '-') + "\n";
+
+	std::string padding;
+	while (padding.size() < size)
+		padding += line;
+
+	return padding;
+}
+
+static const char* const Square =
+	"v 0 0 0\n"
+	"v 1 0 0\n"
+	"v 1 1 0\n"
+	"v 0 1 0\n"
+	"vt 0 0\n"
+	"vt 1 0\n"
+	"vt 1 .25\n"
+	"vn 0 0 1\n"
+	"vn 0 0 -1\n";
+
+TEST(ObjParserCornerForms)
+{
+	const std::string text = std::string(Square)
+		+ "f 1 2 3\n"
+		+ "f 1/1 2/2 3/3\n"
+		+ "f 1//1 2//1 3//1\n"
+		+ "f 1/1/2 2/2/2 3/3/2\n";
+
+	std::vector<Vertex> vertices;
+	std::vector<uint32_t> indices;
+	const bool valid = ParseAll(text, vertices, indices);
+
+	CHECK(valid);
+	CHECK(vertices.size() == 12);
+	CHECK(indices.size() == 12);
+
+	if (!valid || vertices.size() != 12 || indices.size() != 12)
+		return;
+
+	for (uint32_t i = 0; i < 12; i++)
+		CHECK(indices[i] == i);
+
+	const Vector3 positions[] = { Vector3(0.f, 0.f, 0.f), Vector3(1.f, 0.f, 0.f), Vector3(1.f, 1.f, 0.f) };
+	// The v coordinate is flipped
+	const Vector2 uvs[] = { Vector2(0.f, 1.f), Vector2(1.f, 1.f), Vector2(1.f, .75f) };
+
+	for (uint32_t face = 0; face < 4; face++)
+	{
+		for (uint32_t corner = 0; corner < 3; corner++)
+		{
+			const Vector2 uv = face == 1 || face == 3 ? uvs[corner] : Vector2();
+			const Vector3 normal = face == 2 ? Vector3(0.f, 0.f, 1.f) : face == 3 ? Vector3(0.f, 0.f, -1.f) : Vector3();
+
+			CHECK(VertexEqual(vertices[face * 3 + corner], Vertex(positions[corner], uv, normal)));
+		}
+	}
+}
+
+TEST(ObjParserFanTriangulation)
+{
+	const std::string text = std::string(Square) + "v .5 1.5 0\n" + "f 1/1 2/2 3/3 4/1 5/2\n";
+
+	std::vector<Vertex> vertices;
+	std::vector<uint32_t> indices;
+
+	CHECK(ParseAll(text, vertices, indices));
+	CHECK(vertices.size() == 5);
+	CHECK((indices == std::vector<uint32_t>{ 0, 1, 2, 0, 2, 3, 0, 3, 4 }));
+
+	// Too few corners
+	CHECK(!ParseAll(std::string(Square) + "f 1 2\n", vertices, indices));
+	CHECK(!ParseAll(std::string(Square) + "f \n", vertices, indices));
+}
+
+TEST(ObjParserDeduplication)
+{
+	// Two triangles sharing an edge, then the same corners written with negative indices
+	const std::string text = std::string(Square)
+		+ "f 1/1/1 2/2/1 3/3/1\n"
+		+ "f 1/1/1 3/3/1 4/1/1\n"
+		+ "f -4/-3/-2 -2/-1/-2 -1/-3/-2\n"
+		// Same positions, other uvs or normals
+		+ "f 1/2/1 2/2/1 3/3/2\n"
+		+ "f 1 2//1 3/3\n";
+
+	std::vector<Vertex> vertices;
+	std::vector<uint32_t> indices;
+
+	CHECK(ParseAll(text, vertices, indices));
+	CHECK((indices == std::vector<uint32_t>{ 0, 1, 2, 0, 2, 3, 0, 2, 3, 4, 1, 5, 6, 7, 8 }));
+	CHECK(vertices.size() == 9);
+}
+
+TEST(ObjParserStatements)
+{
+	// Statements that are skipped or tolerated
+	const std::string accepted =
+		"# comment\r\n"
+		"mtllib room.mtl\r\n"
+		"o room\r\n"
+		"v 1 2 3 1\r\n"
+		"v +1.5 -2e1 .5\r\n"
+		"  v\t-1 0 1\r\n"
+		"vt 0.5 0.5 0\r\n"
+		"vn 0 1 0\r\n"
+		"usemtl wood\r\n"
+		"s off\r\n"
+		"g group\r\n"
+		"f 1/1/1 2/1/1 3/1/1\r\n"
+		"\r\n"
+		"f 3/1/1 2/1/1 1/1/1";
+
+	std::vector<Vertex> vertices;
+	std::vector<uint32_t> indices;
+	const bool valid = ParseAll(accepted, vertices, indices);
+
+	CHECK(valid);
+	CHECK(vertices.size() == 3);
+	CHECK((indices == std::vector<uint32_t>{ 0, 1, 2, 2, 1, 0 }));
+
+	if (valid && vertices.size() == 3)
+	{
+		CHECK(VertexEqual(vertices[0], Vertex(Vector3(1.f, 2.f, 3.f), Vector2(.5f, .5f), Vector3(0.f, 1.f, 0.f))));
+		CHECK(VertexEqual(vertices[1], Vertex(Vector3(1.5f, -20.f, .5f), Vector2(.5f, .5f), Vector3(0.f, 1.f, 0.f))));
+		CHECK(VertexEqual(vertices[2], Vertex(Vector3(-1.f, 0.f, 1.f), Vector2(.5f, .5f), Vector3(0.f, 1.f, 0.f))));
+	}
+
+	const char* const malformed[] =
+	{
+		"v 1 2\n",
+		"v 1 x 3\n",
+		"vt 1\n",
+		"vn 0 1\n",
+		"f 0 1 2\n",
+		"f 1/a 2 3\n",
+		"f 1// 2 3\n",
+		"f 1/1/ 2 3\n",
+		"f 1 2 3x\n",
+		"f 99999999999 1 2\n",
+	};
+
+	for (const char* const statement : malformed)
+		CHECK(!ParseAll(std::string(Square) + "f 1 2 3\n" + statement, vertices, indices));
+
+	// A malformed statement in any chunk fails the whole file
+	CHECK(!ParseAll(std::string(Square) + Padding(512 * 1024) + "v 1 2\n" + Padding(512 * 1024) + "f 1 2 3\n", vertices, indices));
+
+	CHECK(!ObjParser::Parse(nullptr, 0, vertices, indices));
+	CHECK(!ParseAll("", vertices, indices));
+}
+
+TEST(ObjParserOutOfRange)
+{
+	std::vector<Vertex> vertices;
+	std::vector<uint32_t> indices;
+
+	const char* const faces[] =
+	{
+		"f 1 2 5\n",
+		"f -5 1 2\n",
+		"f 1/4 2/1 3/1\n",
+		"f 1/-4 2/1 3/1\n",
+		"f 1//3 2//1 3//1\n",
+		"f 1/1/-3 2/1/1 3/1/1\n",
+	};
+
+	for (const char* const face : faces)
+		CHECK(!ParseAll(std::string(Square) + face, vertices, indices));
+
+	// Faces can't refer to attributes declared after them, in the same chunk or in a later one
+	CHECK(!ParseAll(std::string("v 0 0 0\nv 1 0 0\nf 1 2 3\nv 1 1 0\n"), vertices, indices));
+	CHECK(!ParseAll(std::string("v 0 0 0\nv 1 0 0\nv 1 1 0\nf 1/1 2/1 3/1\nvt 0 0\n"), vertices, indices));
+	CHECK(!ParseAll("f 1 2 3\n" + Padding(512 * 1024) + Square, vertices, indices));
+	CHECK(!ParseAll(std::string("v 0 0 0\nv 1 0 0\n") + Padding(512 * 1024) + "f 1 2 3\n" + Padding(512 * 1024) + "v 1 1 0\n", vertices, indices));
+
+	// Declared before the face in a previous chunk
+	CHECK(ParseAll(std::string(Square) + Padding(512 * 1024) + "f 1 2 3\nf -4 -3 -2\n", vertices, indices));
+	CHECK(vertices.size() == 3);
+}
+
+TEST(ObjParserChunks)
+{
+	Reference::Random random;
+
+	// Small blocks of attributes followed by faces using negative indices, some reaching a few blocks back,
+	// and absolute indices to any previous attribute, over enough text to make several chunks
+	std::string text;
+	std::vector<uint32_t> expected;
+	uint32_t count = 0;
+
+	const auto corner = [&](const uint32_t index, const bool negative)
+		{
+			expected.push_back(index);
+			const std::string value = negative ? std::to_string(static_cast<int32_t>(index) - static_cast<int32_t>(count)) : std::to_string(index + 1);
+			return " " + value + "/" + value + "/" + value;
+		};
+
+	while (text.size() < 2 * 1024 * 1024)
+	{
+		for (uint32_t i = 0; i < 3; i++, count++)
+		{
+			text += "v " + std::to_string(count) + " " + std::to_string(count % 7) + " -" + std::to_string(count % 11) + "\n";
+			text += "vt " + std::to_string(count % 16) + " 0.5\n";
+			text += "vn 0 " + std::to_string(count % 5) + " 1\n";
+		}
+
+		text += "f" + corner(count - 3, true);
+		text += corner(count - 2, true);
+		text += corner(count - 1, true) + "\n";
+
+		// Reaching back across lines of padding, likely in a previous chunk
+		const uint32_t back = static_cast<uint32_t>(random.Float(0.f, static_cast<float>(count - 2)));
+		const uint32_t far = static_cast<uint32_t>(random.Float(0.f, static_cast<float>(count)));
+		text += "f" + corner(back, true);
+		text += corner(back + 1, false);
+		text += corner(far, random.Float() < 0.f) + "\n";
+		text += Padding(random.Float() < .9f ? 0 : 4096);
+	}
+
+	std::vector<Vertex> vertices;
+	std::vector<uint32_t> indices;
+	const bool valid = ParseAll(text, vertices, indices);
+
+	CHECK(valid);
+	CHECK(indices.size() == expected.size());
+
+	if (!valid || indices.size() != expected.size())
+		return;
+
+	// Every corner refers to the attributes of the expected triplet, and every triplet is only stored once
+	bool matches = true;
+	std::vector<int32_t> unique(count, -1);
+
+	for (size_t i = 0; i < indices.size(); i++)
+	{
+		const uint32_t index = expected[i];
+		const Vertex& vertex = vertices[indices[i]];
+
+		matches &= VertexEqual(vertex, Vertex(
+			Vector3(static_cast<float>(index), static_cast<float>(index % 7), -static_cast<float>(index % 11)),
+			Vector2(static_cast<float>(index % 16), .5f),
+			Vector3(0.f, static_cast<float>(index % 5), 1.f)
+		));
+
+		matches &= unique[index] == -1 || unique[index] == static_cast<int32_t>(indices[i]);
+		unique[index] = static_cast<int32_t>(indices[i]);
+	}
+
+	CHECK(matches);
+	CHECK(vertices.size() == static_cast<size_t>(std::count_if(unique.begin(), unique.end(), [](const int32_t v) { return v != -1; })));
+}
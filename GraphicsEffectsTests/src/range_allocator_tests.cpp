@@ -0,0 +1,189 @@
+#include "test.hpp"
+
+#include <random>
+
+#include "core/data_structures/range_allocator.hpp"
+
+TEST(RangeAllocatorFirstFit)
+{
+	RangeAllocator allocator(100);
+
+	CHECK(allocator.Allocate(10) == 0);
+	CHECK(allocator.Allocate(20) == 10);
+	CHECK(allocator.Allocate(30) == 30);
+	CHECK(allocator.GetFreeSize() == 40);
+	CHECK(allocator.GetFreeRangeCount() == 1);
+
+	// The hole left by the first range is reused before the end of the space
+	allocator.Free(0, 10);
+	CHECK(allocator.GetFreeRangeCount() == 2);
+	CHECK(allocator.Allocate(4) == 0);
+	CHECK(allocator.Allocate(6) == 4);
+	CHECK(allocator.GetFreeRangeCount() == 1);
+
+	// Too large for the hole
+	allocator.Free(10, 20);
+	CHECK(allocator.Allocate(25) == 60);
+	CHECK(allocator.Allocate(20) == 10);
+	CHECK(allocator.GetFreeSize() == 15);
+}
+
+TEST(RangeAllocatorCoalescing)
+{
+	RangeAllocator allocator(100);
+
+	uint32_t r[6];
+	for (uint32_t& offset : r)
+		offset = allocator.Allocate(10);
+
+	// r0 r1 r2 r3 r4 r5 [free]
+	allocator.Free(r[1], 10);
+	CHECK(allocator.GetFreeRangeCount() == 2);
+
+	// Merged with the previous free range only
+	allocator.Free(r[2], 10);
+	CHECK(allocator.GetFreeRangeCount() == 2);
+
+	// Not touching any free range
+	allocator.Free(r[4], 10);
+	CHECK(allocator.GetFreeRangeCount() == 3);
+
+	// Merged with both
+	allocator.Free(r[3], 10);
+	CHECK(allocator.GetFreeRangeCount() == 2);
+
+	// Merged with the next free range only
+	allocator.Free(r[0], 10);
+	CHECK(allocator.GetFreeRangeCount() == 2);
+	CHECK(allocator.GetFreeSize() == 90);
+
+	// The space is whole again
+	allocator.Free(r[5], 10);
+	CHECK(allocator.GetFreeRangeCount() == 1);
+	CHECK(allocator.GetFreeSize() == 100);
+	CHECK(allocator.Allocate(100) == 0);
+}
+
+TEST(RangeAllocatorFull)
+{
+	RangeAllocator allocator(64);
+
+	CHECK(allocator.Allocate(65) == RangeAllocator::InvalidOffset);
+	CHECK(allocator.GetFreeSize() == 64);
+
+	for (uint32_t i = 0; i < 8; i++)
+		CHECK(allocator.Allocate(8) == i * 8);
+
+	CHECK(allocator.GetFreeSize() == 0);
+	CHECK(allocator.GetFreeRangeCount() == 0);
+	CHECK(allocator.Allocate(1) == RangeAllocator::InvalidOffset);
+
+	// Enough free space in total, but fragmented
+	for (uint32_t i = 0; i < 8; i += 2)
+		allocator.Free(i * 8, 8);
+
+	CHECK(allocator.GetFreeSize() == 32);
+	CHECK(allocator.GetFreeRangeCount() == 4);
+	CHECK(allocator.Allocate(9) == RangeAllocator::InvalidOffset);
+	CHECK(allocator.GetFreeSize() == 32);
+	CHECK(allocator.Allocate(8) == 0);
+
+	RangeAllocator empty(0);
+	CHECK(empty.GetFreeRangeCount() == 0);
+	CHECK(empty.Allocate(1) == RangeAllocator::InvalidOffset);
+}
+
+TEST(RangeAllocatorZeroSize)
+{
+	RangeAllocator allocator(32);
+
+	// Empty ranges take no space, wherever they are freed
+	CHECK(allocator.Allocate(0) == 0);
+	CHECK(allocator.GetFreeSize() == 32);
+	CHECK(allocator.GetFreeRangeCount() == 1);
+
+	const uint32_t a = allocator.Allocate(8);
+	const uint32_t b = allocator.Allocate(8);
+	allocator.Free(a, 8);
+
+	allocator.Free(0, 0);
+	allocator.Free(b, 0);
+	allocator.Free(b + 8, 0);
+	CHECK(allocator.GetFreeSize() == 24);
+	CHECK(allocator.GetFreeRangeCount() == 2);
+
+	allocator.Free(b, 8);
+	CHECK(allocator.GetFreeRangeCount() == 1);
+	CHECK(allocator.Allocate(32) == 0);
+
+	// Still valid once the space is full
+	CHECK(allocator.Allocate(0) == 0);
+	allocator.Free(0, 0);
+	CHECK(allocator.GetFreeSize() == 0);
+	CHECK(allocator.GetFreeRangeCount() == 0);
+
+	RangeAllocator empty(0);
+	CHECK(empty.Allocate(0) == 0);
+}
+
+TEST(RangeAllocatorRandom)
+{
+	constexpr uint32_t Capacity = 4096;
+
+	std::mt19937 engine(42);
+	RangeAllocator allocator(Capacity);
+
+	// Owner of every element, to check that the ranges never overlap
+	std::vector<int32_t> owners(Capacity, -1);
+	std::vector<std::pair<uint32_t, uint32_t>> ranges;
+	uint32_t used = 0;
+
+	for (int32_t step = 0; step < 20000; step++)
+	{
+		if (ranges.empty() || std::uniform_int_distribution<int32_t>(0, 2)(engine) != 0)
+		{
+			const uint32_t size = std::uniform_int_distribution<uint32_t>(1, 64)(engine);
+			const uint32_t offset = allocator.Allocate(size);
+
+			if (offset == RangeAllocator::InvalidOffset)
+			{
+				CHECK(size > Capacity - used || allocator.GetFreeRangeCount() > 1);
+				continue;
+			}
+
+			CHECK(offset + size <= Capacity);
+
+			bool free = true;
+			for (uint32_t i = offset; i < offset + size && i < Capacity; i++)
+			{
+				free &= owners[i] == -1;
+				owners[i] = step;
+			}
+
+			CHECK(free);
+			ranges.emplace_back(offset, size);
+			used += size;
+		}
+		else
+		{
+			const size_t index = std::uniform_int_distribution<size_t>(0, ranges.size() - 1)(engine);
+			const auto [offset, size] = ranges[index];
+
+			for (uint32_t i = offset; i < offset + size; i++)
+				owners[i] = -1;
+
+			allocator.Free(offset, size);
+			ranges[index] = ranges.back();
+			ranges.pop_back();
+			used -= size;
+		}
+
+		CHECK(allocator.GetFreeSize() == Capacity - used);
+	}
+
+	for (const auto& [offset, size] : ranges)
+		allocator.Free(offset, size);
+
+	CHECK(allocator.GetFreeSize() == Capacity);
+	CHECK(allocator.GetFreeRangeCount() == 1);
+}
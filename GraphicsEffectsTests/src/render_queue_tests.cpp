@@ -0,0 +1,147 @@
+#include "test.hpp"
+#include "maths_reference.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "renderer/render_queue.hpp"
+
+// The radix sort is checked against std::stable_sort on the keys, every packet points to its submission index
+// so the order of the packets sharing a key is checked too
+
+static DrawPacket MakePacket(const uint64_t key, const size_t index)
+{
+	return DrawPacket{ key, reinterpret_cast<Object*>(index + 1) };
+}
+
+static bool SortsLikeStableSort(std::vector<DrawPacket> packets)
+{
+	std::vector<DrawPacket> expected = packets;
+	std::stable_sort(expected.begin(), expected.end(), [](const DrawPacket& a, const DrawPacket& b) { return a.Key < b.Key; });
+
+	std::vector<DrawPacket> scratch;
+	RenderQueue::RadixSort(packets, scratch);
+
+	if (packets.size() != expected.size())
+		return false;
+
+	bool matches = true;
+
+	for (size_t i = 0; i < packets.size(); i++)
+		matches &= packets[i].Key == expected[i].Key && packets[i].Obj == expected[i].Obj;
+
+	return matches;
+}
+
+static uint32_t RandomId(Reference::Random& random, const uint32_t count)
+{
+	return std::min(static_cast<uint32_t>(random.Float(0.f, static_cast<float>(count))), count - 1);
+}
+
+TEST(RenderQueueKeyFields)
+{
+	// Every field lands on its bits
+	CHECK(RenderQueue::MakeKey(0, 0, 0, 0.f, false) == 0);
+	CHECK(RenderQueue::MakeKey(0, 0, 0, 0.f, true) == 1ull << RenderQueue::OutlineShift);
+	CHECK(RenderQueue::MakeKey(1, 0, 0, 0.f, false) == 1ull << RenderQueue::ShaderShift);
+	CHECK(RenderQueue::MakeKey(0, 1, 0, 0.f, false) == 1ull << RenderQueue::TextureShift);
+	CHECK(RenderQueue::MakeKey(0, 0, 1, 0.f, false) == 1ull << RenderQueue::ModelShift);
+	CHECK(RenderQueue::MakeKey(0, 0, 0, 1.f, false) == ((1ull << RenderQueue::DepthBits) - 1) << RenderQueue::DepthShift);
+
+	// Ids are cut to their bits instead of spilling on the next field
+	constexpr uint32_t maxId = (1u << RenderQueue::IdBits) - 1;
+	CHECK(RenderQueue::MakeKey(maxId + 6, maxId + 6, maxId + 6, 0.f, false) == RenderQueue::MakeKey(5, 5, 5, 0.f, false));
+	CHECK(RenderQueue::MakeKey(maxId, maxId, maxId, 1.f, true) >> RenderQueue::DepthShift == (1ull << (64 - RenderQueue::DepthShift)) - 1);
+
+	// Depths outside [0, 1] are clamped
+	CHECK(RenderQueue::MakeKey(3, 2, 1, -1.f, false) == RenderQueue::MakeKey(3, 2, 1, 0.f, false));
+	CHECK(RenderQueue::MakeKey(3, 2, 1, -1e30f, false) == RenderQueue::MakeKey(3, 2, 1, 0.f, false));
+	CHECK(RenderQueue::MakeKey(3, 2, 1, 2.f, false) == RenderQueue::MakeKey(3, 2, 1, 1.f, false));
+	CHECK(RenderQueue::MakeKey(3, 2, 1, 1e30f, false) == RenderQueue::MakeKey(3, 2, 1, 1.f, false));
+	CHECK(RenderQueue::MakeKey(3, 2, 1, .25f, false) < RenderQueue::MakeKey(3, 2, 1, .5f, false));
+}
+
+TEST(RenderQueueKeyOrder)
+{
+	// Each field wins over all the ones after it : outline, shader, texture, model, then depth
+	constexpr uint32_t maxId = (1u << RenderQueue::IdBits) - 1;
+
+	CHECK(RenderQueue::MakeKey(0, 0, 0, 0.f, true) > RenderQueue::MakeKey(maxId, maxId, maxId, 1.f, false));
+	CHECK(RenderQueue::MakeKey(1, 0, 0, 0.f, false) > RenderQueue::MakeKey(0, maxId, maxId, 1.f, false));
+	CHECK(RenderQueue::MakeKey(0, 1, 0, 0.f, false) > RenderQueue::MakeKey(0, 0, maxId, 1.f, false));
+	CHECK(RenderQueue::MakeKey(0, 0, 1, 0.f, false) > RenderQueue::MakeKey(0, 0, 0, 1.f, false));
+
+	Reference::Random random;
+
+	for (uint32_t i = 0; i < 1000; i++)
+	{
+		const bool outlined[] = { random.Float() < 0.f, random.Float() < 0.f };
+		const uint32_t shader[] = { RandomId(random, 4), RandomId(random, 4) };
+		const uint32_t texture[] = { RandomId(random, 4), RandomId(random, 4) };
+		const uint32_t model[] = { RandomId(random, 4), RandomId(random, 4) };
+		const float depth[] = { random.Float(0.f, 1.f), random.Float(0.f, 1.f) };
+
+		const uint64_t a = RenderQueue::MakeKey(shader[0], texture[0], model[0], depth[0], outlined[0]);
+		const uint64_t b = RenderQueue::MakeKey(shader[1], texture[1], model[1], depth[1], outlined[1]);
+
+		const bool expected = outlined[0] != outlined[1] ? outlined[0] < outlined[1]
+			: shader[0] != shader[1] ? shader[0] < shader[1]
+			: texture[0] != texture[1] ? texture[0] < texture[1]
+			: model[0] != model[1] ? model[0] < model[1]
+			: depth[0] < depth[1];
+
+		// Close depths can quantize to the same value
+		CHECK(a == b || (a < b) == expected);
+	}
+}
+
+TEST(RenderQueueRadixSort)
+{
+	Reference::Random random;
+
+	// Nothing and a single packet
+	CHECK(SortsLikeStableSort({}));
+	CHECK(SortsLikeStableSort({ MakePacket(RenderQueue::MakeKey(7, 3, 1, .5f, true), 0) }));
+
+	// Every byte is the same, no pass runs
+	std::vector<DrawPacket> packets;
+	for (size_t i = 0; i < 100; i++)
+		packets.push_back(MakePacket(RenderQueue::MakeKey(7, 3, 1, .5f, false), i));
+
+	CHECK(SortsLikeStableSort(packets));
+
+	// Only the depth changes, the passes of the id bytes are skipped
+	packets.clear();
+	for (size_t i = 0; i < 1000; i++)
+		packets.push_back(MakePacket(RenderQueue::MakeKey(7, 3, 1, random.Float(0.f, 1.f), false), i));
+
+	CHECK(SortsLikeStableSort(packets));
+
+	// Few values per field so many keys are equal, depths outside [0, 1] included
+	for (const size_t count : { 2, 3, 255, 256, 257, 5000 })
+	{
+		packets.clear();
+
+		for (size_t i = 0; i < count; i++)
+		{
+			const uint64_t key = RenderQueue::MakeKey(RandomId(random, 5), RandomId(random, 5), RandomId(random, 5),
+				static_cast<float>(RandomId(random, 8)) / 4.f - .5f, random.Float() < -.5f);
+
+			packets.push_back(MakePacket(key, i));
+		}
+
+		CHECK(SortsLikeStableSort(packets));
+	}
+
+	// Every field over its whole range
+	packets.clear();
+	for (size_t i = 0; i < 5000; i++)
+	{
+		const uint64_t key = RenderQueue::MakeKey(RandomId(random, 1u << RenderQueue::IdBits), RandomId(random, 1u << RenderQueue::IdBits),
+			RandomId(random, 1u << RenderQueue::IdBits), random.Float(-.5f, 1.5f), random.Float() < 0.f);
+
+		packets.push_back(MakePacket(key, i));
+	}
+
+	CHECK(SortsLikeStableSort(packets));
+}
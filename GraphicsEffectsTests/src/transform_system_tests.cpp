@@ -0,0 +1,217 @@
+#include "test.hpp"
+#include "maths_reference.hpp"
+
+#include "core/transform_system.hpp"
+
+// Update computes the local matrices 4 nodes at a time with SSE, then the global ones in a single pass.
+// Both are checked against Matrix4x4::TRS and the product with the global matrix of the parent.
+
+struct Node
+{
+	Vector3 Position;
+	Quaternion Rotation;
+	Vector3 Scaling;
+	int32_t Parent;
+};
+
+static Node RandomNode(Reference::Random& random, const int32_t parent)
+{
+	return Node{ random.Vec3(-5.f, 5.f), random.Rotation(), random.Vec3(.5f, 2.f), parent };
+}
+
+/// <summary>
+/// Random forest in topological order, every node is a root or the child of any previous node
+/// </summary>
+static std::vector<Node> RandomForest(Reference::Random& random, const uint32_t count)
+{
+	std::vector<Node> nodes;
+
+	for (uint32_t i = 0; i < count; i++)
+	{
+		const int32_t parent = static_cast<int32_t>(std::floor(random.Float(-1.f, static_cast<float>(i))));
+		nodes.push_back(RandomNode(random, std::max(parent, -1)));
+	}
+
+	return nodes;
+}
+
+static std::vector<Matrix4x4> ExpectedGlobals(const std::vector<Node>& nodes)
+{
+	std::vector<Matrix4x4> globals(nodes.size());
+
+	for (size_t i = 0; i < nodes.size(); i++)
+	{
+		Matrix4x4 local;
+		Matrix4x4::TRS(nodes[i].Position, nodes[i].Rotation, nodes[i].Scaling, local);
+
+		globals[i] = nodes[i].Parent < 0 ? local : Reference::Multiply(globals[nodes[i].Parent], local);
+	}
+
+	return globals;
+}
+
+static bool Near(const Matrix4x4& mat, const Matrix4x4& expected)
+{
+	float error = 0.f, scale = 1.f;
+
+	for (int r = 0; r < 4; r++)
+	{
+		for (int c = 0; c < 4; c++)
+		{
+			error = std::max(error, std::abs(mat[r][c] - expected[r][c]));
+			scale = std::max(scale, std::abs(expected[r][c]));
+		}
+	}
+
+	return error <= 1e-5f * scale;
+}
+
+static void CheckSystem(const TransformSystem& system, const std::vector<Node>& nodes)
+{
+	CHECK(system.GetCount() == nodes.size());
+
+	if (system.GetCount() != nodes.size())
+		return;
+
+	const std::vector<Matrix4x4> globals = ExpectedGlobals(nodes);
+
+	for (uint32_t i = 0; i < nodes.size(); i++)
+	{
+		Matrix4x4 local;
+		Matrix4x4::TRS(nodes[i].Position, nodes[i].Rotation, nodes[i].Scaling, local);
+
+		CHECK(system.GetParent(i) == nodes[i].Parent);
+		CHECK(Near(system.GetLocal(i), local));
+		CHECK(Near(system.GetGlobal(i), globals[i]));
+	}
+}
+
+TEST(TransformSystemMatchesTRS)
+{
+	Reference::Random random;
+
+	// Every remainder of count % 4, the padding nodes must not leak into the real ones
+	for (const uint32_t count : { 1u, 2u, 3u, 4u, 5u, 6u, 7u, 8u, 9u, 13u, 37u, 1000u })
+	{
+		const std::vector<Node> nodes = RandomForest(random, count);
+
+		TransformSystem system;
+		for (const Node& node : nodes)
+			system.Add(node.Position, node.Rotation, node.Scaling, node.Parent);
+
+		system.Update();
+
+		CHECK(system.GetRecomputedCount() == count);
+		CheckSystem(system, nodes);
+	}
+}
+
+TEST(TransformSystemGrow)
+{
+	Reference::Random random;
+
+	std::vector<Node> nodes = RandomForest(random, 3);
+	TransformSystem system;
+
+	for (const Node& node : nodes)
+		system.Add(node.Position, node.Rotation, node.Scaling, node.Parent);
+
+	system.Update();
+
+	// The new nodes take the place of the padding, only they are computed
+	nodes.push_back(RandomNode(random, 2));
+	nodes.push_back(RandomNode(random, -1));
+	nodes.push_back(RandomNode(random, 3));
+
+	for (size_t i = 3; i < nodes.size(); i++)
+		system.Add(nodes[i].Position, nodes[i].Rotation, nodes[i].Scaling, nodes[i].Parent);
+
+	system.Update();
+
+	CHECK(system.GetRecomputedCount() == 3);
+	CheckSystem(system, nodes);
+
+	system.Clear();
+	CHECK(system.GetCount() == 0);
+
+	system.Update();
+	CHECK(system.GetRecomputedCount() == 0);
+}
+
+TEST(TransformSystemDirtySubtrees)
+{
+	Reference::Random random;
+
+	std::vector<Node> nodes = RandomForest(random, 37);
+	TransformSystem system;
+
+	for (const Node& node : nodes)
+		system.Add(node.Position, node.Rotation, node.Scaling, node.Parent);
+
+	system.Update();
+
+	// Nothing changed
+	std::vector<Matrix4x4> previous(nodes.size());
+	for (uint32_t i = 0; i < nodes.size(); i++)
+		previous[i] = system.GetGlobal(i);
+
+	system.Update();
+	CHECK(system.GetRecomputedCount() == 0);
+
+	for (uint32_t i = 0; i < nodes.size(); i++)
+		CHECK(Reference::BitEqual(system.GetGlobal(i), previous[i]));
+
+	for (uint32_t step = 0; step < 50; step++)
+	{
+		// One or two nodes changed, the second one possibly in the subtree of the first
+		const uint32_t changedCount = step % 2 + 1;
+		std::vector<uint8_t> dirty(nodes.size(), 0);
+
+		for (uint32_t c = 0; c < changedCount; c++)
+		{
+			const uint32_t index = static_cast<uint32_t>(random.Float(0.f, static_cast<float>(nodes.size()))) % nodes.size();
+			Node& node = nodes[index];
+			dirty[index] = 1;
+
+			switch ((step + c) % 3)
+			{
+			case 0:
+				node.Position = random.Vec3(-5.f, 5.f);
+				system.SetPosition(index, node.Position);
+				break;
+			case 1:
+				node.Rotation = random.Rotation();
+				system.SetRotation(index, node.Rotation);
+				break;
+			default:
+				node.Scaling = random.Vec3(.5f, 2.f);
+				system.SetScaling(index, node.Scaling);
+				break;
+			}
+		}
+
+		uint32_t expectedCount = 0;
+		for (size_t i = 0; i < nodes.size(); i++)
+		{
+			if (nodes[i].Parent >= 0 && dirty[nodes[i].Parent])
+				dirty[i] = 1;
+
+			expectedCount += dirty[i];
+		}
+
+		for (uint32_t i = 0; i < nodes.size(); i++)
+			previous[i] = system.GetGlobal(i);
+
+		system.Update();
+
+		CHECK(system.GetRecomputedCount() == expectedCount);
+		CheckSystem(system, nodes);
+
+		// The other nodes keep their matrices, even the ones computed in the same group of 4
+		for (uint32_t i = 0; i < nodes.size(); i++)
+		{
+			if (!dirty[i])
+				CHECK(Reference::BitEqual(system.GetGlobal(i), previous[i]));
+		}
+	}
+}